@@ -0,0 +1,279 @@
+#include "FbxSdkAnimation.h"
+#include "FbxSdkParallel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    const float kSqrtHalf = 0.70710678f;
+    const float kQuantizeScale = 32767.0f;
+
+    void CollectNodes(FbxNode* pNode, std::vector<FbxNode*>& Nodes)
+    {
+        for (int i = 0; i < pNode->GetChildCount(); ++i)
+        {
+            FbxNode* child = pNode->GetChild(i);
+            Nodes.push_back(child);
+            CollectNodes(child, Nodes);
+        }
+    }
+
+    /**
+     * @brief 逐帧采样得到的原始数据，按[分量][节点 * 帧数 + 帧]存放
+     */
+    struct RawSamples
+    {
+        size_t FrameCount = 0;
+        std::vector<float> T[3];
+        std::vector<float> Q[4];
+        std::vector<float> S[3];
+    };
+
+    /**
+     * @brief 贪心的线性关键帧精简：从当前关键帧出发尽量向后延伸，
+     *        只要被跳过的每个采样与线性插值的误差都不超过Tolerance
+     * @param Channels C个分量，各Count个采样
+     */
+    template <int C>
+    void ReduceKeys(const float* const Channels[C], size_t Count, float Tolerance, std::vector<uint32_t>& Keys)
+    {
+        Keys.clear();
+        if (Count == 0)
+            return;
+        Keys.push_back(0);
+        if (Tolerance <= 0.0f)
+        {
+            for (size_t i = 1; i < Count; ++i)
+                Keys.push_back(static_cast<uint32_t>(i));
+            return;
+        }
+
+        auto fits = [&](size_t a, size_t e)
+        {
+            const float span = static_cast<float>(e - a);
+            for (size_t i = a + 1; i < e; ++i)
+            {
+                const float t = static_cast<float>(i - a) / span;
+                for (int c = 0; c < C; ++c)
+                {
+                    const float value = Channels[c][a] + (Channels[c][e] - Channels[c][a]) * t;
+                    if (std::fabs(value - Channels[c][i]) > Tolerance)
+                        return false;
+                }
+            }
+            return true;
+        };
+
+        size_t anchor = 0;
+        while (anchor + 1 < Count)
+        {
+            size_t end = anchor + 1;
+            while (end + 1 < Count && fits(anchor, end + 1))
+                ++end;
+            Keys.push_back(static_cast<uint32_t>(end));
+            anchor = end;
+        }
+
+        // 整段恒定时只保留一个关键帧
+        if (Keys.size() == 2)
+        {
+            bool constant = true;
+            for (int c = 0; c < C; ++c)
+                constant = constant && std::fabs(Channels[c][Keys[1]] - Channels[c][0]) <= Tolerance;
+            if (constant)
+                Keys.pop_back();
+        }
+    }
+
+    template <int C>
+    void EmitChannel(const float* const Channels[C], size_t Count, float Tolerance, double SampleRate,
+                     std::vector<float>& Times, std::vector<float>* Outputs[C])
+    {
+        std::vector<uint32_t> keys;
+        ReduceKeys<C>(Channels, Count, Tolerance, keys);
+        Times.resize(keys.size());
+        for (int c = 0; c < C; ++c)
+            Outputs[c]->resize(keys.size());
+        for (size_t k = 0; k < keys.size(); ++k)
+        {
+            Times[k] = static_cast<float>(keys[k] / SampleRate);
+            for (int c = 0; c < C; ++c)
+                (*Outputs[c])[k] = Channels[c][keys[k]];
+        }
+    }
+
+    void BuildTrack(RawSamples& Raw, size_t NodeIndex, const FbxAnimBakeOptions& Options, FbxAnimTrack& Track)
+    {
+        const size_t frames = Raw.FrameCount;
+        const size_t base = NodeIndex * frames;
+
+        // 保持相邻四元数同半球，避免插值绕远路
+        float* q[4] = { Raw.Q[0].data() + base, Raw.Q[1].data() + base, Raw.Q[2].data() + base, Raw.Q[3].data() + base };
+        for (size_t f = 1; f < frames; ++f)
+        {
+            const float dot = q[0][f] * q[0][f - 1] + q[1][f] * q[1][f - 1] + q[2][f] * q[2][f - 1] + q[3][f] * q[3][f - 1];
+            const float sign = dot < 0.0f ? -1.0f : 1.0f;
+            for (int c = 0; c < 4; ++c)
+                q[c][f] *= sign;
+        }
+
+        const float* t[3] = { Raw.T[0].data() + base, Raw.T[1].data() + base, Raw.T[2].data() + base };
+        std::vector<float>* tOut[3] = { &Track.Tx, &Track.Ty, &Track.Tz };
+        EmitChannel<3>(t, frames, Options.TranslationTolerance, Options.SampleRate, Track.TranslationTimes, tOut);
+
+        const float* qIn[4] = { q[0], q[1], q[2], q[3] };
+        std::vector<float>* qOut[4] = { &Track.Qx, &Track.Qy, &Track.Qz, &Track.Qw };
+        EmitChannel<4>(qIn, frames, Options.RotationTolerance, Options.SampleRate, Track.RotationTimes, qOut);
+
+        const float* s[3] = { Raw.S[0].data() + base, Raw.S[1].data() + base, Raw.S[2].data() + base };
+        std::vector<float>* sOut[3] = { &Track.Sx, &Track.Sy, &Track.Sz };
+        EmitChannel<3>(s, frames, Options.ScaleTolerance, Options.SampleRate, Track.ScaleTimes, sOut);
+
+        if (Options.QuantizeRotations)
+        {
+            const size_t keys = Track.RotationTimes.size();
+            Track.QuantizedRotations.resize(keys * 3);
+            for (size_t k = 0; k < keys; ++k)
+            {
+                const float value[4] = { Track.Qx[k], Track.Qy[k], Track.Qz[k], Track.Qw[k] };
+                FbxAnimationBaker::QuantizeRotation(value, &Track.QuantizedRotations[k * 3]);
+            }
+            std::vector<float>().swap(Track.Qx);
+            std::vector<float>().swap(Track.Qy);
+            std::vector<float>().swap(Track.Qz);
+            std::vector<float>().swap(Track.Qw);
+        }
+    }
+}
+
+void FbxAnimTrack::GetRotation(size_t Key, float Q[4]) const
+{
+    if (!QuantizedRotations.empty())
+    {
+        FbxAnimationBaker::DequantizeRotation(&QuantizedRotations[Key * 3], Q);
+        return;
+    }
+    Q[0] = Qx[Key];
+    Q[1] = Qy[Key];
+    Q[2] = Qz[Key];
+    Q[3] = Qw[Key];
+}
+
+void FbxAnimationBaker::QuantizeRotation(const float Q[4], uint16_t Packed[3])
+{
+    int largest = 0;
+    for (int i = 1; i < 4; ++i)
+    {
+        if (std::fabs(Q[i]) > std::fabs(Q[largest]))
+            largest = i;
+    }
+    // q与-q表示同一旋转，令被丢弃的分量为正
+    const float sign = Q[largest] < 0.0f ? -1.0f : 1.0f;
+
+    int slot = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        if (i == largest)
+            continue;
+        const float normalized = std::min(1.0f, std::max(0.0f, (Q[i] * sign / kSqrtHalf) * 0.5f + 0.5f));
+        Packed[slot++] = static_cast<uint16_t>(std::lround(normalized * kQuantizeScale));
+    }
+    Packed[0] |= static_cast<uint16_t>((largest & 1) << 15);
+    Packed[1] |= static_cast<uint16_t>((largest >> 1) << 15);
+}
+
+void FbxAnimationBaker::DequantizeRotation(const uint16_t Packed[3], float Q[4])
+{
+    const int largest = (Packed[0] >> 15) | ((Packed[1] >> 15) << 1);
+    float sum = 0.0f;
+    int slot = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        if (i == largest)
+            continue;
+        const float value = ((Packed[slot++] & 0x7fff) / kQuantizeScale * 2.0f - 1.0f) * kSqrtHalf;
+        Q[i] = value;
+        sum += value * value;
+    }
+    Q[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+}
+
+void FbxAnimationBaker::Bake(FbxScene* pScene, const FbxAnimBakeOptions& Options, std::vector<FbxAnimClip>& Clips)
+{
+    Clips.clear();
+    if (!pScene || !pScene->GetRootNode() || Options.SampleRate <= 0.0)
+    {
+        return;
+    }
+
+    std::vector<FbxNode*> nodes;
+    CollectNodes(pScene->GetRootNode(), nodes);
+
+    const int stackCount = pScene->GetSrcObjectCount<FbxAnimStack>();
+    for (int i = 0; i < stackCount; ++i)
+    {
+        FbxAnimStack* stack = pScene->GetSrcObject<FbxAnimStack>(i);
+        if (!stack)
+            continue;
+
+        pScene->SetCurrentAnimationStack(stack);
+        FbxAnimEvaluator* evaluator = pScene->GetAnimationEvaluator();
+        const FbxTimeSpan span = stack->GetLocalTimeSpan();
+
+        FbxAnimClip clip;
+        clip.Name = stack->GetName() ? stack->GetName() : "";
+        clip.StartTime = span.GetStart().GetSecondDouble();
+        clip.Duration = std::max(0.0, span.GetStop().GetSecondDouble() - clip.StartTime);
+        clip.SampleRate = Options.SampleRate;
+
+        RawSamples raw;
+        raw.FrameCount = static_cast<size_t>(std::floor(clip.Duration * Options.SampleRate + 1e-6)) + 1;
+        const size_t sampleCount = raw.FrameCount * nodes.size();
+        for (int c = 0; c < 3; ++c)
+        {
+            raw.T[c].resize(sampleCount);
+            raw.S[c].resize(sampleCount);
+        }
+        for (int c = 0; c < 4; ++c)
+        {
+            raw.Q[c].resize(sampleCount);
+        }
+
+        // 按帧采样：同一时刻的全部节点连续求值，命中求值器的缓存
+        for (size_t f = 0; f < raw.FrameCount; ++f)
+        {
+            FbxTime time;
+            time.SetSecondDouble(clip.StartTime + f / Options.SampleRate);
+            for (size_t n = 0; n < nodes.size(); ++n)
+            {
+                const FbxAMatrix& local = evaluator->GetNodeLocalTransform(nodes[n], time);
+                const FbxVector4 translation = local.GetT();
+                const FbxQuaternion rotation = local.GetQ();
+                const FbxVector4 scaling = local.GetS();
+                const size_t index = n * raw.FrameCount + f;
+                for (int c = 0; c < 3; ++c)
+                {
+                    raw.T[c][index] = static_cast<float>(translation[c]);
+                    raw.S[c][index] = static_cast<float>(scaling[c]);
+                }
+                for (int c = 0; c < 4; ++c)
+                {
+                    raw.Q[c][index] = static_cast<float>(rotation[c]);
+                }
+            }
+        }
+
+        clip.Tracks.resize(nodes.size());
+        for (size_t n = 0; n < nodes.size(); ++n)
+        {
+            clip.Tracks[n].NodeId = nodes[n]->GetUniqueID();
+            clip.Tracks[n].NodeName = nodes[n]->GetName() ? nodes[n]->GetName() : "";
+        }
+        FbxParallelFor(nodes.size(), [&](size_t n)
+        {
+            BuildTrack(raw, n, Options, clip.Tracks[n]);
+        }, Options.ThreadCount);
+
+        Clips.push_back(std::move(clip));
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "FbxSdkLibrary.h"
+#include <cstdint>
+
+/**
+ * @brief 单个节点的局部变换轨道，平移/旋转/缩放各自独立精简，按分量SoA存储
+ * @note Times为相对剪辑起点的秒数；旋转量化后只保留QuantizedRotations（每个关键帧3个uint16）
+ */
+struct FbxAnimTrack
+{
+    uint64_t NodeId = 0;
+    std::string NodeName;
+
+    std::vector<float> TranslationTimes;
+    std::vector<float> Tx, Ty, Tz;
+
+    std::vector<float> RotationTimes;
+    std::vector<float> Qx, Qy, Qz, Qw;
+    std::vector<uint16_t> QuantizedRotations;
+
+    std::vector<float> ScaleTimes;
+    std::vector<float> Sx, Sy, Sz;
+
+    /**
+     * @brief 读取第Key个旋转关键帧（x, y, z, w），量化与否均可用
+     */
+    void GetRotation(size_t Key, float Q[4]) const;
+};
+
+struct FbxAnimClip
+{
+    std::string Name;
+    double StartTime = 0.0;   // 秒
+    double Duration = 0.0;    // 秒
+    double SampleRate = 0.0;  // 帧/秒
+    std::vector<FbxAnimTrack> Tracks;
+};
+
+struct FbxAnimBakeOptions
+{
+    double SampleRate = 30.0;            // 采样频率（帧/秒）
+    float TranslationTolerance = 0.0f;   // 关键帧精简的最大误差（场景单位），0表示不精简
+    float RotationTolerance = 0.0f;      // 四元数分量的最大误差，0表示不精简
+    float ScaleTolerance = 0.0f;         // 缩放分量的最大误差，0表示不精简
+    bool QuantizeRotations = false;      // 旋转按smallest-three压缩为48位
+    unsigned ThreadCount = 0;            // 精简与量化的线程数，0表示使用硬件并发数
+};
+
+/**
+ * @brief 把每个FbxAnimStack烘焙为按固定频率采样的节点局部变换轨道
+ * @note SDK的求值器不是线程安全的：采样在调用线程按帧进行，之后的精简与量化按节点并行。
+ *       烘焙会切换场景的当前动画栈。
+ */
+class FbxAnimationBaker
+{
+public:
+    static void Bake(FbxScene* pScene, const FbxAnimBakeOptions& Options, std::vector<FbxAnimClip>& Clips);
+
+    /**
+     * @brief smallest-three量化：丢弃绝对值最大的分量，其余三个各15位，最大分量序号占2位
+     */
+    static void QuantizeRotation(const float Q[4], uint16_t Packed[3]);
+    static void DequantizeRotation(const uint16_t Packed[3], float Q[4]);
+};
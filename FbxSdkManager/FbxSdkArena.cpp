@@ -0,0 +1,290 @@
+#include "FbxSdkArena.h"
+#include "FbxSdkException.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace
+{
+    // SDK分配在用户区前保存块大小，供realloc拷贝旧数据
+    const size_t kSdkHeaderSize = 16;
+
+    class SpinLockGuard
+    {
+    public:
+        explicit SpinLockGuard(std::atomic_flag& flag) : m_flag(flag)
+        {
+            while (m_flag.test_and_set(std::memory_order_acquire))
+            {
+            }
+        }
+        ~SpinLockGuard() { m_flag.clear(std::memory_order_release); }
+
+    private:
+        std::atomic_flag& m_flag;
+    };
+
+    // 当前接管SDK分配的内存池及被替换的处理函数
+    FbxArenaResource* s_sdkArena = nullptr;
+    FbxReallocProc s_prevRealloc = nullptr;
+    FbxFreeProc s_prevFree = nullptr;
+
+    void* ArenaMalloc(size_t size)
+    {
+        if (size > SIZE_MAX - kSdkHeaderSize)
+        {
+            return nullptr;
+        }
+
+        // SDK的处理函数是C接口，不能让异常穿过，失败时返回nullptr
+        char* block = static_cast<char*>(s_sdkArena->TryAllocate(size + kSdkHeaderSize, kSdkHeaderSize));
+        if (!block)
+        {
+            return nullptr;
+        }
+        memcpy(block, &size, sizeof(size));
+        return block + kSdkHeaderSize;
+    }
+
+    void* ArenaCalloc(size_t count, size_t size)
+    {
+        // 与calloc一致：count * size溢出时返回nullptr
+        if (size != 0 && count > SIZE_MAX / size)
+        {
+            return nullptr;
+        }
+
+        const size_t total = count * size;
+        void* p = ArenaMalloc(total);
+        if (p)
+        {
+            memset(p, 0, total);
+        }
+        return p;
+    }
+
+    void* ArenaRealloc(void* p, size_t size)
+    {
+        if (!p)
+        {
+            return ArenaMalloc(size);
+        }
+        if (!s_sdkArena->Owns(p))
+        {
+            return s_prevRealloc(p, size);
+        }
+
+        size_t oldSize;
+        memcpy(&oldSize, static_cast<char*>(p) - kSdkHeaderSize, sizeof(oldSize));
+        if (size <= oldSize)
+        {
+            return p;
+        }
+
+        // 与realloc一致：失败时原块保持有效
+        void* grown = ArenaMalloc(size);
+        if (!grown)
+        {
+            return nullptr;
+        }
+        memcpy(grown, p, oldSize);
+        return grown;
+    }
+
+    void ArenaFree(void* p)
+    {
+        // 内存池中的块在Release时统一归还
+        if (p && !s_sdkArena->Owns(p))
+        {
+            s_prevFree(p);
+        }
+    }
+}
+
+FbxArenaResource::FbxArenaResource(size_t slabSize)
+    : m_slabSize(slabSize), m_cursor(nullptr), m_end(nullptr), m_bytesAllocated(0), m_bytesReserved(0)
+{
+}
+
+FbxArenaResource::~FbxArenaResource()
+{
+    Release();
+}
+
+void FbxArenaResource::Release()
+{
+    SpinLockGuard guard(m_lock);
+    for (const Slab& slab : m_slabs)
+    {
+        std::free(slab.Begin);
+    }
+    m_slabs.clear();
+    m_cursor = m_end = nullptr;
+    m_bytesAllocated = 0;
+    m_bytesReserved = 0;
+}
+
+bool FbxArenaResource::Owns(const void* p) const
+{
+    SpinLockGuard guard(m_lock);
+    const char* address = static_cast<const char*>(p);
+    auto it = std::upper_bound(m_slabs.begin(), m_slabs.end(), address,
+                               [](const char* a, const Slab& slab) { return a < slab.Begin; });
+    if (it == m_slabs.begin())
+    {
+        return false;
+    }
+    --it;
+    return address < it->Begin + it->Size;
+}
+
+void* FbxArenaResource::TryAllocate(size_t bytes, size_t alignment) noexcept
+{
+    SpinLockGuard guard(m_lock);
+    return AllocateLocked(bytes, alignment);
+}
+
+size_t FbxArenaResource::GetBytesAllocated() const
+{
+    SpinLockGuard guard(m_lock);
+    return m_bytesAllocated;
+}
+
+size_t FbxArenaResource::GetBytesReserved() const
+{
+    SpinLockGuard guard(m_lock);
+    return m_bytesReserved;
+}
+
+size_t FbxArenaResource::GetSlabCount() const
+{
+    SpinLockGuard guard(m_lock);
+    return m_slabs.size();
+}
+
+void* FbxArenaResource::do_allocate(size_t bytes, size_t alignment)
+{
+    void* p = TryAllocate(bytes, alignment);
+    if (!p)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void FbxArenaResource::do_deallocate(void* /*p*/, size_t /*bytes*/, size_t /*alignment*/)
+{
+    // 单调内存池：释放为空操作
+}
+
+bool FbxArenaResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+void* FbxArenaResource::AllocateLocked(size_t bytes, size_t alignment) noexcept
+{
+    // 先排除会使下面的加法回绕的请求
+    if (bytes > SIZE_MAX - alignment)
+    {
+        return nullptr;
+    }
+
+    if (m_cursor)
+    {
+        const uintptr_t cursor = reinterpret_cast<uintptr_t>(m_cursor);
+        const uintptr_t end = reinterpret_cast<uintptr_t>(m_end);
+        const uintptr_t aligned = (cursor + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        if (aligned <= end && bytes <= end - aligned)
+        {
+            m_cursor = reinterpret_cast<char*>(aligned + bytes);
+            m_bytesAllocated += bytes;
+            return reinterpret_cast<void*>(aligned);
+        }
+    }
+
+    // 大块请求单独占用一个slab，不打断当前slab
+    const size_t required = bytes + alignment;
+    if (required > m_slabSize / 2)
+    {
+        char* begin = AddSlab(required);
+        if (!begin)
+        {
+            return nullptr;
+        }
+        const uintptr_t result = (reinterpret_cast<uintptr_t>(begin) + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        m_bytesAllocated += bytes;
+        return reinterpret_cast<void*>(result);
+    }
+
+    char* slab = AddSlab(m_slabSize);
+    if (!slab)
+    {
+        return nullptr;
+    }
+    m_cursor = slab;
+    m_end = m_cursor + m_slabSize;
+    return AllocateLocked(bytes, alignment);
+}
+
+char* FbxArenaResource::AddSlab(size_t size) noexcept
+{
+    char* begin = static_cast<char*>(std::malloc(size));
+    if (!begin)
+    {
+        return nullptr;
+    }
+
+    Slab slab = { begin, size };
+    try
+    {
+        m_slabs.insert(std::upper_bound(m_slabs.begin(), m_slabs.end(), slab,
+                                        [](const Slab& a, const Slab& b) { return a.Begin < b.Begin; }),
+                       slab);
+    }
+    catch (const std::bad_alloc&)
+    {
+        std::free(begin);
+        return nullptr;
+    }
+    m_bytesReserved += size;
+    return begin;
+}
+
+FbxSdkArenaScope::FbxSdkArenaScope(FbxArenaResource& arena)
+    : m_prevMalloc(FbxGetMallocHandler()), m_prevCalloc(FbxGetCallocHandler()),
+      m_prevRealloc(FbxGetReallocHandler()), m_prevFree(FbxGetFreeHandler())
+{
+    if (s_sdkArena)
+    {
+        throw FbxSdkException(FbxSdkException::UNKNOWN_ERROR, "FbxSdkArenaScope: another arena already owns the SDK allocator");
+    }
+
+    s_sdkArena = &arena;
+    s_prevRealloc = m_prevRealloc;
+    s_prevFree = m_prevFree;
+
+    FbxSetMallocHandler(ArenaMalloc);
+    FbxSetCallocHandler(ArenaCalloc);
+    FbxSetReallocHandler(ArenaRealloc);
+    FbxSetFreeHandler(ArenaFree);
+}
+
+FbxSdkArenaScope::~FbxSdkArenaScope()
+{
+    FbxSetMallocHandler(m_prevMalloc);
+    FbxSetCallocHandler(m_prevCalloc);
+    FbxSetReallocHandler(m_prevRealloc);
+    FbxSetFreeHandler(m_prevFree);
+
+    s_sdkArena = nullptr;
+    s_prevRealloc = nullptr;
+    s_prevFree = nullptr;
+}
+
+bool FbxSdkArenaScope::IsActive()
+{
+    return s_sdkArena != nullptr;
+}
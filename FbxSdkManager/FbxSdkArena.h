@@ -0,0 +1,100 @@
+#pragma once
+#include <fbxsdk.h>
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @brief 按块（slab）分配的单调内存池，释放为空操作，整体在Release或析构时归还
+ * @note 既作为std::pmr::memory_resource供提取容器使用，也可通过FbxSdkArenaScope接管FBX SDK的分配
+ */
+class FbxArenaResource : public std::pmr::memory_resource
+{
+public:
+    /**
+     * @param slabSize 普通slab的大小，超过一半的请求会单独分配一个slab
+     */
+    explicit FbxArenaResource(size_t slabSize = 4u << 20);
+    ~FbxArenaResource() override;
+
+    // 禁用拷贝
+    FbxArenaResource(const FbxArenaResource&) = delete;
+    FbxArenaResource& operator=(const FbxArenaResource&) = delete;
+
+    /**
+     * @brief 一次性归还全部slab，之前分配的内存全部失效
+     */
+    void Release();
+
+    /**
+     * @brief 判断指针是否位于本内存池的某个slab中
+     */
+    bool Owns(const void* p) const;
+
+    /**
+     * @brief 不抛异常的分配，失败（包括大小溢出）时返回nullptr，供SDK的C风格分配函数使用
+     */
+    void* TryAllocate(size_t bytes, size_t alignment) noexcept;
+
+    size_t GetBytesAllocated() const;
+    size_t GetBytesReserved() const;
+    size_t GetSlabCount() const;
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+    struct Slab
+    {
+        char* Begin;
+        size_t Size;
+    };
+
+    void* AllocateLocked(size_t bytes, size_t alignment) noexcept;
+    char* AddSlab(size_t size) noexcept;
+
+    size_t m_slabSize;
+    char* m_cursor;
+    char* m_end;
+    std::vector<Slab> m_slabs;  // 按地址排序，供Owns二分查找
+    size_t m_bytesAllocated;
+    size_t m_bytesReserved;
+    mutable std::atomic_flag m_lock = ATOMIC_FLAG_INIT;
+};
+
+/**
+ * @brief 作用域内通过FbxSetMallocHandler等接口把FBX SDK的分配重定向到内存池
+ * @note SDK的分配函数是进程级全局的，处理函数只在作用域内替换，因此：
+ *       - 同一时刻只能有一个作用域生效；
+ *       - 作用域必须覆盖FbxManager的整个生命周期：在作用域内创建，并在作用域结束前销毁。
+ *         作用域内分配、结束后才释放的块会交给恢复后的处理函数，而它从未分配过这个块
+ *         （安装了FbxMemoryAccounting时还会去读不存在的头部）；
+ *       - 作用域生效期间只能有一个线程使用SDK：其他线程上的FbxManager的分配同样会进入本内存池，
+ *         并在作用域结束后被释放。
+ *       不属于内存池的指针（进入作用域前分配的块）仍交给原处理函数释放；内存池耗尽时SDK得到nullptr。
+ *       需要FbxMemoryAccounting时须在进入任何作用域之前调用其Install，作用域生效期间安装会失败。
+ */
+class FbxSdkArenaScope
+{
+public:
+    explicit FbxSdkArenaScope(FbxArenaResource& arena);
+    ~FbxSdkArenaScope();
+
+    // 禁用拷贝
+    FbxSdkArenaScope(const FbxSdkArenaScope&) = delete;
+    FbxSdkArenaScope& operator=(const FbxSdkArenaScope&) = delete;
+
+    /**
+     * @brief 当前是否有作用域接管SDK分配
+     */
+    static bool IsActive();
+
+private:
+    FbxMallocProc m_prevMalloc;
+    FbxCallocProc m_prevCalloc;
+    FbxReallocProc m_prevRealloc;
+    FbxFreeProc m_prevFree;
+};
@@ -0,0 +1,76 @@
+#include "FbxSdkAsync.h"
+#include "FbxSdkException.h"
+#include <algorithm>
+
+FbxBlockingPool::FbxBlockingPool(unsigned threadCount)
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::max(2u, std::thread::hardware_concurrency() / 2);
+    }
+    m_threads.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i)
+    {
+        m_threads.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+FbxBlockingPool::~FbxBlockingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_available.notify_all();
+    for (std::thread& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void FbxBlockingPool::Post(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_available.notify_one();
+}
+
+FbxBlockingPool& FbxBlockingPool::Default()
+{
+    static FbxBlockingPool pool;
+    return pool;
+}
+
+void FbxBlockingPool::WorkerLoop()
+{
+    for (;;)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_available.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+            if (m_tasks.empty())
+            {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+
+        // 任务自行处理业务异常，这里只防止漏出的异常终止进程
+        try
+        {
+            task();
+        }
+        catch (const std::exception& e)
+        {
+            FbxErrorHandler::LogError(std::string("Blocking pool task failed: ") + e.what());
+        }
+        catch (...)
+        {
+            FbxErrorHandler::LogError("Blocking pool task failed");
+        }
+    }
+}
@@ -0,0 +1,236 @@
+#pragma once
+#include "FbxSdkWrapper.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(__has_include)
+#if __has_include(<coroutine>) && (__cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L))
+#include <coroutine>
+#endif
+#endif
+
+/**
+ * @brief 执行阻塞的SDK调用的固定线程池，把导入/提取从调用者的事件循环线程上移开
+ * @note 析构时先执行完已投递的任务再退出
+ */
+class FbxBlockingPool
+{
+public:
+    /**
+     * @param threadCount 线程数，0表示硬件并发数的一半（至少2个）
+     */
+    explicit FbxBlockingPool(unsigned threadCount = 0);
+    ~FbxBlockingPool();
+
+    FbxBlockingPool(const FbxBlockingPool&) = delete;
+    FbxBlockingPool& operator=(const FbxBlockingPool&) = delete;
+
+    void Post(std::function<void()> task);
+
+    size_t GetThreadCount() const { return m_threads.size(); }
+
+    /**
+     * @brief 进程级默认池，首次使用时创建
+     */
+    static FbxBlockingPool& Default();
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_available;
+    bool m_stopping = false;
+};
+
+/**
+ * @brief 把任务投递到调用者的executor上运行，如 [&io](std::function<void()> f) { asio::post(io, std::move(f)); }
+ */
+using FbxExecutor = std::function<void(std::function<void()>)>;
+
+struct FbxAsyncContext
+{
+    FbxBlockingPool* Pool = nullptr;    // nullptr表示FbxBlockingPool::Default()
+    FbxExecutor Resume;                 // 恢复协程所用的executor，为空时直接在池线程上恢复
+};
+
+struct FbxAsyncGeometry
+{
+    uint64_t MeshId = 0;
+    FbxGeometryInfo Geometry;
+};
+
+#ifdef __cpp_lib_coroutine
+
+/**
+ * @brief 在阻塞池上执行work，完成后经context.Resume恢复等待的协程；work抛出的异常在co_await处重新抛出
+ * @note 惰性执行：co_await时才投递，未被等待的对象不会运行work
+ */
+template <typename T>
+class FbxBlockingAwaitable
+{
+public:
+    FbxBlockingAwaitable(std::function<T()> work, FbxAsyncContext context)
+        : m_work(std::move(work)), m_context(std::move(context))
+    {
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        // 挂起期间本对象保存在协程帧中，池线程可以直接写入结果
+        FbxBlockingPool& pool = m_context.Pool ? *m_context.Pool : FbxBlockingPool::Default();
+        pool.Post([this, handle]()
+        {
+            try
+            {
+                m_result.emplace(m_work());
+            }
+            catch (...)
+            {
+                m_error = std::current_exception();
+            }
+
+            // executor可能在返回前就恢复协程并销毁本对象，先把它移出
+            FbxExecutor resume = std::move(m_context.Resume);
+            if (resume)
+                resume([handle]() { handle.resume(); });
+            else
+                handle.resume();
+        });
+    }
+
+    T await_resume()
+    {
+        if (m_error)
+            std::rethrow_exception(m_error);
+        return std::move(*m_result);
+    }
+
+private:
+    std::function<T()> m_work;
+    FbxAsyncContext m_context;
+    std::optional<T> m_result;
+    std::exception_ptr m_error;
+};
+
+/**
+ * @brief 逐Mesh的异步生成器：while (auto item = co_await stream.Next()) { ... }
+ * @note 每次Next只在池上提取一个Mesh，两次Next之间不占用池线程，调用者处理结果时其他请求可以使用该线程。
+ *       Mesh列表在第一次Next时按当前提取过滤器确定；遍历期间wrapper与stream都必须保持有效
+ */
+class FbxGeometryStream
+{
+public:
+    FbxGeometryStream(const FbxSdkWrapper& wrapper, FbxAsyncContext context = FbxAsyncContext())
+        : m_wrapper(&wrapper), m_context(std::move(context))
+    {
+    }
+
+    /**
+     * @return 下一个几何体，遍历结束时为空
+     */
+    FbxBlockingAwaitable<std::optional<FbxAsyncGeometry>> Next()
+    {
+        return FbxBlockingAwaitable<std::optional<FbxAsyncGeometry>>([this]() -> std::optional<FbxAsyncGeometry>
+        {
+            if (!m_collected)
+            {
+                m_meshes = m_wrapper->GetFilteredMeshes();
+                m_collected = true;
+            }
+            if (m_next >= m_meshes.size())
+                return std::nullopt;
+
+            FbxMesh* mesh = m_meshes[m_next++];
+            FbxAsyncGeometry item;
+            item.MeshId = mesh->GetUniqueID();
+            item.Geometry = m_wrapper->ExtractGeometry(mesh);
+            return item;
+        }, m_context);
+    }
+
+    /**
+     * @brief 已知的Mesh总数，第一次Next完成前为0
+     */
+    size_t GetMeshCount() const { return m_meshes.size(); }
+
+private:
+    const FbxSdkWrapper* m_wrapper;
+    FbxAsyncContext m_context;
+    std::vector<FbxMesh*> m_meshes;
+    size_t m_next = 0;
+    bool m_collected = false;
+};
+
+/**
+ * @brief FbxSdkWrapper阻塞调用的可等待版本
+ * @note 不同wrapper上的调用可以并发；同一wrapper上的调用必须依次co_await，不能同时挂起多个。
+ *       filename等参数按值保存，调用者不必在等待期间保持其有效
+ */
+class FbxAsync
+{
+public:
+    static FbxBlockingAwaitable<bool> LoadAsync(FbxSdkWrapper& wrapper, std::string filename,
+                                                FbxAsyncContext context = FbxAsyncContext())
+    {
+        return FbxBlockingAwaitable<bool>([&wrapper, filename = std::move(filename)]() { return wrapper.LoadFile(filename); },
+                                          std::move(context));
+    }
+
+    static FbxBlockingAwaitable<bool> LoadMappedAsync(FbxSdkWrapper& wrapper, std::string filename,
+                                                      FbxAsyncContext context = FbxAsyncContext())
+    {
+        return FbxBlockingAwaitable<bool>([&wrapper, filename = std::move(filename)]() { return wrapper.LoadMappedFile(filename); },
+                                          std::move(context));
+    }
+
+    static FbxBlockingAwaitable<std::map<uint64_t, FbxGeometryInfo>> GetGeometriesAsync(const FbxSdkWrapper& wrapper,
+                                                                                      FbxAsyncContext context = FbxAsyncContext())
+    {
+        return FbxBlockingAwaitable<std::map<uint64_t, FbxGeometryInfo>>([&wrapper]() { return wrapper.GetGeometries(); },
+                                                                         std::move(context));
+    }
+
+    static FbxBlockingAwaitable<std::map<uint64_t, FbxMaterialsInfo>> GetMaterialsAsync(const FbxSdkWrapper& wrapper,
+                                                                                     FbxAsyncContext context = FbxAsyncContext())
+    {
+        return FbxBlockingAwaitable<std::map<uint64_t, FbxMaterialsInfo>>([&wrapper]() { return wrapper.GetMaterials(); },
+                                                                          std::move(context));
+    }
+
+    /**
+     * @brief 把任意阻塞调用放到池上执行，返回void的调用co_await得到true
+     */
+    template <typename F>
+    static auto Run(F&& work, FbxAsyncContext context = FbxAsyncContext())
+    {
+        using Result = decltype(work());
+        if constexpr (std::is_void_v<Result>)
+        {
+            return FbxBlockingAwaitable<bool>([work = std::forward<F>(work)]() mutable
+            {
+                work();
+                return true;
+            }, std::move(context));
+        }
+        else
+        {
+            return FbxBlockingAwaitable<Result>(std::function<Result()>(std::forward<F>(work)), std::move(context));
+        }
+    }
+};
+
+#endif
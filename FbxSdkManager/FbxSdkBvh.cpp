@@ -0,0 +1,743 @@
+#include "FbxSdkBvh.h"
+#include "FbxSdkParallel.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <numeric>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FBX_BVH_SSE 1
+#endif
+
+namespace
+{
+    const int kStackSize = 64;
+    const int kMaxSahDepth = 32;         // 超过该深度改为中位数划分，保证树深不超过遍历栈
+    const int kMaxBins = 64;
+    const uint32_t kMaxLeafForced = 16;  // SAH认为不值得分割时，允许的最大叶子
+
+    struct Bounds
+    {
+        float Min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+        float Max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+        void Grow(const float* Minimum, const float* Maximum)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                Min[k] = std::min(Min[k], Minimum[k]);
+                Max[k] = std::max(Max[k], Maximum[k]);
+            }
+        }
+
+        float HalfArea() const
+        {
+            const float x = Max[0] - Min[0], y = Max[1] - Min[1], z = Max[2] - Min[2];
+            return x < 0.0f ? 0.0f : x * y + y * z + z * x;
+        }
+    };
+
+    /**
+     * @brief 分箱SAH自顶向下构建，图元以包围盒与中心点描述
+     * @param Order 输出：叶子顺序下的图元下标
+     */
+    void BuildTree(size_t Count, const std::vector<float>& Minimum, const std::vector<float>& Maximum,
+                   const std::vector<float>& Centroids, const FbxBvhOptions& Options,
+                   std::vector<FbxBvhNode>& Nodes, std::vector<uint32_t>& Order)
+    {
+        Nodes.clear();
+        Order.resize(Count);
+        std::iota(Order.begin(), Order.end(), 0u);
+        if (Count == 0)
+        {
+            return;
+        }
+
+        const uint32_t maxLeafSize = static_cast<uint32_t>(std::max(1, Options.MaxLeafSize));
+        const int binCount = std::min(kMaxBins, std::max(2, Options.BinCount));
+        Nodes.reserve(2 * Count);
+        Nodes.push_back(FbxBvhNode{ {}, 0, {}, static_cast<uint32_t>(Count) });
+
+        std::vector<std::pair<uint32_t, int>> stack;
+        stack.emplace_back(0u, 0);
+        while (!stack.empty())
+        {
+            const uint32_t nodeIndex = stack.back().first;
+            const int depth = stack.back().second;
+            stack.pop_back();
+            const uint32_t first = Nodes[nodeIndex].LeftOrFirst;
+            const uint32_t count = Nodes[nodeIndex].Count;
+
+            Bounds bounds, centroidBounds;
+            for (uint32_t i = first; i < first + count; ++i)
+            {
+                const uint32_t p = Order[i];
+                bounds.Grow(&Minimum[3 * p], &Maximum[3 * p]);
+                centroidBounds.Grow(&Centroids[3 * p], &Centroids[3 * p]);
+            }
+            std::copy_n(bounds.Min, 3, Nodes[nodeIndex].Min);
+            std::copy_n(bounds.Max, 3, Nodes[nodeIndex].Max);
+            if (count <= maxLeafSize)
+                continue;
+
+            // 三个轴上分箱，扫描求最小SAH代价
+            int bestAxis = -1, bestSplit = 0;
+            float bestCost = FLT_MAX;
+            for (int axis = 0; axis < 3 && depth < kMaxSahDepth; ++axis)
+            {
+                const float extent = centroidBounds.Max[axis] - centroidBounds.Min[axis];
+                if (!(extent > 0.0f))
+                    continue;
+                const float scale = binCount / extent;
+
+                Bounds bins[kMaxBins];
+                uint32_t binCounts[kMaxBins] = {};
+                for (uint32_t i = first; i < first + count; ++i)
+                {
+                    const uint32_t p = Order[i];
+                    const int bin = std::min(binCount - 1, static_cast<int>((Centroids[3 * p + axis] - centroidBounds.Min[axis]) * scale));
+                    bins[bin].Grow(&Minimum[3 * p], &Maximum[3 * p]);
+                    ++binCounts[bin];
+                }
+
+                float rightArea[kMaxBins];
+                uint32_t rightCount[kMaxBins];
+                Bounds right;
+                uint32_t rightSum = 0;
+                for (int b = binCount - 1; b > 0; --b)
+                {
+                    right.Grow(bins[b].Min, bins[b].Max);
+                    rightSum += binCounts[b];
+                    rightArea[b] = right.HalfArea();
+                    rightCount[b] = rightSum;
+                }
+                Bounds left;
+                uint32_t leftSum = 0;
+                for (int b = 1; b < binCount; ++b)
+                {
+                    left.Grow(bins[b - 1].Min, bins[b - 1].Max);
+                    leftSum += binCounts[b - 1];
+                    if (leftSum == 0 || rightCount[b] == 0)
+                        continue;
+                    const float cost = left.HalfArea() * leftSum + rightArea[b] * rightCount[b];
+                    if (cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestSplit = b;
+                    }
+                }
+            }
+
+            uint32_t middle = first + count / 2;
+            if (bestAxis >= 0)
+            {
+                const float leafCost = bounds.HalfArea() * count;
+                if (bestCost >= leafCost && count <= kMaxLeafForced)
+                    continue;
+
+                const float extent = centroidBounds.Max[bestAxis] - centroidBounds.Min[bestAxis];
+                const float scale = binCount / extent;
+                auto split = std::partition(Order.begin() + first, Order.begin() + first + count, [&](uint32_t p)
+                {
+                    const int bin = std::min(binCount - 1, static_cast<int>((Centroids[3 * p + bestAxis] - centroidBounds.Min[bestAxis]) * scale));
+                    return bin < bestSplit;
+                });
+                middle = static_cast<uint32_t>(split - Order.begin());
+            }
+            else if (depth >= kMaxSahDepth)
+            {
+                int axis = 0;
+                for (int k = 1; k < 3; ++k)
+                {
+                    if (centroidBounds.Max[k] - centroidBounds.Min[k] > centroidBounds.Max[axis] - centroidBounds.Min[axis])
+                        axis = k;
+                }
+                std::nth_element(Order.begin() + first, Order.begin() + middle, Order.begin() + first + count,
+                                 [&](uint32_t a, uint32_t b) { return Centroids[3 * a + axis] < Centroids[3 * b + axis]; });
+            }
+            // 中心点全部重合或划分退化时对半分
+            if (middle == first || middle == first + count)
+                middle = first + count / 2;
+
+            const uint32_t left = static_cast<uint32_t>(Nodes.size());
+            Nodes.push_back(FbxBvhNode{ {}, first, {}, middle - first });
+            Nodes.push_back(FbxBvhNode{ {}, middle, {}, first + count - middle });
+            Nodes[nodeIndex].LeftOrFirst = left;
+            Nodes[nodeIndex].Count = 0;
+            stack.emplace_back(left, depth + 1);
+            stack.emplace_back(left + 1, depth + 1);
+        }
+    }
+
+    void TransformPoint(const float* M, const float* P, float* Out)
+    {
+        for (int r = 0; r < 3; ++r)
+            Out[r] = M[4 * r] * P[0] + M[4 * r + 1] * P[1] + M[4 * r + 2] * P[2] + M[4 * r + 3];
+    }
+
+    void TransformVector(const float* M, const float* V, float* Out)
+    {
+        for (int r = 0; r < 3; ++r)
+            Out[r] = M[4 * r] * V[0] + M[4 * r + 1] * V[1] + M[4 * r + 2] * V[2];
+    }
+
+    /**
+     * @brief 包围盒经仿射变换后的包围盒
+     */
+    void TransformBounds(const float* M, const float* Minimum, const float* Maximum, float* OutMin, float* OutMax)
+    {
+        for (int r = 0; r < 3; ++r)
+        {
+            OutMin[r] = OutMax[r] = M[4 * r + 3];
+            for (int c = 0; c < 3; ++c)
+            {
+                const float a = M[4 * r + c] * Minimum[c];
+                const float b = M[4 * r + c] * Maximum[c];
+                OutMin[r] += std::min(a, b);
+                OutMax[r] += std::max(a, b);
+            }
+        }
+    }
+
+    bool InvertAffine(const float* M, float* Inverse)
+    {
+        const double a = M[0], b = M[1], c = M[2], d = M[4], e = M[5], f = M[6], g = M[8], h = M[9], i = M[10];
+        const double det = a * (e * i - f * h) - b * (d * i - f * g) + c * (d * h - e * g);
+        if (std::fabs(det) < 1e-20)
+            return false;
+        const double inv = 1.0 / det;
+        const double r[9] = {
+            (e * i - f * h) * inv, (c * h - b * i) * inv, (b * f - c * e) * inv,
+            (f * g - d * i) * inv, (a * i - c * g) * inv, (c * d - a * f) * inv,
+            (d * h - e * g) * inv, (b * g - a * h) * inv, (a * e - b * d) * inv };
+        for (int row = 0; row < 3; ++row)
+        {
+            double t = 0.0;
+            for (int col = 0; col < 3; ++col)
+            {
+                Inverse[4 * row + col] = static_cast<float>(r[3 * row + col]);
+                t -= r[3 * row + col] * M[4 * col + 3];
+            }
+            Inverse[4 * row + 3] = static_cast<float>(t);
+        }
+        return true;
+    }
+
+    struct Ray
+    {
+        float Origin[3];
+        float Direction[3];
+        float InverseDirection[3];
+
+        void Setup(const float* O, const float* D)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                Origin[k] = O[k];
+                Direction[k] = D[k];
+                // 避免0 * inf产生NaN
+                const float safe = std::fabs(D[k]) > 1e-30f ? D[k] : (D[k] < 0.0f ? -1e-30f : 1e-30f);
+                InverseDirection[k] = 1.0f / safe;
+            }
+        }
+    };
+
+#if FBX_BVH_SSE
+    struct SimdRay
+    {
+        __m128 Origin;
+        __m128 InverseDirection;
+
+        explicit SimdRay(const Ray& R)
+            : Origin(_mm_setr_ps(R.Origin[0], R.Origin[1], R.Origin[2], 0.0f))
+            , InverseDirection(_mm_setr_ps(R.InverseDirection[0], R.InverseDirection[1], R.InverseDirection[2], 0.0f))
+        {
+        }
+    };
+
+    /**
+     * @brief slab测试，四通道一次算完三个轴（第四通道是LeftOrFirst/Count，不参与比较）
+     */
+    inline bool IntersectNode(const FbxBvhNode& Node, const SimdRay& R, float MaxDistance, float& Near)
+    {
+        const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(Node.Min), R.Origin), R.InverseDirection);
+        const __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(Node.Max), R.Origin), R.InverseDirection);
+        const __m128 tNear = _mm_min_ps(t1, t2);
+        const __m128 tFar = _mm_max_ps(t1, t2);
+        const __m128 nearXY = _mm_max_ss(tNear, _mm_shuffle_ps(tNear, tNear, _MM_SHUFFLE(1, 1, 1, 1)));
+        const __m128 farXY = _mm_min_ss(tFar, _mm_shuffle_ps(tFar, tFar, _MM_SHUFFLE(1, 1, 1, 1)));
+        const float enter = _mm_cvtss_f32(_mm_max_ss(_mm_max_ss(nearXY, _mm_movehl_ps(tNear, tNear)), _mm_setzero_ps()));
+        const float exit = _mm_cvtss_f32(_mm_min_ss(_mm_min_ss(farXY, _mm_movehl_ps(tFar, tFar)), _mm_set_ss(MaxDistance)));
+        Near = enter;
+        return enter <= exit;
+    }
+#else
+    struct SimdRay
+    {
+        const Ray& R;
+        explicit SimdRay(const Ray& Source) : R(Source) {}
+    };
+
+    inline bool IntersectNode(const FbxBvhNode& Node, const SimdRay& S, float MaxDistance, float& Near)
+    {
+        float enter = 0.0f, exit = MaxDistance;
+        for (int k = 0; k < 3; ++k)
+        {
+            const float t1 = (Node.Min[k] - S.R.Origin[k]) * S.R.InverseDirection[k];
+            const float t2 = (Node.Max[k] - S.R.Origin[k]) * S.R.InverseDirection[k];
+            enter = std::max(enter, std::min(t1, t2));
+            exit = std::min(exit, std::max(t1, t2));
+        }
+        Near = enter;
+        return enter <= exit;
+    }
+#endif
+
+    /**
+     * @brief Möller-Trumbore，双面
+     */
+    inline bool IntersectTriangle(const Ray& R, const float* V, float MaxDistance, float& T, float& U, float& W)
+    {
+        const float e1[3] = { V[3] - V[0], V[4] - V[1], V[5] - V[2] };
+        const float e2[3] = { V[6] - V[0], V[7] - V[1], V[8] - V[2] };
+        const float p[3] = { R.Direction[1] * e2[2] - R.Direction[2] * e2[1],
+                             R.Direction[2] * e2[0] - R.Direction[0] * e2[2],
+                             R.Direction[0] * e2[1] - R.Direction[1] * e2[0] };
+        const float det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+        if (std::fabs(det) < 1e-12f)
+            return false;
+        const float inv = 1.0f / det;
+        const float s[3] = { R.Origin[0] - V[0], R.Origin[1] - V[1], R.Origin[2] - V[2] };
+        const float u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * inv;
+        if (u < 0.0f || u > 1.0f)
+            return false;
+        const float q[3] = { s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0] };
+        const float v = (R.Direction[0] * q[0] + R.Direction[1] * q[1] + R.Direction[2] * q[2]) * inv;
+        if (v < 0.0f || u + v > 1.0f)
+            return false;
+        const float t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * inv;
+        if (t < 0.0f || t > MaxDistance)
+            return false;
+        T = t;
+        U = u;
+        W = v;
+        return true;
+    }
+
+    bool BoxesOverlap(const float* MinA, const float* MaxA, const float* MinB, const float* MaxB)
+    {
+        return MinA[0] <= MaxB[0] && MaxA[0] >= MinB[0] && MinA[1] <= MaxB[1] && MaxA[1] >= MinB[1]
+            && MinA[2] <= MaxB[2] && MaxA[2] >= MinB[2];
+    }
+
+    /**
+     * @brief 三角形与包围盒的分离轴测试（包围盒三轴、三角形法线、9个边叉积轴）
+     */
+    bool TriangleOverlapsBox(const float* Center, const float* Half, const float* Triangle)
+    {
+        float v[3][3];
+        for (int i = 0; i < 3; ++i)
+            for (int k = 0; k < 3; ++k)
+                v[i][k] = Triangle[3 * i + k] - Center[k];
+
+        for (int k = 0; k < 3; ++k)
+        {
+            if (std::min({ v[0][k], v[1][k], v[2][k] }) > Half[k] || std::max({ v[0][k], v[1][k], v[2][k] }) < -Half[k])
+                return false;
+        }
+
+        auto separated = [&](const float* Axis)
+        {
+            const float p0 = Axis[0] * v[0][0] + Axis[1] * v[0][1] + Axis[2] * v[0][2];
+            const float p1 = Axis[0] * v[1][0] + Axis[1] * v[1][1] + Axis[2] * v[1][2];
+            const float p2 = Axis[0] * v[2][0] + Axis[1] * v[2][1] + Axis[2] * v[2][2];
+            const float r = Half[0] * std::fabs(Axis[0]) + Half[1] * std::fabs(Axis[1]) + Half[2] * std::fabs(Axis[2]);
+            return std::min({ p0, p1, p2 }) > r || std::max({ p0, p1, p2 }) < -r;
+        };
+
+        float edges[3][3];
+        for (int i = 0; i < 3; ++i)
+            for (int k = 0; k < 3; ++k)
+                edges[i][k] = v[(i + 1) % 3][k] - v[i][k];
+
+        const float normal[3] = { edges[0][1] * edges[1][2] - edges[0][2] * edges[1][1],
+                                  edges[0][2] * edges[1][0] - edges[0][0] * edges[1][2],
+                                  edges[0][0] * edges[1][1] - edges[0][1] * edges[1][0] };
+        if (separated(normal))
+            return false;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            const float* e = edges[i];
+            const float axes[3][3] = { { 0.0f, -e[2], e[1] }, { e[2], 0.0f, -e[0] }, { -e[1], e[0], 0.0f } };
+            for (const auto& axis : axes)
+            {
+                if (separated(axis))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    void BuildMesh(uint64_t MeshId, const FbxGeometryInfo& Geometry, const FbxBvhOptions& Options, FbxBvhMesh& Mesh)
+    {
+        Mesh.MeshId = MeshId;
+
+        // 收集三角形并计算包围盒与中心点
+        std::vector<float> triangles;
+        std::vector<uint32_t> sections, indices;
+        for (const auto& sectionPair : Geometry.Sections)
+        {
+            const std::pmr::vector<int>& corners = sectionPair.second.Triangle;
+            const uint32_t sectionIndex = static_cast<uint32_t>(Mesh.SectionIds.size());
+            Mesh.SectionIds.push_back(sectionPair.first);
+            for (size_t t = 0; t + 2 < corners.size(); t += 3)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    const int cp = corners[t + c];
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        const bool valid = cp >= 0 && static_cast<size_t>(cp) < Geometry.ControlPoints.size();
+                        triangles.push_back(valid ? static_cast<float>(Geometry.ControlPoints[cp][k]) : 0.0f);
+                    }
+                }
+                sections.push_back(sectionIndex);
+                indices.push_back(static_cast<uint32_t>(t / 3));
+            }
+        }
+
+        const size_t count = indices.size();
+        std::vector<float> minimum(3 * count), maximum(3 * count), centroids(3 * count);
+        for (size_t t = 0; t < count; ++t)
+        {
+            const float* v = &triangles[9 * t];
+            for (int k = 0; k < 3; ++k)
+            {
+                minimum[3 * t + k] = std::min({ v[k], v[3 + k], v[6 + k] });
+                maximum[3 * t + k] = std::max({ v[k], v[3 + k], v[6 + k] });
+                centroids[3 * t + k] = 0.5f * (minimum[3 * t + k] + maximum[3 * t + k]);
+            }
+        }
+
+        std::vector<uint32_t> order;
+        BuildTree(count, minimum, maximum, centroids, Options, Mesh.Nodes, order);
+
+        // 按叶子顺序重排，叶子内三角形连续存放
+        Mesh.Triangles.resize(9 * count);
+        Mesh.TriangleSections.resize(count);
+        Mesh.TriangleIndices.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::copy_n(&triangles[9 * order[i]], 9, &Mesh.Triangles[9 * i]);
+            Mesh.TriangleSections[i] = sections[order[i]];
+            Mesh.TriangleIndices[i] = indices[order[i]];
+        }
+    }
+
+    /**
+     * @brief 按距离由近到远遍历，Leaf(first, count, maxDistance)返回新的最大距离
+     */
+    template <typename LeafFn>
+    void TraverseRay(const std::vector<FbxBvhNode>& Nodes, const Ray& R, float MaxDistance, LeafFn&& Leaf)
+    {
+        if (Nodes.empty())
+            return;
+
+        const SimdRay simdRay(R);
+        float near;
+        if (!IntersectNode(Nodes[0], simdRay, MaxDistance, near))
+            return;
+
+        uint32_t stack[kStackSize];
+        int stackSize = 0;
+        uint32_t nodeIndex = 0;
+        while (true)
+        {
+            const FbxBvhNode& node = Nodes[nodeIndex];
+            if (node.IsLeaf())
+            {
+                MaxDistance = Leaf(node.LeftOrFirst, node.Count, MaxDistance);
+            }
+            else
+            {
+                float nearLeft, nearRight;
+                const bool hitLeft = IntersectNode(Nodes[node.LeftOrFirst], simdRay, MaxDistance, nearLeft);
+                const bool hitRight = IntersectNode(Nodes[node.LeftOrFirst + 1], simdRay, MaxDistance, nearRight);
+                if (hitLeft && hitRight)
+                {
+                    const bool leftFirst = nearLeft <= nearRight;
+                    if (stackSize < kStackSize)
+                        stack[stackSize++] = leftFirst ? node.LeftOrFirst + 1 : node.LeftOrFirst;
+                    nodeIndex = leftFirst ? node.LeftOrFirst : node.LeftOrFirst + 1;
+                    continue;
+                }
+                if (hitLeft || hitRight)
+                {
+                    nodeIndex = hitLeft ? node.LeftOrFirst : node.LeftOrFirst + 1;
+                    continue;
+                }
+            }
+
+            // 出栈时重新测试，跳过已被更近交点剔除的节点
+            bool found = false;
+            while (stackSize > 0)
+            {
+                nodeIndex = stack[--stackSize];
+                if (IntersectNode(Nodes[nodeIndex], simdRay, MaxDistance, near))
+                {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found)
+                return;
+        }
+    }
+
+    template <typename LeafFn>
+    void TraverseBox(const std::vector<FbxBvhNode>& Nodes, const float* Minimum, const float* Maximum, LeafFn&& Leaf)
+    {
+        if (Nodes.empty())
+            return;
+
+        uint32_t stack[kStackSize];
+        int stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0)
+        {
+            const FbxBvhNode& node = Nodes[stack[--stackSize]];
+            if (!BoxesOverlap(node.Min, node.Max, Minimum, Maximum))
+                continue;
+            if (node.IsLeaf())
+            {
+                Leaf(node.LeftOrFirst, node.Count);
+            }
+            else if (stackSize + 2 <= kStackSize)
+            {
+                stack[stackSize++] = node.LeftOrFirst + 1;
+                stack[stackSize++] = node.LeftOrFirst;
+            }
+        }
+    }
+}
+
+void FbxSceneBvh::Clear()
+{
+    m_meshes.clear();
+    m_meshIndices.clear();
+    m_instances.clear();
+    m_nodes.clear();
+    m_instanceOrder.clear();
+}
+
+void FbxSceneBvh::BuildMeshes(const std::map<uint64_t, FbxGeometryInfo>& geometries, const FbxBvhOptions& options)
+{
+    Clear();
+    m_options = options;
+
+    std::vector<std::pair<uint64_t, const FbxGeometryInfo*>> sources;
+    for (const auto& geoPair : geometries)
+    {
+        m_meshIndices[geoPair.first] = static_cast<uint32_t>(sources.size());
+        sources.emplace_back(geoPair.first, &geoPair.second);
+    }
+
+    m_meshes.resize(sources.size());
+    FbxParallelFor(sources.size(), [&](size_t i)
+    {
+        BuildMesh(sources[i].first, *sources[i].second, m_options, m_meshes[i]);
+    }, options.ThreadCount);
+}
+
+bool FbxSceneBvh::AddInstance(uint64_t nodeId, uint64_t meshId, const FbxAMatrix& world)
+{
+    auto mesh = m_meshIndices.find(meshId);
+    if (mesh == m_meshIndices.end() || m_meshes[mesh->second].Nodes.empty())
+    {
+        return false;
+    }
+
+    FbxBvhInstance instance;
+    instance.NodeId = nodeId;
+    instance.Mesh = mesh->second;
+
+    // 由变换后的原点与三个基向量得到3x4矩阵，与FbxAMatrix的内部存储约定无关
+    const FbxVector4 origin = world.MultT(FbxVector4(0.0, 0.0, 0.0, 1.0));
+    const FbxVector4 axes[3] = { world.MultT(FbxVector4(1.0, 0.0, 0.0, 1.0)), world.MultT(FbxVector4(0.0, 1.0, 0.0, 1.0)),
+                                 world.MultT(FbxVector4(0.0, 0.0, 1.0, 1.0)) };
+    for (int r = 0; r < 3; ++r)
+    {
+        for (int c = 0; c < 3; ++c)
+            instance.World[4 * r + c] = static_cast<float>(axes[c][r] - origin[r]);
+        instance.World[4 * r + 3] = static_cast<float>(origin[r]);
+    }
+    if (!InvertAffine(instance.World, instance.InverseWorld))
+    {
+        return false;
+    }
+
+    const FbxBvhNode& root = m_meshes[mesh->second].Nodes[0];
+    TransformBounds(instance.World, root.Min, root.Max, instance.Min, instance.Max);
+    m_instances.push_back(instance);
+    return true;
+}
+
+void FbxSceneBvh::BuildInstances()
+{
+    const size_t count = m_instances.size();
+    std::vector<float> minimum(3 * count), maximum(3 * count), centroids(3 * count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            minimum[3 * i + k] = m_instances[i].Min[k];
+            maximum[3 * i + k] = m_instances[i].Max[k];
+            centroids[3 * i + k] = 0.5f * (m_instances[i].Min[k] + m_instances[i].Max[k]);
+        }
+    }
+
+    FbxBvhOptions options = m_options;
+    options.MaxLeafSize = 1;
+    BuildTree(count, minimum, maximum, centroids, options, m_nodes, m_instanceOrder);
+}
+
+void FbxSceneBvh::Build(FbxScene* pScene, const std::map<uint64_t, FbxGeometryInfo>& geometries, const FbxBvhOptions& options)
+{
+    BuildMeshes(geometries, options);
+
+    FbxNode* root = pScene ? pScene->GetRootNode() : nullptr;
+    std::vector<FbxNode*> stack;
+    if (root)
+    {
+        stack.push_back(root);
+    }
+    while (!stack.empty())
+    {
+        FbxNode* node = stack.back();
+        stack.pop_back();
+        for (int i = node->GetChildCount() - 1; i >= 0; --i)
+        {
+            stack.push_back(node->GetChild(i));
+        }
+
+        FbxMesh* mesh = node->GetMesh();
+        if (!mesh)
+            continue;
+        // 几何变换只作用于本节点的几何体，不向子节点传递
+        const FbxAMatrix geometric(node->GetGeometricTranslation(FbxNode::eSourcePivot),
+                                   node->GetGeometricRotation(FbxNode::eSourcePivot),
+                                   node->GetGeometricScaling(FbxNode::eSourcePivot));
+        AddInstance(node->GetUniqueID(), mesh->GetUniqueID(), node->EvaluateGlobalTransform() * geometric);
+    }
+
+    BuildInstances();
+}
+
+bool FbxSceneBvh::RayCast(const float origin[3], const float direction[3], float maxDistance, FbxRayHit& hit) const
+{
+    const float length = std::sqrt(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+    if (!(length > 0.0f))
+    {
+        return false;
+    }
+    const float unit[3] = { direction[0] / length, direction[1] / length, direction[2] / length };
+
+    Ray worldRay;
+    worldRay.Setup(origin, unit);
+    bool found = false;
+    TraverseRay(m_nodes, worldRay, maxDistance, [&](uint32_t first, uint32_t count, float best)
+    {
+        for (uint32_t i = first; i < first + count; ++i)
+        {
+            const FbxBvhInstance& instance = m_instances[m_instanceOrder[i]];
+            const FbxBvhMesh& mesh = m_meshes[instance.Mesh];
+
+            // 射线变换到Mesh局部空间，参数t与世界空间一致
+            float localOrigin[3], localDirection[3];
+            TransformPoint(instance.InverseWorld, worldRay.Origin, localOrigin);
+            TransformVector(instance.InverseWorld, worldRay.Direction, localDirection);
+            Ray localRay;
+            localRay.Setup(localOrigin, localDirection);
+
+            TraverseRay(mesh.Nodes, localRay, best, [&](uint32_t firstTriangle, uint32_t triangleCount, float meshBest)
+            {
+                for (uint32_t t = firstTriangle; t < firstTriangle + triangleCount; ++t)
+                {
+                    float distance, u, v;
+                    if (IntersectTriangle(localRay, &mesh.Triangles[9 * t], meshBest, distance, u, v))
+                    {
+                        meshBest = distance;
+                        found = true;
+                        hit.Distance = distance;
+                        hit.U = u;
+                        hit.V = v;
+                        hit.NodeId = instance.NodeId;
+                        hit.MeshId = mesh.MeshId;
+                        hit.MaterialId = mesh.SectionIds[mesh.TriangleSections[t]];
+                        hit.TriangleIndex = mesh.TriangleIndices[t];
+                    }
+                }
+                return meshBest;
+            });
+            best = found ? std::min(best, hit.Distance) : best;
+        }
+        return best;
+    });
+    return found;
+}
+
+size_t FbxSceneBvh::QueryAabb(const float minimum[3], const float maximum[3], std::vector<FbxBvhOverlap>& overlaps) const
+{
+    const size_t before = overlaps.size();
+    float center[3], half[3];
+    for (int k = 0; k < 3; ++k)
+    {
+        center[k] = 0.5f * (minimum[k] + maximum[k]);
+        half[k] = 0.5f * (maximum[k] - minimum[k]);
+    }
+
+    TraverseBox(m_nodes, minimum, maximum, [&](uint32_t first, uint32_t count)
+    {
+        for (uint32_t i = first; i < first + count; ++i)
+        {
+            const FbxBvhInstance& instance = m_instances[m_instanceOrder[i]];
+            const FbxBvhMesh& mesh = m_meshes[instance.Mesh];
+
+            // 局部空间中用查询盒的外接盒粗筛，再在世界空间精确测试
+            float localMin[3], localMax[3];
+            TransformBounds(instance.InverseWorld, minimum, maximum, localMin, localMax);
+            TraverseBox(mesh.Nodes, localMin, localMax, [&](uint32_t firstTriangle, uint32_t triangleCount)
+            {
+                for (uint32_t t = firstTriangle; t < firstTriangle + triangleCount; ++t)
+                {
+                    float world[9];
+                    for (int c = 0; c < 3; ++c)
+                        TransformPoint(instance.World, &mesh.Triangles[9 * t + 3 * c], &world[3 * c]);
+                    if (!TriangleOverlapsBox(center, half, world))
+                        continue;
+                    FbxBvhOverlap overlap;
+                    overlap.NodeId = instance.NodeId;
+                    overlap.MeshId = mesh.MeshId;
+                    overlap.MaterialId = mesh.SectionIds[mesh.TriangleSections[t]];
+                    overlap.TriangleIndex = mesh.TriangleIndices[t];
+                    overlaps.push_back(overlap);
+                }
+            });
+        }
+    });
+    return overlaps.size() - before;
+}
+
+bool FbxSceneBvh::GetBounds(float minimum[3], float maximum[3]) const
+{
+    if (m_nodes.empty())
+    {
+        return false;
+    }
+    std::copy_n(m_nodes[0].Min, 3, minimum);
+    std::copy_n(m_nodes[0].Max, 3, maximum);
+    return true;
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include "FbxSdkLibrary.h"
+#include <cstdint>
+
+/**
+ * @brief 32字节的BVH节点
+ * @note 内部节点的两个子节点相邻存放：左子节点为LeftOrFirst，右子节点为LeftOrFirst + 1；
+ *       叶子节点的图元为[LeftOrFirst, LeftOrFirst + Count)
+ */
+struct FbxBvhNode
+{
+    float Min[3];
+    uint32_t LeftOrFirst;
+    float Max[3];
+    uint32_t Count;  // 0表示内部节点
+
+    bool IsLeaf() const { return Count != 0; }
+};
+static_assert(sizeof(FbxBvhNode) == 32, "FbxBvhNode must stay 32 bytes");
+
+/**
+ * @brief 一个Mesh的底层BVH（BLAS），三角形按叶子顺序重排，坐标为Mesh局部空间
+ */
+struct FbxBvhMesh
+{
+    uint64_t MeshId = 0;
+    std::vector<FbxBvhNode> Nodes;
+    std::vector<float> Triangles;           // 每个三角形9个float
+    std::vector<uint32_t> TriangleSections; // 三角形所属section在SectionIds中的下标
+    std::vector<uint32_t> TriangleIndices;  // 三角形在所属section中的序号（Triangle[3 * i]起的3个corner）
+    std::vector<uint64_t> SectionIds;       // section的材质Id
+
+    size_t GetTriangleCount() const { return TriangleIndices.size(); }
+};
+
+/**
+ * @brief 顶层BVH（TLAS）中的一个节点实例，World为3x4行主序矩阵（p' = World * p）
+ */
+struct FbxBvhInstance
+{
+    uint64_t NodeId = 0;
+    uint32_t Mesh = 0;        // FbxSceneBvh::GetMeshes()中的下标
+    float World[12];
+    float InverseWorld[12];
+    float Min[3];             // 世界空间包围盒
+    float Max[3];
+};
+
+struct FbxBvhOptions
+{
+    int MaxLeafSize = 4;      // 叶子最多容纳的图元数
+    int BinCount = 16;        // SAH分箱数
+    unsigned ThreadCount = 0; // 各Mesh的BLAS并行构建，0表示使用硬件并发数
+};
+
+struct FbxRayHit
+{
+    float Distance = 0.0f;    // 沿单位化方向的距离
+    float U = 0.0f;           // 重心坐标，交点 = (1 - U - V) * v0 + U * v1 + V * v2
+    float V = 0.0f;
+    uint64_t NodeId = 0;
+    uint64_t MeshId = 0;
+    uint64_t MaterialId = 0;  // 即FbxGeometryInfo::Sections的键
+    uint32_t TriangleIndex = 0;
+};
+
+struct FbxBvhOverlap
+{
+    uint64_t NodeId = 0;
+    uint64_t MeshId = 0;
+    uint64_t MaterialId = 0;
+    uint32_t TriangleIndex = 0;
+};
+
+/**
+ * @brief 两级场景BVH：每个Mesh一个分箱SAH构建的BLAS，节点实例之上一个TLAS
+ * @note 射线与包围盒的求交使用SSE（不可用时退回标量实现）；构建完成后查询是只读的，可多线程并发调用
+ */
+class FbxSceneBvh
+{
+public:
+    /**
+     * @brief 为GetFbxGeometries的结果构建BLAS，并以引用这些Mesh的节点（全局变换 * 几何变换）构建TLAS
+     */
+    void Build(FbxScene* pScene, const std::map<uint64_t, FbxGeometryInfo>& geometries,
+               const FbxBvhOptions& options = FbxBvhOptions());
+
+    /**
+     * @brief 只构建BLAS，之后用AddInstance + BuildInstances自行组织实例
+     */
+    void BuildMeshes(const std::map<uint64_t, FbxGeometryInfo>& geometries, const FbxBvhOptions& options = FbxBvhOptions());
+
+    /**
+     * @return meshId没有对应的BLAS时返回false
+     */
+    bool AddInstance(uint64_t nodeId, uint64_t meshId, const FbxAMatrix& world);
+
+    void BuildInstances();
+
+    void Clear();
+
+    /**
+     * @brief 最近交点查询
+     * @param direction 不需要单位化
+     * @param maxDistance 沿单位化方向的最大距离
+     */
+    bool RayCast(const float origin[3], const float direction[3], float maxDistance, FbxRayHit& hit) const;
+
+    /**
+     * @brief 收集与世界空间包围盒相交的全部三角形（精确的三角形-包围盒分离轴测试）
+     * @return 本次追加的数量
+     */
+    size_t QueryAabb(const float minimum[3], const float maximum[3], std::vector<FbxBvhOverlap>& overlaps) const;
+
+    bool GetBounds(float minimum[3], float maximum[3]) const;
+
+    const std::vector<FbxBvhMesh>& GetMeshes() const { return m_meshes; }
+    const std::vector<FbxBvhInstance>& GetInstances() const { return m_instances; }
+    const std::vector<FbxBvhNode>& GetTopLevelNodes() const { return m_nodes; }
+
+private:
+    FbxBvhOptions m_options;
+    std::vector<FbxBvhMesh> m_meshes;
+    std::map<uint64_t, uint32_t> m_meshIndices;
+    std::vector<FbxBvhInstance> m_instances;
+    std::vector<FbxBvhNode> m_nodes;       // TLAS，叶子图元为m_instanceOrder中的下标
+    std::vector<uint32_t> m_instanceOrder;
+};
@@ -0,0 +1,319 @@
+#include "FbxSdkCApi.h"
+#include "FbxSdkException.h"
+#include "FbxSdkWrapper.h"
+#include <exception>
+
+static_assert(sizeof(FbxVector4) == 4 * sizeof(double), "FbxVector4 must be four packed doubles");
+static_assert(sizeof(FbxVector2) == 2 * sizeof(double), "FbxVector2 must be two packed doubles");
+static_assert(sizeof(FbxColor) == 4 * sizeof(double), "FbxColor must be four packed doubles");
+static_assert(static_cast<uint32_t>(FBXC_ATTRIBUTE_ALL) == static_cast<uint32_t>(FBX_ATTRIBUTE_ALL), "FbxcAttribute must mirror FbxAttributeFlags");
+
+/**
+ * @brief 句柄持有SDK场景与一次性提取的结果，按下标访问的表在加载时建好
+ */
+struct FbxcScene
+{
+    FbxSdkWrapper Wrapper;
+    std::map<uint64_t, FbxGeometryInfo> Geometries;
+    std::vector<std::pair<uint64_t, const FbxGeometryInfo*>> Meshes;
+    std::vector<std::vector<std::pair<uint64_t, const FbxSection*>>> Sections;
+    std::vector<std::pair<uint64_t, FbxMaterialsInfo>> Materials;
+    std::vector<FbxNodeInfo> Nodes;
+};
+
+namespace
+{
+    std::string& LastError()
+    {
+        thread_local std::string lastError;
+        return lastError;
+    }
+
+    FbxcStatus Fail(FbxcStatus status, const std::string& message)
+    {
+        LastError() = message;
+        return status;
+    }
+
+    /**
+     * @brief 加载之后的公共部分：提取并建立下标表
+     */
+    FbxcStatus FinishLoad(FbxcScene* scene, FbxcScene** outScene)
+    {
+        scene->Geometries = scene->Wrapper.GetGeometries();
+        scene->Meshes.reserve(scene->Geometries.size());
+        scene->Sections.reserve(scene->Geometries.size());
+        for (const auto& geometry : scene->Geometries)
+        {
+            scene->Meshes.emplace_back(geometry.first, &geometry.second);
+            std::vector<std::pair<uint64_t, const FbxSection*>> sections;
+            sections.reserve(geometry.second.Sections.size());
+            for (const auto& section : geometry.second.Sections)
+                sections.emplace_back(section.first, &section.second);
+            scene->Sections.push_back(std::move(sections));
+        }
+
+        std::map<uint64_t, FbxMaterialsInfo> materials = scene->Wrapper.GetMaterials();
+        scene->Materials.assign(materials.begin(), materials.end());
+        scene->Nodes = scene->Wrapper.GetNodes();
+
+        *outScene = scene;
+        return FBXC_OK;
+    }
+
+    template <typename TLoad>
+    FbxcStatus Load(uint32_t attributeMask, FbxcScene** outScene, TLoad&& load)
+    {
+        *outScene = nullptr;
+        FbxcScene* scene = nullptr;
+        try
+        {
+            scene = new FbxcScene();
+            scene->Wrapper.SetAttributeMask(attributeMask);
+            FbxErrorHandler::ClearLastError();
+            if (!load(scene->Wrapper))
+            {
+                std::string error = FbxErrorHandler::GetLastError();
+                delete scene;
+                return Fail(FBXC_ERROR_LOAD_FAILED, error.empty() ? "Failed to load scene" : error);
+            }
+            return FinishLoad(scene, outScene);
+        }
+        catch (const std::exception& e)
+        {
+            delete scene;
+            return Fail(FBXC_ERROR_LOAD_FAILED, e.what());
+        }
+        catch (...)
+        {
+            delete scene;
+            return Fail(FBXC_ERROR_INTERNAL, "Unknown exception");
+        }
+    }
+
+    FbxcStatus FindSection(const FbxcScene* scene, uint32_t meshIndex, uint32_t sectionIndex, const FbxSection*& section)
+    {
+        if (!scene)
+            return Fail(FBXC_ERROR_INVALID_ARGUMENT, "Scene is null");
+        if (meshIndex >= scene->Meshes.size())
+            return Fail(FBXC_ERROR_OUT_OF_RANGE, "Mesh index out of range");
+        if (sectionIndex >= scene->Sections[meshIndex].size())
+            return Fail(FBXC_ERROR_OUT_OF_RANGE, "Section index out of range");
+        section = scene->Sections[meshIndex][sectionIndex].second;
+        return FBXC_OK;
+    }
+
+    template <typename T>
+    FbxcStatus MakeView(const std::pmr::vector<T>& values, uint32_t components, FbxcComponentType type, FbxcView* outView)
+    {
+        if (values.empty())
+            return Fail(FBXC_ERROR_NOT_PRESENT, "Stream is not present");
+        outView->data = values.data();
+        outView->count = values.size();
+        outView->stride = sizeof(T);
+        outView->components = components;
+        outView->componentType = type;
+        outView->reserved = 0;
+        return FBXC_OK;
+    }
+}
+
+uint32_t fbxc_abi_version(void)
+{
+    return FBXC_ABI_VERSION;
+}
+
+const char* fbxc_last_error(void)
+{
+    return LastError().c_str();
+}
+
+FbxcStatus fbxc_scene_load(const char* utf8Path, uint32_t attributeMask, FbxcScene** outScene)
+{
+    if (!utf8Path || !outScene)
+        return Fail(FBXC_ERROR_INVALID_ARGUMENT, "Path or output is null");
+    return Load(attributeMask, outScene, [&](FbxSdkWrapper& wrapper) { return wrapper.LoadFile(utf8Path); });
+}
+
+FbxcStatus fbxc_scene_load_memory(const void* data, size_t size, uint32_t attributeMask, FbxcScene** outScene)
+{
+    if (!data || size == 0 || !outScene)
+        return Fail(FBXC_ERROR_INVALID_ARGUMENT, "Buffer or output is null");
+    return Load(attributeMask, outScene, [&](FbxSdkWrapper& wrapper) { return wrapper.LoadFromMemory(data, size); });
+}
+
+void fbxc_scene_release(FbxcScene* scene)
+{
+    delete scene;
+}
+
+uint32_t fbxc_scene_mesh_count(const FbxcScene* scene)
+{
+    return scene ? static_cast<uint32_t>(scene->Meshes.size()) : 0;
+}
+
+uint32_t fbxc_scene_material_count(const FbxcScene* scene)
+{
+    return scene ? static_cast<uint32_t>(scene->Materials.size()) : 0;
+}
+
+uint32_t fbxc_scene_node_count(const FbxcScene* scene)
+{
+    return scene ? static_cast<uint32_t>(scene->Nodes.size()) : 0;
+}
+
+FbxcStatus fbxc_mesh_info(const FbxcScene* scene, uint32_t meshIndex, FbxcMeshInfo* outInfo)
+{
+    if (!scene || !outInfo)
+        return Fail(FBXC_ERROR_INVALID_ARGUMENT, "Scene or output is null");
+    if (meshIndex >= scene->Meshes.size())
+        return Fail(FBXC_ERROR_OUT_OF_RANGE, "Mesh index out of range");
+
+    const auto& mesh = scene->Meshes[meshIndex];
+    outInfo->id = mesh.first;
+    outInfo->controlPointCount = mesh.second->ControlPoints.size();
+    outInfo->sectionCount = static_cast<uint32_t>(scene->Sections[meshIndex].size());
+    outInfo->reserved = 0;
+    return FBXC_OK;
+}
+
+FbxcStatus fbxc_mesh_control_points(const FbxcScene* scene, uint32_t meshIndex, FbxcView* outView)
+{
+    if (!scene || !outView)
+        return Fail(FBXC_ERROR_INVALID_ARGUMENT, "Scene or output is null");
+    if (meshIndex >= scene->Meshes.size())
+        return Fail(FBXC_ERROR_OUT_OF_RANGE, "Mesh index out of range");
+    return MakeView(scene->Meshes[meshIndex].second->ControlPoints, 3, FBXC_COMPONENT_FLOAT64, outView);
+}
+
+FbxcStatus fbxc_section_info(const FbxcScene* scene, uint32_t meshIndex, uint32_t sectionIndex, FbxcSectionInfo* outInfo)
+{
+    if (!outInfo)
+        return Fail(FBXC_ERROR_INVALID_ARGUMENT, "Output is null");
+    const FbxSection* section = nullptr;
+    FbxcStatus status = FindSection(scene, meshIndex, sectionIndex, section);
+    if (status != FBXC_OK)
+        return status;
+
+    uint32_t attributes = 0;
+    if (!section->ColorSets.empty())
+        attributes |= FBXC_ATTRIBUTE_COLOR;
+    if (!section->UVSets.empty())
+        attributes |= FBXC_ATTRIBUTE_UV;
+    if (!section->Normals.empty())
+        attributes |= FBXC_ATTRIBUTE_NORMAL;
+    if (!section->Tangents.empty())
+        attributes |= FBXC_ATTRIBUTE_TANGENT;
+    if (!section->Binormals.empty())
+        attributes |= FBXC_ATTRIBUTE_BINORMAL;
+    if (!section->SmoothingGroups.empty())
+        attributes |= FBXC_ATTRIBUTE_SMOOTHING;
+
+    outInfo->materialId = scene->Sections[meshIndex][sectionIndex].first;
+    outInfo->cornerCount = section->Triangle.size();
+    outInfo->uvSetCount = static_cast<uint32_t>(section->UVSets.size());
+    outInfo->colorSetCount = static_cast<uint32_t>(section->ColorSets.size());
+    outInfo->attributes = attributes;
+    outInfo->reserved = 0;
+    return FBXC_OK;
+}
+
+FbxcStatus fbxc_section_stream(const FbxcScene* scene, uint32_t meshIndex, uint32_t sectionIndex,
+                               FbxcStream stream, uint32_t setIndex, FbxcView* outView)
+{
+    if (!outView)
+        return Fail(FBXC_ERROR_INVALID_ARGUMENT, "Output is null");
+    const FbxSection* section = nullptr;
+    FbxcStatus status = FindSection(scene, meshIndex, sectionIndex, section);
+    if (status != FBXC_OK)
+        return status;
+
+    switch (stream)
+    {
+    case FBXC_STREAM_INDICES:
+        // 空section的索引流也是合法的视图
+        *outView = FbxcView{ section->Triangle.data(), section->Triangle.size(), sizeof(int), 1, FBXC_COMPONENT_INT32, 0 };
+        return FBXC_OK;
+    case FBXC_STREAM_NORMALS:
+        return MakeView(section->Normals, 3, FBXC_COMPONENT_FLOAT64, outView);
+    case FBXC_STREAM_TANGENTS:
+        return MakeView(section->Tangents, 3, FBXC_COMPONENT_FLOAT64, outView);
+    case FBXC_STREAM_BINORMALS:
+        return MakeView(section->Binormals, 3, FBXC_COMPONENT_FLOAT64, outView);
+    case FBXC_STREAM_UVS:
+        if (setIndex >= section->UVSets.size())
+            return Fail(FBXC_ERROR_NOT_PRESENT, "UV set is not present");
+        return MakeView(section->UVSets[setIndex].UVs, 2, FBXC_COMPONENT_FLOAT64, outView);
+    case FBXC_STREAM_COLORS:
+        if (setIndex >= section->ColorSets.size())
+            return Fail(FBXC_ERROR_NOT_PRESENT, "Color set is not present");
+        return MakeView(section->ColorSets[setIndex].Colors, 4, FBXC_COMPONENT_FLOAT64, outView);
+    case FBXC_STREAM_SMOOTHING:
+        return MakeView(section->SmoothingGroups, 1, FBXC_COMPONENT_INT32, outView);
+    default:
+        return Fail(FBXC_ERROR_INVALID_ARGUMENT, "Unknown stream");
+    }
+}
+
+FbxcStatus fbxc_material_info(const FbxcScene* scene, uint32_t materialIndex, FbxcMaterialInfo* outInfo)
+{
+    if (!scene || !outInfo)
+        return Fail(FBXC_ERROR_INVALID_ARGUMENT, "Scene or output is null");
+    if (materialIndex >= scene->Materials.size())
+        return Fail(FBXC_ERROR_OUT_OF_RANGE, "Material index out of range");
+
+    const auto& material = scene->Materials[materialIndex];
+    const FbxMaterialsInfo& info = material.second;
+    outInfo->id = material.first;
+    for (int i = 0; i < 3; ++i)
+    {
+        outInfo->ambient[i] = info.Ambient.Color[i];
+        outInfo->diffuse[i] = info.Diffuse.Color[i];
+        outInfo->specular[i] = info.Specular.Color[i];
+        outInfo->emissive[i] = info.Emissive.Color[i];
+    }
+    outInfo->opacity = info.Opacity.Factor;
+    outInfo->shininess = info.Shininess.Factor;
+    outInfo->reflectivity = info.Reflectivity.Factor;
+    outInfo->ambientTexture = info.Ambient.Texture;
+    outInfo->diffuseTexture = info.Diffuse.Texture;
+    outInfo->specularTexture = info.Specular.Texture;
+    outInfo->emissiveTexture = info.Emissive.Texture;
+    outInfo->opacityTexture = info.Opacity.Texture;
+    outInfo->shininessTexture = info.Shininess.Texture;
+    outInfo->reflectivityTexture = info.Reflectivity.Texture;
+    return FBXC_OK;
+}
+
+FbxcStatus fbxc_node_info(const FbxcScene* scene, uint32_t nodeIndex, FbxcNodeInfo* outInfo)
+{
+    if (!scene || !outInfo)
+        return Fail(FBXC_ERROR_INVALID_ARGUMENT, "Scene or output is null");
+    if (nodeIndex >= scene->Nodes.size())
+        return Fail(FBXC_ERROR_OUT_OF_RANGE, "Node index out of range");
+
+    const FbxNodeInfo& node = scene->Nodes[nodeIndex];
+    outInfo->id = node.Id;
+    outInfo->parentId = node.ParentId;
+    outInfo->meshId = node.LinkMeshId;
+    outInfo->name = node.NodeName;
+    for (int row = 0; row < 4; ++row)
+    {
+        for (int column = 0; column < 4; ++column)
+            outInfo->localTransform[row * 4 + column] = node.LocalTransform.Get(row, column);
+    }
+    outInfo->materialCount = static_cast<uint32_t>(node.LinkMaterialsId.size());
+    outInfo->reserved = 0;
+    return FBXC_OK;
+}
+
+FbxcStatus fbxc_node_material(const FbxcScene* scene, uint32_t nodeIndex, uint32_t slot, uint64_t* outMaterialId)
+{
+    if (!scene || !outMaterialId)
+        return Fail(FBXC_ERROR_INVALID_ARGUMENT, "Scene or output is null");
+    if (nodeIndex >= scene->Nodes.size() || slot >= scene->Nodes[nodeIndex].LinkMaterialsId.size())
+        return Fail(FBXC_ERROR_OUT_OF_RANGE, "Node or material slot out of range");
+
+    *outMaterialId = scene->Nodes[nodeIndex].LinkMaterialsId[slot];
+    return FBXC_OK;
+}
@@ -0,0 +1,177 @@
+#pragma once
+/**
+ * @brief 稳定的C ABI，供Python(ctypes/numpy)、C#(P/Invoke)等其他运行时直接读取提取结果
+ * @note 只使用C类型；场景句柄不透明。几何数据以“指针 + 步长”的视图直接指向句柄内部的提取缓冲区（零拷贝），
+ *       视图与字符串在fbxc_scene_release之前一直有效。函数不会抛出异常，失败时返回错误码，
+ *       错误信息按线程保存。加载完成后句柄只读，可被多个线程同时访问
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#ifdef FBXC_IMPORTS
+#define FBXC_API __declspec(dllimport)
+#else
+#define FBXC_API __declspec(dllexport)
+#endif
+#else
+#define FBXC_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 结构体布局或函数语义不兼容地变化时递增 */
+#define FBXC_ABI_VERSION 1
+
+typedef struct FbxcScene FbxcScene;
+
+typedef enum FbxcStatus
+{
+    FBXC_OK = 0,
+    FBXC_ERROR_INVALID_ARGUMENT = 1,
+    FBXC_ERROR_LOAD_FAILED = 2,
+    FBXC_ERROR_OUT_OF_RANGE = 3,
+    FBXC_ERROR_NOT_PRESENT = 4,     /* 请求的属性流在该section中不存在 */
+    FBXC_ERROR_INTERNAL = 5
+} FbxcStatus;
+
+typedef enum FbxcComponentType
+{
+    FBXC_COMPONENT_FLOAT64 = 1,
+    FBXC_COMPONENT_INT32 = 2
+} FbxcComponentType;
+
+/* 与FbxAttributeFlags取值相同 */
+typedef enum FbxcAttribute
+{
+    FBXC_ATTRIBUTE_COLOR = 1u << 0,
+    FBXC_ATTRIBUTE_UV = 1u << 1,
+    FBXC_ATTRIBUTE_NORMAL = 1u << 2,
+    FBXC_ATTRIBUTE_TANGENT = 1u << 3,
+    FBXC_ATTRIBUTE_BINORMAL = 1u << 4,
+    FBXC_ATTRIBUTE_SMOOTHING = 1u << 5,
+    FBXC_ATTRIBUTE_ALL = 0x3f
+} FbxcAttribute;
+
+typedef enum FbxcStream
+{
+    FBXC_STREAM_INDICES = 0,    /* 每个corner一个int32控制点下标，3个一组构成三角形 */
+    FBXC_STREAM_NORMALS = 1,    /* 每个corner一个float64 xyz（步长32字节，w未使用） */
+    FBXC_STREAM_TANGENTS = 2,
+    FBXC_STREAM_BINORMALS = 3,
+    FBXC_STREAM_UVS = 4,        /* 每个corner一个float64 uv，setIndex选择UV集 */
+    FBXC_STREAM_COLORS = 5,     /* 每个corner一个float64 rgba，setIndex选择颜色集 */
+    FBXC_STREAM_SMOOTHING = 6   /* 每个三角形一个int32平滑组掩码 */
+} FbxcStream;
+
+/**
+ * @brief 第i个元素的第c个分量位于 (const char*)data + i * stride + c * 分量字节数
+ */
+typedef struct FbxcView
+{
+    const void* data;
+    uint64_t count;
+    uint32_t stride;
+    uint32_t components;
+    uint32_t componentType;     /* FbxcComponentType */
+    uint32_t reserved;
+} FbxcView;
+
+typedef struct FbxcMeshInfo
+{
+    uint64_t id;
+    uint64_t controlPointCount;
+    uint32_t sectionCount;
+    uint32_t reserved;
+} FbxcMeshInfo;
+
+typedef struct FbxcSectionInfo
+{
+    uint64_t materialId;
+    uint64_t cornerCount;
+    uint32_t uvSetCount;
+    uint32_t colorSetCount;
+    uint32_t attributes;        /* 该section实际带有的属性流（FbxcAttribute组合） */
+    uint32_t reserved;
+} FbxcSectionInfo;
+
+typedef struct FbxcMaterialInfo
+{
+    uint64_t id;
+    double ambient[3];
+    double diffuse[3];
+    double specular[3];
+    double emissive[3];
+    double opacity;
+    double shininess;
+    double reflectivity;
+    /* 各属性连接的贴图文件名，无贴图时为NULL，字符串归句柄所有 */
+    const char* ambientTexture;
+    const char* diffuseTexture;
+    const char* specularTexture;
+    const char* emissiveTexture;
+    const char* opacityTexture;
+    const char* shininessTexture;
+    const char* reflectivityTexture;
+} FbxcMaterialInfo;
+
+typedef struct FbxcNodeInfo
+{
+    uint64_t id;
+    uint64_t parentId;          /* 场景根节点的直接子节点为0 */
+    uint64_t meshId;            /* 没有Mesh时为0 */
+    const char* name;
+    double localTransform[16];  /* 行主序，与FbxAMatrix一致，第3行为平移 */
+    uint32_t materialCount;
+    uint32_t reserved;
+} FbxcNodeInfo;
+
+FBXC_API uint32_t fbxc_abi_version(void);
+
+/**
+ * @brief 当前线程最近一次失败的描述，没有时为空字符串；指针在本线程下一次调用前有效
+ */
+FBXC_API const char* fbxc_last_error(void);
+
+/**
+ * @brief 加载文件并按attributeMask一次性提取全部几何体、材质与节点
+ * @param utf8Path 文件路径
+ */
+FBXC_API FbxcStatus fbxc_scene_load(const char* utf8Path, uint32_t attributeMask, FbxcScene** outScene);
+
+/**
+ * @brief 从内存缓冲区加载，缓冲区只需在调用期间有效
+ */
+FBXC_API FbxcStatus fbxc_scene_load_memory(const void* data, size_t size, uint32_t attributeMask, FbxcScene** outScene);
+
+FBXC_API void fbxc_scene_release(FbxcScene* scene);
+
+FBXC_API uint32_t fbxc_scene_mesh_count(const FbxcScene* scene);
+FBXC_API uint32_t fbxc_scene_material_count(const FbxcScene* scene);
+FBXC_API uint32_t fbxc_scene_node_count(const FbxcScene* scene);
+
+FBXC_API FbxcStatus fbxc_mesh_info(const FbxcScene* scene, uint32_t meshIndex, FbxcMeshInfo* outInfo);
+
+/**
+ * @brief 控制点，float64 xyz（步长32字节）
+ */
+FBXC_API FbxcStatus fbxc_mesh_control_points(const FbxcScene* scene, uint32_t meshIndex, FbxcView* outView);
+
+FBXC_API FbxcStatus fbxc_section_info(const FbxcScene* scene, uint32_t meshIndex, uint32_t sectionIndex, FbxcSectionInfo* outInfo);
+
+/**
+ * @param setIndex 只对UV与颜色有效，其余传0
+ */
+FBXC_API FbxcStatus fbxc_section_stream(const FbxcScene* scene, uint32_t meshIndex, uint32_t sectionIndex,
+                                        FbxcStream stream, uint32_t setIndex, FbxcView* outView);
+
+FBXC_API FbxcStatus fbxc_material_info(const FbxcScene* scene, uint32_t materialIndex, FbxcMaterialInfo* outInfo);
+
+FBXC_API FbxcStatus fbxc_node_info(const FbxcScene* scene, uint32_t nodeIndex, FbxcNodeInfo* outInfo);
+FBXC_API FbxcStatus fbxc_node_material(const FbxcScene* scene, uint32_t nodeIndex, uint32_t slot, uint64_t* outMaterialId);
+
+#ifdef __cplusplus
+}
+#endif
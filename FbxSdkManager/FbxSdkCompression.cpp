@@ -0,0 +1,471 @@
+#include "FbxSdkCompression.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FBX_CODEC_SSE2 1
+#endif
+
+namespace
+{
+    const uint32_t kMagic = 0x31434d46u;  // "FMC1"
+    const uint8_t kFlagColors = 1u;
+
+    /**
+     * @brief 文件头，各字段按声明顺序逐个写入，不依赖结构体布局
+     */
+    struct Header
+    {
+        uint32_t VertexCount = 0;
+        uint32_t IndexCount = 0;
+        uint64_t MaterialId = 0;
+        uint8_t PositionBits = 16;
+        uint8_t NormalBits = 12;
+        uint8_t UVBits = 14;
+        uint8_t Flags = 0;
+        float PositionMin[3] = {};
+        float PositionExtent[3] = {};
+        float UVMin[2] = {};
+        float UVExtent[2] = {};
+    };
+
+    class Writer
+    {
+    public:
+        explicit Writer(std::vector<uint8_t>& Out) : m_out(Out) {}
+
+        template <typename T>
+        void Put(const T& Value)
+        {
+            const size_t offset = m_out.size();
+            m_out.resize(offset + sizeof(T));
+            memcpy(m_out.data() + offset, &Value, sizeof(T));
+        }
+
+        uint8_t* Reserve(size_t Size)
+        {
+            const size_t offset = m_out.size();
+            m_out.resize(offset + Size);
+            return m_out.data() + offset;
+        }
+
+    private:
+        std::vector<uint8_t>& m_out;
+    };
+
+    class Reader
+    {
+    public:
+        Reader(const uint8_t* Data, size_t Size) : m_data(Data), m_size(Size) {}
+
+        template <typename T>
+        bool Get(T& Value)
+        {
+            if (m_size - m_offset < sizeof(T))
+                return false;
+            memcpy(&Value, m_data + m_offset, sizeof(T));
+            m_offset += sizeof(T);
+            return true;
+        }
+
+        const uint8_t* Take(size_t Size)
+        {
+            if (m_size - m_offset < Size)
+                return nullptr;
+            const uint8_t* result = m_data + m_offset;
+            m_offset += Size;
+            return result;
+        }
+
+    private:
+        const uint8_t* m_data;
+        size_t m_size;
+        size_t m_offset = 0;
+    };
+
+    int ClampBits(int Bits)
+    {
+        return std::min(16, std::max(1, Bits));
+    }
+
+    uint32_t MaxQuantized(int Bits)
+    {
+        return (1u << Bits) - 1u;
+    }
+
+    uint16_t Quantize(float Value, float Min, float Extent, uint32_t MaxValue)
+    {
+        if (!(Extent > 0.0f))
+            return 0;
+        const float normalized = std::min(1.0f, std::max(0.0f, (Value - Min) / Extent));
+        return static_cast<uint16_t>(std::lround(normalized * static_cast<float>(MaxValue)));
+    }
+
+    /**
+     * @brief 差分 + zigzag后拆成Width个字节平面；差分按Width字节的无符号整数回绕
+     */
+    template <typename T>
+    void EncodeStream(const T* Values, size_t Count, Writer& Out)
+    {
+        using Signed = std::make_signed_t<T>;
+        const size_t width = sizeof(T);
+        uint8_t* planes = Out.Reserve(Count * width);
+        T previous = 0;
+        for (size_t i = 0; i < Count; ++i)
+        {
+            const T delta = static_cast<T>(Values[i] - previous);
+            const T zigzag = static_cast<T>(static_cast<T>(delta << 1) ^ static_cast<T>(static_cast<Signed>(delta) >> (8 * width - 1)));
+            for (size_t b = 0; b < width; ++b)
+                planes[b * Count + i] = static_cast<uint8_t>(zigzag >> (8 * b));
+            previous = Values[i];
+        }
+    }
+
+    template <typename T>
+    void DecodeStreamScalar(const uint8_t* Planes, size_t Count, size_t Begin, T Previous, T* Values)
+    {
+        const size_t width = sizeof(T);
+        for (size_t i = Begin; i < Count; ++i)
+        {
+            T zigzag = 0;
+            for (size_t b = 0; b < width; ++b)
+                zigzag = static_cast<T>(zigzag | (static_cast<T>(Planes[b * Count + i]) << (8 * b)));
+            const T delta = static_cast<T>((zigzag >> 1) ^ static_cast<T>(0u - (zigzag & 1u)));
+            Previous = static_cast<T>(Previous + delta);
+            Values[i] = Previous;
+        }
+    }
+
+#if FBX_CODEC_SSE2
+    // 每次处理一个寄存器宽度：字节平面交织回整数 -> 还原zigzag -> 寄存器内前缀和 -> 加上一组的末值
+
+    void DecodeStream(const uint8_t* Planes, size_t Count, uint8_t* Values)
+    {
+        const __m128i one = _mm_set1_epi8(1);
+        const __m128i low7 = _mm_set1_epi8(0x7f);
+        __m128i carry = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 16 <= Count; i += 16)
+        {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Planes + i));
+            const __m128i sign = _mm_sub_epi8(_mm_setzero_si128(), _mm_and_si128(x, one));
+            x = _mm_xor_si128(_mm_and_si128(_mm_srli_epi16(x, 1), low7), sign);
+            x = _mm_add_epi8(x, _mm_slli_si128(x, 1));
+            x = _mm_add_epi8(x, _mm_slli_si128(x, 2));
+            x = _mm_add_epi8(x, _mm_slli_si128(x, 4));
+            x = _mm_add_epi8(x, _mm_slli_si128(x, 8));
+            x = _mm_add_epi8(x, carry);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(Values + i), x);
+            carry = _mm_set1_epi8(static_cast<char>(Values[i + 15]));
+        }
+        DecodeStreamScalar<uint8_t>(Planes, Count, i, i > 0 ? Values[i - 1] : 0, Values);
+    }
+
+    void DecodeStream(const uint8_t* Planes, size_t Count, uint16_t* Values)
+    {
+        const uint8_t* low = Planes;
+        const uint8_t* high = Planes + Count;
+        const __m128i one = _mm_set1_epi16(1);
+        __m128i carry = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 8 <= Count; i += 8)
+        {
+            __m128i x = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(low + i)),
+                                          _mm_loadl_epi64(reinterpret_cast<const __m128i*>(high + i)));
+            x = _mm_xor_si128(_mm_srli_epi16(x, 1), _mm_sub_epi16(_mm_setzero_si128(), _mm_and_si128(x, one)));
+            x = _mm_add_epi16(x, _mm_slli_si128(x, 2));
+            x = _mm_add_epi16(x, _mm_slli_si128(x, 4));
+            x = _mm_add_epi16(x, _mm_slli_si128(x, 8));
+            x = _mm_add_epi16(x, carry);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(Values + i), x);
+            carry = _mm_shufflehi_epi16(x, 0xff);
+            carry = _mm_unpackhi_epi64(carry, carry);
+        }
+        DecodeStreamScalar<uint16_t>(Planes, Count, i, i > 0 ? Values[i - 1] : 0, Values);
+    }
+
+    void DecodeStream(const uint8_t* Planes, size_t Count, uint32_t* Values)
+    {
+        const uint8_t* b0 = Planes;
+        const uint8_t* b1 = Planes + Count;
+        const uint8_t* b2 = Planes + 2 * Count;
+        const uint8_t* b3 = Planes + 3 * Count;
+        const __m128i one = _mm_set1_epi32(1);
+        __m128i carry = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 8 <= Count; i += 8)
+        {
+            const __m128i lo = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(b0 + i)),
+                                                 _mm_loadl_epi64(reinterpret_cast<const __m128i*>(b1 + i)));
+            const __m128i hi = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(b2 + i)),
+                                                 _mm_loadl_epi64(reinterpret_cast<const __m128i*>(b3 + i)));
+            __m128i x[2] = { _mm_unpacklo_epi16(lo, hi), _mm_unpackhi_epi16(lo, hi) };
+            for (int h = 0; h < 2; ++h)
+            {
+                __m128i v = x[h];
+                v = _mm_xor_si128(_mm_srli_epi32(v, 1), _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(v, one)));
+                v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+                v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+                v = _mm_add_epi32(v, carry);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(Values + i + 4 * h), v);
+                carry = _mm_shuffle_epi32(v, 0xff);
+            }
+        }
+        DecodeStreamScalar<uint32_t>(Planes, Count, i, i > 0 ? Values[i - 1] : 0, Values);
+    }
+#else
+    template <typename T>
+    void DecodeStream(const uint8_t* Planes, size_t Count, T* Values)
+    {
+        DecodeStreamScalar<T>(Planes, Count, 0, 0, Values);
+    }
+#endif
+
+    template <typename T>
+    bool ReadStream(Reader& In, size_t Count, std::vector<T>& Values)
+    {
+        const uint8_t* planes = In.Take(Count * sizeof(T));
+        if (!planes)
+            return false;
+        Values.resize(Count);
+        DecodeStream(planes, Count, Values.data());
+        return true;
+    }
+}
+
+void FbxMeshCodec::EncodeOctahedral(const float normal[3], int bits, uint16_t encoded[2])
+{
+    const uint32_t maxValue = MaxQuantized(ClampBits(bits));
+    float x = normal[0], y = normal[1], z = normal[2];
+    const float length = std::fabs(x) + std::fabs(y) + std::fabs(z);
+    if (!(length > 0.0f))
+    {
+        x = 0.0f;
+        y = 0.0f;
+        z = 1.0f;
+    }
+    else
+    {
+        x /= length;
+        y /= length;
+        z /= length;
+    }
+
+    // 下半球沿对角线折叠到正方形的四个角
+    if (z < 0.0f)
+    {
+        const float foldedX = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        const float foldedY = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = foldedX;
+        y = foldedY;
+    }
+    encoded[0] = Quantize(x, -1.0f, 2.0f, maxValue);
+    encoded[1] = Quantize(y, -1.0f, 2.0f, maxValue);
+}
+
+void FbxMeshCodec::DecodeOctahedral(const uint16_t encoded[2], int bits, float normal[3])
+{
+    const float scale = 2.0f / static_cast<float>(MaxQuantized(ClampBits(bits)));
+    float x = encoded[0] * scale - 1.0f;
+    float y = encoded[1] * scale - 1.0f;
+    const float z = 1.0f - std::fabs(x) - std::fabs(y);
+    const float t = std::max(-z, 0.0f);
+    x += x >= 0.0f ? -t : t;
+    y += y >= 0.0f ? -t : t;
+
+    const float inverse = 1.0f / std::sqrt(x * x + y * y + z * z);
+    normal[0] = x * inverse;
+    normal[1] = y * inverse;
+    normal[2] = z * inverse;
+}
+
+std::vector<uint8_t> FbxMeshCodec::Encode(const FbxGeometryExporter::SimplifiedMesh& mesh, const FbxCompressionOptions& options)
+{
+    const auto& vertices = mesh.vertices;
+    const size_t vertexCount = vertices.size();
+
+    Header header;
+    header.VertexCount = static_cast<uint32_t>(vertexCount);
+    header.IndexCount = static_cast<uint32_t>(mesh.indices.size());
+    header.MaterialId = mesh.materialId;
+    header.PositionBits = static_cast<uint8_t>(ClampBits(options.PositionBits));
+    header.NormalBits = static_cast<uint8_t>(ClampBits(options.NormalBits));
+    header.UVBits = static_cast<uint8_t>(ClampBits(options.UVBits));
+
+    // 位置与UV各自按包围盒量化
+    if (vertexCount > 0)
+    {
+        float positionMax[3], uvMax[2];
+        for (int k = 0; k < 3; ++k)
+            header.PositionMin[k] = positionMax[k] = vertices[0].position[k];
+        for (int k = 0; k < 2; ++k)
+            header.UVMin[k] = uvMax[k] = vertices[0].uv[k];
+        for (const auto& vertex : vertices)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                header.PositionMin[k] = std::min(header.PositionMin[k], vertex.position[k]);
+                positionMax[k] = std::max(positionMax[k], vertex.position[k]);
+            }
+            for (int k = 0; k < 2; ++k)
+            {
+                header.UVMin[k] = std::min(header.UVMin[k], vertex.uv[k]);
+                uvMax[k] = std::max(uvMax[k], vertex.uv[k]);
+            }
+        }
+        for (int k = 0; k < 3; ++k)
+            header.PositionExtent[k] = positionMax[k] - header.PositionMin[k];
+        for (int k = 0; k < 2; ++k)
+            header.UVExtent[k] = uvMax[k] - header.UVMin[k];
+    }
+
+    if (options.KeepColors)
+    {
+        for (const auto& vertex : vertices)
+        {
+            if (vertex.color[0] != 1.0f || vertex.color[1] != 1.0f || vertex.color[2] != 1.0f || vertex.color[3] != 1.0f)
+            {
+                header.Flags |= kFlagColors;
+                break;
+            }
+        }
+    }
+
+    std::vector<uint16_t> positions[3], normals[2], uvs[2];
+    std::vector<uint8_t> colors[4];
+    for (int k = 0; k < 3; ++k)
+        positions[k].resize(vertexCount);
+    for (int k = 0; k < 2; ++k)
+    {
+        normals[k].resize(vertexCount);
+        uvs[k].resize(vertexCount);
+    }
+    if (header.Flags & kFlagColors)
+    {
+        for (int k = 0; k < 4; ++k)
+            colors[k].resize(vertexCount);
+    }
+
+    const uint32_t positionMaxValue = MaxQuantized(header.PositionBits);
+    const uint32_t uvMaxValue = MaxQuantized(header.UVBits);
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        const auto& vertex = vertices[i];
+        for (int k = 0; k < 3; ++k)
+            positions[k][i] = Quantize(vertex.position[k], header.PositionMin[k], header.PositionExtent[k], positionMaxValue);
+
+        uint16_t octahedral[2];
+        EncodeOctahedral(vertex.normal, header.NormalBits, octahedral);
+        normals[0][i] = octahedral[0];
+        normals[1][i] = octahedral[1];
+
+        for (int k = 0; k < 2; ++k)
+            uvs[k][i] = Quantize(vertex.uv[k], header.UVMin[k], header.UVExtent[k], uvMaxValue);
+
+        if (header.Flags & kFlagColors)
+        {
+            for (int k = 0; k < 4; ++k)
+                colors[k][i] = static_cast<uint8_t>(Quantize(vertex.color[k], 0.0f, 1.0f, 255));
+        }
+    }
+
+    std::vector<uint8_t> result;
+    Writer out(result);
+    out.Put(kMagic);
+    out.Put(header.VertexCount);
+    out.Put(header.IndexCount);
+    out.Put(header.MaterialId);
+    out.Put(header.PositionBits);
+    out.Put(header.NormalBits);
+    out.Put(header.UVBits);
+    out.Put(header.Flags);
+    for (float value : header.PositionMin) out.Put(value);
+    for (float value : header.PositionExtent) out.Put(value);
+    for (float value : header.UVMin) out.Put(value);
+    for (float value : header.UVExtent) out.Put(value);
+
+    for (const auto& stream : positions)
+        EncodeStream(stream.data(), vertexCount, out);
+    for (const auto& stream : normals)
+        EncodeStream(stream.data(), vertexCount, out);
+    for (const auto& stream : uvs)
+        EncodeStream(stream.data(), vertexCount, out);
+    if (header.Flags & kFlagColors)
+    {
+        for (const auto& stream : colors)
+            EncodeStream(stream.data(), vertexCount, out);
+    }
+    EncodeStream(mesh.indices.data(), mesh.indices.size(), out);
+    return result;
+}
+
+bool FbxMeshCodec::Decode(const uint8_t* data, size_t size, FbxGeometryExporter::SimplifiedMesh& mesh)
+{
+    Reader in(data, size);
+    uint32_t magic = 0;
+    Header header;
+    bool valid = in.Get(magic) && magic == kMagic
+        && in.Get(header.VertexCount) && in.Get(header.IndexCount) && in.Get(header.MaterialId)
+        && in.Get(header.PositionBits) && in.Get(header.NormalBits) && in.Get(header.UVBits) && in.Get(header.Flags);
+    for (float& value : header.PositionMin) valid = valid && in.Get(value);
+    for (float& value : header.PositionExtent) valid = valid && in.Get(value);
+    for (float& value : header.UVMin) valid = valid && in.Get(value);
+    for (float& value : header.UVExtent) valid = valid && in.Get(value);
+    if (!valid || header.PositionBits < 1 || header.PositionBits > 16 || header.NormalBits < 1 || header.NormalBits > 16
+        || header.UVBits < 1 || header.UVBits > 16)
+    {
+        return false;
+    }
+
+    const size_t vertexCount = header.VertexCount;
+    std::vector<uint16_t> positions[3], normals[2], uvs[2];
+    std::vector<uint8_t> colors[4];
+    std::vector<uint32_t> indices;
+    for (auto& stream : positions)
+        valid = valid && ReadStream(in, vertexCount, stream);
+    for (auto& stream : normals)
+        valid = valid && ReadStream(in, vertexCount, stream);
+    for (auto& stream : uvs)
+        valid = valid && ReadStream(in, vertexCount, stream);
+    if (header.Flags & kFlagColors)
+    {
+        for (auto& stream : colors)
+            valid = valid && ReadStream(in, vertexCount, stream);
+    }
+    valid = valid && ReadStream(in, header.IndexCount, indices);
+    for (size_t i = 0; valid && i < indices.size(); ++i)
+        valid = indices[i] < vertexCount;
+    if (!valid)
+    {
+        return false;
+    }
+
+    float positionScale[3], uvScale[2];
+    for (int k = 0; k < 3; ++k)
+        positionScale[k] = header.PositionExtent[k] / static_cast<float>(MaxQuantized(header.PositionBits));
+    for (int k = 0; k < 2; ++k)
+        uvScale[k] = header.UVExtent[k] / static_cast<float>(MaxQuantized(header.UVBits));
+
+    mesh.vertices.resize(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        auto& vertex = mesh.vertices[i];
+        for (int k = 0; k < 3; ++k)
+            vertex.position[k] = header.PositionMin[k] + positions[k][i] * positionScale[k];
+
+        const uint16_t octahedral[2] = { normals[0][i], normals[1][i] };
+        DecodeOctahedral(octahedral, header.NormalBits, vertex.normal);
+
+        for (int k = 0; k < 2; ++k)
+            vertex.uv[k] = header.UVMin[k] + uvs[k][i] * uvScale[k];
+
+        for (int k = 0; k < 4; ++k)
+            vertex.color[k] = (header.Flags & kFlagColors) ? colors[k][i] / 255.0f : 1.0f;
+    }
+    mesh.indices = std::move(indices);
+    mesh.materialId = header.MaterialId;
+    return true;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "FbxSdkWrapper.h"
+#include <cstdint>
+
+struct FbxCompressionOptions
+{
+    int PositionBits = 16;      // 位置按网格包围盒量化的位数（1~16）
+    int NormalBits = 12;        // 八面体法线每个分量的位数（1~16）
+    int UVBits = 14;            // UV按UV包围盒量化的位数（1~16）
+    bool KeepColors = true;     // false时丢弃顶点色；全为白色时总是丢弃
+};
+
+/**
+ * @brief SimplifiedMesh的量化压缩编码
+ * @note 每个属性分量是一条独立的流：逐顶点取差分并zigzag后按字节拆成若干平面（先全部低字节，再全部高字节），
+ *       索引流同样按相邻索引差分。结果本身已比float数组小，相邻值相近时高字节平面几乎全为0，
+ *       交给gzip/zstd等通用压缩器还能再明显缩小。数据按小端序存放
+ */
+class FbxMeshCodec
+{
+public:
+    /**
+     * @brief 编码一个网格，未焊接的网格也能编码，但焊接后（FbxLodGenerator::WeldVertices）体积小得多
+     */
+    static std::vector<uint8_t> Encode(const FbxGeometryExporter::SimplifiedMesh& mesh,
+                                       const FbxCompressionOptions& options = FbxCompressionOptions());
+
+    /**
+     * @brief 解码Encode的结果，差分还原使用SSE2（不可用时退回标量实现）
+     * @return 数据格式不正确或被截断时返回false
+     */
+    static bool Decode(const uint8_t* data, size_t size, FbxGeometryExporter::SimplifiedMesh& mesh);
+
+    static bool Decode(const std::vector<uint8_t>& data, FbxGeometryExporter::SimplifiedMesh& mesh)
+    {
+        return Decode(data.data(), data.size(), mesh);
+    }
+
+    /**
+     * @brief 单位向量的八面体编码，Bits位无符号分量
+     */
+    static void EncodeOctahedral(const float normal[3], int bits, uint16_t encoded[2]);
+    static void DecodeOctahedral(const uint16_t encoded[2], int bits, float normal[3]);
+};
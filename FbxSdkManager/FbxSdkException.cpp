@@ -1,42 +1,36 @@
 #include "FbxSdkException.h"
-#include <iostream>
-#include <ctime>
-#include <iomanip>
 
-bool FbxErrorHandler::s_quietMode = false;
-std::string FbxErrorHandler::s_lastError;
-
-void FbxErrorHandler::LogError(const std::string& error)
+namespace
 {
-    s_lastError = error;
-    
-    if (!s_quietMode)
+    std::string& LastError()
     {
-        auto t = std::time(nullptr);
-        auto tm = *std::localtime(&t);
-        std::cerr << "[ERROR] " << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") 
-                  << " - " << error << std::endl;
+        thread_local std::string lastError;
+        return lastError;
     }
 }
 
+void FbxErrorHandler::LogError(const std::string& error)
+{
+    LastError() = error;
+    FBX_LOG_ERROR("%s", error.c_str());
+}
+
 void FbxErrorHandler::LogWarning(const std::string& warning)
 {
-    if (!s_quietMode)
-    {
-        auto t = std::time(nullptr);
-        auto tm = *std::localtime(&t);
-        std::cerr << "[WARN]  " << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") 
-                  << " - " << warning << std::endl;
-    }
+    FBX_LOG_WARNING("%s", warning.c_str());
 }
 
 void FbxErrorHandler::LogInfo(const std::string& info)
 {
-    if (!s_quietMode)
-    {
-        auto t = std::time(nullptr);
-        auto tm = *std::localtime(&t);
-        std::cout << "[INFO]  " << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") 
-                  << " - " << info << std::endl;
-    }
-}
\ No newline at end of file
+    FBX_LOG_INFO("%s", info.c_str());
+}
+
+std::string FbxErrorHandler::GetLastError()
+{
+    return LastError();
+}
+
+void FbxErrorHandler::ClearLastError()
+{
+    LastError().clear();
+}
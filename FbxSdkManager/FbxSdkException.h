@@ -1,4 +1,5 @@
 #pragma once
+#include "FbxSdkLog.h"
 #include <exception>
 #include <string>
 
@@ -45,21 +46,24 @@ private:
 
 /**
  * @brief 错误处理工具类
+ * @note 输出经由FbxLogger异步写出；最后一条错误按线程保存，并行提取时互不覆盖
  */
 class FbxErrorHandler
 {
 public:
-    static void SetQuietMode(bool quiet) { s_quietMode = quiet; }
-    static bool IsQuietMode() { return s_quietMode; }
+    /**
+     * @brief 安静模式即把FbxLogger的运行期级别设为Off，关闭时恢复为Info
+     */
+    static void SetQuietMode(bool quiet) { FbxLogger::SetLevel(quiet ? FBX_LOG_LEVEL_OFF : FBX_LOG_LEVEL_INFO); }
+    static bool IsQuietMode() { return FbxLogger::GetLevel() == FBX_LOG_LEVEL_OFF; }
     
     static void LogError(const std::string& error);
     static void LogWarning(const std::string& warning);
     static void LogInfo(const std::string& info);
 
-    static std::string GetLastError() { return s_lastError; }
-    static void ClearLastError() { s_lastError.clear(); }
-
-private:
-    static bool s_quietMode;
-    static std::string s_lastError;
+    /**
+     * @brief 当前线程最后一次LogError的内容
+     */
+    static std::string GetLastError();
+    static void ClearLastError();
 };
\ No newline at end of file
@@ -0,0 +1,853 @@
+#include "FbxSdkGltf.h"
+#include "FbxSdkException.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+#include <unordered_map>
+
+namespace
+{
+    const uint32_t kGlbMagic = 0x46546c67u;      // "glTF"
+    const uint32_t kGlbVersion = 2;
+    const uint32_t kChunkJson = 0x4e4f534au;     // "JSON"
+    const uint32_t kChunkBin = 0x004e4942u;      // "BIN\0"
+
+    const int kArrayBuffer = 34962;
+    const int kElementArrayBuffer = 34963;
+    const int kUnsignedShort = 5123;
+    const int kUnsignedInt = 5125;
+    const int kFloat = 5126;
+
+    void AppendString(std::string& Json, const std::string& Value)
+    {
+        Json += '"';
+        for (unsigned char c : Value)
+        {
+            switch (c)
+            {
+            case '"': Json += "\\\""; break;
+            case '\\': Json += "\\\\"; break;
+            case '\n': Json += "\\n"; break;
+            case '\r': Json += "\\r"; break;
+            case '\t': Json += "\\t"; break;
+            default:
+                if (c < 0x20)
+                {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    Json += escaped;
+                }
+                else
+                {
+                    Json += static_cast<char>(c);
+                }
+            }
+        }
+        Json += '"';
+    }
+
+    void AppendNumber(std::string& Json, double Value)
+    {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.9g", std::isfinite(Value) ? Value : 0.0);
+        Json += buffer;
+    }
+
+    void AppendNumbers(std::string& Json, const double* Values, int Count)
+    {
+        Json += '[';
+        for (int i = 0; i < Count; ++i)
+        {
+            if (i > 0)
+                Json += ',';
+            AppendNumber(Json, Values[i]);
+        }
+        Json += ']';
+    }
+
+    bool IsIdentity(const FbxAMatrix& Matrix)
+    {
+        for (int row = 0; row < 4; ++row)
+        {
+            for (int column = 0; column < 4; ++column)
+            {
+                if (std::abs(Matrix.Get(row, column) - (row == column ? 1.0 : 0.0)) > 1e-12)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 以glTF节点的translation/rotation/scale写出变换，省略默认值
+     */
+    void AppendTransform(std::string& Json, const FbxAMatrix& Transform)
+    {
+        const FbxVector4 translation = Transform.GetT();
+        const FbxQuaternion rotation = Transform.GetQ();
+        const FbxVector4 scaling = Transform.GetS();
+        double t[3] = { translation[0], translation[1], translation[2] };
+        double r[4] = { rotation[0], rotation[1], rotation[2], rotation[3] };
+        double s[3] = { scaling[0], scaling[1], scaling[2] };
+        const double length = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3]);
+        if (length > 1e-12)
+        {
+            for (double& value : r)
+                value /= length;
+        }
+        else
+        {
+            r[0] = r[1] = r[2] = 0.0;
+            r[3] = 1.0;
+        }
+        if (t[0] != 0.0 || t[1] != 0.0 || t[2] != 0.0)
+        {
+            Json += ",\"translation\":";
+            AppendNumbers(Json, t, 3);
+        }
+        if (r[0] != 0.0 || r[1] != 0.0 || r[2] != 0.0 || r[3] != 1.0)
+        {
+            Json += ",\"rotation\":";
+            AppendNumbers(Json, r, 4);
+        }
+        if (s[0] != 1.0 || s[1] != 1.0 || s[2] != 1.0)
+        {
+            Json += ",\"scale\":";
+            AppendNumbers(Json, s, 3);
+        }
+    }
+
+    /**
+     * @brief 按URI规则百分号编码，'/'保留；':'只在keepColon时保留，否则相对引用的第一段会被解析为scheme
+     */
+    void AppendUriPath(std::string& uri, const std::string& path, bool keepColon)
+    {
+        static const char hex[] = "0123456789ABCDEF";
+        for (const unsigned char c : path)
+        {
+            if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || std::strchr("-._~/", c) ||
+                (keepColon && c == ':'))
+            {
+                uri += static_cast<char>(c);
+            }
+            else
+            {
+                uri += '%';
+                uri += hex[c >> 4];
+                uri += hex[c & 15];
+            }
+        }
+    }
+
+    /**
+     * @brief 贴图文件名转为glTF的URI：反斜杠改为'/'；绝对路径改写为相对输出文件所在目录的路径，
+     *       无法相对表示（如位于其他盘符）时写为file:///URI
+     */
+    std::string ToImageUri(const char* FileName, const std::filesystem::path& BaseDirectory)
+    {
+        std::string path = FileName;
+        std::replace(path.begin(), path.end(), '\\', '/');
+
+        std::string uri;
+        const std::filesystem::path file(path);
+        if (file.has_root_name() || file.has_root_directory())
+        {
+            const std::filesystem::path relative = file.lexically_normal().lexically_relative(BaseDirectory);
+            if (!relative.empty())
+            {
+                AppendUriPath(uri, relative.generic_string(), false);
+                return uri;
+            }
+            if (file.is_absolute())
+            {
+                uri = "file://";
+                const std::string absolute = file.lexically_normal().generic_string();
+                if (absolute.front() != '/')
+                    uri += '/';
+                AppendUriPath(uri, absolute, true);
+                return uri;
+            }
+        }
+
+        AppendUriPath(uri, path, false);
+        return uri;
+    }
+
+    /**
+     * @brief 以逗号连接JSON片段为数组
+     */
+    std::string JoinArray(const std::vector<std::string>& Items)
+    {
+        std::string result = "[";
+        for (size_t i = 0; i < Items.size(); ++i)
+        {
+            if (i > 0)
+                result += ',';
+            result += Items[i];
+        }
+        result += ']';
+        return result;
+    }
+
+    /**
+     * @brief 由不含材质与结尾的primitive描述拼出一个mesh，materials[i]为-1时不设置材质
+     */
+    std::string BuildMesh(const std::string& Name, const std::vector<std::string>& Bodies, const std::vector<int>& Materials)
+    {
+        std::vector<std::string> primitives;
+        primitives.reserve(Bodies.size());
+        for (size_t i = 0; i < Bodies.size(); ++i)
+        {
+            std::string primitive = Bodies[i];
+            if (Materials[i] >= 0)
+                primitive += ",\"material\":" + std::to_string(Materials[i]);
+            primitive += ",\"mode\":4}";
+            primitives.push_back(std::move(primitive));
+        }
+
+        std::string mesh = "{\"name\":";
+        AppendString(mesh, Name);
+        mesh += ",\"primitives\":" + JoinArray(primitives) + "}";
+        return mesh;
+    }
+
+    void Normalize(float* Vector, int Count, const float* Fallback)
+    {
+        float length = 0.0f;
+        for (int k = 0; k < Count; ++k)
+            length += Vector[k] * Vector[k];
+        length = std::sqrt(length);
+        for (int k = 0; k < Count; ++k)
+            Vector[k] = length > 1e-12f ? Vector[k] / length : Fallback[k];
+    }
+
+    /**
+     * @brief 一个primitive内各属性在顶点中的偏移（以float计），-1表示不输出
+     */
+    struct VertexLayout
+    {
+        int Normal = -1;
+        int Tangent = -1;
+        int Color = -1;
+        std::vector<int> UVSets;    // 输出的源UV集序号
+        std::vector<int> UVOffsets;
+        int Stride = 3;
+    };
+}
+
+FbxGltfWriter::FbxGltfWriter(const FbxGltfOptions& options)
+    : m_options(options)
+    , m_binLength(0)
+    , m_open(false)
+{
+}
+
+FbxGltfWriter::~FbxGltfWriter()
+{
+    if (m_open)
+    {
+        Abort();
+    }
+}
+
+void FbxGltfWriter::Abort()
+{
+    if (m_bin.is_open())
+    {
+        m_bin.close();
+    }
+    std::remove(m_binPath.c_str());
+    m_open = false;
+}
+
+bool FbxGltfWriter::Open(const std::string& path)
+{
+    if (m_open)
+    {
+        Abort();
+    }
+
+    m_path = path;
+    m_binPath = path + ".bin.tmp";
+    std::error_code error;
+    const std::filesystem::path absolute = std::filesystem::absolute(path, error);
+    m_baseDirectory = (error ? std::filesystem::path(path) : absolute).lexically_normal().parent_path();
+    m_bin.open(m_binPath, std::ios::binary | std::ios::trunc);
+    if (!m_bin.is_open())
+    {
+        FbxErrorHandler::LogError("Failed to create temporary buffer file: " + m_binPath);
+        return false;
+    }
+
+    m_binLength = 0;
+    m_bufferViews.clear();
+    m_accessors.clear();
+    m_meshes.clear();
+    m_materials.clear();
+    m_nodes.clear();
+    m_rootNodes.clear();
+    m_meshIndices.clear();
+    m_materialIndices.clear();
+    m_images.clear();
+    m_textures.clear();
+    m_textureIndices.clear();
+    m_meshPrimitives.clear();
+    m_open = true;
+    return true;
+}
+
+int FbxGltfWriter::WriteBufferView(const void* data, size_t size, int target)
+{
+    static const char padding[4] = {};
+    const uint64_t offset = m_binLength;
+    m_bin.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    const size_t aligned = (size + 3) & ~static_cast<size_t>(3);
+    m_bin.write(padding, static_cast<std::streamsize>(aligned - size));
+    if (!m_bin)
+    {
+        return -1;
+    }
+    m_binLength += aligned;
+
+    std::string view = "{\"buffer\":0,\"byteOffset\":" + std::to_string(offset)
+        + ",\"byteLength\":" + std::to_string(size) + ",\"target\":" + std::to_string(target) + "}";
+    m_bufferViews.push_back(std::move(view));
+    return static_cast<int>(m_bufferViews.size() - 1);
+}
+
+int FbxGltfWriter::AddAccessor(int bufferView, int componentType, size_t count, const char* type,
+                               const float* minimum, const float* maximum, int components)
+{
+    std::string accessor = "{\"bufferView\":" + std::to_string(bufferView)
+        + ",\"componentType\":" + std::to_string(componentType)
+        + ",\"count\":" + std::to_string(count) + ",\"type\":\"" + type + "\"";
+    if (minimum && maximum)
+    {
+        double values[4];
+        std::copy(minimum, minimum + components, values);
+        accessor += ",\"min\":";
+        AppendNumbers(accessor, values, components);
+        std::copy(maximum, maximum + components, values);
+        accessor += ",\"max\":";
+        AppendNumbers(accessor, values, components);
+    }
+    accessor += '}';
+    m_accessors.push_back(std::move(accessor));
+    return static_cast<int>(m_accessors.size() - 1);
+}
+
+void FbxGltfWriter::AddMaterials(const std::map<uint64_t, FbxMaterialsInfo>& materials)
+{
+    for (const auto& materialPair : materials)
+    {
+        if (m_materialIndices.count(materialPair.first))
+            continue;
+
+        const FbxMaterialsInfo& info = materialPair.second;
+        const double opacity = std::min(1.0, std::max(0.0, info.Opacity.Factor));
+        const double baseColor[4] = { info.Diffuse.Color[0], info.Diffuse.Color[1], info.Diffuse.Color[2], opacity };
+        double emissive[3];
+        for (int k = 0; k < 3; ++k)
+            emissive[k] = std::min(1.0, std::max(0.0, info.Emissive.Color[k]));
+        // Phong高光指数粗略换算为粗糙度
+        const double roughness = info.Shininess.Factor > 0.0 ? std::sqrt(2.0 / (info.Shininess.Factor + 2.0)) : 1.0;
+
+        std::string material = "{\"name\":";
+        AppendString(material, "material_" + std::to_string(materialPair.first));
+        material += ",\"pbrMetallicRoughness\":{\"baseColorFactor\":";
+        AppendNumbers(material, baseColor, 4);
+        const int texture = AddTexture(info.Diffuse.Texture);
+        if (texture >= 0)
+            material += ",\"baseColorTexture\":{\"index\":" + std::to_string(texture) + "}";
+        material += ",\"metallicFactor\":0,\"roughnessFactor\":";
+        AppendNumber(material, roughness);
+        material += "},\"emissiveFactor\":";
+        AppendNumbers(material, emissive, 3);
+        if (opacity < 1.0)
+            material += ",\"alphaMode\":\"BLEND\"";
+        material += '}';
+
+        m_materialIndices[materialPair.first] = static_cast<int>(m_materials.size());
+        m_materials.push_back(std::move(material));
+    }
+}
+
+int FbxGltfWriter::AddTexture(const char* fileName)
+{
+    if (!fileName || !*fileName)
+        return -1;
+
+    // 同一贴图文件只生成一个image与texture
+    auto found = m_textureIndices.find(fileName);
+    if (found != m_textureIndices.end())
+        return found->second;
+
+    std::string image = "{\"uri\":";
+    AppendString(image, ToImageUri(fileName, m_baseDirectory));
+    image += '}';
+    const int index = static_cast<int>(m_textures.size());
+    m_textures.push_back("{\"source\":" + std::to_string(m_images.size()) + "}");
+    m_images.push_back(std::move(image));
+    m_textureIndices.emplace(fileName, index);
+    return index;
+}
+
+bool FbxGltfWriter::AddMesh(uint64_t meshId, const FbxGeometryInfo& geometry, const std::string& name)
+{
+    if (!m_open)
+    {
+        return false;
+    }
+    if (m_meshIndices.count(meshId))
+    {
+        return true;
+    }
+
+    MeshPrimitives record;
+    std::vector<float> corners;
+    std::vector<float> attribute;
+    std::vector<uint32_t> indices;
+    for (const auto& sectionPair : geometry.Sections)
+    {
+        const FbxSection& section = sectionPair.second;
+        const size_t cornerCount = section.Triangle.size() - section.Triangle.size() % 3;
+        if (cornerCount == 0)
+            continue;
+
+        // 只输出覆盖全部corner的属性流
+        VertexLayout layout;
+        if (section.Normals.size() >= cornerCount)
+        {
+            layout.Normal = layout.Stride;
+            layout.Stride += 3;
+            if (m_options.ExportTangents && section.Tangents.size() >= cornerCount)
+            {
+                layout.Tangent = layout.Stride;
+                layout.Stride += 4;
+            }
+        }
+        for (size_t set = 0; set < section.UVSets.size(); ++set)
+        {
+            if (!m_options.AllUVSets && set > 0)
+                break;
+            if (section.UVSets[set].UVs.size() < cornerCount)
+                continue;
+            layout.UVSets.push_back(static_cast<int>(set));
+            layout.UVOffsets.push_back(layout.Stride);
+            layout.Stride += 2;
+        }
+        if (m_options.ExportColors && !section.ColorSets.empty() && section.ColorSets[0].Colors.size() >= cornerCount)
+        {
+            layout.Color = layout.Stride;
+            layout.Stride += 4;
+        }
+
+        // 展开为逐corner的定长顶点
+        const size_t stride = static_cast<size_t>(layout.Stride);
+        corners.assign(cornerCount * stride, 0.0f);
+        const bool hasBinormals = section.Binormals.size() >= cornerCount;
+        for (size_t i = 0; i < cornerCount; ++i)
+        {
+            float* vertex = &corners[i * stride];
+            const int controlPoint = section.Triangle[i];
+            if (controlPoint >= 0 && static_cast<size_t>(controlPoint) < geometry.ControlPoints.size())
+            {
+                for (int k = 0; k < 3; ++k)
+                    vertex[k] = static_cast<float>(geometry.ControlPoints[controlPoint][k]);
+            }
+            if (layout.Normal >= 0)
+            {
+                static const float up[3] = { 0.0f, 0.0f, 1.0f };
+                float* normal = vertex + layout.Normal;
+                for (int k = 0; k < 3; ++k)
+                    normal[k] = static_cast<float>(section.Normals[i][k]);
+                Normalize(normal, 3, up);
+
+                if (layout.Tangent >= 0)
+                {
+                    static const float side[3] = { 1.0f, 0.0f, 0.0f };
+                    float* tangent = vertex + layout.Tangent;
+                    for (int k = 0; k < 3; ++k)
+                        tangent[k] = static_cast<float>(section.Tangents[i][k]);
+                    Normalize(tangent, 3, side);
+                    // 手性：Binormal与 N x T 反向时为-1
+                    float handedness = 1.0f;
+                    if (hasBinormals)
+                    {
+                        const float cross[3] = {
+                            normal[1] * tangent[2] - normal[2] * tangent[1],
+                            normal[2] * tangent[0] - normal[0] * tangent[2],
+                            normal[0] * tangent[1] - normal[1] * tangent[0] };
+                        const FbxVector4& binormal = section.Binormals[i];
+                        const double dot = cross[0] * binormal[0] + cross[1] * binormal[1] + cross[2] * binormal[2];
+                        handedness = dot < 0.0 ? -1.0f : 1.0f;
+                    }
+                    tangent[3] = handedness;
+                }
+            }
+            for (size_t u = 0; u < layout.UVSets.size(); ++u)
+            {
+                const FbxVector2& uv = section.UVSets[layout.UVSets[u]].UVs[i];
+                vertex[layout.UVOffsets[u]] = static_cast<float>(uv[0]);
+                vertex[layout.UVOffsets[u] + 1] = static_cast<float>(1.0 - uv[1]);
+            }
+            if (layout.Color >= 0)
+            {
+                const FbxColor& color = section.ColorSets[0].Colors[i];
+                for (int k = 0; k < 4; ++k)
+                    vertex[layout.Color + k] = static_cast<float>(std::min(1.0, std::max(0.0, color[k])));
+            }
+        }
+
+        // 按完整的顶点字节焊接
+        size_t vertexCount = cornerCount;
+        indices.resize(cornerCount);
+        if (m_options.WeldVertices)
+        {
+            std::unordered_map<std::string_view, uint32_t> unique;
+            unique.reserve(cornerCount);
+            const size_t vertexBytes = stride * sizeof(float);
+            vertexCount = 0;
+            for (size_t i = 0; i < cornerCount; ++i)
+            {
+                auto found = unique.find(std::string_view(reinterpret_cast<const char*>(&corners[i * stride]), vertexBytes));
+                if (found != unique.end())
+                {
+                    indices[i] = found->second;
+                    continue;
+                }
+                // 新顶点前移到紧凑位置（不晚于当前corner），键指向紧凑位置，之后不会再被覆盖
+                if (vertexCount != i)
+                    std::copy_n(&corners[i * stride], stride, &corners[vertexCount * stride]);
+                unique.emplace(std::string_view(reinterpret_cast<const char*>(&corners[vertexCount * stride]), vertexBytes),
+                               static_cast<uint32_t>(vertexCount));
+                indices[i] = static_cast<uint32_t>(vertexCount++);
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < cornerCount; ++i)
+                indices[i] = static_cast<uint32_t>(i);
+        }
+
+        auto writeAttribute = [&](int offset, int components, const char* type, bool bounds) -> int
+        {
+            attribute.resize(vertexCount * components);
+            float minimum[4] = { INFINITY, INFINITY, INFINITY, INFINITY };
+            float maximum[4] = { -INFINITY, -INFINITY, -INFINITY, -INFINITY };
+            for (size_t v = 0; v < vertexCount; ++v)
+            {
+                for (int k = 0; k < components; ++k)
+                {
+                    const float value = corners[v * stride + offset + k];
+                    attribute[v * components + k] = value;
+                    minimum[k] = std::min(minimum[k], value);
+                    maximum[k] = std::max(maximum[k], value);
+                }
+            }
+            const int view = WriteBufferView(attribute.data(), attribute.size() * sizeof(float), kArrayBuffer);
+            if (view < 0)
+                return -1;
+            return bounds ? AddAccessor(view, kFloat, vertexCount, type, minimum, maximum, components)
+                          : AddAccessor(view, kFloat, vertexCount, type);
+        };
+
+        std::string primitive = "{\"attributes\":{";
+        int accessor = writeAttribute(0, 3, "VEC3", true);
+        bool failed = accessor < 0;
+        primitive += "\"POSITION\":" + std::to_string(accessor);
+        if (!failed && layout.Normal >= 0)
+        {
+            accessor = writeAttribute(layout.Normal, 3, "VEC3", false);
+            failed = accessor < 0;
+            primitive += ",\"NORMAL\":" + std::to_string(accessor);
+        }
+        if (!failed && layout.Tangent >= 0)
+        {
+            accessor = writeAttribute(layout.Tangent, 4, "VEC4", false);
+            failed = accessor < 0;
+            primitive += ",\"TANGENT\":" + std::to_string(accessor);
+        }
+        for (size_t u = 0; !failed && u < layout.UVOffsets.size(); ++u)
+        {
+            accessor = writeAttribute(layout.UVOffsets[u], 2, "VEC2", false);
+            failed = accessor < 0;
+            primitive += ",\"TEXCOORD_" + std::to_string(u) + "\":" + std::to_string(accessor);
+        }
+        if (!failed && layout.Color >= 0)
+        {
+            accessor = writeAttribute(layout.Color, 4, "VEC4", false);
+            failed = accessor < 0;
+            primitive += ",\"COLOR_0\":" + std::to_string(accessor);
+        }
+        primitive += '}';
+
+        // 顶点数不超过65535时使用16位索引
+        int view = -1;
+        int componentType = kUnsignedInt;
+        if (!failed && vertexCount <= 0xffff)
+        {
+            std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+            componentType = kUnsignedShort;
+            view = WriteBufferView(shortIndices.data(), shortIndices.size() * sizeof(uint16_t), kElementArrayBuffer);
+        }
+        else if (!failed)
+        {
+            view = WriteBufferView(indices.data(), indices.size() * sizeof(uint32_t), kElementArrayBuffer);
+        }
+        if (failed || view < 0)
+        {
+            FbxErrorHandler::LogError("Failed to write GLB buffer data: " + m_binPath);
+            return false;
+        }
+        primitive += ",\"indices\":" + std::to_string(AddAccessor(view, componentType, cornerCount, "SCALAR"));
+
+        auto material = m_materialIndices.find(sectionPair.first);
+        record.Bodies.push_back(std::move(primitive));
+        record.Slots.push_back(section.MaterialSlot);
+        record.Materials.push_back(material != m_materialIndices.end() ? material->second : -1);
+    }
+
+    if (record.Bodies.empty())
+    {
+        return true;
+    }
+
+    record.Name = name.empty() ? "mesh_" + std::to_string(meshId) : name;
+    const int meshIndex = static_cast<int>(m_meshes.size());
+    m_meshes.push_back(BuildMesh(record.Name, record.Bodies, record.Materials));
+    record.Variants[record.Materials] = meshIndex;
+    m_meshIndices[meshId] = meshIndex;
+    m_meshPrimitives[meshId] = std::move(record);
+    return true;
+}
+
+int FbxGltfWriter::GetMeshVariant(uint64_t meshId, const std::vector<uint64_t>& nodeMaterials)
+{
+    auto found = m_meshPrimitives.find(meshId);
+    if (found == m_meshPrimitives.end())
+    {
+        auto mesh = m_meshIndices.find(meshId);
+        return mesh != m_meshIndices.end() ? mesh->second : -1;
+    }
+
+    // 按节点自己的材质槽位解析，槽位为空或材质未登记时沿用默认材质
+    MeshPrimitives& record = found->second;
+    std::vector<int> materials = record.Materials;
+    for (size_t i = 0; i < materials.size(); ++i)
+    {
+        const int slot = record.Slots[i];
+        if (slot < 0 || static_cast<size_t>(slot) >= nodeMaterials.size() || nodeMaterials[slot] == 0)
+            continue;
+        auto material = m_materialIndices.find(nodeMaterials[slot]);
+        if (material != m_materialIndices.end())
+            materials[i] = material->second;
+    }
+
+    auto variant = record.Variants.find(materials);
+    if (variant != record.Variants.end())
+        return variant->second;
+
+    const int meshIndex = static_cast<int>(m_meshes.size());
+    m_meshes.push_back(BuildMesh(record.Name + "_variant" + std::to_string(record.Variants.size()), record.Bodies, materials));
+    record.Variants.emplace(std::move(materials), meshIndex);
+    return meshIndex;
+}
+
+void FbxGltfWriter::AddNodes(const std::vector<FbxNodeInfo>& nodes)
+{
+    // glTF节点下标 = 本批中的序号 + 已有节点数
+    const int base = static_cast<int>(m_nodes.size());
+    std::map<uint64_t, int> indexById;
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        indexById[nodes[i].Id] = base + static_cast<int>(i);
+    }
+
+    std::vector<std::vector<int>> children(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        auto parent = indexById.find(nodes[i].ParentId);
+        if (nodes[i].ParentId != 0 && parent != indexById.end() && parent->second != base + static_cast<int>(i))
+            children[parent->second - base].push_back(base + static_cast<int>(i));
+        else
+            m_rootNodes.push_back(base + static_cast<int>(i));
+    }
+
+    // glTF没有几何变换：带几何变换的Mesh节点把mesh挂到一个只承载几何变换的子节点上（排在本批之后），
+    // 该变换不会传给原节点的其他子节点
+    std::vector<std::string> geometryNodes;
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        const FbxNodeInfo& info = nodes[i];
+        const std::string name = info.NodeName ? info.NodeName : "";
+        std::string node = "{\"name\":";
+        AppendString(node, name);
+
+        const int mesh = info.LinkMeshId != 0 ? GetMeshVariant(info.LinkMeshId, info.LinkMaterialsId) : -1;
+        if (mesh >= 0 && !IsIdentity(info.GeometricTransform))
+        {
+            std::string geometryNode = "{\"name\":";
+            AppendString(geometryNode, name + "_geometry");
+            geometryNode += ",\"mesh\":" + std::to_string(mesh);
+            AppendTransform(geometryNode, info.GeometricTransform);
+            geometryNode += '}';
+            children[i].push_back(base + static_cast<int>(nodes.size() + geometryNodes.size()));
+            geometryNodes.push_back(std::move(geometryNode));
+        }
+        else if (mesh >= 0)
+        {
+            node += ",\"mesh\":" + std::to_string(mesh);
+        }
+
+        if (!children[i].empty())
+        {
+            node += ",\"children\":[";
+            for (size_t c = 0; c < children[i].size(); ++c)
+            {
+                if (c > 0)
+                    node += ',';
+                node += std::to_string(children[i][c]);
+            }
+            node += ']';
+        }
+
+        AppendTransform(node, info.LocalTransform);
+        node += '}';
+        m_nodes.push_back(std::move(node));
+    }
+
+    for (std::string& node : geometryNodes)
+        m_nodes.push_back(std::move(node));
+}
+
+bool FbxGltfWriter::Finish()
+{
+    if (!m_open)
+    {
+        return false;
+    }
+
+    // 没有节点层级时每个mesh一个根节点
+    if (m_nodes.empty())
+    {
+        for (size_t i = 0; i < m_meshes.size(); ++i)
+        {
+            m_rootNodes.push_back(static_cast<int>(m_nodes.size()));
+            m_nodes.push_back("{\"mesh\":" + std::to_string(i) + "}");
+        }
+    }
+
+    m_bin.close();
+    if (m_bin.fail())
+    {
+        FbxErrorHandler::LogError("Failed to write GLB buffer data: " + m_binPath);
+        Abort();
+        return false;
+    }
+
+    std::string json = "{\"asset\":{\"version\":\"2.0\",\"generator\":\"FbxSdkManager\"}";
+    json += ",\"scene\":0,\"scenes\":[{\"nodes\":[";
+    for (size_t i = 0; i < m_rootNodes.size(); ++i)
+    {
+        if (i > 0)
+            json += ',';
+        json += std::to_string(m_rootNodes[i]);
+    }
+    json += "]}]";
+    if (!m_nodes.empty())
+        json += ",\"nodes\":" + JoinArray(m_nodes);
+    if (!m_meshes.empty())
+        json += ",\"meshes\":" + JoinArray(m_meshes);
+    if (!m_materials.empty())
+        json += ",\"materials\":" + JoinArray(m_materials);
+    if (!m_textures.empty())
+        json += ",\"textures\":" + JoinArray(m_textures) + ",\"images\":" + JoinArray(m_images);
+    if (!m_accessors.empty())
+        json += ",\"accessors\":" + JoinArray(m_accessors);
+    if (!m_bufferViews.empty())
+        json += ",\"bufferViews\":" + JoinArray(m_bufferViews);
+    if (m_binLength > 0)
+        json += ",\"buffers\":[{\"byteLength\":" + std::to_string(m_binLength) + "}]";
+    json += '}';
+    // JSON块以空格补齐到4字节
+    json.append((4 - json.size() % 4) % 4, ' ');
+
+    const uint64_t totalLength = 12 + 8 + json.size() + (m_binLength > 0 ? 8 + m_binLength : 0);
+    if (totalLength > UINT32_MAX)
+    {
+        FbxErrorHandler::LogError("GLB exceeds 4 GB: " + m_path);
+        Abort();
+        return false;
+    }
+
+    std::ofstream out(m_path, std::ios::binary | std::ios::trunc);
+    std::ifstream bin(m_binPath, std::ios::binary);
+    if (!out.is_open() || !bin.is_open())
+    {
+        FbxErrorHandler::LogError("Failed to create GLB file: " + m_path);
+        bin.close();
+        Abort();
+        return false;
+    }
+
+    auto put32 = [&out](uint32_t value) { out.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+    put32(kGlbMagic);
+    put32(kGlbVersion);
+    put32(static_cast<uint32_t>(totalLength));
+    put32(static_cast<uint32_t>(json.size()));
+    put32(kChunkJson);
+    out.write(json.data(), static_cast<std::streamsize>(json.size()));
+    if (m_binLength > 0)
+    {
+        put32(static_cast<uint32_t>(m_binLength));
+        put32(kChunkBin);
+        std::vector<char> buffer(1 << 20);
+        while (bin)
+        {
+            bin.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            out.write(buffer.data(), bin.gcount());
+        }
+    }
+    bin.close();
+
+    const bool succeeded = static_cast<bool>(out);
+    out.close();
+    Abort();
+    if (!succeeded)
+    {
+        FbxErrorHandler::LogError("Failed to write GLB file: " + m_path);
+    }
+    return succeeded;
+}
+
+bool FbxGltfWriter::Export(const FbxSdkWrapper& wrapper, const std::string& path, const FbxGltfOptions& options)
+{
+    if (!wrapper.IsLoaded())
+    {
+        return false;
+    }
+
+    FbxGltfWriter writer(options);
+    if (!writer.Open(path))
+    {
+        return false;
+    }
+    writer.AddMaterials(wrapper.GetMaterials());
+
+    bool succeeded = true;
+    wrapper.ForEachGeometry([&](uint64_t meshId, FbxGeometryInfo& geometry)
+    {
+        succeeded = succeeded && writer.AddMesh(meshId, geometry);
+    });
+    if (!succeeded)
+    {
+        return false;
+    }
+
+    writer.AddNodes(wrapper.GetNodes());
+    return writer.Finish();
+}
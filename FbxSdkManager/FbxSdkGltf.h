@@ -0,0 +1,117 @@
+#pragma once
+#include "FbxSdkWrapper.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+struct FbxGltfOptions
+{
+    bool WeldVertices = true;    // 合并section内属性完全相同的corner，生成索引
+    bool ExportTangents = true;  // section同时带法线与切线时输出TANGENT
+    bool ExportColors = true;    // 输出第一套顶点色为COLOR_0
+    bool AllUVSets = true;       // 输出全部UV集为TEXCOORD_n，否则只输出主UV
+};
+
+/**
+ * @brief 流式GLB（glTF 2.0二进制）写出器
+ * @note 每个Mesh的顶点数据在AddMesh时立即写入临时文件（<path>.bin.tmp），内存中只保留JSON描述；
+ *       Finish时拼接为 头 + JSON块 + BIN块 并删除临时文件。
+ *       坐标按源文件原样输出，需要Y轴向上/米单位时先对场景做FbxAxisSystem/FbxSystemUnit转换；
+ *       UV的v分量翻转为glTF的左上角原点
+ */
+class FbxGltfWriter
+{
+public:
+    explicit FbxGltfWriter(const FbxGltfOptions& options = FbxGltfOptions());
+    ~FbxGltfWriter();
+
+    FbxGltfWriter(const FbxGltfWriter&) = delete;
+    FbxGltfWriter& operator=(const FbxGltfWriter&) = delete;
+
+    /**
+     * @brief 开始写出，path为最终的.glb路径
+     */
+    bool Open(const std::string& path);
+
+    /**
+     * @brief 登记材质，需在引用它们的AddMesh之前调用；section的材质Id不在表中时不设置材质
+     * @note 漫反射贴图输出为baseColorTexture，image以贴图文件名为URI引用外部文件（不嵌入GLB），绝对路径改写为相对GLB所在目录的路径
+     */
+    void AddMaterials(const std::map<uint64_t, FbxMaterialsInfo>& materials);
+
+    /**
+     * @brief 把一个Mesh的各section写为一个glTF mesh的各primitive，同一meshId只写一次
+     * @return 写入失败时返回false；没有可写的section时返回true但不生成mesh
+     */
+    bool AddMesh(uint64_t meshId, const FbxGeometryInfo& geometry, const std::string& name = std::string());
+
+    /**
+     * @brief 写入节点层级，LinkMeshId指向已添加的Mesh时引用该mesh（多个节点可共用，即实例化）
+     * @note 节点按LinkMaterialsId与section的材质槽位解析材质，与Mesh默认材质不同的实例引用共用顶点数据的mesh变体；
+     *       带几何变换（GeometricTransform）的节点把mesh放在名为<节点名>_geometry的子节点上，由该子节点承载几何变换；
+     *       不调用时Finish为每个mesh生成一个根节点
+     */
+    void AddNodes(const std::vector<FbxNodeInfo>& nodes);
+
+    /**
+     * @brief 生成最终的GLB文件
+     */
+    bool Finish();
+
+    /**
+     * @brief 导出wrapper中的节点、材质与几何体（逐Mesh提取，提取完即写出并释放）
+     */
+    static bool Export(const FbxSdkWrapper& wrapper, const std::string& path, const FbxGltfOptions& options = FbxGltfOptions());
+
+private:
+    /**
+     * @brief 写入一段BIN数据（4字节对齐）并登记bufferView
+     * @return bufferView下标，写入失败时为-1
+     */
+    int WriteBufferView(const void* data, size_t size, int target);
+
+    int AddAccessor(int bufferView, int componentType, size_t count, const char* type,
+                    const float* minimum = nullptr, const float* maximum = nullptr, int components = 0);
+
+    void Abort();
+
+    /**
+     * @return texture下标，fileName为空时为-1
+     */
+    int AddTexture(const char* fileName);
+
+    FbxGltfOptions m_options;
+    std::string m_path;
+    std::string m_binPath;
+    std::filesystem::path m_baseDirectory;  // 输出文件所在目录，绝对路径的贴图相对它写出
+    std::ofstream m_bin;
+    uint64_t m_binLength;
+    bool m_open;
+
+    std::vector<std::string> m_bufferViews;
+    std::vector<std::string> m_accessors;
+    std::vector<std::string> m_meshes;
+    std::vector<std::string> m_materials;
+    std::vector<std::string> m_nodes;
+    std::vector<int> m_rootNodes;
+    std::map<uint64_t, int> m_meshIndices;
+    std::map<uint64_t, int> m_materialIndices;
+    std::vector<std::string> m_images;
+    std::vector<std::string> m_textures;
+    std::map<std::string, int> m_textureIndices;
+
+    /**
+     * @brief 已写出Mesh的primitive描述（不含材质），供材质不同的实例节点生成共用顶点数据的mesh变体
+     */
+    struct MeshPrimitives
+    {
+        std::string Name;
+        std::vector<std::string> Bodies;
+        std::vector<int> Slots;                      // FbxSection::MaterialSlot
+        std::vector<int> Materials;                  // 默认材质下标，-1表示不设置
+        std::map<std::vector<int>, int> Variants;    // 材质组合 -> mesh下标
+    };
+    std::map<uint64_t, MeshPrimitives> m_meshPrimitives;
+
+    int GetMeshVariant(uint64_t meshId, const std::vector<uint64_t>& nodeMaterials);
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief 64位内容哈希，按8字节字长处理，大数组上远快于逐字节的FNV
+ */
+class FbxContentHasher
+{
+public:
+    explicit FbxContentHasher(uint64_t seed = 0) : m_hash(seed ^ 0x9e3779b97f4a7c15ull) {}
+
+    void Add(const void* data, size_t size)
+    {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        while (size >= 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, p, 8);
+            Mix(word);
+            p += 8;
+            size -= 8;
+        }
+        uint64_t tail = 0;
+        std::memcpy(&tail, p, size);
+        Mix(tail ^ (static_cast<uint64_t>(size) << 56));
+    }
+
+    template <typename T>
+    void AddValue(const T& value) { Add(&value, sizeof(value)); }
+
+    void AddString(const char* text)
+    {
+        Add(text ? text : "", text ? std::strlen(text) : 0);
+    }
+
+    uint64_t Get() const
+    {
+        uint64_t h = m_hash;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        return h;
+    }
+
+private:
+    void Mix(uint64_t word)
+    {
+        m_hash = (m_hash ^ word) * 0x9e3779b97f4a7c15ull;
+        m_hash ^= m_hash >> 29;
+    }
+
+    uint64_t m_hash;
+};
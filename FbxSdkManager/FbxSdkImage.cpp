@@ -0,0 +1,1965 @@
+#include "FbxSdkImage.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+    std::array<FbxImageDecoder, FBX_IMAGE_FORMAT_COUNT> s_decoders;
+
+    // 单边上限，同时保证宽*高*4不会溢出
+    const uint32_t kMaxDimension = 1u << 15;
+
+    uint32_t ReadBE32(const uint8_t* p)
+    {
+        return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) | (static_cast<uint32_t>(p[2]) << 8) | p[3];
+    }
+
+    uint16_t ReadBE16(const uint8_t* p)
+    {
+        return static_cast<uint16_t>((p[0] << 8) | p[1]);
+    }
+
+    uint16_t ReadLE16(const uint8_t* p)
+    {
+        return static_cast<uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    uint32_t ReadLE32(const uint8_t* p)
+    {
+        return p[0] | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    bool Fail(std::string* error, const char* message)
+    {
+        if (error)
+            *error = message;
+        return false;
+    }
+
+    // ---- deflate ----
+
+    const uint16_t kLengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                       35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    const uint8_t kLengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    const uint16_t kDistanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                         257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+    const uint8_t kDistanceExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+    const int kFastBits = 10;
+
+    /**
+     * @brief 规范Huffman码表：短码（不超过kFastBits位）查表一次解出，长码按长度逐位比较
+     */
+    struct Huffman
+    {
+        uint16_t Count[16];
+        uint16_t Symbol[288];
+        uint16_t Fast[1 << kFastBits];  // (符号 << 4) | 码长，0表示需要走慢路径
+    };
+
+    bool BuildHuffman(Huffman& h, const uint8_t* lengths, int n)
+    {
+        memset(&h, 0, sizeof(h));
+        for (int i = 0; i < n; ++i)
+            ++h.Count[lengths[i]];
+        h.Count[0] = 0;
+
+        // 码长超额订阅的表无法解码；不完整的表（如只有一个距离码）是合法的
+        int left = 1;
+        for (int len = 1; len < 16; ++len)
+        {
+            left = (left << 1) - h.Count[len];
+            if (left < 0)
+                return false;
+        }
+
+        uint16_t offsets[16] = {};
+        for (int len = 1; len < 15; ++len)
+            offsets[len + 1] = static_cast<uint16_t>(offsets[len] + h.Count[len]);
+        uint32_t next[16] = {};
+        uint32_t code = 0;
+        for (int len = 1; len < 16; ++len)
+        {
+            code = (code + h.Count[len - 1]) << 1;
+            next[len] = code;
+        }
+
+        for (int symbol = 0; symbol < n; ++symbol)
+        {
+            const int len = lengths[symbol];
+            if (len == 0)
+                continue;
+            h.Symbol[offsets[len]++] = static_cast<uint16_t>(symbol);
+            const uint32_t value = next[len]++;
+            if (len > kFastBits)
+                continue;
+
+            // deflate从码的最高位开始按位写入，查表下标是反转后的码
+            uint32_t reversed = 0;
+            for (int b = 0; b < len; ++b)
+                reversed |= ((value >> b) & 1u) << (len - 1 - b);
+            for (uint32_t r = reversed; r < (1u << kFastBits); r += 1u << len)
+                h.Fast[r] = static_cast<uint16_t>((symbol << 4) | len);
+        }
+        return true;
+    }
+
+    class Inflater
+    {
+    public:
+        Inflater(const uint8_t* data, size_t size, std::vector<uint8_t>& out)
+            : m_data(data), m_size(size), m_out(out)
+        {
+        }
+
+        bool Run()
+        {
+            uint32_t last = 0;
+            do
+            {
+                uint32_t type = 0;
+                if (!Bits(1, last) || !Bits(2, type))
+                    return false;
+
+                bool ok = false;
+                switch (type)
+                {
+                case 0:
+                    ok = Stored();
+                    break;
+                case 1:
+                    ok = Fixed() && Codes();
+                    break;
+                case 2:
+                    ok = Dynamic() && Codes();
+                    break;
+                default:
+                    return false;
+                }
+                if (!ok)
+                    return false;
+            } while (!last);
+
+            // 末尾补的0不能被当作数据消耗
+            return m_padding * 8 <= m_count;
+        }
+
+    private:
+        bool Fill(int need)
+        {
+            while (m_count < need)
+            {
+                uint64_t byte = 0;
+                if (m_pos < m_size)
+                    byte = m_data[m_pos++];
+                else if (++m_padding > 8)
+                    return false;
+                m_bits |= byte << m_count;
+                m_count += 8;
+            }
+            return true;
+        }
+
+        bool Bits(int need, uint32_t& value)
+        {
+            if (need == 0)
+            {
+                value = 0;
+                return true;
+            }
+            if (!Fill(need))
+                return false;
+            value = static_cast<uint32_t>(m_bits & ((1ull << need) - 1));
+            m_bits >>= need;
+            m_count -= need;
+            return true;
+        }
+
+        int DecodeSymbol(const Huffman& h)
+        {
+            if (!Fill(15))
+                return -1;
+            const uint16_t entry = h.Fast[m_bits & ((1u << kFastBits) - 1)];
+            if (entry)
+            {
+                const int len = entry & 15;
+                m_bits >>= len;
+                m_count -= len;
+                return entry >> 4;
+            }
+
+            int code = 0, first = 0, index = 0;
+            uint64_t bits = m_bits;
+            for (int len = 1; len < 16; ++len)
+            {
+                code |= static_cast<int>(bits & 1);
+                bits >>= 1;
+                const int count = h.Count[len];
+                if (code - first < count)
+                {
+                    m_bits >>= len;
+                    m_count -= len;
+                    return h.Symbol[index + code - first];
+                }
+                index += count;
+                first = (first + count) << 1;
+                code <<= 1;
+            }
+            return -1;
+        }
+
+        bool Stored()
+        {
+            m_bits >>= (m_count & 7);
+            m_count -= m_count & 7;
+            uint32_t length = 0, inverse = 0;
+            if (!Bits(16, length) || !Bits(16, inverse) || (length ^ 0xffffu) != inverse)
+                return false;
+
+            // 缓冲中剩余的整字节先输出（补的0在最高位，不属于数据）
+            while (length > 0 && m_count >= 8 + m_padding * 8)
+            {
+                m_out.push_back(static_cast<uint8_t>(m_bits));
+                m_bits >>= 8;
+                m_count -= 8;
+                --length;
+            }
+            if (m_size - m_pos < length)
+                return false;
+            m_out.insert(m_out.end(), m_data + m_pos, m_data + m_pos + length);
+            m_pos += length;
+            return true;
+        }
+
+        bool Fixed()
+        {
+            uint8_t lengths[288];
+            memset(lengths, 8, 144);
+            memset(lengths + 144, 9, 112);
+            memset(lengths + 256, 7, 24);
+            memset(lengths + 280, 8, 8);
+            uint8_t distances[30];
+            memset(distances, 5, sizeof(distances));
+            return BuildHuffman(m_literals, lengths, 288) && BuildHuffman(m_distances, distances, 30);
+        }
+
+        bool Dynamic()
+        {
+            static const uint8_t kOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+            uint32_t literalCount = 0, distanceCount = 0, codeCount = 0;
+            if (!Bits(5, literalCount) || !Bits(5, distanceCount) || !Bits(4, codeCount))
+                return false;
+            literalCount += 257;
+            distanceCount += 1;
+            codeCount += 4;
+            if (literalCount > 286 || distanceCount > 30)
+                return false;
+
+            uint8_t lengths[320] = {};
+            for (uint32_t i = 0; i < codeCount; ++i)
+            {
+                uint32_t value = 0;
+                if (!Bits(3, value))
+                    return false;
+                lengths[kOrder[i]] = static_cast<uint8_t>(value);
+            }
+            if (!BuildHuffman(m_lengths, lengths, 19))
+                return false;
+
+            memset(lengths, 0, sizeof(lengths));
+            const uint32_t total = literalCount + distanceCount;
+            for (uint32_t index = 0; index < total;)
+            {
+                const int symbol = DecodeSymbol(m_lengths);
+                if (symbol < 0)
+                    return false;
+                if (symbol < 16)
+                {
+                    lengths[index++] = static_cast<uint8_t>(symbol);
+                    continue;
+                }
+
+                uint8_t value = 0;
+                uint32_t repeat = 0;
+                if (symbol == 16)
+                {
+                    if (index == 0 || !Bits(2, repeat))
+                        return false;
+                    value = lengths[index - 1];
+                    repeat += 3;
+                }
+                else if (symbol == 17)
+                {
+                    if (!Bits(3, repeat))
+                        return false;
+                    repeat += 3;
+                }
+                else
+                {
+                    if (!Bits(7, repeat))
+                        return false;
+                    repeat += 11;
+                }
+                if (index + repeat > total)
+                    return false;
+                memset(lengths + index, value, repeat);
+                index += repeat;
+            }
+
+            // 没有块结束符的表无法终止
+            if (lengths[256] == 0)
+                return false;
+            return BuildHuffman(m_literals, lengths, static_cast<int>(literalCount)) &&
+                   BuildHuffman(m_distances, lengths + literalCount, static_cast<int>(distanceCount));
+        }
+
+        bool Codes()
+        {
+            for (;;)
+            {
+                int symbol = DecodeSymbol(m_literals);
+                if (symbol < 0)
+                    return false;
+                if (symbol < 256)
+                {
+                    m_out.push_back(static_cast<uint8_t>(symbol));
+                    continue;
+                }
+                if (symbol == 256)
+                    return true;
+
+                symbol -= 257;
+                if (symbol >= 29)
+                    return false;
+                uint32_t extra = 0;
+                if (!Bits(kLengthExtra[symbol], extra))
+                    return false;
+                const size_t length = kLengthBase[symbol] + extra;
+
+                const int distanceSymbol = DecodeSymbol(m_distances);
+                if (distanceSymbol < 0 || distanceSymbol >= 30 || !Bits(kDistanceExtra[distanceSymbol], extra))
+                    return false;
+                const size_t distance = kDistanceBase[distanceSymbol] + extra;
+                if (distance > m_out.size())
+                    return false;
+
+                const size_t at = m_out.size();
+                m_out.resize(at + length);
+                uint8_t* out = m_out.data();
+                const size_t from = at - distance;
+                if (distance >= length)
+                {
+                    memcpy(out + at, out + from, length);
+                }
+                else
+                {
+                    // 重叠复制（如distance为1的游程）必须逐字节
+                    for (size_t i = 0; i < length; ++i)
+                        out[at + i] = out[from + i];
+                }
+            }
+        }
+
+        const uint8_t* m_data;
+        size_t m_size;
+        size_t m_pos = 0;
+        uint64_t m_bits = 0;
+        int m_count = 0;
+        int m_padding = 0;
+        std::vector<uint8_t>& m_out;
+        Huffman m_literals;
+        Huffman m_distances;
+        Huffman m_lengths;
+    };
+
+    // ---- PNG ----
+
+    uint8_t Paeth(int a, int b, int c)
+    {
+        const int p = a + b - c;
+        const int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+        if (pa <= pb && pa <= pc)
+            return static_cast<uint8_t>(a);
+        return static_cast<uint8_t>(pb <= pc ? b : c);
+    }
+
+    bool Unfilter(uint8_t filter, uint8_t* row, const uint8_t* previous, size_t rowBytes, size_t pixelBytes)
+    {
+        switch (filter)
+        {
+        case 0:
+            return true;
+        case 1:
+            for (size_t i = pixelBytes; i < rowBytes; ++i)
+                row[i] = static_cast<uint8_t>(row[i] + row[i - pixelBytes]);
+            return true;
+        case 2:
+            if (previous)
+            {
+                for (size_t i = 0; i < rowBytes; ++i)
+                    row[i] = static_cast<uint8_t>(row[i] + previous[i]);
+            }
+            return true;
+        case 3:
+            for (size_t i = 0; i < rowBytes; ++i)
+            {
+                const int a = i >= pixelBytes ? row[i - pixelBytes] : 0;
+                const int b = previous ? previous[i] : 0;
+                row[i] = static_cast<uint8_t>(row[i] + ((a + b) >> 1));
+            }
+            return true;
+        case 4:
+            for (size_t i = 0; i < rowBytes; ++i)
+            {
+                const int a = i >= pixelBytes ? row[i - pixelBytes] : 0;
+                const int b = previous ? previous[i] : 0;
+                const int c = previous && i >= pixelBytes ? previous[i - pixelBytes] : 0;
+                row[i] = static_cast<uint8_t>(row[i] + Paeth(a, b, c));
+            }
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    uint32_t ReadSample(const uint8_t* row, size_t index, int depth)
+    {
+        switch (depth)
+        {
+        case 16:
+            return ReadBE16(row + index * 2);
+        case 8:
+            return row[index];
+        default:
+        {
+            const size_t bit = index * depth;
+            return (row[bit >> 3] >> (8 - depth - (bit & 7))) & ((1u << depth) - 1);
+        }
+        }
+    }
+
+    uint8_t ToByte(uint32_t sample, int depth)
+    {
+        if (depth == 16)
+            return static_cast<uint8_t>(sample >> 8);
+        if (depth == 8)
+            return static_cast<uint8_t>(sample);
+        return static_cast<uint8_t>(sample * 255 / ((1u << depth) - 1));
+    }
+
+    struct PngHeader
+    {
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        int Depth = 0;
+        int ColorType = 0;
+        int Channels = 0;
+        bool Interlaced = false;
+        std::vector<uint8_t> Palette;   // RGBA
+        bool HasKey = false;
+        uint16_t Key[3] = {};           // tRNS：灰度或RGB的透明色
+    };
+
+    void ConvertPngRow(const PngHeader& header, const uint8_t* row, uint32_t count, uint8_t* out, size_t outStride)
+    {
+        const int depth = header.Depth;
+        for (uint32_t x = 0; x < count; ++x, out += outStride)
+        {
+            const size_t s = static_cast<size_t>(x) * header.Channels;
+            switch (header.ColorType)
+            {
+            case 0:
+            {
+                const uint32_t gray = ReadSample(row, s, depth);
+                out[0] = out[1] = out[2] = ToByte(gray, depth);
+                out[3] = header.HasKey && gray == header.Key[0] ? 0 : 255;
+                break;
+            }
+            case 2:
+            {
+                const uint32_t r = ReadSample(row, s, depth), g = ReadSample(row, s + 1, depth), b = ReadSample(row, s + 2, depth);
+                out[0] = ToByte(r, depth);
+                out[1] = ToByte(g, depth);
+                out[2] = ToByte(b, depth);
+                out[3] = header.HasKey && r == header.Key[0] && g == header.Key[1] && b == header.Key[2] ? 0 : 255;
+                break;
+            }
+            case 3:
+            {
+                const size_t index = ReadSample(row, s, depth);
+                if (index * 4 + 4 <= header.Palette.size())
+                {
+                    memcpy(out, &header.Palette[index * 4], 4);
+                }
+                else
+                {
+                    out[0] = out[1] = out[2] = 0;
+                    out[3] = 255;
+                }
+                break;
+            }
+            case 4:
+                out[0] = out[1] = out[2] = ToByte(ReadSample(row, s, depth), depth);
+                out[3] = ToByte(ReadSample(row, s + 1, depth), depth);
+                break;
+            default:
+                for (int c = 0; c < 4; ++c)
+                    out[c] = ToByte(ReadSample(row, s + c, depth), depth);
+                break;
+            }
+        }
+    }
+
+    // ---- TGA ----
+
+    struct TgaHeader
+    {
+        uint8_t IdLength;
+        uint8_t ColorMapType;
+        uint8_t ImageType;
+        uint16_t ColorMapFirst;
+        uint16_t ColorMapLength;
+        uint8_t ColorMapBits;
+        uint16_t Width;
+        uint16_t Height;
+        uint8_t PixelBits;
+        uint8_t Descriptor;
+    };
+
+    bool ReadTgaHeader(const uint8_t* data, size_t size, TgaHeader& header)
+    {
+        if (size < 18)
+            return false;
+        header.IdLength = data[0];
+        header.ColorMapType = data[1];
+        header.ImageType = data[2];
+        header.ColorMapFirst = ReadLE16(data + 3);
+        header.ColorMapLength = ReadLE16(data + 5);
+        header.ColorMapBits = data[7];
+        header.Width = ReadLE16(data + 12);
+        header.Height = ReadLE16(data + 14);
+        header.PixelBits = data[16];
+        header.Descriptor = data[17];
+
+        const uint8_t type = header.ImageType & 7;
+        return header.ColorMapType <= 1 && (type == 1 || type == 2 || type == 3) && (header.ImageType & ~11) == 0 &&
+               header.Width > 0 && header.Height > 0;
+    }
+
+    /**
+     * @brief 15/16/24/32位BGR(A)像素转为RGBA
+     */
+    void TgaColor(const uint8_t* p, int bits, bool alpha, uint8_t* out)
+    {
+        if (bits <= 16)
+        {
+            const uint16_t v = ReadLE16(p);
+            out[0] = static_cast<uint8_t>(((v >> 10) & 31) * 255 / 31);
+            out[1] = static_cast<uint8_t>(((v >> 5) & 31) * 255 / 31);
+            out[2] = static_cast<uint8_t>((v & 31) * 255 / 31);
+            out[3] = 255;
+        }
+        else
+        {
+            out[0] = p[2];
+            out[1] = p[1];
+            out[2] = p[0];
+            out[3] = bits == 32 && alpha ? p[3] : 255;
+        }
+    }
+
+    // ---- JPEG ----
+
+    // 之字形序号 -> 自然序下标；末尾的填充使损坏数据中越界的k落在63上
+    const uint8_t kZigZag[64 + 16] = {
+        0, 1, 8, 16, 9, 2, 3, 10, 17, 24, 32, 25, 18, 11, 4, 5,
+        12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6, 7, 14, 21, 28,
+        35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+        58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63,
+        63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63 };
+    const int kJpegFastBits = 9;
+
+    /**
+     * @brief JPEG的Huffman表：不超过kJpegFastBits位的码查表一次解出，长码与各码长的最大码比较
+     */
+    struct JpegHuffman
+    {
+        bool Defined = false;
+        uint8_t Fast[1 << kJpegFastBits];   // 码的下标，255表示需要走慢路径
+        uint8_t Values[256];
+        uint8_t Size[257];
+        uint32_t MaxCode[18];               // 左对齐到16位后的上界（不含）
+        int Delta[17];                      // 码 + Delta = 码的下标
+    };
+
+    bool BuildJpegHuffman(JpegHuffman& h, const uint8_t* counts, const uint8_t* values, int total)
+    {
+        int k = 0;
+        for (int len = 1; len <= 16; ++len)
+        {
+            for (int i = 0; i < counts[len - 1]; ++i)
+                h.Size[k++] = static_cast<uint8_t>(len);
+        }
+        h.Size[k] = 0;
+        memcpy(h.Values, values, total);
+
+        uint16_t codes[256];
+        uint32_t code = 0;
+        k = 0;
+        for (int len = 1; len <= 16; ++len)
+        {
+            h.Delta[len] = k - static_cast<int>(code);
+            while (h.Size[k] == len)
+                codes[k++] = static_cast<uint16_t>(code++);
+            if (code > (1u << len))
+                return false;
+            h.MaxCode[len] = code << (16 - len);
+            code <<= 1;
+        }
+        h.MaxCode[17] = UINT32_MAX;
+
+        memset(h.Fast, 255, sizeof(h.Fast));
+        for (int i = 0; i < k; ++i)
+        {
+            const int len = h.Size[i];
+            if (len > kJpegFastBits)
+                continue;
+            const int first = codes[i] << (kJpegFastBits - len);
+            memset(h.Fast + first, i, static_cast<size_t>(1) << (kJpegFastBits - len));
+        }
+        h.Defined = true;
+        return true;
+    }
+
+    /**
+     * @brief 熵编码段的位读取：去掉填充的0x00，遇到标记后停在标记处并以0补位
+     */
+    class JpegBitReader
+    {
+    public:
+        JpegBitReader(const uint8_t* data, size_t size, size_t pos) : m_data(data), m_size(size), m_pos(pos) {}
+
+        size_t GetPosition() const { return m_pos; }
+
+        int Decode(const JpegHuffman& h)
+        {
+            Fill();
+            int index = h.Fast[m_buffer >> (32 - kJpegFastBits)];
+            int len;
+            if (index != 255)
+            {
+                len = h.Size[index];
+            }
+            else
+            {
+                const uint32_t top = m_buffer >> 16;
+                for (len = kJpegFastBits + 1; top >= h.MaxCode[len]; ++len)
+                {
+                }
+                if (len > 16)
+                    return -1;
+                index = static_cast<int>(top >> (16 - len)) + h.Delta[len];
+                if (index < 0 || index > 255 || h.Size[index] != len)
+                    return -1;
+            }
+            Consume(len);
+            return h.Values[index];
+        }
+
+        uint32_t Bits(int n)
+        {
+            if (n == 0)
+                return 0;
+            Fill();
+            const uint32_t value = m_buffer >> (32 - n);
+            Consume(n);
+            return value;
+        }
+
+        /**
+         * @brief 读n位并按JPEG的规则扩展为有符号数
+         */
+        int Receive(int n)
+        {
+            const int value = static_cast<int>(Bits(n));
+            return n > 0 && value < (1 << (n - 1)) ? value - (1 << n) + 1 : value;
+        }
+
+        /**
+         * @brief 丢弃剩余的位并跳过RSTn标记
+         */
+        void Restart()
+        {
+            m_buffer = 0;
+            m_count = 0;
+            m_marker = false;
+            while (m_pos + 1 < m_size && m_data[m_pos] == 0xFF && m_data[m_pos + 1] == 0xFF)
+                ++m_pos;
+            if (m_pos + 1 < m_size && m_data[m_pos] == 0xFF && m_data[m_pos + 1] >= 0xD0 && m_data[m_pos + 1] <= 0xD7)
+                m_pos += 2;
+        }
+
+    private:
+        void Fill()
+        {
+            while (m_count <= 24)
+            {
+                uint32_t byte = 0;
+                if (!m_marker && m_pos < m_size)
+                {
+                    byte = m_data[m_pos];
+                    if (byte != 0xFF)
+                    {
+                        ++m_pos;
+                    }
+                    else if (m_pos + 1 < m_size && m_data[m_pos + 1] == 0)
+                    {
+                        m_pos += 2;
+                    }
+                    else
+                    {
+                        m_marker = true;
+                        byte = 0;
+                    }
+                }
+                m_buffer |= byte << (24 - m_count);
+                m_count += 8;
+            }
+        }
+
+        void Consume(int n)
+        {
+            m_buffer <<= n;
+            m_count -= n;
+        }
+
+        const uint8_t* m_data;
+        size_t m_size;
+        size_t m_pos;
+        uint32_t m_buffer = 0;
+        int m_count = 0;
+        bool m_marker = false;
+    };
+
+    struct JpegComponent
+    {
+        int Id = 0;
+        int H = 1;
+        int V = 1;
+        int Quant = 0;
+        int Dc = 0;
+        int Ac = 0;
+        int Pred = 0;
+        uint32_t Width = 0;         // 下采样后的有效尺寸
+        uint32_t Height = 0;
+        uint32_t BlocksW = 0;       // 按MCU补齐后的块数
+        uint32_t BlocksH = 0;
+        std::vector<int16_t> Coefs; // 逐块64个系数（自然序、未反量化）
+        std::vector<uint8_t> Samples;
+    };
+
+    /**
+     * @brief 整数逆DCT（与libjpeg的jidctint相同的Loeffler算法与定点精度），输出加128并截断
+     * @note 中间值用64位：合法数据与libjpeg的32位结果相同，损坏数据的超大系数不会溢出
+     */
+    void InverseDct(const int16_t* coefs, const uint16_t* quant, uint8_t* out, size_t stride)
+    {
+        const int kConstBits = 13;
+        const int kPass1Bits = 2;
+        const int64_t k0_298631336 = 2446, k0_390180644 = 3196, k0_541196100 = 4433, k0_765366865 = 6270,
+                      k0_899976223 = 7373, k1_175875602 = 9633, k1_501321110 = 12299, k1_847759065 = 15137,
+                      k1_961570560 = 16069, k2_053119869 = 16819, k2_562915447 = 20995, k3_072711026 = 25172;
+        auto descale = [](int64_t x, int n) { return (x + (int64_t(1) << (n - 1))) >> n; };
+
+        int64_t workspace[64];
+        for (int column = 0; column < 8; ++column)
+        {
+            const int16_t* in = coefs + column;
+            const uint16_t* q = quant + column;
+            int64_t* ws = workspace + column;
+            if (in[8] == 0 && in[16] == 0 && in[24] == 0 && in[32] == 0 && in[40] == 0 && in[48] == 0 && in[56] == 0)
+            {
+                const int64_t dc = static_cast<int64_t>(in[0] * q[0]) * (1 << kPass1Bits);
+                for (int row = 0; row < 8; ++row)
+                    ws[row * 8] = dc;
+                continue;
+            }
+
+            int64_t z2 = in[16] * q[16];
+            int64_t z3 = in[48] * q[48];
+            int64_t z1 = (z2 + z3) * k0_541196100;
+            int64_t tmp2 = z1 - z3 * k1_847759065;
+            int64_t tmp3 = z1 + z2 * k0_765366865;
+            z2 = in[0] * q[0];
+            z3 = in[32] * q[32];
+            int64_t tmp0 = (z2 + z3) * (1 << kConstBits);
+            int64_t tmp1 = (z2 - z3) * (1 << kConstBits);
+            const int64_t tmp10 = tmp0 + tmp3, tmp13 = tmp0 - tmp3, tmp11 = tmp1 + tmp2, tmp12 = tmp1 - tmp2;
+
+            tmp0 = in[56] * q[56];
+            tmp1 = in[40] * q[40];
+            tmp2 = in[24] * q[24];
+            tmp3 = in[8] * q[8];
+            z1 = tmp0 + tmp3;
+            z2 = tmp1 + tmp2;
+            z3 = tmp0 + tmp2;
+            int64_t z4 = tmp1 + tmp3;
+            const int64_t z5 = (z3 + z4) * k1_175875602;
+            tmp0 *= k0_298631336;
+            tmp1 *= k2_053119869;
+            tmp2 *= k3_072711026;
+            tmp3 *= k1_501321110;
+            z1 *= -k0_899976223;
+            z2 *= -k2_562915447;
+            z3 = z3 * -k1_961570560 + z5;
+            z4 = z4 * -k0_390180644 + z5;
+            tmp0 += z1 + z3;
+            tmp1 += z2 + z4;
+            tmp2 += z2 + z3;
+            tmp3 += z1 + z4;
+
+            const int shift = kConstBits - kPass1Bits;
+            ws[0] = descale(tmp10 + tmp3, shift);
+            ws[56] = descale(tmp10 - tmp3, shift);
+            ws[8] = descale(tmp11 + tmp2, shift);
+            ws[48] = descale(tmp11 - tmp2, shift);
+            ws[16] = descale(tmp12 + tmp1, shift);
+            ws[40] = descale(tmp12 - tmp1, shift);
+            ws[24] = descale(tmp13 + tmp0, shift);
+            ws[32] = descale(tmp13 - tmp0, shift);
+        }
+
+        auto clamp = [](int64_t x) { return static_cast<uint8_t>(std::min<int64_t>(255, std::max<int64_t>(0, x + 128))); };
+        for (int row = 0; row < 8; ++row)
+        {
+            const int64_t* ws = workspace + row * 8;
+            uint8_t* o = out + row * stride;
+            if (ws[1] == 0 && ws[2] == 0 && ws[3] == 0 && ws[4] == 0 && ws[5] == 0 && ws[6] == 0 && ws[7] == 0)
+            {
+                memset(o, clamp(descale(ws[0], kPass1Bits + 3)), 8);
+                continue;
+            }
+
+            int64_t z2 = ws[2];
+            int64_t z3 = ws[6];
+            int64_t z1 = (z2 + z3) * k0_541196100;
+            int64_t tmp2 = z1 - z3 * k1_847759065;
+            int64_t tmp3 = z1 + z2 * k0_765366865;
+            int64_t tmp0 = (ws[0] + ws[4]) * (1 << kConstBits);
+            int64_t tmp1 = (ws[0] - ws[4]) * (1 << kConstBits);
+            const int64_t tmp10 = tmp0 + tmp3, tmp13 = tmp0 - tmp3, tmp11 = tmp1 + tmp2, tmp12 = tmp1 - tmp2;
+
+            tmp0 = ws[7];
+            tmp1 = ws[5];
+            tmp2 = ws[3];
+            tmp3 = ws[1];
+            z1 = tmp0 + tmp3;
+            z2 = tmp1 + tmp2;
+            z3 = tmp0 + tmp2;
+            int64_t z4 = tmp1 + tmp3;
+            const int64_t z5 = (z3 + z4) * k1_175875602;
+            tmp0 *= k0_298631336;
+            tmp1 *= k2_053119869;
+            tmp2 *= k3_072711026;
+            tmp3 *= k1_501321110;
+            z1 *= -k0_899976223;
+            z2 *= -k2_562915447;
+            z3 = z3 * -k1_961570560 + z5;
+            z4 = z4 * -k0_390180644 + z5;
+            tmp0 += z1 + z3;
+            tmp1 += z2 + z4;
+            tmp2 += z2 + z3;
+            tmp3 += z1 + z4;
+
+            const int shift = kConstBits + kPass1Bits + 3;
+            o[0] = clamp(descale(tmp10 + tmp3, shift));
+            o[7] = clamp(descale(tmp10 - tmp3, shift));
+            o[1] = clamp(descale(tmp11 + tmp2, shift));
+            o[6] = clamp(descale(tmp11 - tmp2, shift));
+            o[2] = clamp(descale(tmp12 + tmp1, shift));
+            o[5] = clamp(descale(tmp12 - tmp1, shift));
+            o[3] = clamp(descale(tmp13 + tmp0, shift));
+            o[4] = clamp(descale(tmp13 - tmp0, shift));
+        }
+    }
+
+    /**
+     * @brief 顺序与渐进式（SOF0/1/2）Huffman编码JPEG的解码器，8位精度，1或3个分量
+     * @note 所有扫描先解出系数，EOI后统一反量化、逆DCT、上采样（2倍时与libjpeg相同的三角滤波，其余倍数复制）并转换颜色
+     */
+    class JpegDecoder
+    {
+    public:
+        JpegDecoder(const uint8_t* data, size_t size, std::string* error) : m_data(data), m_size(size), m_error(error) {}
+
+        bool Run(FbxImageLevel& image)
+        {
+            if (m_size < 4 || m_data[0] != 0xFF || m_data[1] != 0xD8)
+                return Fail(m_error, "Not a JPEG file");
+
+            size_t pos = 2;
+            bool ended = false;
+            while (!ended)
+            {
+                // 标记前允许任意个0xFF填充
+                while (pos < m_size && m_data[pos] != 0xFF)
+                    ++pos;
+                while (pos < m_size && m_data[pos] == 0xFF)
+                    ++pos;
+                if (pos >= m_size)
+                    break;
+                const uint8_t marker = m_data[pos++];
+                if (marker == 0xD9)
+                {
+                    ended = true;
+                    break;
+                }
+                if ((marker >= 0xD0 && marker <= 0xD7) || marker == 0x01)
+                    continue;
+
+                if (pos + 2 > m_size)
+                    return Fail(m_error, "Truncated JPEG segment");
+                const size_t length = ReadBE16(m_data + pos);
+                if (length < 2 || pos + length > m_size)
+                    return Fail(m_error, "Truncated JPEG segment");
+                const uint8_t* segment = m_data + pos + 2;
+                const size_t segmentSize = length - 2;
+                pos += length;
+
+                bool ok = true;
+                if (marker == 0xC0 || marker == 0xC1 || marker == 0xC2)
+                    ok = ReadFrame(segment, segmentSize, marker == 0xC2);
+                else if (marker >= 0xC3 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+                    return Fail(m_error, "Unsupported JPEG process (lossless, hierarchical or arithmetic coding)");
+                else if (marker == 0xC4)
+                    ok = ReadHuffmanTables(segment, segmentSize);
+                else if (marker == 0xDB)
+                    ok = ReadQuantTables(segment, segmentSize);
+                else if (marker == 0xDD && segmentSize >= 2)
+                    m_restartInterval = ReadBE16(segment);
+                else if (marker == 0xEE && segmentSize >= 12 && memcmp(segment, "Adobe", 5) == 0)
+                    m_adobeTransform = segment[11];
+                else if (marker == 0xDA)
+                    ok = ReadScan(segment, segmentSize, pos);
+                if (!ok)
+                    return false;
+            }
+
+            // 截断的文件按已解出的系数输出，与常见解码器一致
+            if (m_components.empty() || !m_scanned)
+                return Fail(m_error, ended ? "JPEG has no image data" : "Truncated JPEG file");
+            return Output(image);
+        }
+
+    private:
+        bool ReadFrame(const uint8_t* p, size_t size, bool progressive)
+        {
+            if (!m_components.empty())
+                return Fail(m_error, "Multiple JPEG frames");
+            if (size < 6 || p[0] != 8)
+                return Fail(m_error, "Unsupported JPEG sample precision");
+            m_height = ReadBE16(p + 1);
+            m_width = ReadBE16(p + 3);
+            const int count = p[5];
+            if (m_width == 0 || m_height == 0 || m_width > kMaxDimension || m_height > kMaxDimension)
+                return Fail(m_error, "Unsupported JPEG dimensions");
+            if (count != 1 && count != 3)
+                return Fail(m_error, "Unsupported JPEG component count");
+            if (size < 6 + static_cast<size_t>(count) * 3)
+                return Fail(m_error, "Invalid JPEG frame header");
+
+            m_progressive = progressive;
+            m_components.resize(count);
+            for (int i = 0; i < count; ++i)
+            {
+                JpegComponent& component = m_components[i];
+                component.Id = p[6 + i * 3];
+                component.H = p[7 + i * 3] >> 4;
+                component.V = p[7 + i * 3] & 15;
+                component.Quant = p[8 + i * 3];
+                if (component.H < 1 || component.H > 4 || component.V < 1 || component.V > 4 || component.Quant > 3)
+                    return Fail(m_error, "Invalid JPEG frame header");
+                m_maxH = std::max(m_maxH, component.H);
+                m_maxV = std::max(m_maxV, component.V);
+            }
+
+            m_mcusX = (m_width + 8 * m_maxH - 1) / (8 * m_maxH);
+            m_mcusY = (m_height + 8 * m_maxV - 1) / (8 * m_maxV);
+            for (JpegComponent& component : m_components)
+            {
+                if (m_maxH % component.H != 0 || m_maxV % component.V != 0)
+                    return Fail(m_error, "Unsupported JPEG sampling factors");
+                component.Width = (m_width * component.H + m_maxH - 1) / m_maxH;
+                component.Height = (m_height * component.V + m_maxV - 1) / m_maxV;
+                component.BlocksW = m_mcusX * component.H;
+                component.BlocksH = m_mcusY * component.V;
+                component.Coefs.assign(static_cast<size_t>(component.BlocksW) * component.BlocksH * 64, 0);
+            }
+            return true;
+        }
+
+        bool ReadHuffmanTables(const uint8_t* p, size_t size)
+        {
+            while (size > 0)
+            {
+                if (size < 17)
+                    return Fail(m_error, "Invalid JPEG Huffman table");
+                const int tableClass = p[0] >> 4;
+                const int index = p[0] & 15;
+                int total = 0;
+                for (int i = 0; i < 16; ++i)
+                    total += p[1 + i];
+                if (tableClass > 1 || index > 3 || total > 256 || size < 17 + static_cast<size_t>(total))
+                    return Fail(m_error, "Invalid JPEG Huffman table");
+                JpegHuffman& table = tableClass == 0 ? m_dcTables[index] : m_acTables[index];
+                if (!BuildJpegHuffman(table, p + 1, p + 17, total))
+                    return Fail(m_error, "Invalid JPEG Huffman table");
+                p += 17 + total;
+                size -= 17 + total;
+            }
+            return true;
+        }
+
+        bool ReadQuantTables(const uint8_t* p, size_t size)
+        {
+            while (size > 0)
+            {
+                const int precision = p[0] >> 4;
+                const int index = p[0] & 15;
+                const size_t bytes = precision == 0 ? 64 : 128;
+                if (precision > 1 || index > 3 || size < 1 + bytes)
+                    return Fail(m_error, "Invalid JPEG quantization table");
+                for (int i = 0; i < 64; ++i)
+                    m_quant[index][kZigZag[i]] = precision == 0 ? p[1 + i] : ReadBE16(p + 1 + i * 2);
+                p += 1 + bytes;
+                size -= 1 + bytes;
+            }
+            return true;
+        }
+
+        bool ReadScan(const uint8_t* p, size_t size, size_t& pos)
+        {
+            if (m_components.empty())
+                return Fail(m_error, "JPEG scan before frame header");
+            const int count = size > 0 ? p[0] : 0;
+            if (count < 1 || count > 4 || size < 4 + static_cast<size_t>(count) * 2)
+                return Fail(m_error, "Invalid JPEG scan header");
+
+            std::vector<JpegComponent*> scan;
+            for (int i = 0; i < count; ++i)
+            {
+                auto found = std::find_if(m_components.begin(), m_components.end(),
+                                          [&](const JpegComponent& c) { return c.Id == p[1 + i * 2]; });
+                if (found == m_components.end())
+                    return Fail(m_error, "Invalid JPEG scan header");
+                found->Dc = p[2 + i * 2] >> 4;
+                found->Ac = p[2 + i * 2] & 15;
+                if (found->Dc > 3 || found->Ac > 3)
+                    return Fail(m_error, "Invalid JPEG scan header");
+                scan.push_back(&*found);
+            }
+            const uint8_t* tail = p + 1 + count * 2;
+            m_spectralStart = tail[0];
+            m_spectralEnd = tail[1];
+            m_approxHigh = tail[2] >> 4;
+            m_approxLow = tail[2] & 15;
+            if (m_progressive)
+            {
+                const bool validSpectrum = m_spectralStart == 0 ? m_spectralEnd == 0
+                                                                : m_spectralStart <= m_spectralEnd && m_spectralEnd <= 63 && count == 1;
+                if (!validSpectrum || m_approxLow > 13)
+                    return Fail(m_error, "Invalid JPEG progressive scan");
+            }
+            else
+            {
+                m_spectralStart = 0;
+                m_spectralEnd = 63;
+                m_approxHigh = m_approxLow = 0;
+            }
+
+            // 用到的码表必须已定义
+            for (const JpegComponent* component : scan)
+            {
+                const bool needDc = m_spectralStart == 0 && m_approxHigh == 0;
+                const bool needAc = m_spectralEnd > 0;
+                if ((needDc && !m_dcTables[component->Dc].Defined) || (needAc && !m_acTables[component->Ac].Defined))
+                    return Fail(m_error, "Missing JPEG Huffman table");
+            }
+
+            JpegBitReader bits(m_data, m_size, pos);
+            for (JpegComponent* component : scan)
+                component->Pred = 0;
+            m_eobRun = 0;
+
+            uint32_t unitsX, unitsY;
+            if (count == 1)
+            {
+                // 非交错扫描：每个块是一个MCU，只覆盖分量的有效区域
+                unitsX = (scan[0]->Width + 7) / 8;
+                unitsY = (scan[0]->Height + 7) / 8;
+            }
+            else
+            {
+                unitsX = m_mcusX;
+                unitsY = m_mcusY;
+            }
+
+            uint32_t untilRestart = m_restartInterval;
+            for (uint32_t y = 0; y < unitsY; ++y)
+            {
+                for (uint32_t x = 0; x < unitsX; ++x)
+                {
+                    if (m_restartInterval)
+                    {
+                        if (untilRestart == 0)
+                        {
+                            bits.Restart();
+                            for (JpegComponent* component : scan)
+                                component->Pred = 0;
+                            m_eobRun = 0;
+                            untilRestart = m_restartInterval;
+                        }
+                        --untilRestart;
+                    }
+
+                    bool ok = true;
+                    if (count == 1)
+                    {
+                        JpegComponent& component = *scan[0];
+                        ok = DecodeBlock(bits, component, &component.Coefs[(static_cast<size_t>(y) * component.BlocksW + x) * 64]);
+                    }
+                    else
+                    {
+                        for (JpegComponent* component : scan)
+                        {
+                            for (int v = 0; v < component->V && ok; ++v)
+                            {
+                                for (int h = 0; h < component->H && ok; ++h)
+                                {
+                                    const size_t block = (static_cast<size_t>(y) * component->V + v) * component->BlocksW + x * component->H + h;
+                                    ok = DecodeBlock(bits, *component, &component->Coefs[block * 64]);
+                                }
+                            }
+                        }
+                    }
+                    if (!ok)
+                        return Fail(m_error, "Corrupted JPEG data");
+                }
+            }
+
+            m_scanned = true;
+            pos = bits.GetPosition();
+            return true;
+        }
+
+        bool DecodeBlock(JpegBitReader& bits, JpegComponent& component, int16_t* block)
+        {
+            if (!m_progressive)
+            {
+                const int t = bits.Decode(m_dcTables[component.Dc]);
+                if (t < 0 || t > 11)
+                    return false;
+                component.Pred += bits.Receive(t);
+                block[0] = static_cast<int16_t>(component.Pred);
+
+                const JpegHuffman& ac = m_acTables[component.Ac];
+                for (int k = 1; k < 64;)
+                {
+                    const int rs = bits.Decode(ac);
+                    if (rs < 0)
+                        return false;
+                    const int run = rs >> 4;
+                    const int s = rs & 15;
+                    if (s == 0)
+                    {
+                        if (run != 15)
+                            break;
+                        k += 16;
+                        continue;
+                    }
+                    k += run;
+                    block[kZigZag[k]] = static_cast<int16_t>(bits.Receive(s));
+                    ++k;
+                }
+                return true;
+            }
+
+            if (m_spectralStart == 0)
+            {
+                // DC：首次扫描解出差分，细化扫描每次补一位
+                if (m_approxHigh == 0)
+                {
+                    const int t = bits.Decode(m_dcTables[component.Dc]);
+                    if (t < 0 || t > 11)
+                        return false;
+                    component.Pred += bits.Receive(t);
+                    block[0] = static_cast<int16_t>(component.Pred * (1 << m_approxLow));
+                }
+                else if (bits.Bits(1))
+                {
+                    block[0] = static_cast<int16_t>(block[0] | (1 << m_approxLow));
+                }
+                return true;
+            }
+
+            const JpegHuffman& ac = m_acTables[component.Ac];
+            if (m_approxHigh == 0)
+            {
+                if (m_eobRun > 0)
+                {
+                    --m_eobRun;
+                    return true;
+                }
+                for (int k = m_spectralStart; k <= m_spectralEnd;)
+                {
+                    const int rs = bits.Decode(ac);
+                    if (rs < 0)
+                        return false;
+                    const int run = rs >> 4;
+                    const int s = rs & 15;
+                    if (s == 0)
+                    {
+                        if (run < 15)
+                        {
+                            m_eobRun = (1u << run) - 1 + bits.Bits(run);
+                            break;
+                        }
+                        k += 16;
+                        continue;
+                    }
+                    k += run;
+                    block[kZigZag[k]] = static_cast<int16_t>(bits.Receive(s) * (1 << m_approxLow));
+                    ++k;
+                }
+                return true;
+            }
+
+            // AC细化：已非零的系数各读一位修正，新出现的系数为±1
+            const int positive = 1 << m_approxLow;
+            const int negative = -positive;
+            auto refine = [&](int16_t& coef)
+            {
+                if (bits.Bits(1) && (coef & positive) == 0)
+                    coef = static_cast<int16_t>(coef + (coef >= 0 ? positive : negative));
+            };
+
+            int k = m_spectralStart;
+            if (m_eobRun == 0)
+            {
+                for (; k <= m_spectralEnd; ++k)
+                {
+                    const int rs = bits.Decode(ac);
+                    if (rs < 0)
+                        return false;
+                    int run = rs >> 4;
+                    const int s = rs & 15;
+                    int value = 0;
+                    if (s != 0)
+                    {
+                        if (s != 1)
+                            return false;
+                        value = bits.Bits(1) ? positive : negative;
+                    }
+                    else if (run != 15)
+                    {
+                        m_eobRun = (1u << run) + bits.Bits(run);
+                        break;
+                    }
+
+                    for (; k <= m_spectralEnd; ++k)
+                    {
+                        int16_t& coef = block[kZigZag[k]];
+                        if (coef != 0)
+                            refine(coef);
+                        else if (--run < 0)
+                            break;
+                    }
+                    if (value != 0)
+                        block[kZigZag[k]] = static_cast<int16_t>(value);
+                }
+            }
+            if (m_eobRun > 0)
+            {
+                for (; k <= m_spectralEnd; ++k)
+                {
+                    int16_t& coef = block[kZigZag[k]];
+                    if (coef != 0)
+                        refine(coef);
+                }
+                --m_eobRun;
+            }
+            return true;
+        }
+
+        /**
+         * @brief 水平2倍三角滤波（libjpeg的h2v1_fancy_upsample）
+         */
+        static void UpsampleH2V1(const uint8_t* in, uint32_t width, uint8_t* out)
+        {
+            out[0] = in[0];
+            out[1] = static_cast<uint8_t>((in[0] * 3 + in[1] + 2) >> 2);
+            for (uint32_t x = 1; x + 1 < width; ++x)
+            {
+                const int center = in[x] * 3;
+                out[x * 2] = static_cast<uint8_t>((center + in[x - 1] + 1) >> 2);
+                out[x * 2 + 1] = static_cast<uint8_t>((center + in[x + 1] + 2) >> 2);
+            }
+            out[width * 2 - 2] = static_cast<uint8_t>((in[width - 1] * 3 + in[width - 2] + 1) >> 2);
+            out[width * 2 - 1] = in[width - 1];
+        }
+
+        /**
+         * @brief 水平与垂直2倍三角滤波（libjpeg的h2v2_fancy_upsample），near为本行，far为上一行或下一行
+         */
+        static void UpsampleH2V2(const uint8_t* near, const uint8_t* far, uint32_t width, uint8_t* out)
+        {
+            int last = 0;
+            int current = near[0] * 3 + far[0];
+            int next = near[1] * 3 + far[1];
+            out[0] = static_cast<uint8_t>((current * 4 + 8) >> 4);
+            out[1] = static_cast<uint8_t>((current * 3 + next + 7) >> 4);
+            for (uint32_t x = 1; x + 1 < width; ++x)
+            {
+                last = current;
+                current = next;
+                next = near[x + 1] * 3 + far[x + 1];
+                out[x * 2] = static_cast<uint8_t>((current * 3 + last + 8) >> 4);
+                out[x * 2 + 1] = static_cast<uint8_t>((current * 3 + next + 7) >> 4);
+            }
+            last = current;
+            current = next;
+            out[width * 2 - 2] = static_cast<uint8_t>((current * 3 + last + 8) >> 4);
+            out[width * 2 - 1] = static_cast<uint8_t>((current * 4 + 7) >> 4);
+        }
+
+        /**
+         * @brief 把分量上采样到整幅图像的一行
+         */
+        void UpsampleRow(const JpegComponent& component, uint32_t y, uint8_t* out) const
+        {
+            const size_t stride = static_cast<size_t>(component.BlocksW) * 8;
+            const int scaleX = m_maxH / component.H;
+            const int scaleY = m_maxV / component.V;
+            const uint32_t sourceY = y / scaleY;
+            const uint8_t* row = &component.Samples[sourceY * stride];
+
+            // 垂直2倍时与上一行（偶数输出行）或下一行（奇数输出行）插值，图像上下边缘之外取边缘行本身
+            const bool lower = (y & 1) != 0;
+            uint32_t farY = lower ? std::min(sourceY + 1, component.Height - 1) : (sourceY > 0 ? sourceY - 1 : 0);
+            const uint8_t* far = &component.Samples[farY * stride];
+
+            // libjpeg在水平2倍时只对下采样宽度大于2的分量使用三角滤波
+            if (scaleX == 2 && scaleY == 1 && component.Width > 2)
+            {
+                UpsampleH2V1(row, component.Width, out);
+                return;
+            }
+            if (scaleX == 2 && scaleY == 2 && component.Width > 2)
+            {
+                UpsampleH2V2(row, far, component.Width, out);
+                return;
+            }
+            if (scaleX == 1 && scaleY == 2)
+            {
+                // libjpeg的h1v2_fancy_upsample
+                const int bias = lower ? 2 : 1;
+                for (uint32_t x = 0; x < m_width; ++x)
+                    out[x] = static_cast<uint8_t>((row[x] * 3 + far[x] + bias) >> 2);
+                return;
+            }
+            for (uint32_t x = 0; x < m_width; ++x)
+                out[x] = row[x / scaleX];
+        }
+
+        bool Output(FbxImageLevel& image)
+        {
+            for (JpegComponent& component : m_components)
+            {
+                const size_t stride = static_cast<size_t>(component.BlocksW) * 8;
+                component.Samples.assign(stride * component.BlocksH * 8, 0);
+                const uint16_t* quant = m_quant[component.Quant];
+                for (uint32_t by = 0; by < component.BlocksH; ++by)
+                {
+                    for (uint32_t bx = 0; bx < component.BlocksW; ++bx)
+                    {
+                        const int16_t* block = &component.Coefs[(static_cast<size_t>(by) * component.BlocksW + bx) * 64];
+                        InverseDct(block, quant, &component.Samples[by * 8 * stride + bx * 8], stride);
+                    }
+                }
+                std::vector<int16_t>().swap(component.Coefs);
+            }
+
+            image.Width = m_width;
+            image.Height = m_height;
+            image.Pixels.resize(static_cast<size_t>(m_width) * m_height * 4);
+
+            // 与libjpeg相同的定点YCbCr->RGB
+            int32_t crToR[256], cbToB[256], crToG[256], cbToG[256];
+            for (int i = 0; i < 256; ++i)
+            {
+                const int32_t x = i - 128;
+                crToR[i] = (91881 * x + 32768) >> 16;
+                cbToB[i] = (116130 * x + 32768) >> 16;
+                crToG[i] = -46802 * x;
+                cbToG[i] = -22554 * x + 32768;
+            }
+            auto clamp = [](int32_t x) { return static_cast<uint8_t>(std::min(255, std::max(0, x))); };
+
+            // Adobe标记transform=0或分量Id为'R','G','B'时为RGB，否则按JFIF的YCbCr
+            const bool rgb = m_components.size() == 3 &&
+                             (m_adobeTransform == 0 || (m_components[0].Id == 'R' && m_components[1].Id == 'G' && m_components[2].Id == 'B'));
+            const size_t componentCount = m_components.size();
+            std::vector<uint8_t> rows(componentCount * (m_width + 16));
+            for (uint32_t y = 0; y < m_height; ++y)
+            {
+                const uint8_t* planes[3] = {};
+                for (size_t c = 0; c < componentCount; ++c)
+                {
+                    const JpegComponent& component = m_components[c];
+                    if (component.H == m_maxH && component.V == m_maxV)
+                    {
+                        planes[c] = &component.Samples[y * static_cast<size_t>(component.BlocksW) * 8];
+                    }
+                    else
+                    {
+                        uint8_t* row = &rows[c * (m_width + 16)];
+                        UpsampleRow(component, y, row);
+                        planes[c] = row;
+                    }
+                }
+
+                uint8_t* out = &image.Pixels[static_cast<size_t>(y) * m_width * 4];
+                for (uint32_t x = 0; x < m_width; ++x, out += 4)
+                {
+                    if (componentCount == 1)
+                    {
+                        out[0] = out[1] = out[2] = planes[0][x];
+                    }
+                    else if (rgb)
+                    {
+                        out[0] = planes[0][x];
+                        out[1] = planes[1][x];
+                        out[2] = planes[2][x];
+                    }
+                    else
+                    {
+                        const int32_t luma = planes[0][x];
+                        const uint8_t cb = planes[1][x];
+                        const uint8_t cr = planes[2][x];
+                        out[0] = clamp(luma + crToR[cr]);
+                        out[1] = clamp(luma + ((cbToG[cb] + crToG[cr]) >> 16));
+                        out[2] = clamp(luma + cbToB[cb]);
+                    }
+                    out[3] = 255;
+                }
+            }
+            return true;
+        }
+
+        const uint8_t* m_data;
+        size_t m_size;
+        std::string* m_error;
+
+        std::vector<JpegComponent> m_components;
+        JpegHuffman m_dcTables[4];
+        JpegHuffman m_acTables[4];
+        uint16_t m_quant[4][64] = {};
+        uint32_t m_width = 0;
+        uint32_t m_height = 0;
+        uint32_t m_mcusX = 0;
+        uint32_t m_mcusY = 0;
+        int m_maxH = 1;
+        int m_maxV = 1;
+        bool m_progressive = false;
+        bool m_scanned = false;
+        uint32_t m_restartInterval = 0;
+        int m_adobeTransform = -1;
+        int m_spectralStart = 0;
+        int m_spectralEnd = 63;
+        int m_approxHigh = 0;
+        int m_approxLow = 0;
+        uint32_t m_eobRun = 0;
+    };
+}
+
+FbxImageFormat FbxImageCodec::DetectFormat(const uint8_t* data, size_t size, const std::string& fileName)
+{
+    static const uint8_t kPngSignature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+    if (size >= 8 && memcmp(data, kPngSignature, 8) == 0)
+        return FBX_IMAGE_PNG;
+    if (size >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF)
+        return FBX_IMAGE_JPEG;
+    if (size >= 4 && memcmp(data, "DDS ", 4) == 0)
+        return FBX_IMAGE_DDS;
+    if (size >= 26 && data[0] == 'B' && data[1] == 'M')
+        return FBX_IMAGE_BMP;
+
+    // TGA没有魔数
+    const size_t dot = fileName.find_last_of('.');
+    if (dot != std::string::npos)
+    {
+        std::string extension = fileName.substr(dot + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        TgaHeader header;
+        if ((extension == "tga" || extension == "targa") && ReadTgaHeader(data, size, header))
+            return FBX_IMAGE_TGA;
+    }
+    return FBX_IMAGE_UNKNOWN;
+}
+
+bool FbxImageCodec::ReadDimensions(const uint8_t* data, size_t size, FbxImageFormat format, uint32_t& width, uint32_t& height)
+{
+    width = height = 0;
+    switch (format)
+    {
+    case FBX_IMAGE_PNG:
+        if (size < 24)
+            return false;
+        width = ReadBE32(data + 16);
+        height = ReadBE32(data + 20);
+        break;
+    case FBX_IMAGE_JPEG:
+    {
+        // 逐个跳过段，直到帧头（SOF0~SOF15，DHT/JPG/DAC除外）
+        size_t pos = 2;
+        while (pos + 4 <= size)
+        {
+            if (data[pos] != 0xFF)
+                return false;
+            const uint8_t marker = data[pos + 1];
+            if (marker == 0xFF)
+            {
+                ++pos;
+                continue;
+            }
+            if (marker == 0xD8 || marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7))
+            {
+                pos += 2;
+                continue;
+            }
+            if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+            {
+                if (pos + 9 > size)
+                    return false;
+                height = ReadBE16(data + pos + 5);
+                width = ReadBE16(data + pos + 7);
+                break;
+            }
+            pos += 2 + ReadBE16(data + pos + 2);
+        }
+        break;
+    }
+    case FBX_IMAGE_TGA:
+    {
+        TgaHeader header;
+        if (!ReadTgaHeader(data, size, header))
+            return false;
+        width = header.Width;
+        height = header.Height;
+        break;
+    }
+    case FBX_IMAGE_BMP:
+    {
+        if (size < 26)
+            return false;
+        width = ReadLE32(data + 18);
+        const int32_t signedHeight = static_cast<int32_t>(ReadLE32(data + 22));
+        height = static_cast<uint32_t>(signedHeight < 0 ? -static_cast<int64_t>(signedHeight) : signedHeight);
+        break;
+    }
+    case FBX_IMAGE_DDS:
+        if (size < 20)
+            return false;
+        height = ReadLE32(data + 12);
+        width = ReadLE32(data + 16);
+        break;
+    default:
+        return false;
+    }
+    return width > 0 && height > 0;
+}
+
+void FbxImageCodec::SetDecoder(FbxImageFormat format, FbxImageDecoder decoder)
+{
+    if (format > FBX_IMAGE_UNKNOWN && format < FBX_IMAGE_FORMAT_COUNT)
+        s_decoders[format] = std::move(decoder);
+}
+
+bool FbxImageCodec::Decode(const uint8_t* data, size_t size, FbxImageFormat format, FbxImageLevel& image, std::string* error)
+{
+    image = FbxImageLevel();
+    if (!data || size == 0)
+        return Fail(error, "Empty image data");
+
+    if (format > FBX_IMAGE_UNKNOWN && format < FBX_IMAGE_FORMAT_COUNT && s_decoders[format])
+    {
+        if (!s_decoders[format](data, size, image))
+            return Fail(error, "External decoder failed");
+        if (image.Pixels.size() != static_cast<size_t>(image.Width) * image.Height * 4)
+            return Fail(error, "External decoder returned an inconsistent image");
+        return true;
+    }
+
+    switch (format)
+    {
+    case FBX_IMAGE_PNG:
+        return DecodePng(data, size, image, error);
+    case FBX_IMAGE_JPEG:
+        return DecodeJpeg(data, size, image, error);
+    case FBX_IMAGE_TGA:
+        return DecodeTga(data, size, image, error);
+    case FBX_IMAGE_UNKNOWN:
+        return Fail(error, "Unknown image format");
+    default:
+        return Fail(error, "No decoder registered for this image format");
+    }
+}
+
+bool FbxImageCodec::Inflate(const uint8_t* data, size_t size, std::vector<uint8_t>& out, bool zlibHeader)
+{
+    if (zlibHeader)
+    {
+        // CMF/FLG：deflate、校验和正确、没有预设字典；结尾的Adler-32不校验
+        if (size < 2 || (data[0] & 15) != 8 || ((data[0] << 8) | data[1]) % 31 != 0 || (data[1] & 0x20) != 0)
+            return false;
+        data += 2;
+        size -= 2;
+    }
+    return Inflater(data, size, out).Run();
+}
+
+bool FbxImageCodec::DecodePng(const uint8_t* data, size_t size, FbxImageLevel& image, std::string* error)
+{
+    image = FbxImageLevel();
+    if (DetectFormat(data, size, std::string()) != FBX_IMAGE_PNG)
+        return Fail(error, "Not a PNG file");
+
+    PngHeader header;
+    std::vector<uint8_t> compressed;
+    bool hasHeader = false;
+    for (size_t pos = 8; pos + 12 <= size;)
+    {
+        const uint32_t length = ReadBE32(data + pos);
+        const uint8_t* type = data + pos + 4;
+        const uint8_t* chunk = data + pos + 8;
+        if (length > size - pos - 12)
+            return Fail(error, "Truncated PNG chunk");
+
+        if (memcmp(type, "IHDR", 4) == 0)
+        {
+            if (length < 13)
+                return Fail(error, "Invalid PNG header");
+            header.Width = ReadBE32(chunk);
+            header.Height = ReadBE32(chunk + 4);
+            header.Depth = chunk[8];
+            header.ColorType = chunk[9];
+            header.Interlaced = chunk[12] == 1;
+            if (chunk[10] != 0 || chunk[11] != 0 || chunk[12] > 1)
+                return Fail(error, "Unsupported PNG compression, filter or interlace method");
+            hasHeader = true;
+        }
+        else if (memcmp(type, "PLTE", 4) == 0)
+        {
+            const uint32_t entries = std::min<uint32_t>(length / 3, 256);
+            header.Palette.assign(entries * 4, 255);
+            for (uint32_t i = 0; i < entries; ++i)
+                memcpy(&header.Palette[i * 4], chunk + i * 3, 3);
+        }
+        else if (memcmp(type, "tRNS", 4) == 0)
+        {
+            if (header.ColorType == 3)
+            {
+                for (uint32_t i = 0; i < length && i * 4 + 3 < header.Palette.size(); ++i)
+                    header.Palette[i * 4 + 3] = chunk[i];
+            }
+            else if (header.ColorType == 0 && length >= 2)
+            {
+                header.HasKey = true;
+                header.Key[0] = ReadBE16(chunk);
+            }
+            else if (header.ColorType == 2 && length >= 6)
+            {
+                header.HasKey = true;
+                for (int c = 0; c < 3; ++c)
+                    header.Key[c] = ReadBE16(chunk + c * 2);
+            }
+        }
+        else if (memcmp(type, "IDAT", 4) == 0)
+        {
+            compressed.insert(compressed.end(), chunk, chunk + length);
+        }
+        else if (memcmp(type, "IEND", 4) == 0)
+        {
+            break;
+        }
+        pos += 12 + static_cast<size_t>(length);
+    }
+
+    if (!hasHeader || compressed.empty())
+        return Fail(error, "PNG is missing IHDR or IDAT");
+    if (header.Width == 0 || header.Height == 0 || header.Width > kMaxDimension || header.Height > kMaxDimension)
+        return Fail(error, "PNG dimensions out of range");
+
+    const int depth = header.Depth;
+    switch (header.ColorType)
+    {
+    case 0: header.Channels = 1; break;
+    case 2: header.Channels = 3; break;
+    case 3: header.Channels = 1; break;
+    case 4: header.Channels = 2; break;
+    case 6: header.Channels = 4; break;
+    default: return Fail(error, "Invalid PNG color type");
+    }
+    const bool validDepth = header.ColorType == 0 ? (depth == 1 || depth == 2 || depth == 4 || depth == 8 || depth == 16)
+                          : header.ColorType == 3 ? (depth == 1 || depth == 2 || depth == 4 || depth == 8)
+                          : (depth == 8 || depth == 16);
+    if (!validDepth)
+        return Fail(error, "Invalid PNG bit depth");
+    if (header.ColorType == 3 && header.Palette.empty())
+        return Fail(error, "Palette PNG without PLTE");
+
+    // Adam7的7遍各自是一幅带过滤字节的小图；非隔行时只有一遍
+    static const uint32_t kStartX[7] = { 0, 4, 0, 2, 0, 1, 0 };
+    static const uint32_t kStartY[7] = { 0, 0, 4, 0, 2, 0, 1 };
+    static const uint32_t kStepX[7] = { 8, 8, 4, 4, 2, 2, 1 };
+    static const uint32_t kStepY[7] = { 8, 8, 8, 4, 4, 2, 2 };
+    static const uint32_t kSingle[1] = { 0 };
+    static const uint32_t kUnit[1] = { 1 };
+    const int passCount = header.Interlaced ? 7 : 1;
+    const uint32_t* startX = header.Interlaced ? kStartX : kSingle;
+    const uint32_t* startY = header.Interlaced ? kStartY : kSingle;
+    const uint32_t* stepX = header.Interlaced ? kStepX : kUnit;
+    const uint32_t* stepY = header.Interlaced ? kStepY : kUnit;
+
+    const size_t bitsPerPixel = static_cast<size_t>(header.Channels) * depth;
+    const size_t pixelBytes = std::max<size_t>(1, bitsPerPixel / 8);
+    size_t expected = 0;
+    for (int pass = 0; pass < passCount; ++pass)
+    {
+        const uint32_t passWidth = header.Width > startX[pass] ? (header.Width - startX[pass] + stepX[pass] - 1) / stepX[pass] : 0;
+        const uint32_t passHeight = header.Height > startY[pass] ? (header.Height - startY[pass] + stepY[pass] - 1) / stepY[pass] : 0;
+        if (passWidth > 0 && passHeight > 0)
+            expected += static_cast<size_t>(passHeight) * (1 + (passWidth * bitsPerPixel + 7) / 8);
+    }
+
+    std::vector<uint8_t> raw;
+    raw.reserve(expected);
+    if (!Inflate(compressed.data(), compressed.size(), raw) || raw.size() < expected)
+        return Fail(error, "Corrupt PNG image data");
+    compressed = std::vector<uint8_t>();
+
+    image.Width = header.Width;
+    image.Height = header.Height;
+    image.Pixels.resize(static_cast<size_t>(header.Width) * header.Height * 4);
+    size_t offset = 0;
+    for (int pass = 0; pass < passCount; ++pass)
+    {
+        const uint32_t passWidth = header.Width > startX[pass] ? (header.Width - startX[pass] + stepX[pass] - 1) / stepX[pass] : 0;
+        const uint32_t passHeight = header.Height > startY[pass] ? (header.Height - startY[pass] + stepY[pass] - 1) / stepY[pass] : 0;
+        if (passWidth == 0 || passHeight == 0)
+            continue;
+
+        const size_t rowBytes = (passWidth * bitsPerPixel + 7) / 8;
+        const uint8_t* previous = nullptr;
+        for (uint32_t y = 0; y < passHeight; ++y)
+        {
+            uint8_t* row = raw.data() + offset + 1;
+            if (!Unfilter(raw[offset], row, previous, rowBytes, pixelBytes))
+                return Fail(error, "Invalid PNG filter type");
+            const size_t targetY = startY[pass] + static_cast<size_t>(y) * stepY[pass];
+            uint8_t* out = image.Pixels.data() + (targetY * header.Width + startX[pass]) * 4;
+            ConvertPngRow(header, row, passWidth, out, stepX[pass] * 4);
+            previous = row;
+            offset += 1 + rowBytes;
+        }
+    }
+    return true;
+}
+
+bool FbxImageCodec::DecodeJpeg(const uint8_t* data, size_t size, FbxImageLevel& image, std::string* error)
+{
+    image = FbxImageLevel();
+    if (!JpegDecoder(data, size, error).Run(image))
+    {
+        image = FbxImageLevel();
+        return false;
+    }
+    return true;
+}
+
+bool FbxImageCodec::DecodeTga(const uint8_t* data, size_t size, FbxImageLevel& image, std::string* error)
+{
+    image = FbxImageLevel();
+    TgaHeader header;
+    if (!ReadTgaHeader(data, size, header))
+        return Fail(error, "Not a supported TGA file");
+
+    const uint8_t type = header.ImageType & 7;
+    const bool rle = (header.ImageType & 8) != 0;
+    const int bits = header.PixelBits;
+    if ((type == 1 && bits != 8 && bits != 16) || (type == 2 && bits != 15 && bits != 16 && bits != 24 && bits != 32) ||
+        (type == 3 && bits != 8 && bits != 16))
+        return Fail(error, "Unsupported TGA pixel depth");
+
+    size_t pos = 18 + static_cast<size_t>(header.IdLength);
+    std::vector<uint8_t> colorMap;
+    if (header.ColorMapType == 1)
+    {
+        const size_t entryBytes = (header.ColorMapBits + 7) / 8;
+        const size_t mapBytes = entryBytes * header.ColorMapLength;
+        if (entryBytes < 2 || entryBytes > 4 || pos + mapBytes > size)
+            return Fail(error, "Invalid TGA color map");
+        colorMap.resize(static_cast<size_t>(header.ColorMapLength) * 4);
+        for (size_t i = 0; i < header.ColorMapLength; ++i)
+            TgaColor(data + pos + i * entryBytes, header.ColorMapBits, true, &colorMap[i * 4]);
+        pos += mapBytes;
+    }
+    else if (type == 1)
+    {
+        return Fail(error, "Color-mapped TGA without a color map");
+    }
+
+    // 32位且描述符声明了alpha位时才使用alpha，部分导出器会写出全0的alpha通道
+    const bool alpha = (header.Descriptor & 15) != 0;
+    const size_t pixelBytes = (bits + 7) / 8;
+    auto readPixel = [&](const uint8_t* p, uint8_t* out)
+    {
+        if (type == 1)
+        {
+            const size_t index = (bits == 16 ? ReadLE16(p) : p[0]) - static_cast<size_t>(header.ColorMapFirst);
+            if (index < header.ColorMapLength)
+                memcpy(out, &colorMap[index * 4], 4);
+            else
+                out[0] = out[1] = out[2] = 0, out[3] = 255;
+        }
+        else if (type == 3)
+        {
+            out[0] = out[1] = out[2] = p[0];
+            out[3] = bits == 16 ? p[1] : 255;
+        }
+        else
+        {
+            TgaColor(p, bits, alpha, out);
+        }
+    };
+
+    const size_t pixelCount = static_cast<size_t>(header.Width) * header.Height;
+    image.Width = header.Width;
+    image.Height = header.Height;
+    image.Pixels.resize(pixelCount * 4);
+    uint8_t* out = image.Pixels.data();
+    for (size_t written = 0; written < pixelCount;)
+    {
+        size_t run = 1;
+        bool repeat = false;
+        if (rle)
+        {
+            if (pos >= size)
+                return Fail(error, "Truncated TGA image data");
+            const uint8_t packet = data[pos++];
+            run = (packet & 127u) + 1;
+            repeat = (packet & 128u) != 0;
+        }
+        else
+        {
+            run = pixelCount;
+        }
+        run = std::min(run, pixelCount - written);
+
+        const size_t needed = repeat ? pixelBytes : pixelBytes * run;
+        if (pos + needed > size)
+            return Fail(error, "Truncated TGA image data");
+        for (size_t i = 0; i < run; ++i)
+            readPixel(data + pos + (repeat ? 0 : i * pixelBytes), out + (written + i) * 4);
+        pos += needed;
+        written += run;
+    }
+
+    // 默认原点在左下角；描述符第4位为从右到左，第5位为从上到下
+    const size_t stride = static_cast<size_t>(header.Width) * 4;
+    if ((header.Descriptor & 0x20) == 0)
+    {
+        for (uint32_t y = 0; y < header.Height / 2u; ++y)
+            std::swap_ranges(out + y * stride, out + (y + 1) * stride, out + (header.Height - 1 - y) * stride);
+    }
+    if ((header.Descriptor & 0x10) != 0)
+    {
+        for (uint32_t y = 0; y < header.Height; ++y)
+        {
+            uint32_t* row = reinterpret_cast<uint32_t*>(out + y * stride);
+            std::reverse(row, row + header.Width);
+        }
+    }
+    return true;
+}
+
+void FbxImageCodec::Downsample(const FbxImageLevel& source, FbxImageLevel& target)
+{
+    target.Width = std::max(1u, source.Width / 2);
+    target.Height = std::max(1u, source.Height / 2);
+    target.Pixels.resize(static_cast<size_t>(target.Width) * target.Height * 4);
+
+    const size_t sourceStride = static_cast<size_t>(source.Width) * 4;
+    for (uint32_t y = 0; y < target.Height; ++y)
+    {
+        const uint32_t y0 = std::min(y * 2, source.Height - 1);
+        const uint32_t y1 = std::min(y * 2 + 1, source.Height - 1);
+        const uint8_t* row0 = source.Pixels.data() + y0 * sourceStride;
+        const uint8_t* row1 = source.Pixels.data() + y1 * sourceStride;
+        uint8_t* out = target.Pixels.data() + static_cast<size_t>(y) * target.Width * 4;
+        for (uint32_t x = 0; x < target.Width; ++x)
+        {
+            const size_t x0 = std::min(x * 2, source.Width - 1) * 4u;
+            const size_t x1 = std::min(x * 2 + 1, source.Width - 1) * 4u;
+            for (int c = 0; c < 4; ++c)
+                out[x * 4 + c] = static_cast<uint8_t>((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) >> 2);
+        }
+    }
+}
+
+void FbxImageCodec::GenerateMips(FbxImage& image)
+{
+    image.Mips.clear();
+    const FbxImageLevel* previous = &image.Base;
+    while (previous->Width > 1 || previous->Height > 1)
+    {
+        FbxImageLevel level;
+        Downsample(*previous, level);
+        image.Mips.push_back(std::move(level));
+        previous = &image.Mips.back();
+    }
+}
+
+void FbxImageCodec::GenerateThumbnail(FbxImage& image, uint32_t maxSize)
+{
+    image.Thumbnail = FbxImageLevel();
+    if (maxSize == 0 || image.Base.Pixels.empty())
+        return;
+
+    auto fits = [maxSize](const FbxImageLevel& level) { return std::max(level.Width, level.Height) <= maxSize; };
+    if (fits(image.Base))
+    {
+        image.Thumbnail = image.Base;
+        return;
+    }
+    for (const FbxImageLevel& mip : image.Mips)
+    {
+        if (fits(mip))
+        {
+            image.Thumbnail = mip;
+            return;
+        }
+    }
+
+    FbxImageLevel current;
+    Downsample(image.Base, current);
+    while (!fits(current))
+    {
+        FbxImageLevel next;
+        Downsample(current, next);
+        current = std::move(next);
+    }
+    image.Thumbnail = std::move(current);
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+enum FbxImageFormat
+{
+    FBX_IMAGE_UNKNOWN = 0,
+    FBX_IMAGE_PNG,
+    FBX_IMAGE_JPEG,
+    FBX_IMAGE_TGA,
+    FBX_IMAGE_BMP,
+    FBX_IMAGE_DDS,
+    FBX_IMAGE_FORMAT_COUNT
+};
+
+/**
+ * @brief 一级RGBA8像素，行从上到下
+ */
+struct FbxImageLevel
+{
+    uint32_t Width = 0;
+    uint32_t Height = 0;
+    std::vector<uint8_t> Pixels;
+};
+
+struct FbxImage
+{
+    FbxImageLevel Base;
+    std::vector<FbxImageLevel> Mips;    // 第1级起逐级减半直到1x1，未生成时为空
+    FbxImageLevel Thumbnail;            // 未生成时为空
+
+    uint64_t GetByteSize() const
+    {
+        uint64_t bytes = Base.Pixels.capacity() + Thumbnail.Pixels.capacity();
+        for (const FbxImageLevel& mip : Mips)
+            bytes += mip.Pixels.capacity();
+        return bytes;
+    }
+};
+
+/**
+ * @brief 外部解码器，输出RGBA8
+ */
+using FbxImageDecoder = std::function<bool(const uint8_t* data, size_t size, FbxImageLevel& image)>;
+
+/**
+ * @brief 贴图解码：PNG（含Adam7隔行、调色板与16位）、JPEG（顺序与渐进式Huffman编码、8位、灰度或YCbCr/RGB）
+ *       与TGA（含RLE）内置，BMP/DDS只内置读取尺寸，解码需通过SetDecoder接入（如stb_image或WIC）；
+ *       算术编码、无损与CMYK的JPEG同样需要外部解码器
+ */
+class FbxImageCodec
+{
+public:
+    /**
+     * @brief 按文件头识别格式，TGA没有魔数时按扩展名识别
+     */
+    static FbxImageFormat DetectFormat(const uint8_t* data, size_t size, const std::string& fileName);
+
+    /**
+     * @brief 只读文件头得到尺寸，不解码
+     */
+    static bool ReadDimensions(const uint8_t* data, size_t size, FbxImageFormat format, uint32_t& width, uint32_t& height);
+
+    /**
+     * @brief 解码为RGBA8，已注册的外部解码器优先
+     * @param error 失败原因，可为nullptr
+     */
+    static bool Decode(const uint8_t* data, size_t size, FbxImageFormat format, FbxImageLevel& image, std::string* error = nullptr);
+
+    /**
+     * @brief 注册或清除（传空函数）某种格式的解码器
+     * @note 解码器是进程级设置，需在并行解码开始前设置
+     */
+    static void SetDecoder(FbxImageFormat format, FbxImageDecoder decoder);
+
+    static bool DecodePng(const uint8_t* data, size_t size, FbxImageLevel& image, std::string* error = nullptr);
+    /**
+     * @note 逆DCT、上采样与颜色转换与libjpeg的默认设置（JDCT_ISLOW、fancy upsampling）逐字节一致
+     */
+    static bool DecodeJpeg(const uint8_t* data, size_t size, FbxImageLevel& image, std::string* error = nullptr);
+    static bool DecodeTga(const uint8_t* data, size_t size, FbxImageLevel& image, std::string* error = nullptr);
+
+    /**
+     * @brief 解压zlib流（PNG的IDAT），zlibHeader为false时为裸deflate流
+     */
+    static bool Inflate(const uint8_t* data, size_t size, std::vector<uint8_t>& out, bool zlibHeader = true);
+
+    /**
+     * @brief 2x2盒式滤波减半（向下取整），边长为1的一侧复制边缘
+     */
+    static void Downsample(const FbxImageLevel& source, FbxImageLevel& target);
+
+    static void GenerateMips(FbxImage& image);
+
+    /**
+     * @brief 逐级减半直到最长边不超过maxSize，已生成的mip直接复用
+     */
+    static void GenerateThumbnail(FbxImage& image, uint32_t maxSize);
+};
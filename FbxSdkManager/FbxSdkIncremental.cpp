@@ -0,0 +1,324 @@
+#include "FbxSdkIncremental.h"
+#include "FbxSdkException.h"
+#include "FbxSdkHash.h"
+#include <cstring>
+
+namespace
+{
+    /**
+     * @brief 名称重名时按出现顺序追加序号，得到场景内唯一的稳定Id
+     */
+    class StableIdAllocator
+    {
+    public:
+        uint64_t Allocate(const std::string& key)
+        {
+            int occurrence = m_counts[key]++;
+            FbxContentHasher hasher;
+            hasher.Add(key.data(), key.size());
+            hasher.AddValue(occurrence);
+            uint64_t id = hasher.Get();
+            return id ? id : 1;  // 0保留为“未知”
+        }
+
+    private:
+        std::unordered_map<std::string, int> m_counts;
+    };
+
+    std::string NodePath(FbxNode* pNode)
+    {
+        std::string path;
+        // 场景根节点不计入路径
+        for (; pNode && pNode->GetParent(); pNode = pNode->GetParent())
+        {
+            const char* name = pNode->GetName();
+            path.insert(0, name ? name : "");
+            path.insert(0, 1, '/');
+        }
+        return path;
+    }
+
+    template <typename TElement>
+    void HashElement(FbxContentHasher& hasher, TElement* pElement, bool hashDirect = true)
+    {
+        if (!pElement)
+        {
+            hasher.AddValue(-1);
+            return;
+        }
+
+        hasher.AddValue(static_cast<int>(pElement->GetMappingMode()));
+        hasher.AddValue(static_cast<int>(pElement->GetReferenceMode()));
+
+        auto& directArray = pElement->GetDirectArray();
+        auto& indexArray = pElement->GetIndexArray();
+        if (hashDirect)
+        {
+            int count = directArray.GetCount();
+            hasher.AddValue(count);
+            auto* direct = directArray.GetLocked(FbxLayerElementArray::eReadLock);
+            if (direct)
+            {
+                hasher.Add(direct, sizeof(*direct) * static_cast<size_t>(count));
+                directArray.Release(&direct);
+            }
+        }
+        if (pElement->GetReferenceMode() != FbxGeometryElement::eDirect)
+        {
+            int count = indexArray.GetCount();
+            hasher.AddValue(count);
+            int* index = indexArray.GetLocked(FbxLayerElementArray::eReadLock);
+            if (index)
+            {
+                hasher.Add(index, sizeof(int) * static_cast<size_t>(count));
+                indexArray.Release(&index);
+            }
+        }
+    }
+
+    void HashColor(FbxContentHasher& hasher, const FbxMaterialColorProperty& property)
+    {
+        hasher.AddValue(property.Color[0]);
+        hasher.AddValue(property.Color[1]);
+        hasher.AddValue(property.Color[2]);
+        hasher.AddString(property.Texture);
+    }
+
+    void HashFactor(FbxContentHasher& hasher, const FbxMaterialFactorProperty& property)
+    {
+        hasher.AddValue(property.Factor);
+        hasher.AddString(property.Texture);
+    }
+
+    uint64_t HashMaterial(const FbxMaterialsInfo& material)
+    {
+        FbxContentHasher hasher;
+        HashColor(hasher, material.Ambient);
+        HashColor(hasher, material.Diffuse);
+        HashColor(hasher, material.Specular);
+        HashColor(hasher, material.Emissive);
+        HashFactor(hasher, material.Opacity);
+        HashFactor(hasher, material.Shininess);
+        HashFactor(hasher, material.Reflectivity);
+        return hasher.Get();
+    }
+}
+
+uint64_t FbxIncrementalCache::HashMesh(FbxMesh* pMesh, uint32_t attributeMask)
+{
+    FbxContentHasher hasher(attributeMask);
+    if (!pMesh)
+        return hasher.Get();
+
+    int controlPointCount = pMesh->GetControlPointsCount();
+    hasher.AddValue(controlPointCount);
+    if (FbxVector4* controlPoints = pMesh->GetControlPoints())
+        hasher.Add(controlPoints, sizeof(FbxVector4) * static_cast<size_t>(controlPointCount));
+
+    int polygonCount = pMesh->GetPolygonCount();
+    int polygonVertexCount = pMesh->GetPolygonVertexCount();
+    hasher.AddValue(polygonCount);
+    hasher.AddValue(polygonVertexCount);
+    if (int* polygonVertices = pMesh->GetPolygonVertices())
+        hasher.Add(polygonVertices, sizeof(int) * static_cast<size_t>(polygonVertexCount));
+    // 多边形顶点总数不变时边数分布仍可能变化
+    for (int i = 0; i < polygonCount; ++i)
+        hasher.AddValue(pMesh->GetPolygonSize(i));
+
+    if (attributeMask & FBX_ATTRIBUTE_NORMAL)
+    {
+        hasher.AddValue(pMesh->GetElementNormalCount());
+        for (int i = 0; i < pMesh->GetElementNormalCount(); ++i)
+            HashElement(hasher, pMesh->GetElementNormal(i));
+    }
+    if (attributeMask & FBX_ATTRIBUTE_TANGENT)
+    {
+        hasher.AddValue(pMesh->GetElementTangentCount());
+        for (int i = 0; i < pMesh->GetElementTangentCount(); ++i)
+            HashElement(hasher, pMesh->GetElementTangent(i));
+    }
+    if (attributeMask & FBX_ATTRIBUTE_BINORMAL)
+    {
+        hasher.AddValue(pMesh->GetElementBinormalCount());
+        for (int i = 0; i < pMesh->GetElementBinormalCount(); ++i)
+            HashElement(hasher, pMesh->GetElementBinormal(i));
+    }
+    if (attributeMask & FBX_ATTRIBUTE_UV)
+    {
+        hasher.AddValue(pMesh->GetElementUVCount());
+        for (int i = 0; i < pMesh->GetElementUVCount(); ++i)
+        {
+            FbxGeometryElementUV* element = pMesh->GetElementUV(i);
+            hasher.AddString(element ? element->GetName() : nullptr);
+            HashElement(hasher, element);
+        }
+    }
+    if (attributeMask & FBX_ATTRIBUTE_COLOR)
+    {
+        hasher.AddValue(pMesh->GetElementVertexColorCount());
+        for (int i = 0; i < pMesh->GetElementVertexColorCount(); ++i)
+            HashElement(hasher, pMesh->GetElementVertexColor(i));
+    }
+    if (attributeMask & FBX_ATTRIBUTE_SMOOTHING)
+    {
+        hasher.AddValue(pMesh->GetElementSmoothingCount());
+        for (int i = 0; i < pMesh->GetElementSmoothingCount(); ++i)
+            HashElement(hasher, pMesh->GetElementSmoothing(i));
+    }
+
+    // 材质层的直接数组是材质指针，每次导入都不同；材质本身由调用者按稳定Id计入
+    hasher.AddValue(pMesh->GetElementMaterialCount());
+    for (int i = 0; i < pMesh->GetElementMaterialCount(); ++i)
+        HashElement(hasher, pMesh->GetElementMaterial(i), false);
+
+    return hasher.Get();
+}
+
+void FbxIncrementalCache::Update(FbxScene* pScene, const FbxExtractionFilter& filter, uint32_t attributeMask,
+                                 const FbxTangentOptions* tangentOptions, FbxSceneDelta& delta)
+{
+    delta = FbxSceneDelta();
+    if (!pScene)
+    {
+        FbxErrorHandler::LogError("FbxScene is null");
+        return;
+    }
+
+    std::unordered_map<uint64_t, uint64_t> stableIds;
+
+    // 材质：每次都重新读取，Texture指针指向当前场景，旧值不能保留
+    std::map<uint64_t, FbxMaterialsInfo> rawMaterials;
+    FbxSdkLibrary::GetFbxMaterials(pScene, rawMaterials);
+
+    std::map<uint64_t, FbxMaterialsInfo> materials;
+    std::map<uint64_t, uint64_t> materialHashes;
+    StableIdAllocator materialIds;
+    for (int i = 0; i < pScene->GetMaterialCount(); ++i)
+    {
+        FbxSurfaceMaterial* material = pScene->GetMaterial(i);
+        if (!material)
+            continue;
+        auto raw = rawMaterials.find(material->GetUniqueID());
+        if (raw == rawMaterials.end())
+            continue;
+
+        const char* name = material->GetName();
+        uint64_t stableId = materialIds.Allocate(name ? name : "");
+        stableIds[material->GetUniqueID()] = stableId;
+        materials[stableId] = raw->second;
+        uint64_t hash = HashMaterial(raw->second);
+        materialHashes[stableId] = hash;
+
+        auto previous = m_materialHashes.find(stableId);
+        if (previous == m_materialHashes.end())
+            delta.AddedMaterials.push_back(stableId);
+        else if (previous->second != hash)
+            delta.ModifiedMaterials.push_back(stableId);
+    }
+    for (const auto& previous : m_materialHashes)
+    {
+        if (!materialHashes.count(previous.first))
+            delta.RemovedMaterials.push_back(previous.first);
+    }
+
+    // Mesh：与GetFbxGeometries相同的集合与顺序
+    std::vector<FbxMesh*> meshes;
+    if (filter.IsEmpty())
+    {
+        for (int i = 0; i < pScene->GetGeometryCount(); ++i)
+        {
+            FbxGeometry* geometry = pScene->GetGeometry(i);
+            if (geometry && geometry->GetAttributeType() == FbxNodeAttribute::eMesh)
+                meshes.push_back(static_cast<FbxMesh*>(geometry));
+        }
+    }
+    else
+    {
+        FbxSdkLibrary::CollectFilteredMeshes(pScene, filter, meshes);
+    }
+
+    std::map<uint64_t, FbxGeometryInfo> geometries;
+    std::map<uint64_t, uint64_t> meshHashes;
+    StableIdAllocator meshIds;
+    // 开关切线生成也会改变提取结果
+    const uint32_t hashMask = attributeMask | (tangentOptions ? (tangentOptions->AttributeMask << 16) | 0x80000000u : 0);
+    for (FbxMesh* mesh : meshes)
+    {
+        FbxNode* node = mesh->GetNode(0);
+        const char* meshName = mesh->GetName();
+        uint64_t stableId = meshIds.Allocate(NodePath(node) + '|' + (meshName ? meshName : ""));
+        stableIds[mesh->GetUniqueID()] = stableId;
+
+        FbxContentHasher hasher(HashMesh(mesh, hashMask));
+        if (node)
+        {
+            for (int i = 0; i < node->GetMaterialCount(); ++i)
+            {
+                FbxSurfaceMaterial* material = node->GetMaterial(i);
+                auto found = material ? stableIds.find(material->GetUniqueID()) : stableIds.end();
+                hasher.AddValue(found != stableIds.end() ? found->second : 0ull);
+            }
+        }
+        uint64_t hash = hasher.Get();
+        meshHashes[stableId] = hash;
+
+        auto previous = m_meshHashes.find(stableId);
+        if (previous != m_meshHashes.end() && previous->second == hash)
+        {
+            auto cached = m_geometries.find(stableId);
+            if (cached != m_geometries.end())
+            {
+                geometries.emplace(stableId, std::move(cached->second));
+                continue;
+            }
+        }
+
+        (previous == m_meshHashes.end() ? delta.AddedMeshes : delta.ModifiedMeshes).push_back(stableId);
+
+        FbxGeometryInfo extracted = FbxSdkLibrary::GetFbxGeometry(mesh, attributeMask);
+        if (tangentOptions)
+        {
+            FbxTangentOptions options = *tangentOptions;
+            options.AttributeMask &= attributeMask;
+            FbxTangentGenerator::Generate(extracted, options);
+        }
+
+        // section的键换成材质的稳定Id，未登记的键（如无材质）保持原样
+        FbxGeometryInfo& geometry = geometries[stableId];
+        geometry.ControlPoints = std::move(extracted.ControlPoints);
+        for (auto& section : extracted.Sections)
+        {
+            auto found = stableIds.find(section.first);
+            geometry.Sections.emplace(found != stableIds.end() ? found->second : section.first, std::move(section.second));
+        }
+    }
+    for (const auto& previous : m_meshHashes)
+    {
+        if (!meshHashes.count(previous.first))
+            delta.RemovedMeshes.push_back(previous.first);
+    }
+
+    m_geometries = std::move(geometries);
+    m_meshHashes = std::move(meshHashes);
+    m_materials = std::move(materials);
+    m_materialHashes = std::move(materialHashes);
+    m_stableIds = std::move(stableIds);
+
+    FBX_LOG_DEBUG("Incremental update: %zu added, %zu modified, %zu removed meshes",
+                  delta.AddedMeshes.size(), delta.ModifiedMeshes.size(), delta.RemovedMeshes.size());
+}
+
+void FbxIncrementalCache::Clear()
+{
+    m_geometries.clear();
+    m_meshHashes.clear();
+    m_materials.clear();
+    m_materialHashes.clear();
+    m_stableIds.clear();
+}
+
+uint64_t FbxIncrementalCache::GetStableId(uint64_t uniqueId) const
+{
+    auto found = m_stableIds.find(uniqueId);
+    return found != m_stableIds.end() ? found->second : 0;
+}
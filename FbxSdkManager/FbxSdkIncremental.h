@@ -0,0 +1,64 @@
+#pragma once
+#include "FbxSdkLibrary.h"
+#include "FbxSdkTangents.h"
+#include <cstdint>
+#include <unordered_map>
+
+/**
+ * @brief 两次加载之间的变化，Id均为稳定Id（见FbxIncrementalCache）
+ */
+struct FbxSceneDelta
+{
+    std::vector<uint64_t> AddedMeshes;
+    std::vector<uint64_t> ModifiedMeshes;
+    std::vector<uint64_t> RemovedMeshes;
+    std::vector<uint64_t> AddedMaterials;
+    std::vector<uint64_t> ModifiedMaterials;
+    std::vector<uint64_t> RemovedMaterials;
+
+    bool IsEmpty() const
+    {
+        return AddedMeshes.empty() && ModifiedMeshes.empty() && RemovedMeshes.empty() &&
+               AddedMaterials.empty() && ModifiedMaterials.empty() && RemovedMaterials.empty();
+    }
+};
+
+/**
+ * @brief 跨多次导入保留的几何体/材质缓存，只重新提取内容变化的Mesh
+ * @note FbxObject的唯一Id每次导入都会变化，缓存改用稳定Id：Mesh为首个引用节点的路径加Mesh名，
+ *       材质为材质名，重名时按场景顺序追加序号。缓存中几何体的键、section的键（材质）与材质表的键都是稳定Id。
+ *       Mesh的内容哈希直接对SDK中的控制点、多边形与属性掩码选中的元素层数组计算（不三角化），
+ *       并包含所在节点的材质列表；材质每次都重新读取（开销很小），按值比较
+ */
+class FbxIncrementalCache
+{
+public:
+    /**
+     * @brief 用新导入的场景更新缓存
+     * @param tangentOptions 非空时为重新提取的Mesh补齐法线/切线（与FbxSdkWrapper::EnableTangentGeneration一致）
+     */
+    void Update(FbxScene* pScene, const FbxExtractionFilter& filter, uint32_t attributeMask,
+                const FbxTangentOptions* tangentOptions, FbxSceneDelta& delta);
+
+    void Clear();
+
+    const std::map<uint64_t, FbxGeometryInfo>& GetGeometries() const { return m_geometries; }
+    const std::map<uint64_t, FbxMaterialsInfo>& GetMaterials() const { return m_materials; }
+
+    /**
+     * @brief 把当前场景中Mesh或材质的唯一Id（如FbxNodeInfo::LinkMeshId）转换为稳定Id，未知时返回0
+     */
+    uint64_t GetStableId(uint64_t uniqueId) const;
+
+    /**
+     * @brief 计算Mesh的内容哈希
+     */
+    static uint64_t HashMesh(FbxMesh* pMesh, uint32_t attributeMask);
+
+private:
+    std::map<uint64_t, FbxGeometryInfo> m_geometries;
+    std::map<uint64_t, uint64_t> m_meshHashes;
+    std::map<uint64_t, FbxMaterialsInfo> m_materials;
+    std::map<uint64_t, uint64_t> m_materialHashes;
+    std::unordered_map<uint64_t, uint64_t> m_stableIds;
+};
@@ -0,0 +1,186 @@
+#include "FbxSdkIndex.h"
+#include <algorithm>
+
+void FbxSceneIndex::Buckets::Build(size_t keyCount, const std::vector<std::pair<uint32_t, uint32_t>>& pairs)
+{
+    Offsets.assign(keyCount + 1, 0);
+    for (const auto& pair : pairs)
+        ++Offsets[pair.first + 1];
+    for (size_t k = 0; k < keyCount; ++k)
+        Offsets[k + 1] += Offsets[k];
+
+    Values.resize(pairs.size());
+    std::vector<uint32_t> cursor(Offsets.begin(), Offsets.end() - 1);
+    for (const auto& pair : pairs)
+        Values[cursor[pair.first]++] = pair.second;
+}
+
+void FbxSceneIndex::Clear()
+{
+    m_nodes.clear();
+    m_meshes.clear();
+    m_materials.clear();
+    m_nodeById.clear();
+    m_meshById.clear();
+    m_materialById.clear();
+    m_nameIds.clear();
+    m_names.clear();
+    m_nodesByName = Buckets();
+    m_meshesByName = Buckets();
+    m_materialsByName = Buckets();
+    m_nodesByType = Buckets();
+    m_children = Buckets();
+    m_nodeMaterials = Buckets();
+    m_meshInstances = Buckets();
+    m_materialMeshes = Buckets();
+    m_materialNodes = Buckets();
+}
+
+uint32_t FbxSceneIndex::Intern(const char* name)
+{
+    std::string_view view(name ? name : "");
+    auto found = m_nameIds.find(view);
+    if (found != m_nameIds.end())
+        return found->second;
+
+    const uint32_t id = static_cast<uint32_t>(m_names.size());
+    m_names.emplace_back(view);
+    m_nameIds.emplace(std::string_view(m_names.back()), id);
+    return id;
+}
+
+uint32_t FbxSceneIndex::FindName(std::string_view name) const
+{
+    auto found = m_nameIds.find(name);
+    return found != m_nameIds.end() ? found->second : npos;
+}
+
+void FbxSceneIndex::Build(FbxScene* pScene)
+{
+    Clear();
+    if (!pScene)
+        return;
+
+    // Mesh与材质先编号，节点才能直接记录稠密下标
+    for (int i = 0; i < pScene->GetGeometryCount(); ++i)
+    {
+        FbxGeometry* geometry = pScene->GetGeometry(i);
+        if (!geometry || geometry->GetAttributeType() != FbxNodeAttribute::eMesh)
+            continue;
+        FbxIndexedObject mesh;
+        mesh.Id = geometry->GetUniqueID();
+        mesh.NameId = Intern(geometry->GetName());
+        mesh.Name = m_names[mesh.NameId].c_str();
+        if (m_meshById.emplace(mesh.Id, static_cast<uint32_t>(m_meshes.size())).second)
+            m_meshes.push_back(mesh);
+    }
+    for (int i = 0; i < pScene->GetMaterialCount(); ++i)
+    {
+        FbxSurfaceMaterial* pMaterial = pScene->GetMaterial(i);
+        if (!pMaterial)
+            continue;
+        FbxIndexedObject material;
+        material.Id = pMaterial->GetUniqueID();
+        material.NameId = Intern(pMaterial->GetName());
+        material.Name = m_names[material.NameId].c_str();
+        if (m_materialById.emplace(material.Id, static_cast<uint32_t>(m_materials.size())).second)
+            m_materials.push_back(material);
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> children;
+    std::vector<std::pair<uint32_t, uint32_t>> nodeMaterials;
+    std::vector<std::pair<uint32_t, uint32_t>> meshInstances;
+    std::vector<std::pair<uint32_t, uint32_t>> materialMeshes;
+    std::vector<std::pair<uint32_t, uint32_t>> materialNodes;
+    std::vector<uint64_t> slots;
+
+    // 显式栈的先序遍历，深层级不会耗尽调用栈；子节点逆序入栈以保持场景顺序
+    FbxNode* pRoot = pScene->GetRootNode();
+    std::vector<std::pair<FbxNode*, uint32_t>> stack;
+    if (pRoot)
+    {
+        for (int i = pRoot->GetChildCount() - 1; i >= 0; --i)
+            stack.emplace_back(pRoot->GetChild(i), npos);
+    }
+    while (!stack.empty())
+    {
+        FbxNode* pNode = stack.back().first;
+        const uint32_t parent = stack.back().second;
+        stack.pop_back();
+        if (!pNode)
+            continue;
+
+        const uint32_t index = static_cast<uint32_t>(m_nodes.size());
+        FbxIndexedNode node;
+        node.Id = pNode->GetUniqueID();
+        node.NameId = Intern(pNode->GetName());
+        node.Name = m_names[node.NameId].c_str();
+        node.Parent = parent;
+        if (pNode->GetNodeAttribute())
+            node.Type = pNode->GetNodeAttribute()->GetAttributeType();
+        if (pNode->GetMesh())
+            node.Mesh = FindMesh(pNode->GetMesh()->GetUniqueID());
+        m_nodeById.emplace(node.Id, index);
+        m_nodes.push_back(node);
+
+        if (parent != npos)
+            children.emplace_back(parent, index);
+        if (node.Mesh != npos)
+            meshInstances.emplace_back(node.Mesh, index);
+
+        FbxSdkLibrary::GetMaterialIdTable(pNode, slots);
+        for (uint64_t materialId : slots)
+        {
+            const uint32_t material = materialId ? FindMaterial(materialId) : npos;
+            nodeMaterials.emplace_back(index, material);
+            if (material == npos)
+                continue;
+            materialNodes.emplace_back(material, index);
+            if (node.Mesh != npos)
+                materialMeshes.emplace_back(material, node.Mesh);
+        }
+
+        for (int i = pNode->GetChildCount() - 1; i >= 0; --i)
+            stack.emplace_back(pNode->GetChild(i), index);
+    }
+
+    // 同一材质可能出现在多个槽位或多个实例上，去重后再分桶
+    auto unique = [](std::vector<std::pair<uint32_t, uint32_t>>& pairs)
+    {
+        std::sort(pairs.begin(), pairs.end());
+        pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+    };
+    unique(materialMeshes);
+    unique(materialNodes);
+
+    std::vector<std::pair<uint32_t, uint32_t>> byName;
+    byName.reserve(m_nodes.size());
+    for (uint32_t i = 0; i < m_nodes.size(); ++i)
+        byName.emplace_back(m_nodes[i].NameId, i);
+    m_nodesByName.Build(m_names.size(), byName);
+    byName.clear();
+    for (uint32_t i = 0; i < m_meshes.size(); ++i)
+        byName.emplace_back(m_meshes[i].NameId, i);
+    m_meshesByName.Build(m_names.size(), byName);
+    byName.clear();
+    for (uint32_t i = 0; i < m_materials.size(); ++i)
+        byName.emplace_back(m_materials[i].NameId, i);
+    m_materialsByName.Build(m_names.size(), byName);
+
+    std::vector<std::pair<uint32_t, uint32_t>> byType;
+    byType.reserve(m_nodes.size());
+    uint32_t typeCount = 0;
+    for (uint32_t i = 0; i < m_nodes.size(); ++i)
+    {
+        const uint32_t type = static_cast<uint32_t>(m_nodes[i].Type);
+        byType.emplace_back(type, i);
+        typeCount = std::max(typeCount, type + 1);
+    }
+    m_nodesByType.Build(typeCount, byType);
+
+    m_children.Build(m_nodes.size(), children);
+    m_nodeMaterials.Build(m_nodes.size(), nodeMaterials);
+    m_meshInstances.Build(m_meshes.size(), meshInstances);
+    m_materialMeshes.Build(m_materials.size(), materialMeshes);
+    m_materialNodes.Build(m_materials.size(), materialNodes);
+}
@@ -0,0 +1,154 @@
+#pragma once
+#include "FbxSdkLibrary.h"
+#include <cstdint>
+#include <deque>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief 一组稠密下标，指向FbxSceneIndex内部的数组，在下一次Build/Clear之前有效
+ */
+struct FbxIndexRange
+{
+    const uint32_t* First = nullptr;
+    const uint32_t* Last = nullptr;
+
+    const uint32_t* begin() const { return First; }
+    const uint32_t* end() const { return Last; }
+    size_t size() const { return static_cast<size_t>(Last - First); }
+    bool empty() const { return First == Last; }
+    uint32_t operator[](size_t i) const { return First[i]; }
+};
+
+struct FbxIndexedNode
+{
+    uint64_t Id = 0;
+    const char* Name = "";                  // 驻留字符串，与同名的Mesh/材质共用
+    uint32_t NameId = 0;
+    uint32_t Parent = UINT32_MAX;           // 父节点的稠密下标，根节点的直接子节点为UINT32_MAX
+    uint32_t Mesh = UINT32_MAX;             // Mesh的稠密下标，没有Mesh时为UINT32_MAX
+    FbxNodeAttribute::EType Type = FbxNodeAttribute::eUnknown;  // 没有节点属性时为eUnknown
+};
+
+struct FbxIndexedObject
+{
+    uint64_t Id = 0;
+    const char* Name = "";
+    uint32_t NameId = 0;
+};
+
+/**
+ * @brief 一次构建、只读查询的场景索引：按唯一Id、名字与属性类型定位节点/Mesh/材质，
+ *       以及Mesh -> 引用它的节点、材质 -> 使用它的Mesh/节点的反向关系，查询均为O(1)
+ * @note 节点顺序与FbxSdkLibrary::GetFbxNodes相同（先序，不含场景根节点）；Mesh按场景几何体顺序，材质按场景材质顺序。
+ *       名字不唯一，按名字查询返回全部同名对象。材质与Mesh的关系按实例节点的材质槽位建立：
+ *       节点引用Mesh且某个槽位是该材质时，视为该Mesh使用该材质。
+ *       场景结构变化（重新导入、增删节点）后需要重新Build
+ */
+class FbxSceneIndex
+{
+public:
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    FbxSceneIndex() = default;
+
+    // 名字与名字表的键指向内部的驻留字符串，只能移动不能拷贝
+    FbxSceneIndex(const FbxSceneIndex&) = delete;
+    FbxSceneIndex& operator=(const FbxSceneIndex&) = delete;
+    FbxSceneIndex(FbxSceneIndex&&) = default;
+    FbxSceneIndex& operator=(FbxSceneIndex&&) = default;
+
+    void Build(FbxScene* pScene);
+    void Clear();
+
+    size_t GetNodeCount() const { return m_nodes.size(); }
+    size_t GetMeshCount() const { return m_meshes.size(); }
+    size_t GetMaterialCount() const { return m_materials.size(); }
+
+    const FbxIndexedNode& GetNode(uint32_t index) const { return m_nodes[index]; }
+    const FbxIndexedObject& GetMesh(uint32_t index) const { return m_meshes[index]; }
+    const FbxIndexedObject& GetMaterial(uint32_t index) const { return m_materials[index]; }
+
+    /**
+     * @brief 按唯一Id查找稠密下标，不存在时返回npos
+     */
+    uint32_t FindNode(uint64_t id) const { return Find(m_nodeById, id); }
+    uint32_t FindMesh(uint64_t id) const { return Find(m_meshById, id); }
+    uint32_t FindMaterial(uint64_t id) const { return Find(m_materialById, id); }
+
+    FbxIndexRange FindNodesByName(std::string_view name) const { return m_nodesByName.Get(FindName(name)); }
+    FbxIndexRange FindMeshesByName(std::string_view name) const { return m_meshesByName.Get(FindName(name)); }
+    FbxIndexRange FindMaterialsByName(std::string_view name) const { return m_materialsByName.Get(FindName(name)); }
+    FbxIndexRange FindNodesByType(FbxNodeAttribute::EType type) const { return m_nodesByType.Get(static_cast<uint32_t>(type)); }
+
+    FbxIndexRange GetChildren(uint32_t node) const { return m_children.Get(node); }
+
+    /**
+     * @brief 节点的材质槽位，元素为材质的稠密下标，空槽为npos
+     */
+    FbxIndexRange GetNodeMaterials(uint32_t node) const { return m_nodeMaterials.Get(node); }
+
+    /**
+     * @brief 引用该Mesh的全部节点（实例）
+     */
+    FbxIndexRange GetMeshInstances(uint32_t mesh) const { return m_meshInstances.Get(mesh); }
+
+    /**
+     * @brief 使用该材质的Mesh / 节点，已去重
+     */
+    FbxIndexRange GetMaterialMeshes(uint32_t material) const { return m_materialMeshes.Get(material); }
+    FbxIndexRange GetMaterialNodes(uint32_t material) const { return m_materialNodes.Get(material); }
+
+private:
+    /**
+     * @brief 压缩行存储的一对多关系：Values[Offsets[k], Offsets[k + 1])属于键k
+     */
+    struct Buckets
+    {
+        std::vector<uint32_t> Offsets;
+        std::vector<uint32_t> Values;
+
+        /**
+         * @brief 由(键, 值)对按计数排序构建，同一键内保持原有顺序
+         */
+        void Build(size_t keyCount, const std::vector<std::pair<uint32_t, uint32_t>>& pairs);
+
+        FbxIndexRange Get(uint32_t key) const
+        {
+            if (static_cast<size_t>(key) + 1 >= Offsets.size())
+                return FbxIndexRange();
+            return { Values.data() + Offsets[key], Values.data() + Offsets[key + 1] };
+        }
+    };
+
+    static uint32_t Find(const std::unordered_map<uint64_t, uint32_t>& map, uint64_t id)
+    {
+        auto found = map.find(id);
+        return found != map.end() ? found->second : npos;
+    }
+
+    uint32_t Intern(const char* name);
+    uint32_t FindName(std::string_view name) const;
+
+    std::vector<FbxIndexedNode> m_nodes;
+    std::vector<FbxIndexedObject> m_meshes;
+    std::vector<FbxIndexedObject> m_materials;
+    std::unordered_map<uint64_t, uint32_t> m_nodeById;
+    std::unordered_map<uint64_t, uint32_t> m_meshById;
+    std::unordered_map<uint64_t, uint32_t> m_materialById;
+
+    // 驻留字符串：deque追加时不移动已有元素，键与Name直接引用其中的字符
+    std::deque<std::string> m_names;
+    std::unordered_map<std::string_view, uint32_t> m_nameIds;
+
+    Buckets m_nodesByName;
+    Buckets m_meshesByName;
+    Buckets m_materialsByName;
+    Buckets m_nodesByType;
+    Buckets m_children;
+    Buckets m_nodeMaterials;
+    Buckets m_meshInstances;
+    Buckets m_materialMeshes;
+    Buckets m_materialNodes;
+};
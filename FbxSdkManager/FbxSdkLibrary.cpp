@@ -1,5 +1,9 @@
 #include "FbxSdkLibrary.h"
 #include "FbxSdkException.h"
+#include <algorithm>
+#include <array>
+#include <set>
+#include <utility>
 
 using std::vector;
 using std::map;
@@ -20,7 +24,7 @@ void FbxSdkLibrary::InitializeSdkObjects(FbxManager*& pManager, FbxScene*& pScen
         FbxErrorHandler::LogError("Unable to create FBX Manager!");
         throw FbxSdkException(FbxSdkException::MANAGER_CREATE_FAILED, "Failed to create FbxManager instance");
     }
-    else FBXSDK_printf("Autodesk FBX SDK version %s\n", pManager->GetVersion());
+    else FBX_LOG_INFO("Autodesk FBX SDK version %s", pManager->GetVersion());
 
     //Create an IOSettings object. This object holds all import/export settings.
     FbxIOSettings* ios = FbxIOSettings::Create(pManager, IOSROOT);
@@ -44,19 +48,16 @@ void FbxSdkLibrary::DestroySdkObjects(FbxManager* pManager)
     if( pManager ) pManager->Destroy();
 }
 
-bool FbxSdkLibrary::LoadScene(FbxManager* pManager, FbxDocument* pScene, const char* pFilename)
+/**
+ * @brief LoadScene与LoadSceneFromStream共用的导入流程，负责销毁lImporter
+ */
+static bool ImportInitializedScene(FbxManager* pManager, FbxImporter* lImporter, bool lImportStatus, FbxDocument* pScene)
 {
     int lFileMajor, lFileMinor, lFileRevision;
     int lSDKMajor,  lSDKMinor,  lSDKRevision;
 
     // Get the file version number generate by the FBX SDK.
     FbxManager::GetFileFormatVersion(lSDKMajor, lSDKMinor, lSDKRevision);
-
-    // Create an importer.
-    FbxImporter* lImporter = FbxImporter::Create(pManager,"");
-
-    // Initialize the importer by providing a filename.
-    const bool lImportStatus = lImporter->Initialize(pFilename, -1, pManager->GetIOSettings());
     lImporter->GetFileVersion(lFileMajor, lFileMinor, lFileRevision);
 
     if( !lImportStatus )
@@ -80,7 +81,7 @@ bool FbxSdkLibrary::LoadScene(FbxManager* pManager, FbxDocument* pScene, const c
         return false;
     }
 
-    FBXSDK_printf("FBX file format version for this FBX SDK is %d.%d.%d\n", lSDKMajor, lSDKMinor, lSDKRevision);
+    FBX_LOG_INFO("FBX file format version for this FBX SDK is %d.%d.%d", lSDKMajor, lSDKMinor, lSDKRevision);
 
     if (lImporter->IsFBX())
     {
@@ -125,33 +126,30 @@ bool FbxSdkLibrary::LoadScene(FbxManager* pManager, FbxDocument* pScene, const c
 
 	if (!lStatus || (lImporter->GetStatus() != FbxStatus::eSuccess))
 	{
-		FBXSDK_printf("********************************************************************************\n");
+		// 读取成功但有错误时按警告输出，失败按错误输出；级别关闭时不收集错误历史
+		FbxLogLevel lLevel = lStatus ? FBX_LOG_LEVEL_WARNING : FBX_LOG_LEVEL_ERROR;
 		if (lStatus)
-		{
-			FBXSDK_printf("WARNING:\n");
-			FBXSDK_printf("   The importer was able to read the file but with errors.\n");
-			FBXSDK_printf("   Loaded scene may be incomplete.\n\n");
-		}
+			FBX_LOG_WARNING("The importer was able to read the file but with errors. Loaded scene may be incomplete.");
 		else
-		{
-			FBXSDK_printf("Importer failed to load the file!\n\n");
-		}
+			FBX_LOG_ERROR("Importer failed to load the file!");
 
-		if (lImporter->GetStatus() != FbxStatus::eSuccess)
-			FBXSDK_printf("   Last error message: %s\n", lImporter->GetStatus().GetErrorString());
-
-		FbxArray<FbxString*> history;
-		lImporter->GetStatus().GetErrorStringHistory(history);
-		if (history.GetCount() > 1)
+		if (FbxLogger::IsEnabled(lLevel))
 		{
-			FBXSDK_printf("   Error history stack:\n");
-			for (int i = 0; i < history.GetCount(); i++)
+			if (lImporter->GetStatus() != FbxStatus::eSuccess)
+				FBX_LOG(lLevel, "   Last error message: %s", lImporter->GetStatus().GetErrorString());
+
+			FbxArray<FbxString*> history;
+			lImporter->GetStatus().GetErrorStringHistory(history);
+			if (history.GetCount() > 1)
 			{
-				FBXSDK_printf("      %s\n", history[i]->Buffer());
+				FBX_LOG(lLevel, "   Error history stack:");
+				for (int i = 0; i < history.GetCount(); i++)
+				{
+					FBX_LOG(lLevel, "      %s", history[i]->Buffer());
+				}
 			}
+			FbxArrayDelete<FbxString*>(history);
 		}
-		FbxArrayDelete<FbxString*>(history);
-		FBXSDK_printf("********************************************************************************\n");
 	}
 
     // Destroy the importer.
@@ -160,6 +158,31 @@ bool FbxSdkLibrary::LoadScene(FbxManager* pManager, FbxDocument* pScene, const c
     return lStatus;
 }
 
+bool FbxSdkLibrary::LoadScene(FbxManager* pManager, FbxDocument* pScene, const char* pFilename)
+{
+    // Create an importer.
+    FbxImporter* lImporter = FbxImporter::Create(pManager,"");
+
+    // Initialize the importer by providing a filename.
+    const bool lImportStatus = lImporter->Initialize(pFilename, -1, pManager->GetIOSettings());
+    return ImportInitializedScene(pManager, lImporter, lImportStatus, pScene);
+}
+
+bool FbxSdkLibrary::LoadSceneFromStream(FbxManager* pManager, FbxDocument* pScene, FbxStream* pStream, void* pStreamData)
+{
+    if (!pStream)
+    {
+        FbxErrorHandler::LogError("FbxStream is null");
+        return false;
+    }
+
+    FbxImporter* lImporter = FbxImporter::Create(pManager,"");
+
+    // 读取器ID由流自身提供（GetReaderID），这里传-1
+    const bool lImportStatus = lImporter->Initialize(pStream, pStreamData, -1, pManager->GetIOSettings());
+    return ImportInitializedScene(pManager, lImporter, lImportStatus, pScene);
+}
+
 void FbxSdkLibrary::GetMetaData(FbxScene* pScene, map<const char*, const char*>& MetaData)
 {
 	FbxDocumentInfo* sceneInfo = pScene->GetSceneInfo();
@@ -174,7 +197,12 @@ void FbxSdkLibrary::GetMetaData(FbxScene* pScene, map<const char*, const char*>&
 	}
 }
 
-map<uint64_t, FbxGeometryInfo> FbxSdkLibrary::GetFbxGeometries(FbxScene* const pScene)
+map<uint64_t, FbxGeometryInfo> FbxSdkLibrary::GetFbxGeometries(FbxScene* const pScene, std::pmr::memory_resource* Resource)
+{
+	return GetFbxGeometries(pScene, FbxExtractionFilter(), FBX_ATTRIBUTE_ALL, Resource);
+}
+
+map<uint64_t, FbxGeometryInfo> FbxSdkLibrary::GetFbxGeometries(FbxScene* const pScene, const FbxExtractionFilter& Filter, uint32_t AttributeMask, std::pmr::memory_resource* Resource)
 {
 	map<uint64_t,FbxGeometryInfo> Geometries;
 	
@@ -184,9 +212,21 @@ map<uint64_t, FbxGeometryInfo> FbxSdkLibrary::GetFbxGeometries(FbxScene* const p
 		return Geometries;
 	}
 	//Geometry参数
-	FBXSDK_printf("FbxScene is right,BeginConverter\n");
+	FBX_LOG_DEBUG("FbxScene is right, BeginConverter");
 	//三角化 - 只创建一次转换器
 	FbxGeometryConverter converter(pScene->GetFbxManager());
+
+	if(!Filter.IsEmpty())
+	{
+		// 只对命中的节点引用的Mesh做三角化和属性收集
+		vector<FbxMesh*> Meshes;
+		CollectFilteredMeshes(pScene, Filter, Meshes);
+		for(FbxMesh* pMesh : Meshes)
+		{
+			ExtractMeshGeometry(pMesh, converter, AttributeMask, Resource, Geometries);
+		}
+		return Geometries;
+	}
 	
 	// 预先获取几何体数量
 	const int geometryCount = pScene->GetGeometryCount();
@@ -198,110 +238,421 @@ map<uint64_t, FbxGeometryInfo> FbxSdkLibrary::GetFbxGeometries(FbxScene* const p
 		if(!geometry || geometry->GetAttributeType() != FbxNodeAttribute::eMesh)
 			continue;
 			
-		FbxMesh* pMesh = static_cast<FbxMesh*>(geometry);
-		
-		// 如果不是三角网格，进行三角化
-		if(!pMesh->IsTriangleMesh())
+		ExtractMeshGeometry(static_cast<FbxMesh*>(geometry), converter, AttributeMask, Resource, Geometries);
+	}
+	
+	return Geometries;
+}
+
+FbxGeometryInfo FbxSdkLibrary::GetFbxGeometry(FbxMesh* pMesh, uint32_t AttributeMask, std::pmr::memory_resource* Resource)
+{
+	if(!pMesh)
+	{
+		FbxErrorHandler::LogError("FbxMesh is null");
+		return FbxGeometryInfo(Resource ? Resource : std::pmr::get_default_resource());
+	}
+
+	FbxGeometryConverter converter(pMesh->GetFbxManager());
+	map<uint64_t,FbxGeometryInfo> Geometries;
+	ExtractMeshGeometry(pMesh, converter, AttributeMask, Resource, Geometries);
+	return std::move(Geometries.begin()->second);
+}
+
+static void CollectNodeInfo(FbxNode* pNode, uint64_t ParentId, vector<FbxNodeInfo>& Nodes)
+{
+	FbxNodeInfo Info;
+	Info.ParentId = ParentId;
+	Info.Id = pNode->GetUniqueID();
+	Info.NodeName = pNode->GetName();
+	Info.LocalTransform = pNode->EvaluateLocalTransform();
+	Info.GeometricTransform = FbxAMatrix(pNode->GetGeometricTranslation(FbxNode::eSourcePivot),
+		pNode->GetGeometricRotation(FbxNode::eSourcePivot), pNode->GetGeometricScaling(FbxNode::eSourcePivot));
+	if(pNode->GetMesh())
+	{
+		Info.LinkMeshId = pNode->GetMesh()->GetUniqueID();
+	}
+	FbxSdkLibrary::GetMaterialIdTable(pNode, Info.LinkMaterialsId);
+	Nodes.push_back(std::move(Info));
+
+	for(int i = 0; i < pNode->GetChildCount(); ++i)
+	{
+		CollectNodeInfo(pNode->GetChild(i), pNode->GetUniqueID(), Nodes);
+	}
+}
+
+void FbxSdkLibrary::GetFbxNodes(FbxScene* pScene, vector<FbxNodeInfo>& Nodes)
+{
+	FbxNode* RootNode = pScene ? pScene->GetRootNode() : nullptr;
+	if(!RootNode)
+		return;
+
+	for(int i = 0; i < RootNode->GetChildCount(); ++i)
+	{
+		CollectNodeInfo(RootNode->GetChild(i), 0, Nodes);
+	}
+}
+
+/**
+ * @brief 判断节点自身是否满足过滤条件（各条件之间为“与”关系，未设置的条件视为满足）
+ */
+static bool IsNodeMatched(FbxNode* pNode, const FbxExtractionFilter& Filter)
+{
+	if(!Filter.NodeNamePatterns.empty())
+	{
+		bool NameMatched = false;
+		for(const std::string& Pattern : Filter.NodeNamePatterns)
 		{
-			FBXSDK_printf("Triangulating mesh %d\n", i);
-			// 三角化并替换原始网格
-			FbxMesh* triangulatedMesh = converter.TriangulateMesh(pMesh);
-			if(triangulatedMesh && triangulatedMesh != pMesh)
+			if(FbxSdkLibrary::MatchNamePattern(pNode->GetName(), Pattern.c_str()))
 			{
-				pMesh = triangulatedMesh;
+				NameMatched = true;
+				break;
 			}
 		}
-		
-		//Id用Scene获得的Id就不会错
-		const uint64_t ID = pMesh->GetUniqueID();
-		Geometries.insert(pair<uint64_t,FbxGeometryInfo>(ID,FbxGeometryInfo()));
-		FbxGeometryInfo& GeometryInfo = Geometries[ID];
-		
-		
-		int j,k, PolygonCount = pMesh->GetPolygonCount();
-		//ControlPoints
-		GetMeshControlPoint(pMesh,GeometryInfo.ControlPoints);
-	
-		FbxSection section;
-			//三角面信息 - 预分配内存以提高性能
-	vector<int> Triangle;
-	Triangle.reserve(3 * PolygonCount);
-	vector<FbxColor> Colors;
-	Colors.reserve(3 * PolygonCount);
-	vector<FbxVector2> UVs;
-	UVs.reserve(3 * PolygonCount);
+		if(!NameMatched)
+			return false;
+	}
+
+	const FbxNodeAttribute* Attribute = pNode->GetNodeAttribute();
+	if(!Filter.AttributeTypes.empty())
+	{
+		if(!Attribute || Filter.AttributeTypes.count(Attribute->GetAttributeType()) == 0)
+			return false;
+	}
+
+	if(!Filter.Ids.empty())
+	{
+		// 节点Id或其引用的Mesh Id均可
+		const bool IdMatched = Filter.Ids.count(pNode->GetUniqueID()) > 0
+			|| (pNode->GetMesh() && Filter.Ids.count(pNode->GetMesh()->GetUniqueID()) > 0);
+		if(!IdMatched)
+			return false;
+	}
+	return true;
+}
+
+static void CollectFilteredNode(FbxNode* pNode, const FbxExtractionFilter& Filter, bool Inherited, std::set<FbxMesh*>& Visited, vector<FbxMesh*>& Meshes)
+{
+	const bool Matched = Inherited || IsNodeMatched(pNode, Filter);
+	FbxMesh* pMesh = pNode->GetMesh();
+	if(Matched && pMesh && Visited.insert(pMesh).second)
+	{
+		Meshes.push_back(pMesh);
+	}
+
+	const bool ChildInherited = Matched && Filter.IncludeChildren;
+	for(int i = 0; i < pNode->GetChildCount(); ++i)
+	{
+		CollectFilteredNode(pNode->GetChild(i), Filter, ChildInherited, Visited, Meshes);
+	}
+}
+
+void FbxSdkLibrary::CollectFilteredMeshes(FbxScene* pScene, const FbxExtractionFilter& Filter, vector<FbxMesh*>& Meshes)
+{
+	FbxNode* RootNode = pScene ? pScene->GetRootNode() : nullptr;
+	if(!RootNode)
+		return;
+
+	// 同一Mesh被多个节点实例化时只提取一次
+	std::set<FbxMesh*> Visited;
+	for(int i = 0; i < RootNode->GetChildCount(); ++i)
+	{
+		CollectFilteredNode(RootNode->GetChild(i), Filter, false, Visited, Meshes);
+	}
+}
+
+bool FbxSdkLibrary::MatchNamePattern(const char* Name, const char* Pattern)
+{
+	if(!Name || !Pattern)
+		return false;
+
+	// 支持'*'与'?'的通配符匹配，回溯到最近一个'*'
+	const char* StarPattern = nullptr;
+	const char* StarName = nullptr;
+	while(*Name)
+	{
+		if(*Pattern == '*')
+		{
+			StarPattern = ++Pattern;
+			StarName = Name;
+		}
+		else if(*Pattern == '?' || *Pattern == *Name)
+		{
+			++Pattern;
+			++Name;
+		}
+		else if(StarPattern)
+		{
+			Pattern = StarPattern;
+			Name = ++StarName;
+		}
+		else
+		{
+			return false;
+		}
+	}
+	while(*Pattern == '*')
+		++Pattern;
+	return *Pattern == '\0';
+}
+
+/**
+ * @brief 单个Mesh的提取内核，Mask为FbxAttributeFlags的组合
+ * @param MaterialTable 节点材质槽位 -> 材质UniqueId，空槽为0
+ * @note 未选中的属性流在编译期被裁掉：既不分配也不收集，循环中也没有对应的分支
+ */
+template <uint32_t Mask>
+static void ExtractMeshKernel(FbxMesh* pMesh, const vector<uint64_t>& MaterialTable, std::pmr::memory_resource* Resource, FbxGeometryInfo& GeometryInfo)
+{
+	constexpr bool HasColor = (Mask & FBX_ATTRIBUTE_COLOR) != 0;
+	constexpr bool HasUV = (Mask & FBX_ATTRIBUTE_UV) != 0;
+	constexpr bool HasNormal = (Mask & FBX_ATTRIBUTE_NORMAL) != 0;
+	constexpr bool HasTangent = (Mask & FBX_ATTRIBUTE_TANGENT) != 0;
+	constexpr bool HasBinormal = (Mask & FBX_ATTRIBUTE_BINORMAL) != 0;
+	constexpr bool HasSmoothing = (Mask & FBX_ATTRIBUTE_SMOOTHING) != 0;
+
+	int j,k, PolygonCount = pMesh->GetPolygonCount();
+	const int CornerCount = pMesh->GetPolygonVertexCount();
+	const int* PolygonVertices = pMesh->GetPolygonVertices();
+	//ControlPoints
+	FbxSdkLibrary::GetMeshControlPoint(pMesh,GeometryInfo.ControlPoints);
+
+	//法线、切线、副法线按corner整体收集一次，缺失的层以默认值补齐
 	vector<FbxVector4> Normals;
-	Normals.reserve(3 * PolygonCount);
 	vector<FbxVector4> Tangents;
-	Tangents.reserve(3 * PolygonCount);
 	vector<FbxVector4> Binormals;
-	Binormals.reserve(3 * PolygonCount);
-	vector<uint64_t> MaterialIds;
-	MaterialIds.reserve(PolygonCount);
-		//获得Polygon的信息
-		for (j = 0;j<PolygonCount;++j)
+	if constexpr (HasNormal)
+	{
+		if(!FbxSdkLibrary::GetMeshNormals(pMesh, Normals))
+			Normals.assign(CornerCount, FbxVector4());
+	}
+	if constexpr (HasTangent)
+	{
+		if(!FbxSdkLibrary::GetMeshTangents(pMesh, Tangents))
+			Tangents.assign(CornerCount, FbxVector4());
+	}
+	if constexpr (HasBinormal)
+	{
+		if(!FbxSdkLibrary::GetMeshBinormals(pMesh, Binormals))
+			Binormals.assign(CornerCount, FbxVector4());
+	}
+	//平滑组没有合理的默认值，缺失时保持为空
+	vector<int> SmoothingGroups;
+	if constexpr (HasSmoothing)
+	{
+		FbxSdkLibrary::GetMeshSmoothingGroups(pMesh, SmoothingGroups);
+	}
+
+	//每套颜色/UV各整体收集一次，缺失或模式不支持的层以默认值补齐
+	vector<vector<FbxColor>> ColorLayers;
+	vector<vector<FbxVector2>> UVLayers;
+	if constexpr (HasColor)
+	{
+		ColorLayers.resize(pMesh->GetElementVertexColorCount());
+		for(int l = 0; l < (int)ColorLayers.size(); ++l)
 		{
-			int PolygonSize = pMesh->GetPolygonSize(j);
-			 for(k =0;k<PolygonSize;++k )
-			 {
-			 	//获得三角面信息,小于0则意味着没找到对应的点
-			 	int ControlPointIndex = pMesh->GetPolygonVertex(j, k);
-			 	if(ControlPointIndex >=0)
-			 	{
-			 		Triangle.push_back(ControlPointIndex);
-			 		Colors.push_back(GetPolygonVertexColor(pMesh,j,ControlPointIndex));
-			 		FbxVector2 uv;
-			 		GetPolygonUV(pMesh,j,ControlPointIndex,k,uv);
-			 		UVs.push_back(uv);
-			 	}
-			 }
-			 uint64_t MaterialId;
-			 FbxVector4 normal, tangent, binormal;
-			 GetPolygonNormal(pMesh,j,normal);
-			 GetPolygonTangent(pMesh,j,tangent);
-			 GetPolygonBinormal(pMesh,j,binormal);
-			 // 为每个顶点添加相同的法线、切线和副法线
-			 for(int v = 0; v < PolygonSize; ++v) {
-			 	Normals.push_back(normal);
-			 	Tangents.push_back(tangent);
-			 	Binormals.push_back(binormal);
-			 }
-			 GetPolygonMaterialId(pMesh,j,MaterialId);
-			 MaterialIds.push_back(MaterialId);
+			if(!FbxSdkLibrary::GetMeshColors(pMesh, ColorLayers[l], l))
+				ColorLayers[l].assign(CornerCount, FbxColor());
 		}
-		
-		//根据材质分组
-		map<uint64_t,FbxSection>* Sections = &GeometryInfo.Sections ;
-		int vertexIndex = 0;
-		for(int MatIndex = 0 ; MatIndex < (int)MaterialIds.size(); MatIndex++)
+	}
+	if constexpr (HasUV)
+	{
+		UVLayers.resize(pMesh->GetElementUVCount());
+		for(int l = 0; l < (int)UVLayers.size(); ++l)
+		{
+			if(!FbxSdkLibrary::GetMeshUVs(pMesh, UVLayers[l], l))
+				UVLayers[l].assign(CornerCount, FbxVector2());
+		}
+	}
+
+	//多边形的局部材质下标直接读材质层的索引数组，再经材质表映射到section
+	vector<int> PolygonMaterials;
+	FbxSdkLibrary::GetPolygonMaterialIndices(pMesh, PolygonMaterials);
+
+	//每个用到的材质槽位一个section，实例节点各自按MaterialSlot解析材质；先按出现顺序给槽位编号
+	const int SlotCount = (int)MaterialTable.size();
+	vector<int> SectionSlots;
+	vector<int> SlotSections(SlotCount, -1);
+	map<int,int> ExtraSlotSections;  // 超出首个实例材质数的槽位，只在实例材质数不同时出现
+	int NoMaterialSection = -1;
+	vector<int> PolygonSections(PolygonCount);
+	vector<size_t> SectionTriangles;
+	for(j = 0; j < PolygonCount; ++j)
+	{
+		const int Slot = PolygonMaterials[j];
+		int& Section = Slot < 0 ? NoMaterialSection : Slot < SlotCount ? SlotSections[Slot] : ExtraSlotSections.emplace(Slot, -1).first->second;
+		if(Section < 0)
+		{
+			Section = (int)SectionSlots.size();
+			SectionSlots.push_back(Slot);
+			SectionTriangles.push_back(0);
+		}
+		PolygonSections[j] = Section;
+		const int PolygonSize = pMesh->GetPolygonSize(j);
+		SectionTriangles[Section] += PolygonSize > 2 ? PolygonSize - 2 : 0;
+	}
+
+	//section键：按槽位从小到大分配，首个实例上的材质Id归最靠前的槽位，其余槽位使用槽位键
+	const size_t SectionCount = SectionSlots.size();
+	vector<uint64_t> SectionKeys(SectionCount, 0);
+	{
+		vector<int> BySlot(SectionCount);
+		for(size_t s = 0; s < SectionCount; ++s)
+			BySlot[s] = (int)s;
+		std::sort(BySlot.begin(), BySlot.end(), [&](int a, int b) { return SectionSlots[a] < SectionSlots[b]; });
+		std::set<uint64_t> UsedIds;
+		for(int s : BySlot)
+		{
+			const int Slot = SectionSlots[s];
+			if(Slot < 0)
+				continue;
+			const uint64_t Id = Slot < SlotCount ? MaterialTable[Slot] : 0;
+			SectionKeys[s] = Id != 0 && UsedIds.insert(Id).second ? Id : FbxSlotSectionKey(Slot);
+		}
+	}
+
+	//计数排序：前缀和得到每个section的偏移，再按多边形顺序稳定地分桶
+	vector<size_t> SectionOffsets(SectionCount + 1, 0);
+	for(j = 0; j < PolygonCount; ++j)
+		++SectionOffsets[PolygonSections[j] + 1];
+	for(size_t s = 0; s < SectionCount; ++s)
+		SectionOffsets[s + 1] += SectionOffsets[s];
+	vector<int> PolygonOrder(PolygonCount);
+	{
+		vector<size_t> Cursor(SectionOffsets.begin(), SectionOffsets.end() - 1);
+		for(j = 0; j < PolygonCount; ++j)
+			PolygonOrder[Cursor[PolygonSections[j]]++] = j;
+	}
+
+	//一次性预留，单调内存池下不会因扩容留下废弃块
+	map<uint64_t,FbxSection>& Sections = GeometryInfo.Sections;
+	for(size_t s = 0; s < SectionCount; ++s)
+	{
+		if(SectionTriangles[s] == 0)
+			continue;
+
+		FbxSection& Section = Sections.emplace(SectionKeys[s], FbxSection(Resource)).first->second;
+		Section.MaterialSlot = SectionSlots[s];
+		const size_t SectionCorners = 3 * SectionTriangles[s];
+		Section.Triangle.reserve(SectionCorners);
+		if constexpr (HasColor)
 		{
-			//如果当前材质没有记录先加入
-			if(Sections->count(MaterialIds[MatIndex]) == 0)
+			Section.ColorSets.reserve(ColorLayers.size());
+			for(int l = 0; l < (int)ColorLayers.size(); ++l)
 			{
-				Sections->insert(pair<uint64_t,FbxSection>(MaterialIds[MatIndex],FbxSection()));
+				FbxColorSet& Set = Section.ColorSets.emplace_back(Resource);
+				const char* Name = pMesh->GetElementVertexColor(l)->GetName();
+				Set.Name = Name ? Name : "";
+				Set.Colors.reserve(SectionCorners);
 			}
-		
-			FbxSection* Section = &(*Sections)[MaterialIds[MatIndex]];
-			// 每个多边形有3个顶点（已经三角化）
-			for(int l=0;l<3;++l)
+		}
+		if constexpr (HasUV)
+		{
+			Section.UVSets.reserve(UVLayers.size());
+			for(int l = 0; l < (int)UVLayers.size(); ++l)
 			{
-				if(vertexIndex < Triangle.size()) {
-					Section->Triangle.push_back(Triangle[vertexIndex]);
-					Section->Colors.push_back(Colors[vertexIndex]);
-					Section->UVs.push_back(UVs[vertexIndex]);
-					Section->Normals.push_back(Normals[vertexIndex]);
-					Section->Tangents.push_back(Tangents[vertexIndex]);
-					Section->Binormals.push_back(Binormals[vertexIndex]);
-					vertexIndex++;
+				FbxUVSet& Set = Section.UVSets.emplace_back(Resource);
+				const char* Name = pMesh->GetElementUV(l)->GetName();
+				Set.Name = Name ? Name : "";
+				Set.UVs.reserve(SectionCorners);
+			}
+		}
+		if constexpr (HasNormal) Section.Normals.reserve(SectionCorners);
+		if constexpr (HasTangent) Section.Tangents.reserve(SectionCorners);
+		if constexpr (HasBinormal) Section.Binormals.reserve(SectionCorners);
+		if constexpr (HasSmoothing)
+		{
+			if(!SmoothingGroups.empty())
+				Section.SmoothingGroups.reserve(SectionTriangles[s]);
+		}
+
+		//逐section顺序写入，每个section的各条流都是连续追加
+		for(size_t p = SectionOffsets[s]; p < SectionOffsets[s + 1]; ++p)
+		{
+			const int Polygon = PolygonOrder[p];
+			const int PolygonStart = pMesh->GetPolygonVertexIndex(Polygon);
+			const int PolygonSize = pMesh->GetPolygonSize(Polygon);
+			//已三角化时只有一个三角形；三角化失败时按扇形拆分
+			for(k = 1; k + 1 < PolygonSize; ++k)
+			{
+				const int TriangleCorners[3] = { PolygonStart, PolygonStart + k, PolygonStart + k + 1 };
+				//小于0则意味着没找到对应的点
+				if(PolygonVertices[TriangleCorners[0]] < 0 || PolygonVertices[TriangleCorners[1]] < 0 || PolygonVertices[TriangleCorners[2]] < 0)
+					continue;
+
+				if constexpr (HasSmoothing)
+				{
+					if(!SmoothingGroups.empty())
+						Section.SmoothingGroups.push_back(SmoothingGroups[PolygonStart]);
+				}
+				for(const int Corner : TriangleCorners)
+				{
+					Section.Triangle.push_back(PolygonVertices[Corner]);
+					if constexpr (HasColor)
+					{
+						for(size_t l = 0; l < ColorLayers.size(); ++l)
+							Section.ColorSets[l].Colors.push_back(ColorLayers[l][Corner]);
+					}
+					if constexpr (HasUV)
+					{
+						for(size_t l = 0; l < UVLayers.size(); ++l)
+							Section.UVSets[l].UVs.push_back(UVLayers[l][Corner]);
+					}
+					if constexpr (HasNormal) Section.Normals.push_back(Normals[Corner]);
+					if constexpr (HasTangent) Section.Tangents.push_back(Tangents[Corner]);
+					if constexpr (HasBinormal) Section.Binormals.push_back(Binormals[Corner]);
 				}
 			}
 		}
 	}
-	
-	return Geometries;
 }
 
-void FbxSdkLibrary::GetMeshControlPoint(const FbxMesh* pMesh,vector<FbxVector4>& ControlPoints)
+typedef void (*ExtractMeshKernelFn)(FbxMesh*, const vector<uint64_t>&, std::pmr::memory_resource*, FbxGeometryInfo&);
+
+template <size_t... Masks>
+static constexpr std::array<ExtractMeshKernelFn, sizeof...(Masks)> MakeExtractMeshKernelTable(std::index_sequence<Masks...>)
+{
+	return {{ &ExtractMeshKernel<static_cast<uint32_t>(Masks)>... }};
+}
+
+// 预实例化全部64种属性组合，运行时按掩码查表分派
+static constexpr std::array<ExtractMeshKernelFn, FBX_ATTRIBUTE_ALL + 1> s_extractMeshKernels =
+	MakeExtractMeshKernelTable(std::make_index_sequence<FBX_ATTRIBUTE_ALL + 1>());
+
+void FbxSdkLibrary::ExtractMeshGeometry(FbxMesh* pSourceMesh, FbxGeometryConverter& converter, uint32_t AttributeMask, std::pmr::memory_resource* Resource, map<uint64_t, FbxGeometryInfo>& Geometries)
+{
+	if(!Resource)
+		Resource = std::pmr::get_default_resource();
+
+	FbxMesh* pMesh = pSourceMesh;
+	FbxMesh* triangulatedMesh = nullptr;
+
+	// 如果不是三角网格，进行三角化
+	if(!pMesh->IsTriangleMesh())
+	{
+		FBX_LOG_DEBUG("Triangulating mesh %s", pSourceMesh->GetName());
+		// 三角化得到临时网格，提取完成后销毁
+		triangulatedMesh = converter.TriangulateMesh(pMesh);
+		if(triangulatedMesh && triangulatedMesh != pMesh)
+		{
+			pMesh = triangulatedMesh;
+		}
+	}
+
+	// 以源Mesh的Id为键，与FbxNodeInfo::LinkMeshId及过滤器中的Id保持一致
+	const uint64_t ID = pSourceMesh->GetUniqueID();
+	// 三角化得到的临时网格不挂在节点上，材质表从源Mesh的（第一个）实例节点解析
+	vector<uint64_t> MaterialTable;
+	GetMaterialIdTable(pSourceMesh->GetNode(), MaterialTable);
+	Geometries.insert(pair<uint64_t,FbxGeometryInfo>(ID,FbxGeometryInfo(Resource)));
+	s_extractMeshKernels[AttributeMask & FBX_ATTRIBUTE_ALL](pMesh, MaterialTable, Resource, Geometries[ID]);
+
+	if(triangulatedMesh && triangulatedMesh != pSourceMesh)
+	{
+		triangulatedMesh->Destroy();
+	}
+}
+
+void FbxSdkLibrary::GetMeshControlPoint(const FbxMesh* pMesh,std::pmr::vector<FbxVector4>& ControlPoints)
 {
 	if(pMesh)
 	{
@@ -316,256 +667,314 @@ void FbxSdkLibrary::GetMeshControlPoint(const FbxMesh* pMesh,vector<FbxVector4>&
 	}
 }
 
-FbxColor FbxSdkLibrary::GetPolygonVertexColor(FbxMesh* pMesh, int PolygonIndex, int ControlPointIndex)
+/**
+ * @brief 逐corner收集的内层循环，Mapped/Indirect在编译期确定，循环体内没有分支，便于编译器向量化
+ */
+template <bool Mapped, bool Indirect, typename TValue>
+static void GatherCorners(const int* SourceIndices, const int* Index, int IndexCount,
+                          const TValue* Direct, int DirectCount, TValue* Dest, int CornerCount)
 {
-	FbxColor Color;
-	for (int l = 0; l < pMesh->GetElementVertexColorCount(); l++)
+	for(int Corner = 0; Corner < CornerCount; ++Corner)
 	{
-		
-		FbxGeometryElementVertexColor* Vtxc = pMesh->GetElementVertexColor( l);
-		//判断当前定点对应的模式
-		switch (Vtxc->GetMappingMode())
-		{
-				
-		case FbxGeometryElement::eByControlPoint:
-			{
-				switch (Vtxc->GetReferenceMode())
-				{
-				case FbxGeometryElement::eDirect:
-					{
-						Color = Vtxc->GetDirectArray().GetAt(ControlPointIndex);
-						break;
-					}
-				case FbxGeometryElement::eIndexToDirect:
-					{
-						Color = Vtxc->GetDirectArray().GetAt(Vtxc->GetIndexArray().GetAt(ControlPointIndex));
-						break;
-					}
-				default:
-					break; // other reference modes not shown here!
-				}
-				break;
-			}
-		case FbxGeometryElement::eByPolygonVertex:
-			{
-				switch (Vtxc->GetReferenceMode())
-				{
-				case FbxGeometryElement::eDirect:
-					{
-						Color = Vtxc->GetDirectArray().GetAt(PolygonIndex);
-						break;
-					}
-				case FbxGeometryElement::eIndexToDirect:
-					{
-						const int id = Vtxc->GetIndexArray().GetAt(PolygonIndex);
-						Color = Vtxc->GetDirectArray().GetAt(id);
-						break;
-					}
-				default: break;
-				}
-			}
-			break;
-	
-		case FbxGeometryElement::eByPolygon: // doesn't make much sense for UVs
-		case FbxGeometryElement::eAllSame:   // doesn't make much sense for UVs
-		case FbxGeometryElement::eNone:       // doesn't make much sense for UVs
-			break;
-		}
-		
+		int Source = Mapped ? SourceIndices[Corner] : Corner;
+		if(Indirect)
+			Source = static_cast<unsigned>(Source) < static_cast<unsigned>(IndexCount) ? Index[Source] : -1;
+		Dest[Corner] = static_cast<unsigned>(Source) < static_cast<unsigned>(DirectCount) ? Direct[Source] : TValue();
 	}
-	return Color;
 }
 
-void FbxSdkLibrary::GetPolygonUV(FbxMesh* pMesh, int PolygonIndex, int ControlPointIndex, int PositionInPolygon,FbxVector2& UV)
+/**
+ * @brief 把几何元素层按多边形顶点（corner）展开为连续数组，支持全部映射模式与引用模式
+ * @return 元素层不存在或模式不支持时返回false
+ */
+template <typename TElement, typename TValue>
+static bool GatherElementByCorner(FbxMesh* pMesh, TElement* pElement, vector<TValue>& Out)
 {
-	for (int l = 0; l < pMesh->GetElementUVCount(); ++l)
-	{
-		FbxGeometryElementUV* ElUV = pMesh->GetElementUV( l);
-		
-		switch (ElUV->GetMappingMode())
-		{
-		default:
-			break;
-		case FbxGeometryElement::eByControlPoint:
-			switch (ElUV->GetReferenceMode())
-			{
-		case FbxGeometryElement::eDirect:
-				UV = ElUV->GetDirectArray().GetAt(ControlPointIndex);
-				break;
-		case FbxGeometryElement::eIndexToDirect:
-			{
-				int id = ElUV->GetIndexArray().GetAt(ControlPointIndex);
-				UV = ElUV->GetDirectArray().GetAt(id);
+	if(!pMesh || !pElement)
+		return false;
 
-			}
-				break;
-		default:
-			break; // other reference modes not shown here!
-			}
-			break;
+	const FbxGeometryElement::EReferenceMode ReferenceMode = pElement->GetReferenceMode();
+	if(ReferenceMode != FbxGeometryElement::eDirect && ReferenceMode != FbxGeometryElement::eIndexToDirect)
+		return false;
 
-		case FbxGeometryElement::eByPolygonVertex:
-			{
-				int TextureUVIndex = pMesh->GetTextureUVIndex(PolygonIndex, PositionInPolygon);
-				switch (ElUV->GetReferenceMode())
-				{
-				case FbxGeometryElement::eDirect:
-				case FbxGeometryElement::eIndexToDirect:
-					{
-						UV = ElUV->GetDirectArray().GetAt(TextureUVIndex);
-					}
-					break;
-				default:
-					break; // other reference modes not shown here!
-				}
-			}
-			break;
+	const int CornerCount = pMesh->GetPolygonVertexCount();
+	const int PolygonCount = pMesh->GetPolygonCount();
 
-		case FbxGeometryElement::eByPolygon: // doesn't make much sense for UVs
-		case FbxGeometryElement::eAllSame:   // doesn't make much sense for UVs
-		case FbxGeometryElement::eNone:       // doesn't make much sense for UVs
-			break;
+	// 每个corner在元素层中的源索引，nullptr表示源索引就是corner本身
+	const int* SourceIndices = nullptr;
+	vector<int> Expanded;
+	switch(pElement->GetMappingMode())
+	{
+	case FbxGeometryElement::eByPolygonVertex:
+		break;
+	case FbxGeometryElement::eByControlPoint:
+		SourceIndices = pMesh->GetPolygonVertices();
+		break;
+	case FbxGeometryElement::eByPolygon:
+		Expanded.resize(CornerCount);
+		for(int Polygon = 0; Polygon < PolygonCount; ++Polygon)
+		{
+			std::fill_n(Expanded.begin() + pMesh->GetPolygonVertexIndex(Polygon), pMesh->GetPolygonSize(Polygon), Polygon);
 		}
+		SourceIndices = Expanded.data();
+		break;
+	case FbxGeometryElement::eAllSame:
+		Expanded.assign(CornerCount, 0);
+		SourceIndices = Expanded.data();
+		break;
+	default:
+		return false;
 	}
+
+	auto& DirectArray = pElement->GetDirectArray();
+	auto& IndexArray = pElement->GetIndexArray();
+	const bool Indirect = ReferenceMode == FbxGeometryElement::eIndexToDirect;
+	const int DirectCount = DirectArray.GetCount();
+	const int IndexCount = Indirect ? IndexArray.GetCount() : 0;
+
+	// 锁定一次拿到连续存储，避免逐元素GetAt
+	TValue* Direct = DirectArray.GetLocked(FbxLayerElementArray::eReadLock);
+	int* Index = Indirect ? IndexArray.GetLocked(FbxLayerElementArray::eReadLock) : nullptr;
+	const bool Locked = Direct && (!Indirect || Index);
+	if(Locked)
+	{
+		Out.resize(CornerCount);
+		TValue* Dest = Out.data();
+		if(!SourceIndices && !Indirect && DirectCount >= CornerCount)
+			std::copy(Direct, Direct + CornerCount, Dest);
+		else if(!SourceIndices && !Indirect)
+			GatherCorners<false, false>(SourceIndices, Index, IndexCount, Direct, DirectCount, Dest, CornerCount);
+		else if(!SourceIndices)
+			GatherCorners<false, true>(SourceIndices, Index, IndexCount, Direct, DirectCount, Dest, CornerCount);
+		else if(!Indirect)
+			GatherCorners<true, false>(SourceIndices, Index, IndexCount, Direct, DirectCount, Dest, CornerCount);
+		else
+			GatherCorners<true, true>(SourceIndices, Index, IndexCount, Direct, DirectCount, Dest, CornerCount);
+	}
+
+	if(Index)
+		IndexArray.Release(&Index);
+	if(Direct)
+		DirectArray.Release(&Direct);
+	return Locked;
 }
 
-void FbxSdkLibrary::GetPolygonNormal(FbxMesh* pMesh, int PolygonIndex, FbxVector4& Normal)
+/**
+ * @brief 读取元素层在某个corner上的值（单点查询，批量请用GatherElementByCorner）
+ */
+template <typename TElement, typename TValue>
+static bool GetElementValueAtCorner(FbxMesh* pMesh, TElement* pElement, int PolygonIndex, int Corner, TValue& Value)
 {
-	for( int l = 0; l < pMesh->GetElementNormalCount(); ++l)
+	if(!pElement || PolygonIndex < 0 || PolygonIndex >= pMesh->GetPolygonCount())
+		return false;
+
+	int Source = -1;
+	switch(pElement->GetMappingMode())
 	{
-		FbxGeometryElementNormal* ENolrmal = pMesh->GetElementNormal( l);
-		
-		if(ENolrmal->GetMappingMode() == FbxGeometryElement::eByPolygonVertex)
-		{
-			switch (ENolrmal->GetReferenceMode())
-			{
-			case FbxGeometryElement::eDirect:
-				Normal = ENolrmal->GetDirectArray().GetAt(PolygonIndex*3);
-				break;
-			case FbxGeometryElement::eIndexToDirect:
-				{
-					int id = ENolrmal->GetIndexArray().GetAt(PolygonIndex*3);
-					Normal = ENolrmal->GetDirectArray().GetAt(id);
-					
-				}
-				break;
-			default:
-				break; // other reference modes not shown here!
-			}
-			// 移除危险的指针运算，这段代码原本试图设置连续的法线值，但实际上是错误的
-		}
+	case FbxGeometryElement::eByPolygonVertex: Source = Corner; break;
+	case FbxGeometryElement::eByControlPoint: Source = pMesh->GetPolygonVertices()[Corner]; break;
+	case FbxGeometryElement::eByPolygon: Source = PolygonIndex; break;
+	case FbxGeometryElement::eAllSame: Source = 0; break;
+	default: return false;
 	}
+
+	switch(pElement->GetReferenceMode())
+	{
+	case FbxGeometryElement::eDirect:
+		break;
+	case FbxGeometryElement::eIndexToDirect:
+		if(Source < 0 || Source >= pElement->GetIndexArray().GetCount())
+			return false;
+		Source = pElement->GetIndexArray().GetAt(Source);
+		break;
+	default:
+		return false;
+	}
+
+	if(Source < 0 || Source >= pElement->GetDirectArray().GetCount())
+		return false;
+	Value = pElement->GetDirectArray().GetAt(Source);
+	return true;
 }
 
-void FbxSdkLibrary::GetPolygonTangent(FbxMesh* pMesh, int PolygonIndex, FbxVector4& Tangent)
+FbxColor FbxSdkLibrary::GetPolygonVertexColor(FbxMesh* pMesh, int PolygonIndex, int ControlPointIndex, int LayerIndex)
 {
-	for( int l = 0; l < pMesh->GetElementTangentCount(); ++l)
+	FbxColor Color;
+	if(!pMesh || LayerIndex >= pMesh->GetElementVertexColorCount() || PolygonIndex < 0 || PolygonIndex >= pMesh->GetPolygonCount())
+		return Color;
+
+	//按控制点在多边形中的位置换算出corner
+	const int PolygonStart = pMesh->GetPolygonVertexIndex(PolygonIndex);
+	const int PolygonSize = pMesh->GetPolygonSize(PolygonIndex);
+	const int* PolygonVertices = pMesh->GetPolygonVertices();
+	for(int k = 0; k < PolygonSize; ++k)
 	{
-		FbxGeometryElementTangent* ElTangent = pMesh->GetElementTangent( l);
-				
-		if(ElTangent->GetMappingMode() == FbxGeometryElement::eByPolygonVertex)
+		if(PolygonVertices[PolygonStart + k] == ControlPointIndex)
 		{
-			switch (ElTangent->GetReferenceMode())
-			{
-			case FbxGeometryElement::eDirect:
-				Tangent = ElTangent->GetDirectArray().GetAt(PolygonIndex*3);
-				break;
-			case FbxGeometryElement::eIndexToDirect:
-				{
-					int id = ElTangent->GetIndexArray().GetAt(PolygonIndex*3);
-					Tangent = ElTangent->GetDirectArray().GetAt(id);
-				}
-				break;
-			default:
-				break; // other reference modes not shown here!
-			}
-			// 移除危险的指针运算
+			GetElementValueAtCorner(pMesh, pMesh->GetElementVertexColor(LayerIndex), PolygonIndex, PolygonStart + k, Color);
+			break;
 		}
 	}
+	return Color;
+}
+
+void FbxSdkLibrary::GetPolygonUV(FbxMesh* pMesh, int PolygonIndex, int /*ControlPointIndex*/, int PositionInPolygon,FbxVector2& UV, int LayerIndex)
+{
+	if(!pMesh || LayerIndex >= pMesh->GetElementUVCount() || PolygonIndex < 0 || PolygonIndex >= pMesh->GetPolygonCount())
+		return;
+	if(PositionInPolygon < 0 || PositionInPolygon >= pMesh->GetPolygonSize(PolygonIndex))
+		return;
+	GetElementValueAtCorner(pMesh, pMesh->GetElementUV(LayerIndex), PolygonIndex, pMesh->GetPolygonVertexIndex(PolygonIndex) + PositionInPolygon, UV);
+}
+
+bool FbxSdkLibrary::GetMeshUVs(FbxMesh* pMesh, vector<FbxVector2>& UVs, int LayerIndex)
+{
+	return pMesh && LayerIndex < pMesh->GetElementUVCount()
+		&& GatherElementByCorner(pMesh, pMesh->GetElementUV(LayerIndex), UVs);
+}
+
+bool FbxSdkLibrary::GetMeshColors(FbxMesh* pMesh, vector<FbxColor>& Colors, int LayerIndex)
+{
+	return pMesh && LayerIndex < pMesh->GetElementVertexColorCount()
+		&& GatherElementByCorner(pMesh, pMesh->GetElementVertexColor(LayerIndex), Colors);
+}
+
+bool FbxSdkLibrary::GetMeshNormals(FbxMesh* pMesh, vector<FbxVector4>& Normals, int LayerIndex)
+{
+	return pMesh && LayerIndex < pMesh->GetElementNormalCount()
+		&& GatherElementByCorner(pMesh, pMesh->GetElementNormal(LayerIndex), Normals);
+}
+
+bool FbxSdkLibrary::GetMeshTangents(FbxMesh* pMesh, vector<FbxVector4>& Tangents, int LayerIndex)
+{
+	return pMesh && LayerIndex < pMesh->GetElementTangentCount()
+		&& GatherElementByCorner(pMesh, pMesh->GetElementTangent(LayerIndex), Tangents);
+}
+
+bool FbxSdkLibrary::GetMeshBinormals(FbxMesh* pMesh, vector<FbxVector4>& Binormals, int LayerIndex)
+{
+	return pMesh && LayerIndex < pMesh->GetElementBinormalCount()
+		&& GatherElementByCorner(pMesh, pMesh->GetElementBinormal(LayerIndex), Binormals);
+}
+
+bool FbxSdkLibrary::GetShapeNormals(FbxMesh* pBaseMesh, FbxShape* pShape, vector<FbxVector4>& Normals, int LayerIndex)
+{
+	return pBaseMesh && pShape && LayerIndex < pShape->GetElementNormalCount()
+		&& GatherElementByCorner(pBaseMesh, pShape->GetElementNormal(LayerIndex), Normals);
+}
+
+bool FbxSdkLibrary::GetMeshSmoothingGroups(FbxMesh* pMesh, vector<int>& SmoothingGroups, int LayerIndex)
+{
+	return pMesh && LayerIndex < pMesh->GetElementSmoothingCount()
+		&& GatherElementByCorner(pMesh, pMesh->GetElementSmoothing(LayerIndex), SmoothingGroups);
+}
+
+void FbxSdkLibrary::GetPolygonNormal(FbxMesh* pMesh, int PolygonIndex, FbxVector4& Normal)
+{
+	// 原实现按PolygonIndex*3取值且只认eByPolygonVertex，这里改为多边形第一个corner并支持全部映射模式
+	if(pMesh->GetElementNormalCount() > 0)
+		GetElementValueAtCorner(pMesh, pMesh->GetElementNormal(0), PolygonIndex, pMesh->GetPolygonVertexIndex(PolygonIndex), Normal);
+}
+
+void FbxSdkLibrary::GetPolygonTangent(FbxMesh* pMesh, int PolygonIndex, FbxVector4& Tangent)
+{
+	if(pMesh->GetElementTangentCount() > 0)
+		GetElementValueAtCorner(pMesh, pMesh->GetElementTangent(0), PolygonIndex, pMesh->GetPolygonVertexIndex(PolygonIndex), Tangent);
 }
 
 void FbxSdkLibrary::GetPolygonBinormal(FbxMesh* pMesh, int PolygonIndex, FbxVector4& Binormal)
 {
-	for(int l = 0; l < pMesh->GetElementBinormalCount(); ++l)
+	if(pMesh->GetElementBinormalCount() > 0)
+		GetElementValueAtCorner(pMesh, pMesh->GetElementBinormal(0), PolygonIndex, pMesh->GetPolygonVertexIndex(PolygonIndex), Binormal);
+}
+
+void FbxSdkLibrary::GetMaterialIdTable(FbxNode* pNode, vector<uint64_t>& Ids)
+{
+	Ids.clear();
+	if(!pNode)
+		return;
+
+	Ids.resize(pNode->GetMaterialCount(), 0);
+	for(int i = 0; i < (int)Ids.size(); ++i)
 	{
-		FbxGeometryElementBinormal* ElBinormal = pMesh->GetElementBinormal( l);
-				
-		if(ElBinormal->GetMappingMode() == FbxGeometryElement::eByPolygonVertex)
-		{
-			switch (ElBinormal->GetReferenceMode())
-			{
-			case FbxGeometryElement::eDirect:
-				{
-					Binormal = ElBinormal->GetDirectArray().GetAt(PolygonIndex*3);
-				}
-				break;
-			case FbxGeometryElement::eIndexToDirect:
-				{
-					int id = ElBinormal->GetIndexArray().GetAt(PolygonIndex*3);
-					Binormal = ElBinormal->GetDirectArray().GetAt(id);
-				}
-				break;
-			default:
-				break; // other reference modes not shown here!
-			}
-			// 移除危险的指针运算
-		}
+		FbxSurfaceMaterial* Material = pNode->GetMaterial(i);
+		if(Material)
+			Ids[i] = Material->GetUniqueID();
 	}
 }
 
-void FbxSdkLibrary::GetPolygonMaterialId(FbxMesh* pMesh, int PolygonIndex, uint64_t& Id)
+bool FbxSdkLibrary::GetPolygonMaterialIndices(FbxMesh* pMesh, vector<int>& Indices)
 {
-	int l;
-	//check whether the material maps with only one mesh
-	bool lIsAllSame = true;
-	for ( l= 0; l < pMesh->GetElementMaterialCount(); l++)
+	Indices.clear();
+	if(!pMesh)
+		return false;
+
+	const int PolygonCount = pMesh->GetPolygonCount();
+	Indices.assign(PolygonCount, -1);
+	bool Found = false;
+	//与逐多边形查询一致：按材质层顺序，取第一个给出有效下标的层
+	for(int l = 0; l < pMesh->GetElementMaterialCount(); ++l)
 	{
+		FbxGeometryElementMaterial* MaterialElement = pMesh->GetElementMaterial(l);
+		if(!MaterialElement)
+			continue;
+		const FbxGeometryElement::EMappingMode MappingMode = MaterialElement->GetMappingMode();
+		if(MappingMode != FbxGeometryElement::eAllSame && MappingMode != FbxGeometryElement::eByPolygon)
+			continue;
 
-		FbxGeometryElementMaterial* lMaterialElement = pMesh->GetElementMaterial(l);
-		if( lMaterialElement->GetMappingMode() == FbxGeometryElement::eByPolygon) 
+		auto& IndexArray = MaterialElement->GetIndexArray();
+		const int IndexCount = IndexArray.GetCount();
+		if(IndexCount == 0)
+			continue;
+		int* Index = IndexArray.GetLocked(FbxLayerElementArray::eReadLock);
+		if(!Index)
+			continue;
+
+		Found = true;
+		if(MappingMode == FbxGeometryElement::eAllSame)
 		{
-			lIsAllSame = false;
-			break;
+			for(int Polygon = 0; Polygon < PolygonCount; ++Polygon)
+				Indices[Polygon] = Indices[Polygon] < 0 ? Index[0] : Indices[Polygon];
 		}
-	}
-	
-	//For eAllSame mapping type, just out the material and texture mapping info once
-	if(lIsAllSame)
-	{
-		for (l = 0; l < pMesh->GetElementMaterialCount(); l++)
+		else
 		{
-			FbxGeometryElementMaterial* MaterialElement = pMesh->GetElementMaterial( l);
-			if( MaterialElement->GetMappingMode() == FbxGeometryElement::eAllSame) 
-			{
-				FbxSurfaceMaterial* Material = pMesh->GetNode()->GetMaterial(MaterialElement->GetIndexArray().GetAt(0));
-				Id = Material->GetUniqueID();
-				break;
-			}
+			const int Count = std::min(IndexCount, PolygonCount);
+			for(int Polygon = 0; Polygon < Count; ++Polygon)
+				Indices[Polygon] = Indices[Polygon] < 0 ? Index[Polygon] : Indices[Polygon];
 		}
-		//没有材质
-		// if(l == 0)
-		// {
-		// 	Id = 0;
-		// }
+		IndexArray.Release(&Index);
 	}
-	//For eByPolygon mapping type, just out the material and texture mapping info once
-	else
+	return Found;
+}
+
+void FbxSdkLibrary::GetPolygonMaterialId(FbxMesh* pMesh, int PolygonIndex, uint64_t& Id)
+{
+	Id = 0;
+	FbxNode* pNode = pMesh ? pMesh->GetNode() : nullptr;
+	if(!pNode)
+		return;
+
+	for(int l = 0; l < pMesh->GetElementMaterialCount(); ++l)
 	{
-		for (l = 0; l < pMesh->GetElementMaterialCount(); l++)
+		FbxGeometryElementMaterial* MaterialElement = pMesh->GetElementMaterial(l);
+		if(!MaterialElement)
+			continue;
+
+		auto& IndexArray = MaterialElement->GetIndexArray();
+		int Index = -1;
+		if(MaterialElement->GetMappingMode() == FbxGeometryElement::eAllSame && IndexArray.GetCount() > 0)
+			Index = IndexArray.GetAt(0);
+		else if(MaterialElement->GetMappingMode() == FbxGeometryElement::eByPolygon && PolygonIndex < IndexArray.GetCount())
+			Index = IndexArray.GetAt(PolygonIndex);
+
+		if(Index >= 0)
 		{
-			int Index = -1;
-			FbxGeometryElementMaterial* MaterialElement = pMesh->GetElementMaterial( l);
-			Index = MaterialElement->GetIndexArray().GetAt(PolygonIndex);
-			if(Index >= 0)
-			{
-				FbxSurfaceMaterial* Material = pMesh->GetNode()->GetMaterial(Index);
-				Id =  Material->GetUniqueID();
-				break;
-			}
-			
+			FbxSurfaceMaterial* Material = Index < pNode->GetMaterialCount() ? pNode->GetMaterial(Index) : nullptr;
+			if(Material)
+				Id = Material->GetUniqueID();
+			return;
 		}
 	}
-
 }
 
 static const FbxImplementation* LookForImplementation(FbxSurfaceMaterial* pMaterial)
@@ -750,7 +1159,7 @@ void FbxSdkLibrary::GetFbxMaterials(FbxScene* pScene, map<uint64_t, FbxMaterials
 
 			// Display the Shininess
 			MFbxDouble1 =((FbxSurfacePhong *) Material)->Shininess;
-			MaterialInfo.Opacity.Factor = MFbxDouble1.Get();
+			MaterialInfo.Shininess.Factor = MFbxDouble1.Get();
             	
 			// Display the Reflectivity
 			MFbxDouble1 =((FbxSurfacePhong *) Material)->ReflectionFactor;
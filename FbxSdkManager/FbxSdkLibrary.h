@@ -1,6 +1,9 @@
 #pragma once
 #include <fbxsdk.h>
 #include <map>
+#include <memory_resource>
+#include <set>
+#include <string>
 #include <vector>
 
 #define DLLTEST_EXPORTS
@@ -27,19 +30,82 @@ struct FbxMaterialFactorProperty
  const char* Texture;  // 注意：这里存储的是指向FBX SDK内部字符串的指针
 };
 
+/**
+ * @brief 可选的顶点属性流，用于GetFbxGeometries的AttributeMask
+ */
+enum FbxAttributeFlags : uint32_t
+{
+ FBX_ATTRIBUTE_NONE = 0,
+ FBX_ATTRIBUTE_COLOR = 1u << 0,
+ FBX_ATTRIBUTE_UV = 1u << 1,
+ FBX_ATTRIBUTE_NORMAL = 1u << 2,
+ FBX_ATTRIBUTE_TANGENT = 1u << 3,
+ FBX_ATTRIBUTE_BINORMAL = 1u << 4,
+ FBX_ATTRIBUTE_SMOOTHING = 1u << 5,
+ FBX_ATTRIBUTE_ALL = FBX_ATTRIBUTE_COLOR | FBX_ATTRIBUTE_UV | FBX_ATTRIBUTE_NORMAL | FBX_ATTRIBUTE_TANGENT | FBX_ATTRIBUTE_BINORMAL
+  | FBX_ATTRIBUTE_SMOOTHING
+};
+
+/**
+ * @brief 一套UV，按corner与FbxSection::Triangle一一对应
+ */
+struct FbxUVSet
+{
+ FbxUVSet() = default;
+ explicit FbxUVSet(std::pmr::memory_resource* Resource) : UVs(Resource) {}
+
+ std::string Name;
+ std::pmr::vector<FbxVector2> UVs;
+};
+
+/**
+ * @brief 一套顶点颜色，按corner与FbxSection::Triangle一一对应
+ */
+struct FbxColorSet
+{
+ FbxColorSet() = default;
+ explicit FbxColorSet(std::pmr::memory_resource* Resource) : Colors(Resource) {}
+
+ std::string Name;
+ std::pmr::vector<FbxColor> Colors;
+};
+
+/**
+ * @note 容器使用std::pmr分配器，可由FbxArenaResource统一分配与回收
+ */
 struct FbxSection
 {
- std::vector<int> Triangle;
- std::vector<FbxColor> Colors;
- std::vector<FbxVector2> UVs;
- std::vector<FbxVector4> Normals;
- std::vector<FbxVector4> Tangents;
- std::vector<FbxVector4> Binormals;
+ FbxSection() = default;
+ explicit FbxSection(std::pmr::memory_resource* Resource)
+  : Triangle(Resource), ColorSets(Resource), UVSets(Resource), Normals(Resource), Tangents(Resource), Binormals(Resource),
+    SmoothingGroups(Resource) {}
+
+ std::pmr::vector<int> Triangle;
+ std::pmr::vector<FbxColorSet> ColorSets;  // 下标即Mesh中的颜色层序号
+ std::pmr::vector<FbxUVSet> UVSets;        // 下标即Mesh中的UV层序号，0为主UV
+ std::pmr::vector<FbxVector4> Normals;
+ std::pmr::vector<FbxVector4> Tangents;
+ std::pmr::vector<FbxVector4> Binormals;
+ std::pmr::vector<int> SmoothingGroups;  // 每个三角形一个平滑组掩码，Mesh没有平滑层时为空
+ int MaterialSlot = -1;  // 节点材质槽位，每个实例节点用自己的LinkMaterialsId[MaterialSlot]解析材质；没有材质时为-1
 };
 
+/**
+ * @brief 在首个实例节点上没有独占材质Id的槽位（与前面的槽位同一材质、空槽或超出该节点的材质数）所用的section键
+ */
+const uint64_t FBX_SLOT_SECTION_KEY_BASE = 0xffffffff00000000ull;
+
+inline uint64_t FbxSlotSectionKey(int Slot) { return FBX_SLOT_SECTION_KEY_BASE + static_cast<uint32_t>(Slot); }
+inline bool FbxIsSlotSectionKey(uint64_t Key) { return Key >= FBX_SLOT_SECTION_KEY_BASE; }
+
 struct FbxGeometryInfo
 {
- std::vector<FbxVector4> ControlPoints;
+ FbxGeometryInfo() = default;
+ explicit FbxGeometryInfo(std::pmr::memory_resource* Resource) : ControlPoints(Resource) {}
+
+ std::pmr::vector<FbxVector4> ControlPoints;
+ // 每个用到的材质槽位一个section：键为该槽位在首个实例节点上的材质Id，不唯一时为FbxSlotSectionKey(槽位)；
+ // 没有材质的多边形归入键为0的section
  std::map<uint64_t,FbxSection> Sections;
  
 };
@@ -57,14 +123,30 @@ struct FbxMaterialsInfo
 
 
 
+/**
+ * @brief 几何体提取过滤器，只对命中节点引用的Mesh做三角化与属性收集
+ * @note 已设置的条件之间为“与”关系；全部为空时不过滤
+ */
+struct FbxExtractionFilter
+{
+ std::vector<std::string> NodeNamePatterns;  // 节点名通配符（'*'、'?'），命中任意一个即可
+ std::set<uint64_t> Ids;  // 节点Id或Mesh Id
+ std::set<FbxNodeAttribute::EType> AttributeTypes;  // 节点属性类型，如eMesh、eLODGroup
+ bool IncludeChildren = true;  // 命中节点的整棵子树都参与提取
+
+ bool IsEmpty() const { return NodeNamePatterns.empty() && Ids.empty() && AttributeTypes.empty(); }
+};
+
 struct FbxNodeInfo
 {
- uint64_t ParentId = 0;
+ uint64_t ParentId = 0;  // 根节点的直接子节点为0
  uint64_t Id;
  const char* NodeName;
  uint64_t LinkMeshId = 0;
- std::vector<uint64_t> LinkMaterialsId;
+ std::vector<uint64_t> LinkMaterialsId;  // 下标即材质槽位，空槽为0
  std::vector<std::map<const char*,const char*>> Metadata;
+ FbxAMatrix LocalTransform;  // 默认时间的局部变换，不含几何变换（Geometric Transform）
+ FbxAMatrix GeometricTransform;  // 几何变换：只作用于本节点的几何体，不传给子节点
 };
 
 class DLL_API FbxSdkLibrary
@@ -79,47 +161,113 @@ public:
      */
     static void DestroySdkObjects(FbxManager* pManager);
     /**
-    * @brief 销毁FbxManager
+    * @brief 从文件导入场景
     */
     static bool LoadScene(FbxManager* pManager, FbxDocument* pScene, const char* pFilename);
     /**
+    * @brief 从自定义FbxStream导入场景（内存缓冲区、内存映射文件等）
+    * @param pStreamData 透传给FbxStream::Open的用户数据
+    */
+    static bool LoadSceneFromStream(FbxManager* pManager, FbxDocument* pScene, FbxStream* pStream, void* pStreamData = nullptr);
+    /**
     * @brief 获得Fbx文件的metadata
     */
     static void GetMetaData(FbxScene* pScene, std::map<const char*, const char*>& MetaData);
     /**
     * @brief 获得Scene里面的所有Geometry
     */
-    static std::map<uint64_t, FbxGeometryInfo> GetFbxGeometries(FbxScene* pScene);
+    static std::map<uint64_t, FbxGeometryInfo> GetFbxGeometries(FbxScene* pScene, std::pmr::memory_resource* Resource = nullptr);
+    /**
+    * @brief 只提取过滤器命中的Geometry，结果以源Mesh的Id为键
+    * @param AttributeMask FbxAttributeFlags组合，未选中的属性流不分配也不收集
+    * @param Resource 提取容器使用的内存资源，为空时使用std::pmr默认资源
+    */
+    static std::map<uint64_t, FbxGeometryInfo> GetFbxGeometries(FbxScene* pScene, const FbxExtractionFilter& Filter,
+        uint32_t AttributeMask = FBX_ATTRIBUTE_ALL, std::pmr::memory_resource* Resource = nullptr);
+    /**
+    * @brief 提取单个Mesh（必要时先三角化），用于逐Mesh的流式处理
+    */
+    static FbxGeometryInfo GetFbxGeometry(FbxMesh* pMesh, uint32_t AttributeMask = FBX_ATTRIBUTE_ALL, std::pmr::memory_resource* Resource = nullptr);
+    /**
+    * @brief 按先序遍历收集节点层级（不含场景根节点），父节点总在子节点之前
+    */
+    static void GetFbxNodes(FbxScene* pScene, std::vector<FbxNodeInfo>& Nodes);
+    /**
+    * @brief 收集过滤器命中的节点所引用的Mesh（去重，按场景遍历顺序）
+    */
+    static void CollectFilteredMeshes(FbxScene* pScene, const FbxExtractionFilter& Filter, std::vector<FbxMesh*>& Meshes);
+    /**
+    * @brief 通配符匹配，支持'*'与'?'
+    */
+    static bool MatchNamePattern(const char* Name, const char* Pattern);
     
     /**
     * @brief 获得Mesh的控制点
     */
-    static void GetMeshControlPoint(const FbxMesh* pMesh, std::vector<FbxVector4>& ControlPoints);
+    static void GetMeshControlPoint(const FbxMesh* pMesh, std::pmr::vector<FbxVector4>& ControlPoints);
    /**
-    * @brief 获得Mesh的顶点颜色信息
+    * @brief 获得Mesh的顶点颜色信息（单点查询，逐顶点数据请用GetMeshColors）
+    */
+    static FbxColor GetPolygonVertexColor(FbxMesh* pMesh, int PolygonIndex, int ControlPointIndex, int LayerIndex = 0);
+    /**
+    * @brief 获得Mesh的顶点的UV信息（单点查询，逐顶点数据请用GetMeshUVs）
     */
-    static FbxColor GetPolygonVertexColor(FbxMesh* pMesh, int PolygonIndex, int ControlPointIndex);
+    static void GetPolygonUV(FbxMesh* pMesh, int PolygonIndex, int ControlPointIndex, int PositionInPolygon, FbxVector2& UV, int LayerIndex = 0);
     /**
-    * @brief 获得Mesh的顶点的UV信息
+    * @brief 一次性按corner收集某一套UV
     */
-    static void GetPolygonUV(FbxMesh* pMesh, int PolygonIndex, int ControlPointIndex, int PositionInPolygon, FbxVector2& UV);
+    static bool GetMeshUVs(FbxMesh* pMesh, std::vector<FbxVector2>& UVs, int LayerIndex = 0);
     /**
-    * @brief 获得Mesh的法线信息
+    * @brief 一次性按corner收集某一套顶点颜色
+    */
+    static bool GetMeshColors(FbxMesh* pMesh, std::vector<FbxColor>& Colors, int LayerIndex = 0);
+    /**
+    * @brief 获得多边形第一个顶点的法线（逐顶点数据请用GetMeshNormals）
     */
     static void GetPolygonNormal(FbxMesh* pMesh, int PolygonIndex, FbxVector4& Normal);
     /**
-    * @brief 获得Mesh的顶点切线信息
+    * @brief 获得多边形第一个顶点的切线（逐顶点数据请用GetMeshTangents）
     */
     static void GetPolygonTangent(FbxMesh* pMesh, int PolygonIndex, FbxVector4& Tangent);
     /**
-    * @brief 获得Mesh的顶点Binormal信息
+    * @brief 获得多边形第一个顶点的Binormal（逐顶点数据请用GetMeshBinormals）
     */
     static void GetPolygonBinormal(FbxMesh* pMesh, int PolygonIndex, FbxVector4& Binormal);
+    /**
+    * @brief 一次性按多边形顶点（corner）收集整个Mesh的法线，顺序与GetPolygonVertices一致
+    * @return Mesh没有该层或模式不支持时返回false
+    */
+    static bool GetMeshNormals(FbxMesh* pMesh, std::vector<FbxVector4>& Normals, int LayerIndex = 0);
+    /**
+    * @brief 一次性按corner收集整个Mesh的切线
+    */
+    static bool GetMeshTangents(FbxMesh* pMesh, std::vector<FbxVector4>& Tangents, int LayerIndex = 0);
+    /**
+    * @brief 一次性按corner收集整个Mesh的Binormal
+    */
+    static bool GetMeshBinormals(FbxMesh* pMesh, std::vector<FbxVector4>& Binormals, int LayerIndex = 0);
+    /**
+    * @brief 按基础Mesh的多边形结构，一次性按corner收集形变目标（FbxShape）的法线
+    */
+    static bool GetShapeNormals(FbxMesh* pBaseMesh, FbxShape* pShape, std::vector<FbxVector4>& Normals, int LayerIndex = 0);
+    /**
+    * @brief 一次性按corner收集整个Mesh的平滑组（不支持eByEdge硬边模式）
+    */
+    static bool GetMeshSmoothingGroups(FbxMesh* pMesh, std::vector<int>& SmoothingGroups, int LayerIndex = 0);
 
     /**
-    * @brief 获得Polygon对应的材质ID
+    * @brief 获得Polygon对应的材质ID（单点查询，没有材质时为0；整个Mesh请用GetPolygonMaterialIndices + GetMaterialIdTable）
     */
     static void GetPolygonMaterialId(FbxMesh* pMesh, int PolygonIndex, uint64_t& Id);
+    /**
+    * @brief 节点的材质表：槽位 -> 材质UniqueId，空槽为0
+    */
+    static void GetMaterialIdTable(FbxNode* pNode, std::vector<uint64_t>& Ids);
+    /**
+    * @brief 直接从材质层的索引数组一次性读出每个多边形的材质槽位，没有材质的多边形为-1
+    * @return Mesh没有可用的材质层时返回false
+    */
+    static bool GetPolygonMaterialIndices(FbxMesh* pMesh, std::vector<int>& Indices);
     /**
      *@brief 获得场景材质信息
      */
@@ -130,6 +278,10 @@ public:
     static const char* test();
 
 private:
-
+    /**
+    * @brief 提取单个Mesh（必要时先三角化）并写入Geometries
+    */
+    static void ExtractMeshGeometry(FbxMesh* pSourceMesh, FbxGeometryConverter& converter, uint32_t AttributeMask,
+        std::pmr::memory_resource* Resource, std::map<uint64_t, FbxGeometryInfo>& Geometries);
 };
 
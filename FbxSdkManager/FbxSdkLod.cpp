@@ -0,0 +1,607 @@
+#include "FbxSdkLod.h"
+#include "FbxSdkParallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+    using SimplifiedMesh = FbxGeometryExporter::SimplifiedMesh;
+    using SimplifiedVertex = FbxGeometryExporter::SimplifiedVertex;
+
+    // 开放边约束平面相对三角形平面的权重
+    const double kBorderWeight = 10.0;
+
+    enum VertexKind : uint8_t
+    {
+        kManifold,
+        kBorder,
+        kSeam,
+        kLocked
+    };
+
+    struct Vec3
+    {
+        float x, y, z;
+    };
+
+    inline Vec3 Sub(const Vec3& a, const Vec3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    inline Vec3 Cross(const Vec3& a, const Vec3& b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+    inline float Dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    inline float Length(const Vec3& a) { return std::sqrt(Dot(a, a)); }
+
+    /**
+     * @brief 平面距离平方和的二次型，W为累计权重（面积），Evaluate返回加权平均的距离平方
+     */
+    struct Quadric
+    {
+        double A2 = 0, B2 = 0, C2 = 0, AB = 0, AC = 0, BC = 0, AD = 0, BD = 0, CD = 0, D2 = 0, W = 0;
+
+        void AddPlane(double a, double b, double c, double d, double weight)
+        {
+            A2 += a * a * weight; B2 += b * b * weight; C2 += c * c * weight;
+            AB += a * b * weight; AC += a * c * weight; BC += b * c * weight;
+            AD += a * d * weight; BD += b * d * weight; CD += c * d * weight;
+            D2 += d * d * weight;
+            W += weight;
+        }
+
+        void Add(const Quadric& q)
+        {
+            A2 += q.A2; B2 += q.B2; C2 += q.C2; AB += q.AB; AC += q.AC; BC += q.BC;
+            AD += q.AD; BD += q.BD; CD += q.CD; D2 += q.D2; W += q.W;
+        }
+
+        double Evaluate(const Vec3& p) const
+        {
+            const double x = p.x, y = p.y, z = p.z;
+            const double r = A2 * x * x + B2 * y * y + C2 * z * z
+                + 2.0 * (AB * x * y + AC * x * z + BC * y * z)
+                + 2.0 * (AD * x + BD * y + CD * z) + D2;
+            return std::fabs(r) / std::max(W, 1e-20);
+        }
+    };
+
+    inline uint64_t EdgeKey(uint32_t a, uint32_t b)
+    {
+        return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+    }
+
+    inline uint64_t DirectedKey(uint32_t a, uint32_t b)
+    {
+        return (static_cast<uint64_t>(a) << 32) | b;
+    }
+
+    struct PositionKey
+    {
+        float X, Y, Z;
+        bool operator==(const PositionKey& other) const { return X == other.X && Y == other.Y && Z == other.Z; }
+    };
+
+    struct PositionKeyHash
+    {
+        size_t operator()(const PositionKey& key) const
+        {
+            uint32_t bits[3];
+            memcpy(bits, &key, sizeof(bits));
+            return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+        }
+    };
+
+    struct VertexKeyHash
+    {
+        size_t operator()(const SimplifiedVertex& vertex) const
+        {
+            uint32_t bits[sizeof(SimplifiedVertex) / sizeof(uint32_t)];
+            memcpy(bits, &vertex, sizeof(bits));
+            size_t hash = 0;
+            for (uint32_t b : bits)
+                hash ^= b + 0x9e3779b9u + (hash << 6) + (hash >> 2);
+            return hash;
+        }
+    };
+
+    struct VertexKeyEqual
+    {
+        bool operator()(const SimplifiedVertex& a, const SimplifiedVertex& b) const
+        {
+            return memcmp(&a, &b, sizeof(SimplifiedVertex)) == 0;
+        }
+    };
+
+    struct Collapse
+    {
+        uint32_t From, To;
+        uint32_t SeamFrom, SeamTo;  // 接缝另一侧的折叠，非接缝时为UINT32_MAX
+        double Cost;
+    };
+
+    /**
+     * @brief 属性误差：折叠后被移除顶点的法线由保留顶点代替时的偏差
+     * @note UV在接缝内部是连续参数化，半边折叠不引入插值误差，UV不连续处由接缝约束处理
+     */
+    double AttributeDistance(const SimplifiedVertex& a, const SimplifiedVertex& b)
+    {
+        const double dot = a.normal[0] * b.normal[0] + a.normal[1] * b.normal[1] + a.normal[2] * b.normal[2];
+        return std::max(0.0, 1.0 - dot) * 0.5;
+    }
+
+    /**
+     * @brief 简化过程的状态：顶点按位置归并为rep，二次型与位置都挂在rep上
+     */
+    class Simplifier
+    {
+    public:
+        Simplifier(const SimplifiedMesh& Mesh, const FbxLodOptions& Options)
+            : m_mesh(Mesh), m_options(Options)
+        {
+        }
+
+        float Run(size_t TargetIndexCount, std::vector<uint32_t>& Indices);
+
+    private:
+        void BuildReps();
+        void BuildQuadrics(const std::vector<uint32_t>& Indices);
+        bool Pass(size_t TargetIndexCount, std::vector<uint32_t>& Indices, double& Error);
+        bool FlipsTriangle(uint32_t FromRep, uint32_t ToRep, const std::vector<uint32_t>& Indices,
+                           const std::vector<uint32_t>& Start, const std::vector<uint32_t>& Adjacency) const;
+
+        const SimplifiedMesh& m_mesh;
+        const FbxLodOptions& m_options;
+        std::vector<uint32_t> m_rep;      // 顶点 -> rep
+        std::vector<Vec3> m_repPosition;  // 归一化到单位对角线的位置
+        std::vector<Quadric> m_quadrics;  // 每个rep一个
+    };
+
+    void Simplifier::BuildReps()
+    {
+        const size_t vertexCount = m_mesh.vertices.size();
+        Vec3 lo = { 0, 0, 0 }, hi = { 0, 0, 0 };
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            const float* p = m_mesh.vertices[v].position;
+            if (v == 0)
+            {
+                lo = hi = { p[0], p[1], p[2] };
+                continue;
+            }
+            lo = { std::min(lo.x, p[0]), std::min(lo.y, p[1]), std::min(lo.z, p[2]) };
+            hi = { std::max(hi.x, p[0]), std::max(hi.y, p[1]), std::max(hi.z, p[2]) };
+        }
+        const float diagonal = Length(Sub(hi, lo));
+        const float scale = diagonal > 0.0f ? 1.0f / diagonal : 1.0f;
+
+        std::unordered_map<PositionKey, uint32_t, PositionKeyHash> reps;
+        reps.reserve(vertexCount);
+        m_rep.resize(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            const float* p = m_mesh.vertices[v].position;
+            auto inserted = reps.emplace(PositionKey{ p[0], p[1], p[2] }, static_cast<uint32_t>(m_repPosition.size()));
+            if (inserted.second)
+            {
+                m_repPosition.push_back({ (p[0] - lo.x) * scale, (p[1] - lo.y) * scale, (p[2] - lo.z) * scale });
+            }
+            m_rep[v] = inserted.first->second;
+        }
+        m_quadrics.assign(m_repPosition.size(), Quadric());
+    }
+
+    void Simplifier::BuildQuadrics(const std::vector<uint32_t>& Indices)
+    {
+        std::unordered_map<uint64_t, int> edgeCounts;
+        edgeCounts.reserve(Indices.size());
+        for (size_t i = 0; i + 2 < Indices.size(); i += 3)
+        {
+            for (int k = 0; k < 3; ++k)
+                ++edgeCounts[EdgeKey(m_rep[Indices[i + k]], m_rep[Indices[i + (k + 1) % 3]])];
+        }
+
+        for (size_t i = 0; i + 2 < Indices.size(); i += 3)
+        {
+            const uint32_t r[3] = { m_rep[Indices[i]], m_rep[Indices[i + 1]], m_rep[Indices[i + 2]] };
+            const Vec3& p0 = m_repPosition[r[0]];
+            Vec3 normal = Cross(Sub(m_repPosition[r[1]], p0), Sub(m_repPosition[r[2]], p0));
+            const float length = Length(normal);
+            if (length <= 0.0f)
+                continue;
+            normal = { normal.x / length, normal.y / length, normal.z / length };
+            const double area = length * 0.5;
+            for (int k = 0; k < 3; ++k)
+                m_quadrics[r[k]].AddPlane(normal.x, normal.y, normal.z, -Dot(normal, p0), area);
+
+            // 开放边加一个垂直于三角形的约束平面，保持边界形状
+            for (int k = 0; k < 3; ++k)
+            {
+                const uint32_t a = r[k], b = r[(k + 1) % 3];
+                if (edgeCounts[EdgeKey(a, b)] != 1)
+                    continue;
+                const Vec3 edge = Sub(m_repPosition[b], m_repPosition[a]);
+                Vec3 side = Cross(edge, normal);
+                const float sideLength = Length(side);
+                if (sideLength <= 0.0f)
+                    continue;
+                side = { side.x / sideLength, side.y / sideLength, side.z / sideLength };
+                const double d = -Dot(side, m_repPosition[a]);
+                const double weight = Dot(edge, edge) * kBorderWeight;
+                m_quadrics[a].AddPlane(side.x, side.y, side.z, d, weight);
+                m_quadrics[b].AddPlane(side.x, side.y, side.z, d, weight);
+            }
+        }
+    }
+
+    bool Simplifier::FlipsTriangle(uint32_t FromRep, uint32_t ToRep, const std::vector<uint32_t>& Indices,
+                                   const std::vector<uint32_t>& Start, const std::vector<uint32_t>& Adjacency) const
+    {
+        for (uint32_t i = Start[FromRep]; i < Start[FromRep + 1]; ++i)
+        {
+            const size_t t = Adjacency[i] * 3;
+            uint32_t r[3] = { m_rep[Indices[t]], m_rep[Indices[t + 1]], m_rep[Indices[t + 2]] };
+            if (r[0] == ToRep || r[1] == ToRep || r[2] == ToRep)
+                continue;  // 折叠后退化，会被删除
+
+            Vec3 p[3] = { m_repPosition[r[0]], m_repPosition[r[1]], m_repPosition[r[2]] };
+            const Vec3 before = Cross(Sub(p[1], p[0]), Sub(p[2], p[0]));
+            for (int k = 0; k < 3; ++k)
+            {
+                if (r[k] == FromRep)
+                    p[k] = m_repPosition[ToRep];
+            }
+            const Vec3 after = Cross(Sub(p[1], p[0]), Sub(p[2], p[0]));
+            const float beforeLength = Length(before), afterLength = Length(after);
+            if (beforeLength <= 0.0f)
+                continue;
+            // 翻转或退化为零面积都拒绝
+            if (afterLength <= beforeLength * 1e-6f || Dot(before, after) <= 0.0f)
+                return true;
+        }
+        return false;
+    }
+
+    bool Simplifier::Pass(size_t TargetIndexCount, std::vector<uint32_t>& Indices, double& Error)
+    {
+        const size_t vertexCount = m_mesh.vertices.size();
+        const size_t repCount = m_repPosition.size();
+        const size_t triangleCount = Indices.size() / 3;
+
+        // 本轮拓扑：每个rep上仍在使用的顶点（最多记录两个）
+        std::vector<uint8_t> aliveCount(repCount, 0);
+        std::vector<uint32_t> aliveVertex(repCount * 2, UINT32_MAX);
+        std::vector<uint8_t> used(vertexCount, 0);
+        for (uint32_t v : Indices)
+        {
+            if (used[v])
+                continue;
+            used[v] = 1;
+            const uint32_t r = m_rep[v];
+            if (aliveCount[r] < 2)
+                aliveVertex[r * 2 + aliveCount[r]] = v;
+            aliveCount[r] = static_cast<uint8_t>(std::min(aliveCount[r] + 1, 255));
+        }
+
+        std::unordered_map<uint64_t, int> edgeCounts;
+        std::unordered_set<uint64_t> directedEdges;
+        edgeCounts.reserve(Indices.size());
+        directedEdges.reserve(Indices.size());
+        for (size_t i = 0; i < Indices.size(); i += 3)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                const uint32_t a = Indices[i + k], b = Indices[i + (k + 1) % 3];
+                ++edgeCounts[EdgeKey(m_rep[a], m_rep[b])];
+                directedEdges.insert(DirectedKey(a, b));
+            }
+        }
+
+        std::vector<uint8_t> borderEdges(repCount, 0);
+        std::vector<uint8_t> nonManifold(repCount, 0);
+        for (const auto& edge : edgeCounts)
+        {
+            const uint32_t a = static_cast<uint32_t>(edge.first >> 32), b = static_cast<uint32_t>(edge.first);
+            if (edge.second == 1)
+            {
+                borderEdges[a] = static_cast<uint8_t>(std::min(borderEdges[a] + 1, 255));
+                borderEdges[b] = static_cast<uint8_t>(std::min(borderEdges[b] + 1, 255));
+            }
+            else if (edge.second > 2)
+            {
+                nonManifold[a] = nonManifold[b] = 1;
+            }
+        }
+
+        std::vector<uint8_t> kinds(vertexCount, kLocked);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            const uint32_t r = m_rep[v];
+            if (!used[v] || nonManifold[r])
+                continue;
+            if (aliveCount[r] == 1)
+            {
+                if (borderEdges[r] == 0)
+                    kinds[v] = kManifold;
+                else if (borderEdges[r] == 2 && !m_options.LockBorders)
+                    kinds[v] = kBorder;
+            }
+            else if (aliveCount[r] == 2 && borderEdges[r] == 0)
+            {
+                kinds[v] = kSeam;
+            }
+        }
+
+        // rep -> 三角形（CSR）
+        std::vector<uint32_t> start(repCount + 1, 0);
+        for (uint32_t v : Indices)
+            ++start[m_rep[v] + 1];
+        for (size_t r = 0; r < repCount; ++r)
+            start[r + 1] += start[r];
+        std::vector<uint32_t> fill(start.begin(), start.end() - 1);
+        std::vector<uint32_t> adjacency(Indices.size());
+        for (size_t i = 0; i < Indices.size(); ++i)
+            adjacency[fill[m_rep[Indices[i]]]++] = static_cast<uint32_t>(i / 3);
+
+        // 候选折叠
+        std::vector<Collapse> candidates;
+        candidates.reserve(Indices.size() * 2);
+        auto other = [&](uint32_t v)
+        {
+            const uint32_t r = m_rep[v];
+            return aliveVertex[r * 2] == v ? aliveVertex[r * 2 + 1] : aliveVertex[r * 2];
+        };
+        for (size_t i = 0; i < Indices.size(); i += 3)
+        {
+            for (int k = 0; k < 6; ++k)
+            {
+                const uint32_t from = Indices[i + k % 3];
+                const uint32_t to = Indices[i + (k < 3 ? (k + 1) % 3 : (k + 2) % 3)];
+                const uint32_t fromRep = m_rep[from], toRep = m_rep[to];
+                if (fromRep == toRep)
+                    continue;
+
+                Collapse collapse = { from, to, UINT32_MAX, UINT32_MAX, 0.0 };
+                switch (kinds[from])
+                {
+                case kManifold:
+                    break;
+                case kBorder:
+                    if ((kinds[to] != kBorder && kinds[to] != kLocked) || edgeCounts[EdgeKey(fromRep, toRep)] != 1)
+                        continue;
+                    break;
+                case kSeam:
+                {
+                    if (kinds[to] != kSeam)
+                        continue;
+                    const uint32_t seamFrom = other(from), seamTo = other(to);
+                    if (!directedEdges.count(DirectedKey(seamFrom, seamTo)) && !directedEdges.count(DirectedKey(seamTo, seamFrom)))
+                        continue;
+                    collapse.SeamFrom = seamFrom;
+                    collapse.SeamTo = seamTo;
+                    break;
+                }
+                default:
+                    continue;
+                }
+
+                collapse.Cost = m_quadrics[fromRep].Evaluate(m_repPosition[toRep])
+                    + m_options.AttributeWeight * AttributeDistance(m_mesh.vertices[from], m_mesh.vertices[to]);
+                if (collapse.SeamFrom != UINT32_MAX)
+                {
+                    collapse.Cost += m_options.AttributeWeight
+                        * AttributeDistance(m_mesh.vertices[collapse.SeamFrom], m_mesh.vertices[collapse.SeamTo]);
+                }
+                candidates.push_back(collapse);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const Collapse& a, const Collapse& b) { return a.Cost < b.Cost; });
+
+        // 选出互不相邻的折叠
+        const size_t targetTriangles = TargetIndexCount / 3;
+        const size_t trianglesToRemove = triangleCount > targetTriangles ? triangleCount - targetTriangles : 0;
+        const double maxCost = m_options.MaxError > 0.0f ? static_cast<double>(m_options.MaxError) * m_options.MaxError : -1.0;
+        std::vector<uint8_t> touched(repCount, 0);
+        std::vector<uint32_t> remap(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v)
+            remap[v] = static_cast<uint32_t>(v);
+
+        size_t removed = 0, applied = 0;
+        for (const Collapse& collapse : candidates)
+        {
+            if (removed >= trianglesToRemove)
+                break;
+            if (maxCost >= 0.0 && collapse.Cost > maxCost)
+                break;
+
+            const uint32_t fromRep = m_rep[collapse.From], toRep = m_rep[collapse.To];
+            if (touched[fromRep] || touched[toRep])
+                continue;
+            if (FlipsTriangle(fromRep, toRep, Indices, start, adjacency))
+                continue;
+
+            // 锁定被影响三角形的所有rep，保证同一轮内的翻转检查基于最新位置
+            for (uint32_t i = start[fromRep]; i < start[fromRep + 1]; ++i)
+            {
+                const size_t t = adjacency[i] * 3;
+                bool collapsesTriangle = false;
+                for (int k = 0; k < 3; ++k)
+                {
+                    touched[m_rep[Indices[t + k]]] = 1;
+                    collapsesTriangle = collapsesTriangle || m_rep[Indices[t + k]] == toRep;
+                }
+                removed += collapsesTriangle ? 1 : 0;
+            }
+            touched[toRep] = 1;
+
+            remap[collapse.From] = collapse.To;
+            if (collapse.SeamFrom != UINT32_MAX)
+                remap[collapse.SeamFrom] = collapse.SeamTo;
+            m_quadrics[toRep].Add(m_quadrics[fromRep]);
+            Error = std::max(Error, collapse.Cost);
+            ++applied;
+        }
+        if (applied == 0)
+        {
+            return false;
+        }
+
+        // 重建索引，丢弃退化三角形
+        size_t write = 0;
+        for (size_t i = 0; i < Indices.size(); i += 3)
+        {
+            const uint32_t a = remap[Indices[i]], b = remap[Indices[i + 1]], c = remap[Indices[i + 2]];
+            if (m_rep[a] == m_rep[b] || m_rep[b] == m_rep[c] || m_rep[a] == m_rep[c])
+                continue;
+            Indices[write++] = a;
+            Indices[write++] = b;
+            Indices[write++] = c;
+        }
+        Indices.resize(write);
+        return true;
+    }
+
+    float Simplifier::Run(size_t TargetIndexCount, std::vector<uint32_t>& Indices)
+    {
+        Indices.assign(m_mesh.indices.begin(), m_mesh.indices.end() - m_mesh.indices.size() % 3);
+        if (Indices.size() <= TargetIndexCount)
+        {
+            return 0.0f;
+        }
+
+        BuildReps();
+        BuildQuadrics(Indices);
+
+        double error = 0.0;
+        while (Indices.size() > TargetIndexCount && Pass(TargetIndexCount, Indices, error))
+        {
+        }
+        return static_cast<float>(std::sqrt(error));
+    }
+
+    void CollectMeshIds(FbxNode* pNode, std::vector<uint64_t>& Ids)
+    {
+        if (FbxMesh* mesh = pNode->GetMesh())
+            Ids.push_back(mesh->GetUniqueID());
+        for (int i = 0; i < pNode->GetChildCount(); ++i)
+            CollectMeshIds(pNode->GetChild(i), Ids);
+    }
+
+    void CollectLodGroups(FbxNode* pNode, std::vector<FbxLodGroupInfo>& Groups)
+    {
+        const FbxNodeAttribute* attribute = pNode->GetNodeAttribute();
+        if (attribute && attribute->GetAttributeType() == FbxNodeAttribute::eLODGroup)
+        {
+            // eLODGroup的每个直接子节点是一级LOD
+            FbxLodGroupInfo group;
+            group.NodeId = pNode->GetUniqueID();
+            group.Name = pNode->GetName() ? pNode->GetName() : "";
+            group.LevelMeshIds.resize(pNode->GetChildCount());
+            for (int i = 0; i < pNode->GetChildCount(); ++i)
+                CollectMeshIds(pNode->GetChild(i), group.LevelMeshIds[i]);
+            Groups.push_back(std::move(group));
+            return;
+        }
+        for (int i = 0; i < pNode->GetChildCount(); ++i)
+            CollectLodGroups(pNode->GetChild(i), Groups);
+    }
+}
+
+void FbxLodGenerator::WeldVertices(SimplifiedMesh& mesh)
+{
+    std::unordered_map<SimplifiedVertex, uint32_t, VertexKeyHash, VertexKeyEqual> unique;
+    unique.reserve(mesh.vertices.size());
+    std::vector<SimplifiedVertex> vertices;
+    vertices.reserve(mesh.vertices.size());
+    std::vector<uint32_t> remap(mesh.vertices.size());
+    for (size_t v = 0; v < mesh.vertices.size(); ++v)
+    {
+        auto inserted = unique.emplace(mesh.vertices[v], static_cast<uint32_t>(vertices.size()));
+        if (inserted.second)
+            vertices.push_back(mesh.vertices[v]);
+        remap[v] = inserted.first->second;
+    }
+    for (uint32_t& index : mesh.indices)
+    {
+        index = index < remap.size() ? remap[index] : 0;
+    }
+    mesh.vertices.swap(vertices);
+}
+
+float FbxLodGenerator::Simplify(const SimplifiedMesh& mesh, size_t targetIndexCount, const FbxLodOptions& options, std::vector<uint32_t>& indices)
+{
+    Simplifier simplifier(mesh, options);
+    return simplifier.Run(targetIndexCount, indices);
+}
+
+std::vector<FbxLodChain> FbxLodGenerator::GenerateLodChains(const std::vector<SimplifiedMesh>& meshes, const FbxLodOptions& options)
+{
+    std::vector<FbxLodChain> chains(meshes.size());
+    const size_t levelCount = static_cast<size_t>(std::max(0, options.LevelCount));
+
+    FbxParallelFor(meshes.size(), [&](size_t i)
+    {
+        chains[i].mesh = meshes[i];
+        WeldVertices(chains[i].mesh);
+        chains[i].levels.resize(levelCount);
+    }, options.ThreadCount);
+
+    // 每一级都从LOD0独立简化，网格与级别一起并行
+    FbxParallelFor(meshes.size() * levelCount, [&](size_t task)
+    {
+        FbxLodChain& chain = chains[task / levelCount];
+        const size_t level = task % levelCount;
+        FbxLodLevel& lod = chain.levels[level];
+        lod.targetRatio = std::pow(options.ReductionPerLevel, static_cast<float>(level + 1));
+        const size_t targetIndexCount = static_cast<size_t>(chain.mesh.indices.size() / 3 * lod.targetRatio) * 3;
+        lod.error = Simplify(chain.mesh, targetIndexCount, options, lod.indices);
+    }, options.ThreadCount);
+
+    return chains;
+}
+
+std::map<uint64_t, std::vector<FbxLodChain>> FbxLodGenerator::GenerateLodChains(FbxScene* pScene,
+                                                                               const std::map<uint64_t, FbxGeometryInfo>& geometries,
+                                                                               const FbxLodOptions& options)
+{
+    std::vector<FbxLodGroupInfo> groups;
+    CollectSourceLodGroups(pScene, groups);
+    std::set<uint64_t> sourceLodMeshes;
+    for (const FbxLodGroupInfo& group : groups)
+    {
+        for (const std::vector<uint64_t>& level : group.LevelMeshIds)
+            sourceLodMeshes.insert(level.begin(), level.end());
+    }
+
+    // 分成需要生成与只需焊接的两批，各自整体并行
+    std::vector<SimplifiedMesh> generated, welded;
+    std::vector<uint64_t> generatedIds, weldedIds;
+    for (const auto& geometry : geometries)
+    {
+        const bool hasSourceLods = sourceLodMeshes.count(geometry.first) != 0;
+        for (SimplifiedMesh& mesh : FbxGeometryExporter::ConvertToSimplifiedMeshes(geometry.second))
+        {
+            (hasSourceLods ? welded : generated).push_back(std::move(mesh));
+            (hasSourceLods ? weldedIds : generatedIds).push_back(geometry.first);
+        }
+    }
+
+    FbxLodOptions weldOnly = options;
+    weldOnly.LevelCount = 0;
+    std::vector<FbxLodChain> generatedChains = GenerateLodChains(generated, options);
+    std::vector<FbxLodChain> weldedChains = GenerateLodChains(welded, weldOnly);
+
+    std::map<uint64_t, std::vector<FbxLodChain>> result;
+    for (size_t i = 0; i < generatedChains.size(); ++i)
+        result[generatedIds[i]].push_back(std::move(generatedChains[i]));
+    for (size_t i = 0; i < weldedChains.size(); ++i)
+        result[weldedIds[i]].push_back(std::move(weldedChains[i]));
+    return result;
+}
+
+void FbxLodGenerator::CollectSourceLodGroups(FbxScene* pScene, std::vector<FbxLodGroupInfo>& groups)
+{
+    groups.clear();
+    if (pScene && pScene->GetRootNode())
+    {
+        CollectLodGroups(pScene->GetRootNode(), groups);
+    }
+}
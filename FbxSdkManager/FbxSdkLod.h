@@ -0,0 +1,80 @@
+#pragma once
+#include "FbxSdkWrapper.h"
+
+struct FbxLodOptions
+{
+    int LevelCount = 3;               // 除LOD0外生成的级数
+    float ReductionPerLevel = 0.5f;   // 每级三角形数相对上一级的比例
+    float MaxError = 0.0f;            // 允许的最大误差（相对包围盒对角线），0表示只受三角形数约束
+    float AttributeWeight = 0.5f;     // 法线偏差在误差中的权重
+    bool LockBorders = false;         // true时开放边与材质边界上的顶点完全不动
+    unsigned ThreadCount = 0;         // 0表示使用硬件并发数
+};
+
+struct FbxLodLevel
+{
+    std::vector<uint32_t> indices;    // 索引FbxLodChain::mesh.vertices
+    float targetRatio = 1.0f;         // 目标三角形比例
+    float error = 0.0f;               // 实际达到的误差（相对包围盒对角线）
+};
+
+/**
+ * @brief 一个SimplifiedMesh的LOD链：mesh为焊接后的LOD0，各级只保存索引，与LOD0共用顶点
+ */
+struct FbxLodChain
+{
+    FbxGeometryExporter::SimplifiedMesh mesh;
+    std::vector<FbxLodLevel> levels;
+};
+
+/**
+ * @brief 源文件中的eLODGroup节点，LevelMeshIds[i]为第i级子节点下的全部Mesh的Id
+ */
+struct FbxLodGroupInfo
+{
+    uint64_t NodeId = 0;
+    std::string Name;
+    std::vector<std::vector<uint64_t>> LevelMeshIds;
+};
+
+/**
+ * @brief 基于二次误差度量（QEM）的半边折叠简化与LOD链生成
+ * @note 开放边（含材质边界）上的顶点只能沿边界折叠，UV/法线接缝两侧的顶点只能成对沿接缝折叠，
+ *       其余非流形情况直接锁定；折叠前检查三角形翻转
+ */
+class FbxLodGenerator
+{
+public:
+    /**
+     * @brief 合并完全相同的顶点，生成索引缓冲
+     */
+    static void WeldVertices(FbxGeometryExporter::SimplifiedMesh& mesh);
+
+    /**
+     * @brief 简化到不超过targetIndexCount个索引（或达到误差上限）
+     * @param mesh 已焊接的网格
+     * @param indices 输出的索引
+     * @return 达到的误差（相对包围盒对角线）
+     */
+    static float Simplify(const FbxGeometryExporter::SimplifiedMesh& mesh, size_t targetIndexCount,
+                          const FbxLodOptions& options, std::vector<uint32_t>& indices);
+
+    /**
+     * @brief 为每个网格生成LOD链，网格与级别之间并行
+     */
+    static std::vector<FbxLodChain> GenerateLodChains(const std::vector<FbxGeometryExporter::SimplifiedMesh>& meshes,
+                                                      const FbxLodOptions& options = FbxLodOptions());
+
+    /**
+     * @brief 为GetFbxGeometries的结果生成LOD链，键为Mesh的Id
+     * @note 属于源文件eLODGroup的Mesh已经自带LOD，只焊接不生成
+     */
+    static std::map<uint64_t, std::vector<FbxLodChain>> GenerateLodChains(FbxScene* pScene,
+                                                                          const std::map<uint64_t, FbxGeometryInfo>& geometries,
+                                                                          const FbxLodOptions& options = FbxLodOptions());
+
+    /**
+     * @brief 收集场景中的eLODGroup节点
+     */
+    static void CollectSourceLodGroups(FbxScene* pScene, std::vector<FbxLodGroupInfo>& groups);
+};
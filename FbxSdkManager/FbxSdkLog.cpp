@@ -0,0 +1,258 @@
+#include "FbxSdkLog.h"
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+    constexpr size_t kCapacity = FbxLogger::kCapacity;
+    constexpr size_t kMask = kCapacity - 1;
+    static_assert((kCapacity & kMask) == 0, "FbxLogger::kCapacity must be a power of two");
+
+    /**
+     * @brief 环形队列的一个槽
+     * @note Sequence == 位置：空闲，可由该位置的写入方占用；Sequence == 位置 + 1：已发布，可由后台线程取出
+     */
+    struct LogSlot
+    {
+        std::atomic<size_t> Sequence;
+        FbxLogLevel Level;
+        uint32_t ThreadId;
+        int64_t Timestamp;     // 自1970年起的毫秒数
+        char Message[FbxLogger::kMessageSize];
+    };
+
+    std::atomic<uint32_t> g_threadCounter{ 0 };
+
+    uint32_t CurrentThreadId()
+    {
+        thread_local uint32_t id = g_threadCounter.fetch_add(1, std::memory_order_relaxed) + 1;
+        return id;
+    }
+
+    void ConsoleSink(FbxLogLevel level, int64_t timestamp, uint32_t threadId, const char* message)
+    {
+        static const char* const kTags[] = { "[TRACE] ", "[DEBUG] ", "[INFO]  ", "[WARN]  ", "[ERROR] " };
+
+        std::time_t t = static_cast<std::time_t>(timestamp / 1000);
+        std::tm tm = *std::localtime(&t);  // 只在持有输出端锁时调用
+        std::ostream& out = level >= FBX_LOG_LEVEL_WARNING ? std::cerr : std::cout;
+        out << kTags[level < FBX_LOG_LEVEL_OFF ? level : FBX_LOG_LEVEL_ERROR]
+            << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << '.' << std::setw(3) << std::setfill('0') << (timestamp % 1000)
+            << std::setfill(' ') << " [T" << threadId << "] - " << message << '\n';
+        if (level >= FBX_LOG_LEVEL_WARNING)
+            out.flush();
+    }
+
+    class LogState
+    {
+    public:
+        LogState()
+            : m_slots(new LogSlot[kCapacity])
+        {
+            for (size_t i = 0; i < kCapacity; ++i)
+                m_slots[i].Sequence.store(i, std::memory_order_relaxed);
+            m_worker = std::thread([this] { Run(); });
+        }
+
+        ~LogState()
+        {
+            m_stop.store(true, std::memory_order_release);
+            m_signal.fetch_add(1, std::memory_order_release);
+            m_signal.notify_one();
+            if (m_worker.joinable())
+                m_worker.join();
+        }
+
+        void Push(FbxLogLevel level, const char* format, va_list args)
+        {
+            size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+            LogSlot* slot;
+            for (;;)
+            {
+                slot = &m_slots[pos & kMask];
+                size_t sequence = slot->Sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+                if (diff == 0)
+                {
+                    if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    // 队列已满：Error及以上同步写出，其余丢弃，不等待后台线程
+                    if (level >= FBX_LOG_LEVEL_ERROR && std::this_thread::get_id() != m_worker.get_id())
+                        WriteDirect(level, format, args);
+                    else
+                        m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                else
+                {
+                    pos = m_enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            slot->Level = level;
+            slot->ThreadId = CurrentThreadId();
+            slot->Timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            int length = std::vsnprintf(slot->Message, sizeof(slot->Message), format, args);
+            if (length < 0)
+                slot->Message[0] = '\0';
+            slot->Sequence.store(pos + 1, std::memory_order_release);
+
+            m_signal.fetch_add(1, std::memory_order_release);
+            m_signal.notify_one();
+        }
+
+        void SetSink(FbxLogSink sink)
+        {
+            std::lock_guard<std::mutex> lock(m_sinkMutex);
+            m_sink = std::move(sink);
+        }
+
+        void Flush()
+        {
+            if (std::this_thread::get_id() == m_worker.get_id())
+                return;  // 输出端内部调用Flush会等待自己
+
+            size_t target = m_enqueuePos.load(std::memory_order_acquire);
+            size_t consumed = m_consumed.load(std::memory_order_acquire);
+            while (consumed < target)
+            {
+                m_consumed.wait(consumed, std::memory_order_acquire);
+                consumed = m_consumed.load(std::memory_order_acquire);
+            }
+        }
+
+        uint64_t GetDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    private:
+        /**
+         * @brief 在调用线程上先取出已发布的消息，再直接交给输出端，保持与队列中较早消息的先后顺序
+         */
+        void WriteDirect(FbxLogLevel level, const char* format, va_list args)
+        {
+            char message[FbxLogger::kMessageSize];
+            if (std::vsnprintf(message, sizeof(message), format, args) < 0)
+                message[0] = '\0';
+            const int64_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+
+            std::lock_guard<std::mutex> lock(m_sinkMutex);
+            DrainLocked();
+            Emit(level, timestamp, CurrentThreadId(), message);
+        }
+
+        void Run()
+        {
+            for (;;)
+            {
+                uint32_t signal = m_signal.load(std::memory_order_acquire);
+                Drain();
+                if (m_stop.load(std::memory_order_acquire))
+                {
+                    Drain();
+                    return;
+                }
+                m_signal.wait(signal, std::memory_order_acquire);
+            }
+        }
+
+        void Drain()
+        {
+            std::lock_guard<std::mutex> lock(m_sinkMutex);
+            DrainLocked();
+        }
+
+        void DrainLocked()
+        {
+            uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+            if (dropped != m_reportedDropped)
+            {
+                char message[64];
+                std::snprintf(message, sizeof(message), "%llu log message(s) dropped",
+                              static_cast<unsigned long long>(dropped - m_reportedDropped));
+                m_reportedDropped = dropped;
+                Emit(FBX_LOG_LEVEL_WARNING, std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count(), 0, message);
+            }
+
+            bool progressed = false;
+            for (;;)
+            {
+                LogSlot& slot = m_slots[m_dequeuePos & kMask];
+                if (slot.Sequence.load(std::memory_order_acquire) != m_dequeuePos + 1)
+                    break;  // 未发布（或写入方尚未完成格式化），等待下一次信号
+
+                Emit(slot.Level, slot.Timestamp, slot.ThreadId, slot.Message);
+                slot.Sequence.store(m_dequeuePos + kCapacity, std::memory_order_release);
+                ++m_dequeuePos;
+                m_consumed.store(m_dequeuePos, std::memory_order_release);
+                progressed = true;
+            }
+
+            if (progressed)
+            {
+                std::cout.flush();
+                m_consumed.notify_all();
+            }
+        }
+
+        void Emit(FbxLogLevel level, int64_t timestamp, uint32_t threadId, const char* message)
+        {
+            if (m_sink)
+                m_sink(level, timestamp, threadId, message);
+            else
+                ConsoleSink(level, timestamp, threadId, message);
+        }
+
+        std::unique_ptr<LogSlot[]> m_slots;
+        alignas(64) std::atomic<size_t> m_enqueuePos{ 0 };
+        alignas(64) std::atomic<size_t> m_consumed{ 0 };
+        std::atomic<uint32_t> m_signal{ 0 };
+        std::atomic<uint64_t> m_dropped{ 0 };
+        std::atomic<bool> m_stop{ false };
+        size_t m_dequeuePos = 0;          // 只在持有m_sinkMutex时访问
+        uint64_t m_reportedDropped = 0;
+        std::mutex m_sinkMutex;           // SetSink、后台线程与队列满时同步写出的Error之间竞争，其余写入方不加锁
+        FbxLogSink m_sink;
+        std::thread m_worker;
+    };
+
+    LogState& GetState()
+    {
+        static LogState state;
+        return state;
+    }
+}
+
+void FbxLogger::SetSink(FbxLogSink sink)
+{
+    GetState().SetSink(std::move(sink));
+}
+
+void FbxLogger::Write(FbxLogLevel level, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    GetState().Push(level, format, args);
+    va_end(args);
+}
+
+void FbxLogger::Flush()
+{
+    GetState().Flush();
+}
+
+uint64_t FbxLogger::GetDroppedCount()
+{
+    return GetState().GetDropped();
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+enum FbxLogLevel : int
+{
+    FBX_LOG_LEVEL_TRACE = 0,
+    FBX_LOG_LEVEL_DEBUG,
+    FBX_LOG_LEVEL_INFO,
+    FBX_LOG_LEVEL_WARNING,
+    FBX_LOG_LEVEL_ERROR,
+    FBX_LOG_LEVEL_OFF
+};
+
+/**
+ * @brief 编译期最低级别，低于它的FBX_LOG_*调用连同参数求值一起被编译器消除
+ * @note 例如发布版本以 -DFBX_LOG_COMPILE_LEVEL=2 只保留Info及以上
+ */
+#ifndef FBX_LOG_COMPILE_LEVEL
+#define FBX_LOG_COMPILE_LEVEL 0
+#endif
+
+/**
+ * @brief 日志输出端，在后台线程中按写入顺序调用
+ * @param threadId 写入线程的序号（从1开始按首次写日志的顺序分配）
+ */
+using FbxLogSink = std::function<void(FbxLogLevel level, int64_t timestamp, uint32_t threadId, const char* message)>;
+
+/**
+ * @brief 异步日志
+ * @note 写入方把格式化后的消息放入固定容量的无锁多生产者单消费者环形队列，不加锁、不分配内存；
+ *       后台线程在首次写入时启动，取出消息交给输出端。队列满时Error及以上的消息在写入线程上同步交给输出端
+ *       （先取出队列中已发布的消息，会与后台线程竞争输出端的锁），其余级别丢弃并计数，不阻塞写入方；
+ *       输出端内部在队列满时写入的Error仍会被丢弃，以免等待自己。
+ *       运行期级别为一个原子变量，FBX_LOG_*在级别关闭时只有一次relaxed读取，不格式化参数
+ */
+class FbxLogger
+{
+public:
+    static constexpr size_t kCapacity = 1024;     // 环形队列槽数，必须是2的幂（约540KB）
+    static constexpr size_t kMessageSize = 512;   // 单条消息上限（含结尾0），超出部分截断
+
+    static void SetLevel(FbxLogLevel level) { s_level.store(level, std::memory_order_relaxed); }
+    static FbxLogLevel GetLevel() { return static_cast<FbxLogLevel>(s_level.load(std::memory_order_relaxed)); }
+    static bool IsEnabled(FbxLogLevel level) { return level >= s_level.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 替换输出端，传空函数恢复默认的控制台输出（Warning及以上写stderr，其余写stdout）
+     * @note 已在队列中的消息由新的输出端处理
+     */
+    static void SetSink(FbxLogSink sink);
+
+    /**
+     * @brief printf风格写入一条日志，不检查级别（由FBX_LOG_*负责）
+     */
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((format(printf, 2, 3)))
+#endif
+    static void Write(FbxLogLevel level, const char* format, ...);
+
+    /**
+     * @brief 等待调用前写入的消息全部交给输出端
+     */
+    static void Flush();
+
+    /**
+     * @brief 因队列满被丢弃的消息总数（Error及以上只在输出端内部写入时计入）
+     */
+    static uint64_t GetDroppedCount();
+
+private:
+    static inline std::atomic<int> s_level{ FBX_LOG_LEVEL_INFO };
+};
+
+#define FBX_LOG(level, ...)                                                             \
+    do                                                                                  \
+    {                                                                                   \
+        if ((level) >= FBX_LOG_COMPILE_LEVEL && FbxLogger::IsEnabled(level))            \
+            FbxLogger::Write((level), __VA_ARGS__);                                     \
+    } while (0)
+
+#define FBX_LOG_TRACE(...)   FBX_LOG(FBX_LOG_LEVEL_TRACE, __VA_ARGS__)
+#define FBX_LOG_DEBUG(...)   FBX_LOG(FBX_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define FBX_LOG_INFO(...)    FBX_LOG(FBX_LOG_LEVEL_INFO, __VA_ARGS__)
+#define FBX_LOG_WARNING(...) FBX_LOG(FBX_LOG_LEVEL_WARNING, __VA_ARGS__)
+#define FBX_LOG_ERROR(...)   FBX_LOG(FBX_LOG_LEVEL_ERROR, __VA_ARGS__)
@@ -77,10 +77,7 @@ void PrintNode(FbxNode* pNode) {
                 GeometryInfo.ParentId = pNode->GetParent()->GetUniqueID();
             }
             GeometryInfo.LinkMeshId = pNode->GetMesh()->GetUniqueID();
-            for(int i = 0;i<pNode->GetMaterialCount();++i)
-            {
-                GeometryInfo.LinkMaterialsId.push_back(pNode->GetMaterial(i)->GetUniqueID());
-            }
+            FbxSdkLibrary::GetMaterialIdTable(pNode, GeometryInfo.LinkMaterialsId);
         }
     }
     NodeInfos.push_back(GeometryInfo);
@@ -0,0 +1,329 @@
+#include "FbxSdkMemory.h"
+#include "FbxSdkArena.h"
+#include "FbxSdkException.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    // 头部保持16字节，SDK拿到的指针与原分配函数的对齐一致
+    const size_t kHeaderSize = 16;
+
+    struct BlockHeader
+    {
+        size_t Size;
+        FbxMemoryAccount* Account;
+    };
+    static_assert(sizeof(BlockHeader) <= kHeaderSize, "BlockHeader must fit in the block prefix");
+
+    // map/set节点除值之外的开销（颜色、父/左/右指针），按常见实现估算
+    const uint64_t kTreeNodeOverhead = 32;
+
+    std::atomic<bool> s_installed{ false };
+    std::atomic<int64_t> s_liveBytes{ 0 };
+    FbxMallocProc s_malloc = nullptr;
+    FbxReallocProc s_realloc = nullptr;
+    FbxFreeProc s_free = nullptr;
+
+    thread_local FbxMemoryAccount* t_account = nullptr;
+
+    void* Track(void* base, size_t size)
+    {
+        if (!base)
+        {
+            return nullptr;
+        }
+        BlockHeader header = { size, t_account };
+        if (header.Account)
+        {
+            header.Account->OnAllocate(size);
+        }
+        s_liveBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+        memcpy(base, &header, sizeof(header));
+        return static_cast<char*>(base) + kHeaderSize;
+    }
+
+    void* TrackedMalloc(size_t size)
+    {
+        return Track(s_malloc(size + kHeaderSize), size);
+    }
+
+    void* TrackedCalloc(size_t count, size_t size)
+    {
+        if (size != 0 && count > (SIZE_MAX - kHeaderSize) / size)
+        {
+            return nullptr;
+        }
+        const size_t total = count * size;
+        void* p = TrackedMalloc(total);
+        if (p)
+        {
+            memset(p, 0, total);
+        }
+        return p;
+    }
+
+    void* TrackedRealloc(void* p, size_t size)
+    {
+        if (!p)
+        {
+            return TrackedMalloc(size);
+        }
+
+        char* base = static_cast<char*>(p) - kHeaderSize;
+        BlockHeader header;
+        memcpy(&header, base, sizeof(header));
+        char* grown = static_cast<char*>(s_realloc(base, size + kHeaderSize));
+        if (!grown)
+        {
+            return nullptr;
+        }
+
+        // 块仍属于原账户
+        if (header.Account)
+        {
+            header.Account->OnAllocate(size);
+            header.Account->OnFree(header.Size);
+        }
+        s_liveBytes.fetch_add(static_cast<int64_t>(size) - static_cast<int64_t>(header.Size), std::memory_order_relaxed);
+        header.Size = size;
+        memcpy(grown, &header, sizeof(header));
+        return grown + kHeaderSize;
+    }
+
+    void TrackedFree(void* p)
+    {
+        if (!p)
+        {
+            return;
+        }
+
+        char* base = static_cast<char*>(p) - kHeaderSize;
+        BlockHeader header;
+        memcpy(&header, base, sizeof(header));
+        s_liveBytes.fetch_sub(static_cast<int64_t>(header.Size), std::memory_order_relaxed);
+        if (header.Account)
+        {
+            header.Account->OnFree(header.Size);
+        }
+        s_free(base);
+    }
+
+    uint64_t StringBytes(const std::string& text)
+    {
+        static const size_t kInlineCapacity = std::string().capacity();
+        return text.capacity() > kInlineCapacity ? text.capacity() + 1 : 0;
+    }
+
+    template <typename T>
+    uint64_t VectorBytes(const std::pmr::vector<T>& values)
+    {
+        return static_cast<uint64_t>(values.capacity()) * sizeof(T);
+    }
+}
+
+FbxMemoryReport& FbxMemoryReport::operator+=(const FbxMemoryReport& other)
+{
+    SdkBytes += other.SdkBytes;
+    SdkPeakBytes += other.SdkPeakBytes;
+    ControlPointBytes += other.ControlPointBytes;
+    IndexBytes += other.IndexBytes;
+    NormalBytes += other.NormalBytes;
+    TangentBytes += other.TangentBytes;
+    BinormalBytes += other.BinormalBytes;
+    UVBytes += other.UVBytes;
+    ColorBytes += other.ColorBytes;
+    SmoothingBytes += other.SmoothingBytes;
+    MaterialBytes += other.MaterialBytes;
+    StringBytes += other.StringBytes;
+    ContainerBytes += other.ContainerBytes;
+    return *this;
+}
+
+FbxMemoryAccount* FbxMemoryAccount::Create()
+{
+    return new FbxMemoryAccount();
+}
+
+void FbxMemoryAccount::Release()
+{
+    Unreference();
+}
+
+uint64_t FbxMemoryAccount::GetLiveBytes() const
+{
+    int64_t bytes = m_bytes.load(std::memory_order_relaxed);
+    return bytes > 0 ? static_cast<uint64_t>(bytes) : 0;
+}
+
+uint64_t FbxMemoryAccount::GetPeakBytes() const
+{
+    return static_cast<uint64_t>(m_peak.load(std::memory_order_relaxed));
+}
+
+void FbxMemoryAccount::OnAllocate(size_t size)
+{
+    m_references.fetch_add(1, std::memory_order_relaxed);
+    int64_t bytes = m_bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + static_cast<int64_t>(size);
+    int64_t peak = m_peak.load(std::memory_order_relaxed);
+    while (bytes > peak && !m_peak.compare_exchange_weak(peak, bytes, std::memory_order_relaxed))
+    {
+    }
+}
+
+void FbxMemoryAccount::OnFree(size_t size)
+{
+    m_bytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+    Unreference();
+}
+
+void FbxMemoryAccount::Unreference()
+{
+    if (m_references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        delete this;
+    }
+}
+
+FbxMemoryAccountScope::FbxMemoryAccountScope(FbxMemoryAccount* account)
+    : m_previous(t_account)
+{
+    if (account)
+    {
+        t_account = account;
+    }
+}
+
+FbxMemoryAccountScope::~FbxMemoryAccountScope()
+{
+    t_account = m_previous;
+}
+
+bool FbxMemoryAccounting::Install()
+{
+    // 作用域结束时会把处理函数恢复为进入前的值，此时安装的钩子既会被移除，又会把分配转发给已失效的内存池
+    if (FbxSdkArenaScope::IsActive())
+    {
+        FbxErrorHandler::LogError("FbxMemoryAccounting::Install: cannot install while an FbxSdkArenaScope is active");
+        return false;
+    }
+
+    bool expected = false;
+    if (!s_installed.compare_exchange_strong(expected, true))
+    {
+        return false;
+    }
+
+    s_malloc = FbxGetMallocHandler();
+    s_realloc = FbxGetReallocHandler();
+    s_free = FbxGetFreeHandler();
+    FbxSetMallocHandler(TrackedMalloc);
+    FbxSetCallocHandler(TrackedCalloc);
+    FbxSetReallocHandler(TrackedRealloc);
+    FbxSetFreeHandler(TrackedFree);
+    return true;
+}
+
+bool FbxMemoryAccounting::IsInstalled()
+{
+    return s_installed.load(std::memory_order_acquire);
+}
+
+uint64_t FbxMemoryAccounting::GetSdkLiveBytes()
+{
+    int64_t bytes = s_liveBytes.load(std::memory_order_relaxed);
+    return bytes > 0 ? static_cast<uint64_t>(bytes) : 0;
+}
+
+void FbxMemoryAccounting::Measure(const FbxGeometryInfo& geometry, FbxMemoryReport& report)
+{
+    report.ControlPointBytes += VectorBytes(geometry.ControlPoints);
+    for (const auto& sectionPair : geometry.Sections)
+    {
+        const FbxSection& section = sectionPair.second;
+        report.ContainerBytes += sizeof(sectionPair) + kTreeNodeOverhead;
+        report.IndexBytes += VectorBytes(section.Triangle);
+        report.NormalBytes += VectorBytes(section.Normals);
+        report.TangentBytes += VectorBytes(section.Tangents);
+        report.BinormalBytes += VectorBytes(section.Binormals);
+        report.SmoothingBytes += VectorBytes(section.SmoothingGroups);
+
+        report.ContainerBytes += VectorBytes(section.UVSets) + VectorBytes(section.ColorSets);
+        for (const FbxUVSet& set : section.UVSets)
+        {
+            report.UVBytes += VectorBytes(set.UVs);
+            report.StringBytes += StringBytes(set.Name);
+        }
+        for (const FbxColorSet& set : section.ColorSets)
+        {
+            report.ColorBytes += VectorBytes(set.Colors);
+            report.StringBytes += StringBytes(set.Name);
+        }
+    }
+}
+
+void FbxMemoryAccounting::Measure(const std::map<uint64_t, FbxGeometryInfo>& geometries, FbxMemoryReport& report)
+{
+    for (const auto& geoPair : geometries)
+    {
+        report.ContainerBytes += sizeof(geoPair) + kTreeNodeOverhead;
+        Measure(geoPair.second, report);
+    }
+}
+
+void FbxMemoryAccounting::Measure(const std::map<uint64_t, FbxMaterialsInfo>& materials, FbxMemoryReport& report)
+{
+    // 贴图名指向SDK内部字符串，已计入SdkBytes
+    report.MaterialBytes += materials.size() * (sizeof(std::pair<const uint64_t, FbxMaterialsInfo>) + kTreeNodeOverhead);
+}
+
+FbxMemoryReport FbxMemoryAccounting::Estimate(const FbxProbeInfo& info, uint32_t attributeMask)
+{
+    FbxMemoryReport report;
+
+    const uint64_t polygonVertices = info.PolygonVertexCount;
+    const uint64_t triangles = info.TriangleCount ? info.TriangleCount : polygonVertices / 3;
+    const uint64_t corners = triangles * 3;
+    const uint64_t objects = static_cast<uint64_t>(info.ModelCount) + info.MeshCount + info.ShapeCount + info.MaterialCount +
+                             info.TextureCount + info.VideoCount + info.SkinCount + info.BlendShapeCount + info.AnimStackCount;
+
+    // SDK场景：控制点(FbxVector4) + 多边形顶点下标 + 多边形表 + 一层逐corner法线与一套带索引的UV + 每个对象的固定开销
+    report.SdkBytes = info.ControlPointCount * sizeof(FbxVector4) + polygonVertices * sizeof(int) + info.PolygonCount * 12 +
+                      polygonVertices * (sizeof(FbxVector4) + sizeof(FbxVector2) + sizeof(int)) + objects * 2048 +
+                      info.EmbeddedMediaBytes;
+    // 导入时文件内容（二进制FBX的数组还需解压）与场景同时存在
+    report.SdkPeakBytes = report.SdkBytes + info.FileSize * 2;
+
+    report.ControlPointBytes = info.ControlPointCount * sizeof(FbxVector4);
+    report.IndexBytes = corners * sizeof(int);
+    if (attributeMask & FBX_ATTRIBUTE_NORMAL)
+        report.NormalBytes = corners * sizeof(FbxVector4);
+    if (attributeMask & FBX_ATTRIBUTE_TANGENT)
+        report.TangentBytes = corners * sizeof(FbxVector4);
+    if (attributeMask & FBX_ATTRIBUTE_BINORMAL)
+        report.BinormalBytes = corners * sizeof(FbxVector4);
+    if (attributeMask & FBX_ATTRIBUTE_UV)
+        report.UVBytes = corners * sizeof(FbxVector2);
+    if (attributeMask & FBX_ATTRIBUTE_COLOR)
+        report.ColorBytes = corners * sizeof(FbxColor);
+    if (attributeMask & FBX_ATTRIBUTE_SMOOTHING)
+        report.SmoothingBytes = triangles * sizeof(int);
+    report.MaterialBytes = info.MaterialCount * (sizeof(std::pair<const uint64_t, FbxMaterialsInfo>) + kTreeNodeOverhead);
+    // 每个Mesh一个map节点，section数按每个Mesh至多全部材质、至少一个估算
+    const uint64_t sections = info.MeshCount * static_cast<uint64_t>(info.MaterialCount > 0 ? info.MaterialCount : 1);
+    report.ContainerBytes = info.MeshCount * (sizeof(std::pair<const uint64_t, FbxGeometryInfo>) + kTreeNodeOverhead) +
+                            std::min<uint64_t>(sections, info.MeshCount * 8ull) *
+                                (sizeof(std::pair<const uint64_t, FbxSection>) + kTreeNodeOverhead + sizeof(FbxUVSet) + sizeof(FbxColorSet));
+    return report;
+}
+
+bool FbxMemoryAccounting::Estimate(const std::string& filename, FbxMemoryReport& report, uint32_t attributeMask)
+{
+    FbxProbeInfo info;
+    if (!FbxSdkProbe::Probe(filename, info))
+    {
+        return false;
+    }
+    report = Estimate(info, attributeMask);
+    return true;
+}
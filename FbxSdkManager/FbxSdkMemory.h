@@ -0,0 +1,126 @@
+#pragma once
+#include "FbxSdkLibrary.h"
+#include "FbxSdkProbe.h"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief 按类别统计的内存占用（字节）
+ * @note 提取部分按容器容量统计，ContainerBytes为map节点、section与vector头等结构开销的估算
+ */
+struct FbxMemoryReport
+{
+    uint64_t SdkBytes = 0;          // SDK场景当前占用（分配钩子统计；启用内存池时为内存池已分配字节）
+    uint64_t SdkPeakBytes = 0;      // SDK场景的峰值，导入期间的临时缓冲也计入
+    uint64_t ControlPointBytes = 0;
+    uint64_t IndexBytes = 0;        // FbxSection::Triangle
+    uint64_t NormalBytes = 0;
+    uint64_t TangentBytes = 0;
+    uint64_t BinormalBytes = 0;
+    uint64_t UVBytes = 0;
+    uint64_t ColorBytes = 0;
+    uint64_t SmoothingBytes = 0;
+    uint64_t MaterialBytes = 0;
+    uint64_t StringBytes = 0;       // 超出短字符串优化的UV集/颜色集名
+    uint64_t ContainerBytes = 0;
+
+    uint64_t GetExtractionBytes() const
+    {
+        return ControlPointBytes + IndexBytes + NormalBytes + TangentBytes + BinormalBytes + UVBytes + ColorBytes +
+               SmoothingBytes + MaterialBytes + StringBytes + ContainerBytes;
+    }
+
+    /**
+     * @brief 峰值意义上的总量：SDK峰值 + 提取结果，供调度器按预算准入
+     */
+    uint64_t GetTotalBytes() const { return (SdkPeakBytes > SdkBytes ? SdkPeakBytes : SdkBytes) + GetExtractionBytes(); }
+
+    FbxMemoryReport& operator+=(const FbxMemoryReport& other);
+};
+
+/**
+ * @brief SDK分配的记账对象，由FbxSdkWrapper持有
+ * @note 每个块记录分配时所属的账户，在哪个线程释放都记回同一账户；账户按引用计数销毁：
+ *       所有者Release之后仍有未释放的块（如SDK的全局缓存）时，最后一个块释放时才销毁
+ */
+class FbxMemoryAccount
+{
+public:
+    static FbxMemoryAccount* Create();
+
+    /**
+     * @brief 所有者放弃账户
+     */
+    void Release();
+
+    uint64_t GetLiveBytes() const;
+    uint64_t GetPeakBytes() const;
+
+    void OnAllocate(size_t size);
+    void OnFree(size_t size);
+
+private:
+    FbxMemoryAccount() = default;
+    void Unreference();
+
+    std::atomic<int64_t> m_bytes{ 0 };
+    std::atomic<int64_t> m_peak{ 0 };
+    std::atomic<int64_t> m_references{ 1 };
+};
+
+struct FbxMemoryAccountDeleter
+{
+    void operator()(FbxMemoryAccount* account) const { account->Release(); }
+};
+
+/**
+ * @brief 作用域内当前线程的SDK分配记入account（为nullptr时保持外层账户）
+ */
+class FbxMemoryAccountScope
+{
+public:
+    explicit FbxMemoryAccountScope(FbxMemoryAccount* account);
+    ~FbxMemoryAccountScope();
+
+    FbxMemoryAccountScope(const FbxMemoryAccountScope&) = delete;
+    FbxMemoryAccountScope& operator=(const FbxMemoryAccountScope&) = delete;
+
+private:
+    FbxMemoryAccount* m_previous;
+};
+
+class FbxMemoryAccounting
+{
+public:
+    /**
+     * @brief 安装SDK分配钩子（每块多16字节头部记录大小与账户），之后创建的FbxSdkWrapper自动记账
+     * @note 必须在创建任何FbxManager之前调用，安装后不能卸载。与FbxSdkArenaScope可以共存，
+     *       内存池中的分配不经过钩子，由内存池自身统计；但必须先安装钩子再进入作用域：
+     *       作用域结束时会恢复它进入时保存的处理函数，在作用域内安装的钩子会被一并移除，
+     *       而钩子保存的又是内存池的处理函数
+     * @return 已经安装过，或当前有FbxSdkArenaScope生效（如以useArena创建的FbxSdkWrapper存活期间）时返回false
+     */
+    static bool Install();
+
+    static bool IsInstalled();
+
+    /**
+     * @brief 全进程经由钩子的SDK分配当前字节数
+     */
+    static uint64_t GetSdkLiveBytes();
+
+    /**
+     * @brief 累加提取结果的占用
+     */
+    static void Measure(const std::map<uint64_t, FbxGeometryInfo>& geometries, FbxMemoryReport& report);
+    static void Measure(const FbxGeometryInfo& geometry, FbxMemoryReport& report);
+    static void Measure(const std::map<uint64_t, FbxMaterialsInfo>& materials, FbxMemoryReport& report);
+
+    /**
+     * @brief 不导入场景，由探测结果估算加载与全量提取的占用
+     * @note SDK部分为峰值估算（含导入时的文件缓冲与内嵌媒体），UV与颜色按一套估算；系数为经验值，偏保守
+     */
+    static FbxMemoryReport Estimate(const FbxProbeInfo& info, uint32_t attributeMask = FBX_ATTRIBUTE_ALL);
+
+    static bool Estimate(const std::string& filename, FbxMemoryReport& report, uint32_t attributeMask = FBX_ATTRIBUTE_ALL);
+};
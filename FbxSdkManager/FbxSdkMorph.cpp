@@ -0,0 +1,237 @@
+#include "FbxSdkMorph.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    /**
+     * @brief 把按corner的法线平均到控制点上，结果每个控制点3个分量
+     */
+    void AverageByControlPoint(FbxMesh* pMesh, const std::vector<FbxVector4>& CornerNormals, std::vector<float>& Normals)
+    {
+        const int pointCount = pMesh->GetControlPointsCount();
+        const int cornerCount = std::min<int>(pMesh->GetPolygonVertexCount(), static_cast<int>(CornerNormals.size()));
+        const int* polygonVertices = pMesh->GetPolygonVertices();
+
+        Normals.assign(3 * static_cast<size_t>(pointCount), 0.0f);
+        std::vector<int> counts(pointCount, 0);
+        for (int c = 0; c < cornerCount; ++c)
+        {
+            const int cp = polygonVertices[c];
+            if (cp < 0 || cp >= pointCount)
+                continue;
+            for (int k = 0; k < 3; ++k)
+                Normals[3 * cp + k] += static_cast<float>(CornerNormals[c][k]);
+            ++counts[cp];
+        }
+        for (int cp = 0; cp < pointCount; ++cp)
+        {
+            const float inv = counts[cp] > 0 ? 1.0f / counts[cp] : 0.0f;
+            for (int k = 0; k < 3; ++k)
+                Normals[3 * cp + k] *= inv;
+        }
+    }
+
+    void AppendDelta(const float* Value, bool HalfPrecision, std::vector<float>& Floats, std::vector<uint16_t>& Halves)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            if (HalfPrecision)
+                Halves.push_back(FbxMorphExtractor::FloatToHalf(Value[k]));
+            else
+                Floats.push_back(Value[k]);
+        }
+    }
+
+    void ExtractTarget(FbxMesh* pMesh, FbxShape* pShape, const FbxGeometryInfo& Geometry, const std::vector<float>& BaseNormals,
+                       const FbxMorphOptions& Options, FbxMorphTarget& Target)
+    {
+        const int pointCount = pMesh->GetControlPointsCount();
+        const int shapePointCount = std::min(pointCount, pShape->GetControlPointsCount());
+        const FbxVector4* basePoints = pMesh->GetControlPoints();
+        const FbxVector4* shapePoints = pShape->GetControlPoints();
+
+        // 先在控制点上计算增量并标记非零项
+        std::vector<float> positionDeltas(3 * static_cast<size_t>(pointCount), 0.0f);
+        std::vector<float> normalDeltas;
+        std::vector<char> nonZero(pointCount, 0);
+        for (int cp = 0; basePoints && shapePoints && cp < shapePointCount; ++cp)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                const float delta = static_cast<float>(shapePoints[cp][k] - basePoints[cp][k]);
+                positionDeltas[3 * cp + k] = delta;
+                nonZero[cp] |= std::fabs(delta) > Options.Epsilon;
+            }
+        }
+
+        std::vector<FbxVector4> cornerNormals;
+        if (!BaseNormals.empty() && FbxSdkLibrary::GetShapeNormals(pMesh, pShape, cornerNormals))
+        {
+            AverageByControlPoint(pMesh, cornerNormals, normalDeltas);
+            for (size_t i = 0; i < normalDeltas.size(); ++i)
+            {
+                normalDeltas[i] -= BaseNormals[i];
+                nonZero[i / 3] |= std::fabs(normalDeltas[i]) > Options.Epsilon;
+            }
+        }
+
+        // 按section的corner顺序展开，只保留非零项
+        for (const auto& section : Geometry.Sections)
+        {
+            FbxMorphDeltas deltas;
+            const std::pmr::vector<int>& triangle = section.second.Triangle;
+            for (size_t i = 0; i < triangle.size(); ++i)
+            {
+                const int cp = triangle[i];
+                if (cp < 0 || cp >= pointCount || !nonZero[cp])
+                    continue;
+                deltas.Vertices.push_back(static_cast<uint32_t>(i));
+                AppendDelta(&positionDeltas[3 * cp], Options.HalfPrecision, deltas.Positions, deltas.PositionsHalf);
+                if (!normalDeltas.empty())
+                    AppendDelta(&normalDeltas[3 * cp], Options.HalfPrecision, deltas.Normals, deltas.NormalsHalf);
+            }
+            if (!deltas.Vertices.empty())
+            {
+                Target.Sections.emplace(section.first, std::move(deltas));
+            }
+        }
+    }
+}
+
+uint16_t FbxMorphExtractor::FloatToHalf(float Value)
+{
+    uint32_t bits;
+    memcpy(&bits, &Value, sizeof(bits));
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    const uint32_t exponent = (bits >> 23) & 0xffu;
+    uint32_t mantissa = bits & 0x7fffffu;
+
+    if (exponent == 0xffu)
+    {
+        // Inf / NaN
+        return static_cast<uint16_t>(sign | 0x7c00u | (mantissa ? 0x200u : 0u));
+    }
+
+    const int halfExponent = static_cast<int>(exponent) - 127 + 15;
+    if (halfExponent >= 0x1f)
+    {
+        return static_cast<uint16_t>(sign | 0x7c00u);
+    }
+    if (halfExponent <= 0)
+    {
+        // 非规格化数或下溢为0
+        if (halfExponent < -10)
+            return static_cast<uint16_t>(sign);
+        mantissa |= 0x800000u;
+        const int shift = 14 - halfExponent;
+        uint32_t half = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1u)))
+            ++half;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    // 就近舍入到偶数，进位可能溢出到指数位，结果仍然正确
+    uint32_t half = (static_cast<uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+    const uint32_t remainder = mantissa & 0x1fffu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+        ++half;
+    return static_cast<uint16_t>(sign | half);
+}
+
+float FbxMorphExtractor::HalfToFloat(uint16_t Value)
+{
+    const uint32_t sign = static_cast<uint32_t>(Value & 0x8000u) << 16;
+    const uint32_t exponent = (Value >> 10) & 0x1fu;
+    uint32_t mantissa = Value & 0x3ffu;
+    uint32_t bits;
+
+    if (exponent == 0)
+    {
+        if (mantissa == 0)
+        {
+            bits = sign;
+        }
+        else
+        {
+            // 非规格化数：规格化后再换算
+            int e = -1;
+            do
+            {
+                ++e;
+                mantissa <<= 1;
+            } while ((mantissa & 0x400u) == 0);
+            bits = sign | (static_cast<uint32_t>(127 - 15 - e) << 23) | ((mantissa & 0x3ffu) << 13);
+        }
+    }
+    else if (exponent == 0x1f)
+    {
+        bits = sign | 0x7f800000u | (mantissa << 13);
+    }
+    else
+    {
+        bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+void FbxMorphExtractor::Extract(FbxScene* pScene, const std::map<uint64_t, FbxGeometryInfo>& Geometries,
+                                const FbxMorphOptions& Options, std::map<uint64_t, std::vector<FbxMorphTarget>>& Targets)
+{
+    Targets.clear();
+    if (!pScene)
+    {
+        return;
+    }
+
+    for (int i = 0; i < pScene->GetGeometryCount(); ++i)
+    {
+        FbxGeometry* geometry = pScene->GetGeometry(i);
+        if (!geometry || geometry->GetAttributeType() != FbxNodeAttribute::eMesh)
+            continue;
+        FbxMesh* mesh = static_cast<FbxMesh*>(geometry);
+        auto extracted = Geometries.find(mesh->GetUniqueID());
+        if (extracted == Geometries.end() || mesh->GetDeformerCount(FbxDeformer::eBlendShape) == 0)
+            continue;
+
+        // 基础法线按控制点平均一次，所有目标共用
+        std::vector<float> baseNormals;
+        std::vector<FbxVector4> cornerNormals;
+        if (FbxSdkLibrary::GetMeshNormals(mesh, cornerNormals))
+        {
+            AverageByControlPoint(mesh, cornerNormals, baseNormals);
+        }
+
+        std::vector<FbxMorphTarget>& meshTargets = Targets[mesh->GetUniqueID()];
+        for (int d = 0; d < mesh->GetDeformerCount(FbxDeformer::eBlendShape); ++d)
+        {
+            FbxBlendShape* blendShape = static_cast<FbxBlendShape*>(mesh->GetDeformer(d, FbxDeformer::eBlendShape));
+            for (int c = 0; blendShape && c < blendShape->GetBlendShapeChannelCount(); ++c)
+            {
+                FbxBlendShapeChannel* channel = blendShape->GetBlendShapeChannel(c);
+                if (!channel)
+                    continue;
+                const double* fullWeights = channel->GetTargetShapeFullWeights();
+                for (int t = 0; t < channel->GetTargetShapeCount(); ++t)
+                {
+                    FbxShape* shape = channel->GetTargetShape(t);
+                    if (!shape)
+                        continue;
+
+                    FbxMorphTarget target;
+                    target.Name = shape->GetName() ? shape->GetName() : "";
+                    target.ChannelName = channel->GetName() ? channel->GetName() : "";
+                    target.FullWeight = fullWeights ? fullWeights[t] : 100.0;
+                    ExtractTarget(mesh, shape, extracted->second, baseNormals, Options, target);
+                    meshTargets.push_back(std::move(target));
+                }
+            }
+        }
+    }
+}
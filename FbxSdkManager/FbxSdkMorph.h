@@ -0,0 +1,52 @@
+#pragma once
+#include "FbxSdkLibrary.h"
+#include <cstdint>
+
+/**
+ * @brief 一个section内的稀疏形变增量，Vertices为section内的corner下标（与Triangle一一对应）
+ * @note 每个顶点3个分量；按FbxMorphOptions::HalfPrecision只填充float或half其中一组，
+ *       Mesh没有法线层时法线增量为空
+ */
+struct FbxMorphDeltas
+{
+    std::vector<uint32_t> Vertices;
+    std::vector<float> Positions;
+    std::vector<float> Normals;
+    std::vector<uint16_t> PositionsHalf;
+    std::vector<uint16_t> NormalsHalf;
+};
+
+/**
+ * @brief 一个形变目标（BlendShape通道的一个目标，含中间目标）
+ */
+struct FbxMorphTarget
+{
+    std::string Name;          // 目标形状名
+    std::string ChannelName;   // 所属BlendShape通道名
+    double FullWeight = 100.0; // 该目标完全生效时的通道权重（百分比）
+    std::map<uint64_t, FbxMorphDeltas> Sections;  // 键为材质Id，与FbxGeometryInfo::Sections一致
+};
+
+struct FbxMorphOptions
+{
+    float Epsilon = 1e-6f;       // 位置与法线增量的各分量都不超过该值时视为0并丢弃
+    bool HalfPrecision = false;  // true时增量以half存储
+};
+
+/**
+ * @brief 提取FbxBlendShape/FbxShape数据，按GetFbxGeometries的section顶点顺序输出稀疏增量
+ * @note 增量先在控制点上计算：法线增量取每个控制点所有corner的平均，硬边处分裂的法线会被平均
+ */
+class FbxMorphExtractor
+{
+public:
+    /**
+     * @param Geometries GetFbxGeometries的结果，用于重映射到section顶点顺序
+     * @param Targets 输出，键为Mesh的Id
+     */
+    static void Extract(FbxScene* pScene, const std::map<uint64_t, FbxGeometryInfo>& Geometries,
+                        const FbxMorphOptions& Options, std::map<uint64_t, std::vector<FbxMorphTarget>>& Targets);
+
+    static uint16_t FloatToHalf(float Value);
+    static float HalfToFloat(uint16_t Value);
+};
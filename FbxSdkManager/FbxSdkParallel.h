@@ -0,0 +1,81 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 简单的并行for：Count个任务由若干线程通过原子计数动态领取
+ * @param Count 任务数量
+ * @param Fn 任务函数，签名为void(size_t Index)
+ * @param ThreadCount 线程数，0表示使用硬件并发数
+ * @note 任务抛出的第一个异常会在所有线程结束后重新抛出
+ */
+template <typename F>
+void FbxParallelFor(size_t Count, F&& Fn, unsigned ThreadCount = 0)
+{
+    if (Count == 0)
+    {
+        return;
+    }
+
+    if (ThreadCount == 0)
+    {
+        ThreadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    ThreadCount = static_cast<unsigned>(std::min<size_t>(ThreadCount, Count));
+
+    if (ThreadCount == 1)
+    {
+        for (size_t i = 0; i < Count; ++i)
+        {
+            Fn(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto worker = [&]()
+    {
+        for (size_t i = next.fetch_add(1); i < Count; i = next.fetch_add(1))
+        {
+            try
+            {
+                Fn(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error)
+                {
+                    error = std::current_exception();
+                }
+                next.store(Count);
+            }
+        }
+    };
+
+    // 当前线程也参与计算
+    std::vector<std::thread> threads;
+    threads.reserve(ThreadCount - 1);
+    for (unsigned t = 1; t < ThreadCount; ++t)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
@@ -0,0 +1,248 @@
+#include "FbxSdkPipeline.h"
+#include "FbxSdkWrapper.h"
+#include "FbxSdkLod.h"
+#include "FbxSdkException.h"
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <thread>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double ElapsedMs(Clock::time_point begin, Clock::time_point end)
+    {
+        return std::chrono::duration<double, std::milli>(end - begin).count();
+    }
+
+    struct ExtractedItem
+    {
+        FbxGeometryInfo Geometry;
+    };
+
+    struct ConvertedItem
+    {
+        std::vector<FbxGeometryExporter::SimplifiedMesh> Meshes;
+    };
+
+    struct EncodedItem
+    {
+        std::vector<uint8_t> Bytes;    // 一个几何体的完整记录
+    };
+
+    template <typename T>
+    void Append(std::vector<uint8_t>& bytes, const T& value)
+    {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+        bytes.insert(bytes.end(), p, p + sizeof(T));
+    }
+
+    void Append(std::vector<uint8_t>& bytes, const void* data, size_t size)
+    {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        bytes.insert(bytes.end(), p, p + size);
+    }
+
+    void Encode(std::vector<FbxGeometryExporter::SimplifiedMesh>& meshes, const FbxPipelineOptions& options, std::vector<uint8_t>& bytes)
+    {
+        Append(bytes, static_cast<uint32_t>(meshes.size()));
+        for (auto& mesh : meshes)
+        {
+            if (options.Compress)
+            {
+                FbxLodGenerator::WeldVertices(mesh);
+                std::vector<uint8_t> encoded = FbxMeshCodec::Encode(mesh, options.Compression);
+                Append(bytes, static_cast<uint32_t>(encoded.size()));
+                Append(bytes, encoded.data(), encoded.size());
+            }
+            else
+            {
+                Append(bytes, static_cast<uint32_t>(mesh.vertices.size()));
+                Append(bytes, mesh.vertices.data(), mesh.vertices.size() * sizeof(FbxGeometryExporter::SimplifiedVertex));
+                Append(bytes, static_cast<uint32_t>(mesh.indices.size()));
+                Append(bytes, mesh.indices.data(), mesh.indices.size() * sizeof(uint32_t));
+                Append(bytes, mesh.materialId);
+            }
+        }
+    }
+
+    /**
+     * @brief 阶段线程的主循环：取输入、处理、放入输出，并分别计时
+     * @param process 返回false表示出错，流水线随之中止
+     */
+    template <typename In, typename Out, typename F>
+    void RunStage(FbxBoundedQueue<In>& input, FbxBoundedQueue<Out>* output, FbxPipelineStageStats& stats, F&& process,
+                  std::atomic<bool>& failed)
+    {
+        try
+        {
+            In item;
+            Out result;
+            for (;;)
+            {
+                Clock::time_point waitBegin = Clock::now();
+                bool popped = input.Pop(item);
+                Clock::time_point busyBegin = Clock::now();
+                stats.StarvedMs += ElapsedMs(waitBegin, busyBegin);
+                if (!popped)
+                    break;
+
+                bool success = process(item, result);
+                item = In();
+                Clock::time_point busyEnd = Clock::now();
+                stats.BusyMs += ElapsedMs(busyBegin, busyEnd);
+                if (!success)
+                {
+                    failed.store(true);
+                    break;
+                }
+                ++stats.Items;
+
+                if (output)
+                {
+                    bool pushed = output->Push(std::move(result));
+                    stats.BlockedMs += ElapsedMs(busyEnd, Clock::now());
+                    if (!pushed)
+                        break;
+                    result = Out();
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            FbxErrorHandler::LogError(std::string("Export pipeline: ") + e.what());
+            failed.store(true);
+        }
+
+        // 出错时中止两侧，正常结束时只通知下游
+        if (failed.load())
+        {
+            input.Abort();
+            if (output)
+                output->Abort();
+        }
+        else if (output)
+        {
+            output->Close();
+        }
+    }
+}
+
+bool FbxExportPipeline::Run(const FbxSdkWrapper& wrapper, const std::string& path, const FbxPipelineOptions& options,
+                            FbxPipelineReport* report)
+{
+    if (!wrapper.IsLoaded())
+    {
+        FbxErrorHandler::LogError("Export pipeline: scene not loaded");
+        return false;
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open())
+    {
+        FbxErrorHandler::LogError("Export pipeline: cannot open " + path);
+        return false;
+    }
+
+    FbxPipelineReport stats;
+    stats.Stages[FBX_PIPELINE_EXTRACT].Name = "extract";
+    stats.Stages[FBX_PIPELINE_CONVERT].Name = "convert";
+    stats.Stages[FBX_PIPELINE_COMPRESS].Name = options.Compress ? "compress" : "serialize";
+    stats.Stages[FBX_PIPELINE_WRITE].Name = "write";
+
+    const size_t capacity = options.QueueCapacity ? options.QueueCapacity : 1;
+    FbxBoundedQueue<ExtractedItem> extracted(capacity);
+    FbxBoundedQueue<ConvertedItem> converted(capacity);
+    FbxBoundedQueue<EncodedItem> encoded(capacity);
+    std::atomic<bool> failed(false);
+
+    Clock::time_point start = Clock::now();
+
+    std::thread convertThread([&]()
+    {
+        RunStage(extracted, &converted, stats.Stages[FBX_PIPELINE_CONVERT],
+                 [](ExtractedItem& item, ConvertedItem& result)
+                 {
+                     result.Meshes = FbxGeometryExporter::ConvertToSimplifiedMeshes(item.Geometry);
+                     return true;
+                 },
+                 failed);
+    });
+
+    std::thread compressThread([&]()
+    {
+        RunStage(converted, &encoded, stats.Stages[FBX_PIPELINE_COMPRESS],
+                 [&options](ConvertedItem& item, EncodedItem& result)
+                 {
+                     Encode(item.Meshes, options, result.Bytes);
+                     return true;
+                 },
+                 failed);
+    });
+
+    // 几何体数先占位，写完后回填
+    uint32_t geoCount = 0;
+    out.write(reinterpret_cast<const char*>(&geoCount), sizeof(geoCount));
+    std::thread writeThread([&]()
+    {
+        RunStage(encoded, static_cast<FbxBoundedQueue<EncodedItem>*>(nullptr), stats.Stages[FBX_PIPELINE_WRITE],
+                 [&out, &stats](EncodedItem& item, EncodedItem&)
+                 {
+                     out.write(reinterpret_cast<const char*>(item.Bytes.data()), static_cast<std::streamsize>(item.Bytes.size()));
+                     stats.BytesWritten += item.Bytes.size();
+                     return out.good();
+                 },
+                 failed);
+    });
+
+    // 提取阶段留在调用线程：SDK对象只在这一个线程上访问。
+    // 提取容器固定使用默认资源：wrapper的内存池是单调的，已写出的Mesh占用不会归还，滞留上界将不成立
+    FbxPipelineStageStats& extractStats = stats.Stages[FBX_PIPELINE_EXTRACT];
+    try
+    {
+        for (FbxMesh* mesh : wrapper.GetFilteredMeshes())
+        {
+            Clock::time_point busyBegin = Clock::now();
+            ExtractedItem item;
+            item.Geometry = wrapper.ExtractGeometry(mesh, std::pmr::get_default_resource());
+            Clock::time_point busyEnd = Clock::now();
+            extractStats.BusyMs += ElapsedMs(busyBegin, busyEnd);
+            ++extractStats.Items;
+
+            bool pushed = extracted.Push(std::move(item));
+            extractStats.BlockedMs += ElapsedMs(busyEnd, Clock::now());
+            if (!pushed)
+                break;
+        }
+        extracted.Close();
+    }
+    catch (const std::exception& e)
+    {
+        FbxErrorHandler::LogError(std::string("Export pipeline: ") + e.what());
+        failed.store(true);
+        extracted.Abort();
+    }
+
+    convertThread.join();
+    compressThread.join();
+    writeThread.join();
+
+    bool success = !failed.load();
+    if (success)
+    {
+        geoCount = static_cast<uint32_t>(stats.Stages[FBX_PIPELINE_WRITE].Items);
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&geoCount), sizeof(geoCount));
+        out.close();
+        success = !out.fail();
+        stats.BytesWritten += sizeof(geoCount);
+    }
+    stats.WallMs = ElapsedMs(start, Clock::now());
+
+    if (!success)
+        FbxErrorHandler::LogError("Export pipeline: failed writing " + path);
+    if (report)
+        *report = stats;
+    return success;
+}
@@ -0,0 +1,185 @@
+#pragma once
+#include "FbxSdkCompression.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 单生产者单消费者的有界无锁队列，满时Push阻塞、空时Pop阻塞（形成反压）
+ * @note 阻塞通过原子变量的wait/notify实现，不使用互斥锁；任一端调用Abort后两端都立即返回false
+ */
+template <typename T>
+class FbxBoundedQueue
+{
+public:
+    /**
+     * @param capacity 容量，向上取整为2的幂
+     */
+    explicit FbxBoundedQueue(size_t capacity)
+    {
+        size_t size = 1;
+        while (size < capacity)
+            size <<= 1;
+        m_slots.resize(size);
+        m_mask = size - 1;
+    }
+
+    FbxBoundedQueue(const FbxBoundedQueue&) = delete;
+    FbxBoundedQueue& operator=(const FbxBoundedQueue&) = delete;
+
+    /**
+     * @brief 生产者放入一项，队列满时等待消费者取走
+     * @return 队列被中止时返回false
+     */
+    bool Push(T&& value)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            // 先取事件计数再检查条件，之后发生的Pop/Abort一定会让wait返回
+            uint32_t events = m_popEvents.load(std::memory_order_acquire);
+            if (m_aborted.load(std::memory_order_acquire))
+                return false;
+            if (head - m_tail.load(std::memory_order_acquire) <= m_mask)
+                break;
+            m_popEvents.wait(events, std::memory_order_acquire);
+        }
+
+        m_slots[head & m_mask] = std::move(value);
+        m_head.store(head + 1, std::memory_order_release);
+        m_pushEvents.fetch_add(1, std::memory_order_release);
+        m_pushEvents.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief 消费者取出一项，队列空时等待生产者
+     * @return 生产者已Close且队列取空，或队列被中止时返回false
+     */
+    bool Pop(T& value)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            uint32_t events = m_pushEvents.load(std::memory_order_acquire);
+            if (m_aborted.load(std::memory_order_acquire))
+                return false;
+            // Close在最后一次Push之后，先读关闭标志才不会漏掉最后一项
+            bool closed = m_closed.load(std::memory_order_acquire);
+            if (m_head.load(std::memory_order_acquire) != tail)
+                break;
+            if (closed)
+                return false;
+            m_pushEvents.wait(events, std::memory_order_acquire);
+        }
+
+        value = std::move(m_slots[tail & m_mask]);
+        m_slots[tail & m_mask] = T();  // 尽早释放槽位中残留的缓冲区
+        m_tail.store(tail + 1, std::memory_order_release);
+        m_popEvents.fetch_add(1, std::memory_order_release);
+        m_popEvents.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief 生产者声明不再放入
+     */
+    void Close()
+    {
+        m_closed.store(true, std::memory_order_release);
+        m_pushEvents.fetch_add(1, std::memory_order_release);
+        m_pushEvents.notify_all();
+    }
+
+    /**
+     * @brief 任一端出错时中止，唤醒两端
+     */
+    void Abort()
+    {
+        m_aborted.store(true, std::memory_order_release);
+        m_pushEvents.fetch_add(1, std::memory_order_release);
+        m_popEvents.fetch_add(1, std::memory_order_release);
+        m_pushEvents.notify_all();
+        m_popEvents.notify_all();
+    }
+
+private:
+    std::vector<T> m_slots;
+    size_t m_mask = 0;
+    alignas(64) std::atomic<size_t> m_head{ 0 };
+    alignas(64) std::atomic<size_t> m_tail{ 0 };
+    alignas(64) std::atomic<uint32_t> m_pushEvents{ 0 };
+    alignas(64) std::atomic<uint32_t> m_popEvents{ 0 };
+    std::atomic<bool> m_closed{ false };
+    std::atomic<bool> m_aborted{ false };
+};
+
+enum FbxPipelineStage
+{
+    FBX_PIPELINE_EXTRACT = 0,   // 逐Mesh提取（调用线程，唯一访问SDK的线程）
+    FBX_PIPELINE_CONVERT,       // ConvertToSimplifiedMeshes
+    FBX_PIPELINE_COMPRESS,      // 焊接 + FbxMeshCodec编码，或未压缩时序列化
+    FBX_PIPELINE_WRITE,         // 写文件
+    FBX_PIPELINE_STAGE_COUNT
+};
+
+struct FbxPipelineStageStats
+{
+    const char* Name = "";
+    uint64_t Items = 0;
+    double BusyMs = 0.0;        // 处理数据的时间
+    double StarvedMs = 0.0;     // 等待上游（输入队列为空）
+    double BlockedMs = 0.0;     // 等待下游（输出队列已满，即反压）
+};
+
+/**
+ * @brief 各阶段的利用率：BusyMs / WallMs；各阶段Busy之和超过WallMs的部分即为阶段间的重叠
+ */
+struct FbxPipelineReport
+{
+    FbxPipelineStageStats Stages[FBX_PIPELINE_STAGE_COUNT];
+    double WallMs = 0.0;
+    uint64_t BytesWritten = 0;
+
+    double GetUtilization(FbxPipelineStage stage) const
+    {
+        return WallMs > 0.0 ? Stages[stage].BusyMs / WallMs : 0.0;
+    }
+
+    /**
+     * @brief 各阶段Busy之和 / WallMs，串行执行时不超过1，完全重叠时接近阶段数
+     */
+    double GetOverlap() const
+    {
+        double busy = 0.0;
+        for (const FbxPipelineStageStats& stage : Stages)
+            busy += stage.BusyMs;
+        return WallMs > 0.0 ? busy / WallMs : 0.0;
+    }
+};
+
+struct FbxPipelineOptions
+{
+    size_t QueueCapacity = 8;           // 相邻阶段间最多缓存的Mesh数
+    bool Compress = true;               // false时写出未压缩的SimplifiedMesh，与Compress格式共用外层结构
+    FbxCompressionOptions Compression;
+};
+
+class FbxSdkWrapper;
+
+/**
+ * @brief 提取、转换、压缩、写出四阶段流水线导出：每个Mesh提取后立即流向下游，各阶段在独立线程上并行，
+ *       阶段间为有界队列，写盘跟不上时上游自动等待，内存中最多滞留约4 * QueueCapacity个Mesh。
+ *       wrapper启用内存池时提取结果仍从默认资源分配，上界同样成立；只有提取期间SDK自身的临时分配留在内存池中
+ * @note 输出格式与example_usage中的逐几何体格式相同：uint32几何体数，随后每个几何体一个uint32网格数，
+ *       每个网格为（Compress）uint32编码字节数 + FbxMeshCodec编码，或（未压缩）顶点数 + 顶点 + 索引数 + 索引 + 材质Id。
+ *       几何体数在写完后回填。提取受wrapper的过滤器、属性掩码与切线设置约束，SimplifiedMesh只用到法线、UV与顶点色
+ */
+class FbxExportPipeline
+{
+public:
+    static bool Run(const FbxSdkWrapper& wrapper, const std::string& path, const FbxPipelineOptions& options = FbxPipelineOptions(),
+                    FbxPipelineReport* report = nullptr);
+};
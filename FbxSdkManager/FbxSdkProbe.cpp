@@ -0,0 +1,537 @@
+#include "FbxSdkProbe.h"
+#include "FbxSdkStream.h"
+#include "FbxSdkException.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+    const char kBinaryMagic[] = "Kaydara FBX Binary  ";
+    const size_t kBinaryHeaderSize = 27;
+
+    template <typename T>
+    T ReadScalar(const uint8_t* p)
+    {
+        T value;
+        memcpy(&value, p, sizeof(T));
+        return value;
+    }
+
+    bool HasPrefix(const char* pBegin, const char* pEnd, const char* pPrefix)
+    {
+        const size_t length = strlen(pPrefix);
+        return static_cast<size_t>(pEnd - pBegin) >= length && memcmp(pBegin, pPrefix, length) == 0;
+    }
+
+    /**
+     * @brief 估算多边形数量：数组被压缩时用Euler公式F = E - V + 2，缺少Edges时按四边形估算
+     */
+    uint64_t EstimatePolygonCount(uint64_t IndexCount, uint64_t EdgeCount, uint64_t VertexCount)
+    {
+        uint64_t polygons = IndexCount / 4;
+        if (EdgeCount > 0 && EdgeCount + 2 > VertexCount)
+        {
+            polygons = EdgeCount + 2 - VertexCount;
+        }
+        return std::max<uint64_t>(1, std::min<uint64_t>(polygons, IndexCount / 3));
+    }
+
+    void AccumulateMesh(FbxProbeInfo& Info, uint64_t VertexCount, uint64_t IndexCount, uint64_t PolygonCount, bool Exact)
+    {
+        if (IndexCount == 0)
+        {
+            return;
+        }
+        Info.ControlPointCount += VertexCount;
+        Info.PolygonVertexCount += IndexCount;
+        Info.PolygonCount += PolygonCount;
+        Info.TriangleCount += IndexCount > 2 * PolygonCount ? IndexCount - 2 * PolygonCount : 0;
+        Info.TriangleCountExact = Info.TriangleCountExact && Exact;
+    }
+
+    /**
+     * @brief 二进制FBX节点记录扫描器，只读取记录头，通过EndOffset跳过不关心的子树
+     */
+    class FbxBinaryScanner
+    {
+    public:
+        struct Node
+        {
+            uint64_t EndOffset = 0;
+            uint64_t PropertyCount = 0;
+            const char* Name = nullptr;
+            size_t NameLength = 0;
+            size_t PropertiesBegin = 0;
+            size_t ChildrenBegin = 0;
+
+            bool Is(const char* pName) const
+            {
+                return NameLength == strlen(pName) && memcmp(Name, pName, NameLength) == 0;
+            }
+        };
+
+        struct Property
+        {
+            char Type = 0;
+            const uint8_t* Data = nullptr;
+            uint32_t ArrayLength = 0;
+            uint32_t Encoding = 0;
+            uint32_t ByteLength = 0;
+        };
+
+        FbxBinaryScanner(const uint8_t* pData, size_t pSize, uint32_t pVersion)
+            : m_data(pData), m_size(pSize), m_wide(pVersion >= 7500)
+        {
+        }
+
+        /**
+         * @brief 读取offset处的节点头，遇到空记录或越界返回false
+         */
+        bool ReadNode(size_t offset, Node& node) const
+        {
+            const size_t fieldSize = m_wide ? 8 : 4;
+            const size_t headerSize = 3 * fieldSize + 1;
+            if (offset > m_size || headerSize > m_size - offset)
+            {
+                return false;
+            }
+
+            const uint8_t* p = m_data + offset;
+            if (m_wide)
+            {
+                node.EndOffset = ReadScalar<uint64_t>(p);
+                node.PropertyCount = ReadScalar<uint64_t>(p + 8);
+            }
+            else
+            {
+                node.EndOffset = ReadScalar<uint32_t>(p);
+                node.PropertyCount = ReadScalar<uint32_t>(p + 4);
+            }
+            const uint64_t propertyListLength = m_wide ? ReadScalar<uint64_t>(p + 16) : ReadScalar<uint32_t>(p + 8);
+
+            node.NameLength = p[3 * fieldSize];
+            node.Name = reinterpret_cast<const char*>(p + headerSize);
+            node.PropertiesBegin = offset + headerSize + node.NameLength;
+
+            // 长度字段来自不可信的文件：先比较再相加，避免回绕后通过下面的范围检查
+            if (node.PropertiesBegin > m_size || propertyListLength > m_size - node.PropertiesBegin)
+            {
+                return false;
+            }
+            node.ChildrenBegin = node.PropertiesBegin + static_cast<size_t>(propertyListLength);
+
+            // EndOffset为0表示空记录（子节点列表结束）；必须位于本节点之后，遍历才一定向前推进
+            return node.EndOffset > offset && node.EndOffset <= m_size && node.ChildrenBegin <= node.EndOffset;
+        }
+
+        template <typename F>
+        void ForEachTopLevel(F fn) const
+        {
+            Node node;
+            size_t offset = kBinaryHeaderSize;
+            while (ReadNode(offset, node))
+            {
+                fn(node);
+                offset = static_cast<size_t>(node.EndOffset);
+            }
+        }
+
+        template <typename F>
+        void ForEachChild(const Node& parent, F fn) const
+        {
+            Node node;
+            size_t offset = parent.ChildrenBegin;
+            while (offset < parent.EndOffset && ReadNode(offset, node) && node.EndOffset <= parent.EndOffset)
+            {
+                fn(node);
+                offset = static_cast<size_t>(node.EndOffset);
+            }
+        }
+
+        /**
+         * @brief 读取节点的第Index个属性
+         */
+        bool GetProperty(const Node& node, uint64_t Index, Property& property) const
+        {
+            if (Index >= node.PropertyCount)
+            {
+                return false;
+            }
+
+            size_t cursor = node.PropertiesBegin;
+            for (uint64_t i = 0; i <= Index && i < node.PropertyCount; ++i)
+            {
+                if (cursor >= node.ChildrenBegin)
+                {
+                    return false;
+                }
+
+                property = Property();
+                property.Type = static_cast<char>(m_data[cursor++]);
+                size_t payload = 0;
+                switch (property.Type)
+                {
+                case 'C': payload = 1; break;
+                case 'Y': payload = 2; break;
+                case 'I': case 'F': payload = 4; break;
+                case 'D': case 'L': payload = 8; break;
+                case 'f': case 'd': case 'l': case 'i': case 'b':
+                    if (cursor + 12 > node.ChildrenBegin)
+                    {
+                        return false;
+                    }
+                    property.ArrayLength = ReadScalar<uint32_t>(m_data + cursor);
+                    property.Encoding = ReadScalar<uint32_t>(m_data + cursor + 4);
+                    property.ByteLength = ReadScalar<uint32_t>(m_data + cursor + 8);
+                    cursor += 12;
+                    payload = property.ByteLength;
+                    break;
+                case 'S': case 'R':
+                    if (cursor + 4 > node.ChildrenBegin)
+                    {
+                        return false;
+                    }
+                    property.ByteLength = ReadScalar<uint32_t>(m_data + cursor);
+                    cursor += 4;
+                    payload = property.ByteLength;
+                    break;
+                default:
+                    return false;
+                }
+
+                if (cursor + payload > node.ChildrenBegin)
+                {
+                    return false;
+                }
+                property.Data = m_data + cursor;
+                cursor += payload;
+            }
+            return property.Data != nullptr;
+        }
+
+        bool PropertyIs(const Node& node, uint64_t Index, const char* pValue) const
+        {
+            Property property;
+            return GetProperty(node, Index, property) && property.Type == 'S'
+                && property.ByteLength == strlen(pValue) && memcmp(property.Data, pValue, property.ByteLength) == 0;
+        }
+
+    private:
+        const uint8_t* m_data;
+        size_t m_size;
+        bool m_wide;
+    };
+
+    void ScanBinaryGeometry(const FbxBinaryScanner& scanner, const FbxBinaryScanner::Node& geometry, FbxProbeInfo& Info)
+    {
+        uint64_t vertexCount = 0, indexCount = 0, edgeCount = 0, polygonCount = 0;
+        bool exact = false;
+
+        scanner.ForEachChild(geometry, [&](const FbxBinaryScanner::Node& child)
+        {
+            FbxBinaryScanner::Property property;
+            if (!scanner.GetProperty(child, 0, property))
+            {
+                return;
+            }
+
+            if (child.Is("Vertices"))
+            {
+                vertexCount = property.ArrayLength / 3;
+            }
+            else if (child.Is("Edges"))
+            {
+                edgeCount = property.ArrayLength;
+            }
+            else if (child.Is("PolygonVertexIndex") && property.Type == 'i')
+            {
+                indexCount = property.ArrayLength;
+                // 未压缩时直接统计负数（多边形结束标记），得到精确多边形数
+                if (property.Encoding == 0 && property.ByteLength >= indexCount * 4)
+                {
+                    polygonCount = 0;
+                    for (uint64_t i = 0; i < indexCount; ++i)
+                    {
+                        polygonCount += ReadScalar<int32_t>(property.Data + i * 4) < 0 ? 1 : 0;
+                    }
+                    exact = true;
+                }
+            }
+        });
+
+        if (!exact)
+        {
+            polygonCount = EstimatePolygonCount(indexCount, edgeCount, vertexCount);
+        }
+        AccumulateMesh(Info, vertexCount, indexCount, polygonCount, exact);
+    }
+
+    bool ProbeBinary(const uint8_t* pData, size_t pSize, FbxProbeInfo& Info)
+    {
+        if (pSize < kBinaryHeaderSize)
+        {
+            return false;
+        }
+
+        Info.IsBinary = true;
+        Info.FileVersion = ReadScalar<uint32_t>(pData + 23);
+
+        FbxBinaryScanner scanner(pData, pSize, Info.FileVersion);
+        scanner.ForEachTopLevel([&](const FbxBinaryScanner::Node& topLevel)
+        {
+            if (!topLevel.Is("Objects"))
+            {
+                return;
+            }
+
+            scanner.ForEachChild(topLevel, [&](const FbxBinaryScanner::Node& object)
+            {
+                // 对象属性依次为：Id、"Name\x00\x01Class"、子类型
+                if (object.Is("Geometry"))
+                {
+                    if (scanner.PropertyIs(object, 2, "Mesh"))
+                    {
+                        ++Info.MeshCount;
+                        ScanBinaryGeometry(scanner, object, Info);
+                    }
+                    else if (scanner.PropertyIs(object, 2, "Shape"))
+                    {
+                        ++Info.ShapeCount;
+                    }
+                }
+                else if (object.Is("Model"))
+                {
+                    ++Info.ModelCount;
+                }
+                else if (object.Is("Material"))
+                {
+                    ++Info.MaterialCount;
+                }
+                else if (object.Is("Texture"))
+                {
+                    ++Info.TextureCount;
+                }
+                else if (object.Is("Video"))
+                {
+                    ++Info.VideoCount;
+                    scanner.ForEachChild(object, [&](const FbxBinaryScanner::Node& child)
+                    {
+                        FbxBinaryScanner::Property content;
+                        if (child.Is("Content") && scanner.GetProperty(child, 0, content) && content.Type == 'R')
+                        {
+                            Info.EmbeddedMediaBytes += content.ByteLength;
+                        }
+                    });
+                }
+                else if (object.Is("Deformer"))
+                {
+                    if (scanner.PropertyIs(object, 2, "Skin"))
+                    {
+                        ++Info.SkinCount;
+                    }
+                    else if (scanner.PropertyIs(object, 2, "BlendShape"))
+                    {
+                        ++Info.BlendShapeCount;
+                    }
+                }
+                else if (object.Is("AnimationStack"))
+                {
+                    ++Info.AnimStackCount;
+                }
+            });
+        });
+        return true;
+    }
+
+    /**
+     * @brief ASCII FBX按行扫描，只解析对象声明行与几何数组长度
+     */
+    bool ProbeAscii(const char* pData, size_t pSize, FbxProbeInfo& Info)
+    {
+        const char* end = pData + pSize;
+        const char* line = pData;
+
+        bool inMesh = false;
+        uint64_t vertexCount = 0, indexCount = 0, polygonCount = 0;
+        auto flushMesh = [&]()
+        {
+            if (inMesh)
+            {
+                AccumulateMesh(Info, vertexCount, indexCount, polygonCount, true);
+            }
+            inMesh = false;
+            vertexCount = indexCount = polygonCount = 0;
+        };
+
+        while (line < end)
+        {
+            const char* lineEnd = static_cast<const char*>(memchr(line, '\n', end - line));
+            if (!lineEnd)
+            {
+                lineEnd = end;
+            }
+
+            if (HasPrefix(line, lineEnd, "\tGeometry: "))
+            {
+                flushMesh();
+                if (std::search(line, lineEnd, "\"Mesh\"", "\"Mesh\"" + 6) != lineEnd)
+                {
+                    ++Info.MeshCount;
+                    inMesh = true;
+                }
+                else if (std::search(line, lineEnd, "\"Shape\"", "\"Shape\"" + 7) != lineEnd)
+                {
+                    ++Info.ShapeCount;
+                }
+            }
+            else if (line[0] == '\t' && line + 1 < lineEnd && line[1] != '\t')
+            {
+                // 其他一级对象
+                flushMesh();
+                if (HasPrefix(line, lineEnd, "\tModel: ")) ++Info.ModelCount;
+                else if (HasPrefix(line, lineEnd, "\tMaterial: ")) ++Info.MaterialCount;
+                else if (HasPrefix(line, lineEnd, "\tTexture: ")) ++Info.TextureCount;
+                else if (HasPrefix(line, lineEnd, "\tVideo: ")) ++Info.VideoCount;
+                else if (HasPrefix(line, lineEnd, "\tAnimationStack: ")) ++Info.AnimStackCount;
+                else if (Info.FileVersion == 0 && HasPrefix(line, lineEnd, "\tFBXVersion: "))
+                {
+                    Info.FileVersion = static_cast<uint32_t>(strtoul(line + 13, nullptr, 10));
+                }
+                else if (HasPrefix(line, lineEnd, "\tDeformer: "))
+                {
+                    if (std::search(line, lineEnd, "\"Skin\"", "\"Skin\"" + 6) != lineEnd) ++Info.SkinCount;
+                    else if (std::search(line, lineEnd, "\"BlendShape\"", "\"BlendShape\"" + 12) != lineEnd) ++Info.BlendShapeCount;
+                }
+            }
+            else if (inMesh && HasPrefix(line, lineEnd, "\t\tVertices: *"))
+            {
+                vertexCount = strtoull(line + 13, nullptr, 10) / 3;
+            }
+            else if (inMesh && HasPrefix(line, lineEnd, "\t\tPolygonVertexIndex: *"))
+            {
+                indexCount = strtoull(line + 23, nullptr, 10);
+                // 数组内容位于随后的"a: "行，直到'}'为止，负数为多边形结束标记
+                const char* blockEnd = static_cast<const char*>(memchr(lineEnd, '}', end - lineEnd));
+                if (!blockEnd)
+                {
+                    blockEnd = end;
+                }
+                polygonCount = std::count(lineEnd, blockEnd, '-');
+                lineEnd = blockEnd;
+            }
+            else if (HasPrefix(line, lineEnd, "\t\tContent: "))
+            {
+                // 内嵌媒体为base64字符串
+                const char* quote = static_cast<const char*>(memchr(line, '"', lineEnd - line));
+                if (quote)
+                {
+                    const char* closing = static_cast<const char*>(memchr(quote + 1, '"', end - quote - 1));
+                    if (closing)
+                    {
+                        Info.EmbeddedMediaBytes += static_cast<uint64_t>(closing - quote - 1) * 3 / 4;
+                        lineEnd = closing;
+                    }
+                }
+            }
+
+            line = lineEnd + 1;
+        }
+        flushMesh();
+        return Info.FileVersion != 0 || Info.ModelCount > 0;
+    }
+}
+
+bool FbxSdkProbe::Probe(const std::string& filename, FbxProbeInfo& Info)
+{
+    FbxMappedFile mappedFile;
+    if (!mappedFile.Open(filename))
+    {
+        return false;
+    }
+    return ProbeMemory(mappedFile.GetData(), mappedFile.GetSize(), Info);
+}
+
+bool FbxSdkProbe::ProbeMemory(const void* pData, size_t pSize, FbxProbeInfo& Info)
+{
+    Info = FbxProbeInfo();
+    Info.FileSize = pSize;
+    if (!pData || pSize == 0)
+    {
+        return false;
+    }
+
+    const size_t magicLength = sizeof(kBinaryMagic) - 1;
+    const bool ok = pSize >= magicLength && memcmp(pData, kBinaryMagic, magicLength) == 0
+        ? ProbeBinary(static_cast<const uint8_t*>(pData), pSize, Info)
+        : ProbeAscii(static_cast<const char*>(pData), pSize, Info);
+
+    if (!ok)
+    {
+        FbxErrorHandler::LogError("Probe: data is not a recognizable FBX file");
+        return false;
+    }
+
+    Info.FileMajor = static_cast<int>(Info.FileVersion / 1000);
+    Info.FileMinor = static_cast<int>(Info.FileVersion % 1000 / 100);
+    Info.FileRevision = static_cast<int>(Info.FileVersion % 100);
+    return true;
+}
+
+bool FbxSdkProbe::ListEmbeddedMedia(const void* pData, size_t pSize, std::vector<FbxEmbeddedMedia>& Media)
+{
+    Media.clear();
+    const size_t magicLength = sizeof(kBinaryMagic) - 1;
+    if (!pData || pSize < kBinaryHeaderSize || memcmp(pData, kBinaryMagic, magicLength) != 0)
+    {
+        return false;
+    }
+
+    const uint8_t* data = static_cast<const uint8_t*>(pData);
+    FbxBinaryScanner scanner(data, pSize, ReadScalar<uint32_t>(data + 23));
+    scanner.ForEachTopLevel([&](const FbxBinaryScanner::Node& topLevel)
+    {
+        if (!topLevel.Is("Objects"))
+        {
+            return;
+        }
+
+        scanner.ForEachChild(topLevel, [&](const FbxBinaryScanner::Node& object)
+        {
+            if (!object.Is("Video"))
+            {
+                return;
+            }
+
+            FbxEmbeddedMedia media;
+            scanner.ForEachChild(object, [&](const FbxBinaryScanner::Node& child)
+            {
+                FbxBinaryScanner::Property property;
+                if (!scanner.GetProperty(child, 0, property))
+                {
+                    return;
+                }
+                if (child.Is("Content") && property.Type == 'R')
+                {
+                    media.Offset = static_cast<uint64_t>(property.Data - data);
+                    media.Size = property.ByteLength;
+                }
+                else if (child.Is("Filename") && property.Type == 'S')
+                {
+                    media.FileName.assign(reinterpret_cast<const char*>(property.Data), property.ByteLength);
+                }
+                else if (child.Is("RelativeFilename") && property.Type == 'S')
+                {
+                    media.RelativeFileName.assign(reinterpret_cast<const char*>(property.Data), property.ByteLength);
+                }
+            });
+
+            // 同一媒体被多个Video引用时只有一个带内容
+            if (media.Size > 0)
+            {
+                Media.push_back(std::move(media));
+            }
+        });
+    });
+    return true;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 文件探测结果，不经过FbxImporter，不构建几何体
+ */
+struct FbxProbeInfo
+{
+    bool IsBinary = false;
+    uint64_t FileSize = 0;
+
+    // 文件版本，如7400对应7.4.0
+    uint32_t FileVersion = 0;
+    int FileMajor = 0;
+    int FileMinor = 0;
+    int FileRevision = 0;
+
+    // 对象数量
+    uint32_t ModelCount = 0;
+    uint32_t MeshCount = 0;
+    uint32_t ShapeCount = 0;
+    uint32_t MaterialCount = 0;
+    uint32_t TextureCount = 0;
+    uint32_t VideoCount = 0;
+    uint32_t SkinCount = 0;
+    uint32_t BlendShapeCount = 0;
+    uint32_t AnimStackCount = 0;
+
+    // 几何规模
+    uint64_t ControlPointCount = 0;
+    uint64_t PolygonVertexCount = 0;
+    uint64_t PolygonCount = 0;
+    uint64_t TriangleCount = 0;
+    // 为false时PolygonCount/TriangleCount为估算值（数组被zlib压缩时由Euler公式估算）
+    bool TriangleCountExact = true;
+
+    // 内嵌媒体（Video/Content）总字节数
+    uint64_t EmbeddedMediaBytes = 0;
+};
+
+/**
+ * @brief 二进制FBX中的一段内嵌媒体（Video对象的Content），数据原样存放在文件中
+ */
+struct FbxEmbeddedMedia
+{
+    std::string FileName;           // Video的Filename，与FbxFileTexture::GetFileName一致
+    std::string RelativeFileName;
+    uint64_t Offset = 0;            // 内容在文件中的偏移
+    uint64_t Size = 0;
+};
+
+/**
+ * @brief 轻量级FBX探测：直接扫描二进制节点记录（或ASCII文本），毫秒级返回版本与统计信息
+ */
+class FbxSdkProbe
+{
+public:
+    /**
+     * @brief 探测本地文件（内部使用内存映射）
+     * @param filename 文件路径
+     * @param Info 输出的探测结果
+     * @return 文件可识别为FBX时返回true
+     */
+    static bool Probe(const std::string& filename, FbxProbeInfo& Info);
+
+    /**
+     * @brief 探测内存中的FBX数据
+     */
+    static bool ProbeMemory(const void* pData, size_t pSize, FbxProbeInfo& Info);
+
+    /**
+     * @brief 列出内嵌媒体的位置，不拷贝内容
+     * @note 只支持二进制FBX；ASCII FBX中的内容为base64文本，需由SDK导入时解出（<文件名>.fbm目录）
+     * @return 数据为二进制FBX时返回true
+     */
+    static bool ListEmbeddedMedia(const void* pData, size_t pSize, std::vector<FbxEmbeddedMedia>& Media);
+};
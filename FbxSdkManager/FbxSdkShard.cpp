@@ -0,0 +1,586 @@
+#include "FbxSdkShard.h"
+#include "FbxSdkException.h"
+#include "FbxSdkLod.h"
+#include "FbxSdkMemory.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#if defined(__APPLE__)
+#include <mach-o/dyld.h>
+#endif
+extern char** environ;
+#endif
+
+namespace
+{
+    const char kHeaderMagic[4] = { 'F', 'S', 'C', '1' };
+    const char kFooterMagic[4] = { 'F', 'S', 'C', 'T' };
+    const char kWorkerSwitch[] = "--fbx-shard-worker";
+    constexpr uint32_t kVersion = 1;
+    constexpr size_t kHeaderSize = 16;
+    constexpr size_t kEntrySize = 40;
+    constexpr size_t kFooterSize = 16;
+    // SimplifiedMesh只使用法线、主UV与第一套顶点色
+    constexpr uint32_t kAttributeMask = FBX_ATTRIBUTE_NORMAL | FBX_ATTRIBUTE_UV | FBX_ATTRIBUTE_COLOR;
+
+    void Put32(uint8_t* p, uint32_t v)
+    {
+        for (int i = 0; i < 4; ++i)
+            p[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+
+    void Put64(uint8_t* p, uint64_t v)
+    {
+        for (int i = 0; i < 8; ++i)
+            p[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+
+    uint32_t Get32(const uint8_t* p)
+    {
+        uint32_t v = 0;
+        for (int i = 0; i < 4; ++i)
+            v |= static_cast<uint32_t>(p[i]) << (8 * i);
+        return v;
+    }
+
+    uint64_t Get64(const uint8_t* p)
+    {
+        uint64_t v = 0;
+        for (int i = 0; i < 8; ++i)
+            v |= static_cast<uint64_t>(p[i]) << (8 * i);
+        return v;
+    }
+
+    bool EntryLess(const FbxShardEntry& a, const FbxShardEntry& b)
+    {
+        return a.MeshOrdinal != b.MeshOrdinal ? a.MeshOrdinal < b.MeshOrdinal : a.SectionIndex < b.SectionIndex;
+    }
+
+    std::string ShardPath(const std::string& output, unsigned index)
+    {
+        return output + ".shard" + std::to_string(index);
+    }
+
+    /**
+     * @brief 物理内存总量，无法获取时返回0
+     */
+    uint64_t PhysicalMemoryBytes()
+    {
+#ifdef _WIN32
+        MEMORYSTATUSEX status = {};
+        status.dwLength = sizeof(status);
+        return GlobalMemoryStatusEx(&status) ? static_cast<uint64_t>(status.ullTotalPhys) : 0;
+#else
+        long pages = sysconf(_SC_PHYS_PAGES);
+        long pageSize = sysconf(_SC_PAGE_SIZE);
+        return pages > 0 && pageSize > 0 ? static_cast<uint64_t>(pages) * static_cast<uint64_t>(pageSize) : 0;
+#endif
+    }
+
+    std::string CurrentExecutable()
+    {
+#ifdef _WIN32
+        std::string path(MAX_PATH, '\0');
+        for (;;)
+        {
+            DWORD length = GetModuleFileNameA(nullptr, &path[0], static_cast<DWORD>(path.size()));
+            if (length == 0)
+                return std::string();
+            if (length < path.size())
+            {
+                path.resize(length);
+                return path;
+            }
+            path.resize(path.size() * 2);
+        }
+#elif defined(__APPLE__)
+        uint32_t size = 0;
+        _NSGetExecutablePath(nullptr, &size);
+        std::string path(size, '\0');
+        if (_NSGetExecutablePath(&path[0], &size) != 0)
+            return std::string();
+        path.resize(std::strlen(path.c_str()));
+        return path;
+#else
+        std::string path(4096, '\0');
+        ssize_t length = readlink("/proc/self/exe", &path[0], path.size());
+        if (length <= 0 || static_cast<size_t>(length) >= path.size())
+            return std::string();
+        path.resize(static_cast<size_t>(length));
+        return path;
+#endif
+    }
+
+#ifdef _WIN32
+    /**
+     * @brief 按CommandLineToArgvW的规则给参数加引号
+     */
+    void AppendQuoted(std::string& commandLine, const std::string& argument)
+    {
+        if (!commandLine.empty())
+            commandLine += ' ';
+        commandLine += '"';
+        size_t backslashes = 0;
+        for (char c : argument)
+        {
+            if (c == '\\')
+            {
+                ++backslashes;
+                continue;
+            }
+            // 引号前的反斜杠需要加倍，引号本身再转义
+            commandLine.append(c == '"' ? backslashes * 2 + 1 : backslashes, '\\');
+            backslashes = 0;
+            commandLine += c;
+        }
+        commandLine.append(backslashes * 2, '\\');
+        commandLine += '"';
+    }
+
+    using ProcessHandle = HANDLE;
+    const ProcessHandle kInvalidProcess = nullptr;
+
+    ProcessHandle SpawnProcess(const std::string& executable, const std::vector<std::string>& arguments)
+    {
+        std::string commandLine;
+        AppendQuoted(commandLine, executable);
+        for (const std::string& argument : arguments)
+            AppendQuoted(commandLine, argument);
+
+        STARTUPINFOA startup = {};
+        startup.cb = sizeof(startup);
+        PROCESS_INFORMATION process = {};
+        if (!CreateProcessA(executable.c_str(), &commandLine[0], nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startup, &process))
+            return kInvalidProcess;
+        CloseHandle(process.hThread);
+        return process.hProcess;
+    }
+
+    bool WaitProcess(ProcessHandle process)
+    {
+        DWORD exitCode = 1;
+        bool finished = WaitForSingleObject(process, INFINITE) == WAIT_OBJECT_0 && GetExitCodeProcess(process, &exitCode);
+        CloseHandle(process);
+        return finished && exitCode == 0;
+    }
+#else
+    using ProcessHandle = pid_t;
+    const ProcessHandle kInvalidProcess = -1;
+
+    ProcessHandle SpawnProcess(const std::string& executable, const std::vector<std::string>& arguments)
+    {
+        std::vector<char*> argv;
+        argv.push_back(const_cast<char*>(executable.c_str()));
+        for (const std::string& argument : arguments)
+            argv.push_back(const_cast<char*>(argument.c_str()));
+        argv.push_back(nullptr);
+
+        pid_t pid = kInvalidProcess;
+        if (posix_spawn(&pid, executable.c_str(), nullptr, nullptr, argv.data(), environ) != 0)
+            return kInvalidProcess;
+        return pid;
+    }
+
+    bool WaitProcess(ProcessHandle process)
+    {
+        int status = 0;
+        while (waitpid(process, &status, 0) < 0)
+        {
+            if (errno != EINTR)
+                return false;
+        }
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+#endif
+}
+
+FbxShardWriter::~FbxShardWriter()
+{
+    // 未Finish的文件没有目录，不能被读取，直接删除
+    if (m_file.is_open())
+    {
+        m_file.close();
+        std::remove(m_path.c_str());
+    }
+}
+
+bool FbxShardWriter::Open(const std::string& path, uint32_t shardIndex, uint32_t shardCount)
+{
+    m_path = path;
+    m_entries.clear();
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open())
+    {
+        FbxErrorHandler::LogError("Failed to create shard file: " + path);
+        return false;
+    }
+
+    uint8_t header[kHeaderSize];
+    std::memcpy(header, kHeaderMagic, 4);
+    Put32(header + 4, kVersion);
+    Put32(header + 8, shardIndex);
+    Put32(header + 12, shardCount);
+    m_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    m_position = kHeaderSize;
+    return m_file.good();
+}
+
+bool FbxShardWriter::Add(FbxShardEntry entry, const uint8_t* data, size_t size)
+{
+    if (!m_file.is_open())
+        return false;
+
+    entry.Offset = m_position;
+    entry.Size = size;
+    m_file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (!m_file.good())
+    {
+        FbxErrorHandler::LogError("Failed to write shard file: " + m_path);
+        return false;
+    }
+    m_position += size;
+    m_entries.push_back(entry);
+    return true;
+}
+
+bool FbxShardWriter::Finish()
+{
+    if (!m_file.is_open())
+        return false;
+
+    std::sort(m_entries.begin(), m_entries.end(), EntryLess);
+
+    std::vector<uint8_t> table(m_entries.size() * kEntrySize + kFooterSize);
+    uint8_t* p = table.data();
+    for (const FbxShardEntry& entry : m_entries)
+    {
+        Put32(p, entry.MeshOrdinal);
+        Put32(p + 4, entry.SectionIndex);
+        Put64(p + 8, entry.MeshId);
+        Put64(p + 16, entry.MaterialId);
+        Put64(p + 24, entry.Offset);
+        Put64(p + 32, entry.Size);
+        p += kEntrySize;
+    }
+    Put64(p, m_position);
+    Put32(p + 8, static_cast<uint32_t>(m_entries.size()));
+    std::memcpy(p + 12, kFooterMagic, 4);
+
+    m_file.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size()));
+    m_file.close();
+    if (m_file.fail())
+    {
+        FbxErrorHandler::LogError("Failed to finish shard file: " + m_path);
+        std::remove(m_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool FbxShardReader::Open(const std::string& path)
+{
+    Close();
+    if (!m_file.Open(path))
+        return false;
+
+    const uint8_t* data = static_cast<const uint8_t*>(m_file.GetData());
+    size_t size = m_file.GetSize();
+    if (size < kHeaderSize + kFooterSize || std::memcmp(data, kHeaderMagic, 4) != 0 || Get32(data + 4) != kVersion ||
+        std::memcmp(data + size - 4, kFooterMagic, 4) != 0)
+    {
+        FbxErrorHandler::LogError("Not a shard container: " + path);
+        Close();
+        return false;
+    }
+
+    const uint8_t* footer = data + size - kFooterSize;
+    uint64_t tableOffset = Get64(footer);
+    uint64_t count = Get32(footer + 8);
+    // 偏移来自文件，可能接近2^64：先确认它在文件内，再用剩余长度校验表大小，不做可能回绕的加法
+    const uint64_t tableEnd = size - kFooterSize;
+    if (tableOffset < kHeaderSize || tableOffset > tableEnd || (tableEnd - tableOffset) % kEntrySize != 0 ||
+        (tableEnd - tableOffset) / kEntrySize != count)
+    {
+        FbxErrorHandler::LogError("Corrupted shard container: " + path);
+        Close();
+        return false;
+    }
+
+    m_shardIndex = Get32(data + 8);
+    m_shardCount = Get32(data + 12);
+    m_entries.resize(static_cast<size_t>(count));
+    const uint8_t* p = data + tableOffset;
+    for (FbxShardEntry& entry : m_entries)
+    {
+        entry.MeshOrdinal = Get32(p);
+        entry.SectionIndex = Get32(p + 4);
+        entry.MeshId = Get64(p + 8);
+        entry.MaterialId = Get64(p + 16);
+        entry.Offset = Get64(p + 24);
+        entry.Size = Get64(p + 32);
+        p += kEntrySize;
+
+        if (entry.Offset < kHeaderSize || entry.Offset > tableOffset || entry.Size > tableOffset - entry.Offset)
+        {
+            FbxErrorHandler::LogError("Corrupted shard container: " + path);
+            Close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void FbxShardReader::Close()
+{
+    m_file.Close();
+    m_entries.clear();
+    m_shardIndex = 0;
+    m_shardCount = 0;
+}
+
+const uint8_t* FbxShardReader::GetData(const FbxShardEntry& entry) const
+{
+    return static_cast<const uint8_t*>(m_file.GetData()) + entry.Offset;
+}
+
+bool FbxShardReader::Read(const FbxShardEntry& entry, FbxGeometryExporter::SimplifiedMesh& mesh) const
+{
+    if (!m_file.IsOpen())
+        return false;
+    return FbxMeshCodec::Decode(GetData(entry), static_cast<size_t>(entry.Size), mesh);
+}
+
+bool FbxShardedConverter::ConvertShard(const std::string& input, const std::string& shardPath, uint32_t shardIndex, uint32_t shardCount,
+                                       const FbxCompressionOptions& compression)
+{
+    if (shardCount == 0 || shardIndex >= shardCount)
+        return false;
+
+    FbxSdkWrapper wrapper;
+    if (!wrapper.LoadFile(input))
+        return false;
+
+    FbxScene* scene = wrapper.GetScene();
+    std::vector<FbxMesh*> meshes;
+    for (int i = 0; i < scene->GetGeometryCount(); ++i)
+    {
+        FbxGeometry* geometry = scene->GetGeometry(i);
+        if (geometry && geometry->GetAttributeType() == FbxNodeAttribute::eMesh)
+            meshes.push_back(static_cast<FbxMesh*>(geometry));
+    }
+
+    // 最长处理时间优先的贪心划分：按多边形顶点数从大到小分给当前负载最小的分片，
+    // 只依赖场景内容，所有worker得到同一划分
+    std::vector<uint32_t> order(meshes.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::vector<uint64_t> weights(meshes.size());
+    for (size_t i = 0; i < meshes.size(); ++i)
+        weights[i] = static_cast<uint64_t>(std::max(meshes[i]->GetPolygonVertexCount(), 0)) + 1;
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return weights[a] > weights[b]; });
+
+    std::vector<uint64_t> loads(shardCount, 0);
+    std::vector<uint32_t> owned;
+    for (uint32_t ordinal : order)
+    {
+        uint32_t shard = static_cast<uint32_t>(std::min_element(loads.begin(), loads.end()) - loads.begin());
+        loads[shard] += weights[ordinal];
+        if (shard == shardIndex)
+            owned.push_back(ordinal);
+    }
+    std::sort(owned.begin(), owned.end());
+
+    FbxShardWriter writer;
+    if (!writer.Open(shardPath, shardIndex, shardCount))
+        return false;
+
+    for (uint32_t ordinal : owned)
+    {
+        FbxMesh* mesh = meshes[ordinal];
+        FbxGeometryInfo geometry = FbxSdkLibrary::GetFbxGeometry(mesh, kAttributeMask);
+        std::vector<FbxGeometryExporter::SimplifiedMesh> sections = FbxGeometryExporter::ConvertToSimplifiedMeshes(geometry);
+        geometry = FbxGeometryInfo();
+
+        for (size_t s = 0; s < sections.size(); ++s)
+        {
+            FbxLodGenerator::WeldVertices(sections[s]);
+            std::vector<uint8_t> encoded = FbxMeshCodec::Encode(sections[s], compression);
+
+            FbxShardEntry entry;
+            entry.MeshOrdinal = ordinal;
+            entry.SectionIndex = static_cast<uint32_t>(s);
+            entry.MeshId = mesh->GetUniqueID();
+            entry.MaterialId = sections[s].materialId;
+            if (!writer.Add(entry, encoded.data(), encoded.size()))
+                return false;
+        }
+    }
+
+    FBX_LOG_INFO("Shard %u/%u: %zu of %zu meshes", shardIndex + 1, shardCount, owned.size(), meshes.size());
+    return writer.Finish();
+}
+
+bool FbxShardedConverter::Merge(const std::vector<std::string>& shards, const std::string& output)
+{
+    std::vector<FbxShardReader> readers(shards.size());
+    std::vector<std::pair<FbxShardEntry, const FbxShardReader*>> entries;
+    for (size_t i = 0; i < shards.size(); ++i)
+    {
+        if (!readers[i].Open(shards[i]))
+            return false;
+        for (const FbxShardEntry& entry : readers[i].GetEntries())
+            entries.emplace_back(entry, &readers[i]);
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return EntryLess(a.first, b.first); });
+    for (size_t i = 1; i < entries.size(); ++i)
+    {
+        if (!EntryLess(entries[i - 1].first, entries[i].first))
+        {
+            FbxErrorHandler::LogError("Duplicate mesh " + std::to_string(entries[i].first.MeshOrdinal) + " in shards");
+            return false;
+        }
+    }
+
+    // 按目录顺序拷贝，合并后的数据块与目录顺序一致，顺序读取时对磁盘友好
+    FbxShardWriter writer;
+    if (!writer.Open(output))
+        return false;
+    for (const auto& item : entries)
+    {
+        if (!writer.Add(item.first, item.second->GetData(item.first), static_cast<size_t>(item.first.Size)))
+            return false;
+    }
+    return writer.Finish();
+}
+
+bool FbxShardedConverter::Convert(const std::string& input, const std::string& output, const FbxShardOptions& options)
+{
+    FbxProbeInfo info;
+    if (!FbxSdkProbe::Probe(input, info))
+    {
+        FbxErrorHandler::LogError("Failed to probe FBX file: " + input);
+        return false;
+    }
+
+    unsigned workerCount = options.WorkerCount ? options.WorkerCount : std::max(1u, std::thread::hardware_concurrency());
+    workerCount = std::max(1u, std::min<unsigned>(workerCount, info.MeshCount));
+
+    // 每个worker都导入整个场景：总占用 ≈ worker数 × SDK峰值 + 一份提取结果（各worker逐Mesh提取，合计不超过全量）
+    const FbxMemoryReport footprint = FbxMemoryAccounting::Estimate(info, kAttributeMask);
+    const uint64_t sceneBytes = std::max<uint64_t>(std::max(footprint.SdkPeakBytes, footprint.SdkBytes), 1);
+    const uint64_t extractionBytes = footprint.GetExtractionBytes();
+    const uint64_t budget = options.MemoryBudget ? options.MemoryBudget : PhysicalMemoryBytes() / 2;
+    if (budget)
+    {
+        uint64_t affordable = budget > extractionBytes ? (budget - extractionBytes) / sceneBytes : 0;
+        if (affordable == 0)
+        {
+            FbxErrorHandler::LogWarning("Estimated footprint of one shard worker exceeds the memory budget, using a single worker");
+            affordable = 1;
+        }
+        if (affordable < workerCount)
+        {
+            FBX_LOG_INFO("Shard workers limited from %u to %u by the memory budget (%llu MB, %llu MB per worker)", workerCount,
+                         static_cast<unsigned>(affordable), static_cast<unsigned long long>(budget >> 20),
+                         static_cast<unsigned long long>(sceneBytes >> 20));
+            workerCount = static_cast<unsigned>(affordable);
+        }
+    }
+
+    std::string executable = options.WorkerExecutable.empty() ? CurrentExecutable() : options.WorkerExecutable;
+    if (executable.empty())
+    {
+        FbxErrorHandler::LogError("Unable to determine the worker executable");
+        return false;
+    }
+
+    const FbxCompressionOptions& compression = options.Compression;
+    std::vector<std::string> shards(workerCount);
+    std::vector<ProcessHandle> processes(workerCount, kInvalidProcess);
+    bool success = true;
+    for (unsigned i = 0; i < workerCount; ++i)
+    {
+        shards[i] = ShardPath(output, i);
+        std::vector<std::string> arguments = {
+            kWorkerSwitch, input, shards[i], std::to_string(i), std::to_string(workerCount),
+            std::to_string(compression.PositionBits), std::to_string(compression.NormalBits),
+            std::to_string(compression.UVBits), compression.KeepColors ? "1" : "0"
+        };
+        processes[i] = SpawnProcess(executable, arguments);
+        if (processes[i] == kInvalidProcess)
+        {
+            FbxErrorHandler::LogError("Failed to start shard worker: " + executable);
+            success = false;
+            break;
+        }
+    }
+
+    for (unsigned i = 0; i < workerCount; ++i)
+    {
+        if (processes[i] != kInvalidProcess && !WaitProcess(processes[i]))
+        {
+            FbxErrorHandler::LogError("Shard worker " + std::to_string(i) + " failed");
+            success = false;
+        }
+    }
+
+    if (success)
+        success = Merge(shards, output);
+
+    if (!options.KeepShards || !success)
+    {
+        for (const std::string& shard : shards)
+            std::remove(shard.c_str());
+    }
+    return success;
+}
+
+bool FbxShardedConverter::IsWorkerCommand(int argc, char** argv)
+{
+    return argc > 1 && std::strcmp(argv[1], kWorkerSwitch) == 0;
+}
+
+int FbxShardedConverter::WorkerMain(int argc, char** argv)
+{
+    // <exe> --fbx-shard-worker <input> <shard> <index> <count> <positionBits> <normalBits> <uvBits> <keepColors>
+    if (!IsWorkerCommand(argc, argv) || argc != 10)
+    {
+        FbxErrorHandler::LogError("Invalid shard worker command line");
+        FbxLogger::Flush();
+        return 2;
+    }
+
+    FbxCompressionOptions compression;
+    compression.PositionBits = std::atoi(argv[6]);
+    compression.NormalBits = std::atoi(argv[7]);
+    compression.UVBits = std::atoi(argv[8]);
+    compression.KeepColors = std::atoi(argv[9]) != 0;
+
+    bool success = false;
+    try
+    {
+        success = ConvertShard(argv[2], argv[3], static_cast<uint32_t>(std::strtoul(argv[4], nullptr, 10)),
+                               static_cast<uint32_t>(std::strtoul(argv[5], nullptr, 10)), compression);
+    }
+    catch (const std::exception& e)
+    {
+        FbxErrorHandler::LogError(e.what());
+    }
+
+    FbxLogger::Flush();
+    return success ? 0 : 1;
+}
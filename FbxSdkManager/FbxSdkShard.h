@@ -0,0 +1,122 @@
+#pragma once
+#include "FbxSdkCompression.h"
+#include "FbxSdkStream.h"
+#include <cstdint>
+#include <fstream>
+
+/**
+ * @brief 分片容器的一个条目：一个Mesh的一个section，内容为FbxMeshCodec编码（焊接后）
+ * @note MeshOrdinal为Mesh在场景几何体列表中的序号，同一文件在任何进程中都相同，是条目的主键；
+ *       MeshId/MaterialId为各worker进程中的FbxObject唯一Id，每个worker都是以相同顺序导入同一文件的新进程，因此彼此一致
+ */
+struct FbxShardEntry
+{
+    uint32_t MeshOrdinal = 0;
+    uint32_t SectionIndex = 0;   // section在FbxGeometryInfo::Sections中的顺序
+    uint64_t MeshId = 0;
+    uint64_t MaterialId = 0;
+    uint64_t Offset = 0;         // 编码数据在容器文件中的偏移
+    uint64_t Size = 0;
+};
+
+struct FbxShardOptions
+{
+    unsigned WorkerCount = 0;            // 0表示使用硬件并发数，不超过Mesh数，再按MemoryBudget限制
+    uint64_t MemoryBudget = 0;           // 所有worker合计的内存预算（字节），0表示物理内存的一半
+    std::string WorkerExecutable;        // worker进程的可执行文件，空表示当前进程的可执行文件
+    FbxCompressionOptions Compression;
+    bool KeepShards = false;             // 合并后保留各分片文件（<output>.shard<i>）
+};
+
+/**
+ * @brief 分片容器写出器，分片与合并后的最终文件使用同一格式：
+ *       头（"FSC1"、版本、分片序号、分片数） + 编码数据块 + 目录 + 尾（目录偏移、条目数、"FSCT"）
+ * @note 编码数据块在Add时立即写入文件，内存中只保留目录
+ */
+class FbxShardWriter
+{
+public:
+    FbxShardWriter() = default;
+    ~FbxShardWriter();
+
+    FbxShardWriter(const FbxShardWriter&) = delete;
+    FbxShardWriter& operator=(const FbxShardWriter&) = delete;
+
+    bool Open(const std::string& path, uint32_t shardIndex = 0, uint32_t shardCount = 1);
+
+    /**
+     * @brief 追加一块编码数据，entry的Offset与Size由写出器填写
+     */
+    bool Add(FbxShardEntry entry, const uint8_t* data, size_t size);
+
+    /**
+     * @brief 写入目录与尾部并关闭文件
+     */
+    bool Finish();
+
+private:
+    std::string m_path;
+    std::ofstream m_file;
+    uint64_t m_position = 0;
+    std::vector<FbxShardEntry> m_entries;
+};
+
+/**
+ * @brief 分片容器读取器（内存映射，解码时不拷贝编码数据）
+ */
+class FbxShardReader
+{
+public:
+    bool Open(const std::string& path);
+    void Close();
+
+    const std::vector<FbxShardEntry>& GetEntries() const { return m_entries; }
+    uint32_t GetShardIndex() const { return m_shardIndex; }
+    uint32_t GetShardCount() const { return m_shardCount; }
+
+    const uint8_t* GetData(const FbxShardEntry& entry) const;
+    bool Read(const FbxShardEntry& entry, FbxGeometryExporter::SimplifiedMesh& mesh) const;
+
+private:
+    FbxMappedFile m_file;
+    std::vector<FbxShardEntry> m_entries;
+    uint32_t m_shardIndex = 0;
+    uint32_t m_shardCount = 0;
+};
+
+/**
+ * @brief 超大单个场景的多进程分片转换
+ * @note 协调者只用FbxSdkProbe探测Mesh数量，不导入场景；每个worker进程各自导入文件，
+ *       按多边形顶点数把Mesh贪心地均分到各分片（各worker独立算出同一划分，无需通信），
+ *       只提取属于自己的Mesh并逐个编码写出，提取结果不在内存中累积；最后合并各分片并生成按序号排序的目录。
+ *       由于每个worker都持有一份完整的SDK场景，总内存约为 worker数 × FbxMemoryAccounting::Estimate的SDK峰值，
+ *       加上至多一份全量提取结果；Convert按MemoryBudget减少worker数，调用者自己不应同时持有该场景。
+ *       宿主程序需在main开头把worker命令行转交给WorkerMain：
+ *       if (FbxShardedConverter::IsWorkerCommand(argc, argv)) return FbxShardedConverter::WorkerMain(argc, argv);
+ */
+class FbxShardedConverter
+{
+public:
+    /**
+     * @brief 启动worker进程转换input，合并结果写入output
+     */
+    static bool Convert(const std::string& input, const std::string& output, const FbxShardOptions& options = FbxShardOptions());
+
+    /**
+     * @brief 在当前进程中转换input的第shardIndex个分片（共shardCount个）
+     */
+    static bool ConvertShard(const std::string& input, const std::string& shardPath, uint32_t shardIndex, uint32_t shardCount,
+                             const FbxCompressionOptions& compression = FbxCompressionOptions());
+
+    /**
+     * @brief 合并分片：拷贝各分片的编码数据，目录按(MeshOrdinal, SectionIndex)排序
+     */
+    static bool Merge(const std::vector<std::string>& shards, const std::string& output);
+
+    static bool IsWorkerCommand(int argc, char** argv);
+
+    /**
+     * @return 进程退出码，成功为0
+     */
+    static int WorkerMain(int argc, char** argv);
+};
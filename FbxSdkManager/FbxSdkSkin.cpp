@@ -0,0 +1,327 @@
+#include "FbxSdkSkin.h"
+#include "FbxSdkParallel.h"
+#include "FbxSdkException.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+
+namespace
+{
+    // 逐控制点处理时每个任务负责的控制点数
+    const size_t kControlPointChunk = 4096;
+
+    struct ClusterRef
+    {
+        const int* Indices;
+        const double* Weights;
+        int Count;
+        uint32_t SkinJoint;  // FbxSkinInfo::Joints中的下标
+    };
+
+    struct Influence
+    {
+        uint32_t Joint;
+        float Weight;
+    };
+
+    void CollectMeshes(FbxScene* pScene, const FbxExtractionFilter& Filter, std::vector<FbxMesh*>& Meshes)
+    {
+        if (!Filter.IsEmpty())
+        {
+            FbxSdkLibrary::CollectFilteredMeshes(pScene, Filter, Meshes);
+            return;
+        }
+        for (int i = 0; i < pScene->GetGeometryCount(); ++i)
+        {
+            FbxGeometry* geometry = pScene->GetGeometry(i);
+            if (geometry && geometry->GetAttributeType() == FbxNodeAttribute::eMesh)
+            {
+                Meshes.push_back(static_cast<FbxMesh*>(geometry));
+            }
+        }
+    }
+
+    bool IsSkeletonNode(FbxNode* pNode)
+    {
+        const FbxNodeAttribute* attribute = pNode->GetNodeAttribute();
+        return attribute && attribute->GetAttributeType() == FbxNodeAttribute::eSkeleton;
+    }
+
+    /**
+     * @brief 关节集合为全部Cluster的Link及其骨骼类型的祖先，按场景深度优先顺序编号
+     */
+    void BuildSkeleton(FbxScene* pScene, const std::map<FbxNode*, FbxAMatrix>& LinkBindMatrices,
+                       std::vector<FbxJointInfo>& Skeleton, std::map<FbxNode*, int>& JointIndices)
+    {
+        std::set<FbxNode*> joints;
+        for (const auto& link : LinkBindMatrices)
+        {
+            joints.insert(link.first);
+            for (FbxNode* parent = link.first->GetParent(); parent && IsSkeletonNode(parent); parent = parent->GetParent())
+            {
+                joints.insert(parent);
+            }
+        }
+
+        // (节点, 最近的关节祖先下标)
+        std::vector<std::pair<FbxNode*, int>> stack;
+        stack.emplace_back(pScene->GetRootNode(), -1);
+        while (!stack.empty() && JointIndices.size() < joints.size())
+        {
+            FbxNode* node = stack.back().first;
+            int parent = stack.back().second;
+            stack.pop_back();
+            if (!node)
+                continue;
+
+            if (joints.count(node))
+            {
+                FbxJointInfo joint;
+                joint.Name = node->GetName() ? node->GetName() : "";
+                joint.NodeId = node->GetUniqueID();
+                joint.Parent = parent;
+                auto bind = LinkBindMatrices.find(node);
+                joint.BindMatrix = bind != LinkBindMatrices.end() ? bind->second : node->EvaluateGlobalTransform();
+                parent = static_cast<int>(Skeleton.size());
+                JointIndices[node] = parent;
+                Skeleton.push_back(joint);
+            }
+            // 逆序压栈，保持子节点的原始顺序
+            for (int i = node->GetChildCount() - 1; i >= 0; --i)
+            {
+                stack.emplace_back(node->GetChild(i), parent);
+            }
+        }
+    }
+
+    /**
+     * @brief 选出权重最大的MaxInfluences个影响，归一化后量化为unorm，舍入误差补到最大的权重上
+     */
+    template <typename TIndex, typename TWeight>
+    void PackControlPoint(Influence* Begin, Influence* End, int MaxInfluences, uint32_t WeightMax, TIndex* Indices, TWeight* Weights)
+    {
+        // 同一关节可能来自多个Cluster，先合并
+        std::sort(Begin, End, [](const Influence& a, const Influence& b) { return a.Joint < b.Joint; });
+        if (Begin != End)
+        {
+            Influence* last = Begin;
+            for (Influence* it = Begin + 1; it != End; ++it)
+            {
+                if (it->Joint == last->Joint)
+                    last->Weight += it->Weight;
+                else
+                    *++last = *it;
+            }
+            End = last + 1;
+        }
+
+        const size_t count = std::min<size_t>(End - Begin, MaxInfluences);
+        std::partial_sort(Begin, Begin + count, End, [](const Influence& a, const Influence& b)
+        {
+            return a.Weight != b.Weight ? a.Weight > b.Weight : a.Joint < b.Joint;
+        });
+
+        float sum = 0.0f;
+        for (size_t i = 0; i < count; ++i)
+        {
+            sum += std::max(0.0f, Begin[i].Weight);
+        }
+        if (sum <= 0.0f)
+        {
+            return;
+        }
+
+        uint32_t total = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint32_t q = static_cast<uint32_t>(std::lround(std::max(0.0f, Begin[i].Weight) / sum * WeightMax));
+            Indices[i] = static_cast<TIndex>(Begin[i].Joint);
+            Weights[i] = static_cast<TWeight>(std::min(q, WeightMax));
+            total += Weights[i];
+        }
+        Weights[0] = static_cast<TWeight>(static_cast<int64_t>(Weights[0]) + static_cast<int64_t>(WeightMax) - static_cast<int64_t>(total));
+    }
+
+    template <typename TIndex, typename TWeight>
+    void PackInfluences(std::vector<Influence>& Entries, const std::vector<uint32_t>& Start, int MaxInfluences,
+                        uint32_t WeightMax, unsigned ThreadCount, TIndex* Indices, TWeight* Weights)
+    {
+        const size_t pointCount = Start.size() - 1;
+        const size_t chunkCount = (pointCount + kControlPointChunk - 1) / kControlPointChunk;
+        FbxParallelFor(chunkCount, [&](size_t Chunk)
+        {
+            const size_t end = std::min(pointCount, (Chunk + 1) * kControlPointChunk);
+            for (size_t cp = Chunk * kControlPointChunk; cp < end; ++cp)
+            {
+                PackControlPoint(Entries.data() + Start[cp], Entries.data() + Start[cp + 1], MaxInfluences, WeightMax,
+                                 Indices + cp * MaxInfluences, Weights + cp * MaxInfluences);
+            }
+        }, ThreadCount);
+    }
+
+    template <typename TIndex>
+    void PackInfluences(std::vector<Influence>& Entries, const std::vector<uint32_t>& Start, const FbxSkinOptions& Options,
+                        TIndex* Indices, FbxSkinInfo& Skin)
+    {
+        const size_t slots = static_cast<size_t>(Skin.ControlPointCount) * Skin.InfluenceCount;
+        if (Options.Weights8Bit)
+        {
+            Skin.Weights8.assign(slots, 0);
+            PackInfluences(Entries, Start, Skin.InfluenceCount, 255u, Options.ThreadCount, Indices, Skin.Weights8.data());
+        }
+        else
+        {
+            Skin.Weights16.assign(slots, 0);
+            PackInfluences(Entries, Start, Skin.InfluenceCount, 65535u, Options.ThreadCount, Indices, Skin.Weights16.data());
+        }
+    }
+
+    /**
+     * @brief 把Cluster->控制点的映射倒置为控制点->影响（CSR），计数与填充都按Cluster并行
+     */
+    void InvertClusters(const std::vector<ClusterRef>& Clusters, int ControlPointCount, unsigned ThreadCount,
+                        std::vector<uint32_t>& Start, std::vector<Influence>& Entries)
+    {
+        const size_t pointCount = static_cast<size_t>(ControlPointCount);
+        std::unique_ptr<std::atomic<uint32_t>[]> cursor(new std::atomic<uint32_t>[pointCount + 1]());
+
+        FbxParallelFor(Clusters.size(), [&](size_t c)
+        {
+            const ClusterRef& cluster = Clusters[c];
+            for (int i = 0; i < cluster.Count; ++i)
+            {
+                const int cp = cluster.Indices[i];
+                if (cp >= 0 && cp < ControlPointCount)
+                    cursor[cp].fetch_add(1, std::memory_order_relaxed);
+            }
+        }, ThreadCount);
+
+        Start.assign(pointCount + 1, 0);
+        for (size_t cp = 0; cp < pointCount; ++cp)
+        {
+            Start[cp + 1] = Start[cp] + cursor[cp].load(std::memory_order_relaxed);
+            cursor[cp].store(Start[cp], std::memory_order_relaxed);
+        }
+
+        Entries.resize(Start[pointCount]);
+        FbxParallelFor(Clusters.size(), [&](size_t c)
+        {
+            const ClusterRef& cluster = Clusters[c];
+            for (int i = 0; i < cluster.Count; ++i)
+            {
+                const int cp = cluster.Indices[i];
+                if (cp >= 0 && cp < ControlPointCount)
+                {
+                    Influence& entry = Entries[cursor[cp].fetch_add(1, std::memory_order_relaxed)];
+                    entry.Joint = cluster.SkinJoint;
+                    entry.Weight = static_cast<float>(cluster.Weights[i]);
+                }
+            }
+        }, ThreadCount);
+    }
+}
+
+void FbxSkinExtractor::Extract(FbxScene* pScene, const FbxExtractionFilter& Filter, const FbxSkinOptions& Options, FbxSkinningInfo& Skinning)
+{
+    Skinning.Skeleton.clear();
+    Skinning.Skins.clear();
+    if (!pScene || !pScene->GetRootNode())
+    {
+        return;
+    }
+
+    std::vector<FbxMesh*> meshes;
+    CollectMeshes(pScene, Filter, meshes);
+
+    // 先收集全部Cluster的Link与绑定矩阵，建立场景级骨架表
+    std::vector<std::pair<FbxMesh*, std::vector<FbxCluster*>>> skinnedMeshes;
+    std::map<FbxNode*, FbxAMatrix> linkBindMatrices;
+    for (FbxMesh* mesh : meshes)
+    {
+        std::vector<FbxCluster*> clusters;
+        for (int d = 0; d < mesh->GetDeformerCount(FbxDeformer::eSkin); ++d)
+        {
+            FbxSkin* skin = static_cast<FbxSkin*>(mesh->GetDeformer(d, FbxDeformer::eSkin));
+            for (int c = 0; skin && c < skin->GetClusterCount(); ++c)
+            {
+                FbxCluster* cluster = skin->GetCluster(c);
+                if (!cluster || !cluster->GetLink())
+                    continue;
+                clusters.push_back(cluster);
+                if (!linkBindMatrices.count(cluster->GetLink()))
+                {
+                    FbxAMatrix bindMatrix;
+                    cluster->GetTransformLinkMatrix(bindMatrix);
+                    linkBindMatrices[cluster->GetLink()] = bindMatrix;
+                }
+            }
+        }
+        if (!clusters.empty())
+        {
+            skinnedMeshes.emplace_back(mesh, std::move(clusters));
+        }
+    }
+
+    std::map<FbxNode*, int> jointIndices;
+    BuildSkeleton(pScene, linkBindMatrices, Skinning.Skeleton, jointIndices);
+
+    const int maxInfluences = std::max(1, Options.MaxInfluences);
+    for (auto& skinned : skinnedMeshes)
+    {
+        FbxMesh* mesh = skinned.first;
+        FbxSkinInfo& skin = Skinning.Skins[mesh->GetUniqueID()];
+        skin.InfluenceCount = maxInfluences;
+        skin.ControlPointCount = mesh->GetControlPointsCount();
+
+        // 本蒙皮的关节列表与逆绑定矩阵：同一Link只取第一个Cluster
+        std::map<FbxNode*, uint32_t> skinJoints;
+        std::vector<ClusterRef> clusters;
+        clusters.reserve(skinned.second.size());
+        for (FbxCluster* cluster : skinned.second)
+        {
+            // 不在场景层级中的Link（如未挂到根节点下）不会进入骨架表，跳过该Cluster，不能绑定到根关节
+            FbxNode* link = cluster->GetLink();
+            auto joint = jointIndices.find(link);
+            if (joint == jointIndices.end())
+            {
+                FbxErrorHandler::LogWarning(std::string("Skin cluster of mesh ") + mesh->GetName() + " links to node " +
+                                            (link->GetName() ? link->GetName() : "") + " outside the scene hierarchy, skipped");
+                continue;
+            }
+
+            auto inserted = skinJoints.emplace(link, static_cast<uint32_t>(skin.Joints.size()));
+            if (inserted.second)
+            {
+                FbxAMatrix meshBindMatrix, linkBindMatrix;
+                cluster->GetTransformMatrix(meshBindMatrix);
+                cluster->GetTransformLinkMatrix(linkBindMatrix);
+                skin.Joints.push_back(joint->second);
+                skin.InverseBindMatrices.push_back(linkBindMatrix.Inverse() * meshBindMatrix);
+            }
+
+            ClusterRef ref;
+            ref.Indices = cluster->GetControlPointIndices();
+            ref.Weights = cluster->GetControlPointWeights();
+            ref.Count = (ref.Indices && ref.Weights) ? cluster->GetControlPointIndicesCount() : 0;
+            ref.SkinJoint = inserted.first->second;
+            clusters.push_back(ref);
+        }
+
+        std::vector<uint32_t> start;
+        std::vector<Influence> entries;
+        InvertClusters(clusters, skin.ControlPointCount, Options.ThreadCount, start, entries);
+
+        const size_t slots = static_cast<size_t>(skin.ControlPointCount) * skin.InfluenceCount;
+        if (skin.Joints.size() <= 256)
+        {
+            skin.Indices8.assign(slots, 0);
+            PackInfluences(entries, start, Options, skin.Indices8.data(), skin);
+        }
+        else
+        {
+            skin.Indices16.assign(slots, 0);
+            PackInfluences(entries, start, Options, skin.Indices16.data(), skin);
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "FbxSdkLibrary.h"
+#include <cstdint>
+
+/**
+ * @brief 骨架表中的一个关节，父关节总是排在子关节之前
+ */
+struct FbxJointInfo
+{
+    std::string Name;
+    uint64_t NodeId;
+    int Parent;              // 父关节在骨架表中的下标，-1为根
+    FbxAMatrix BindMatrix;   // 绑定姿势下的全局矩阵（无Cluster引用时取当前全局矩阵）
+};
+
+/**
+ * @brief 单个Mesh的蒙皮数据，按控制点存储，每个控制点固定InfluenceCount个影响
+ * @note 骨骼索引指向本结构的Joints（而非骨架表），关节数不超过256时使用Indices8，否则使用Indices16；
+ *       权重为unorm，每个控制点的权重和恰好为最大值（65535或255），不足的槽位索引与权重均为0
+ */
+struct FbxSkinInfo
+{
+    std::vector<int> Joints;                        // 本蒙皮用到的关节在骨架表中的下标
+    std::vector<FbxAMatrix> InverseBindMatrices;    // 与Joints一一对应
+    int InfluenceCount = 0;
+    int ControlPointCount = 0;
+    std::vector<uint8_t> Indices8;
+    std::vector<uint16_t> Indices16;
+    std::vector<uint8_t> Weights8;
+    std::vector<uint16_t> Weights16;
+
+    uint16_t GetJointIndex(int ControlPoint, int Slot) const
+    {
+        const size_t i = static_cast<size_t>(ControlPoint) * InfluenceCount + Slot;
+        return Indices8.empty() ? Indices16[i] : Indices8[i];
+    }
+
+    float GetWeight(int ControlPoint, int Slot) const
+    {
+        const size_t i = static_cast<size_t>(ControlPoint) * InfluenceCount + Slot;
+        return Weights8.empty() ? Weights16[i] / 65535.0f : Weights8[i] / 255.0f;
+    }
+};
+
+struct FbxSkinningInfo
+{
+    std::vector<FbxJointInfo> Skeleton;
+    std::map<uint64_t, FbxSkinInfo> Skins;  // 键为Mesh的Id，与GetFbxGeometries一致
+};
+
+struct FbxSkinOptions
+{
+    int MaxInfluences = 4;     // 每个控制点保留权重最大的前N个影响
+    bool Weights8Bit = false;  // true时权重量化为unorm8，否则为unorm16
+    unsigned ThreadCount = 0;  // 0表示使用硬件并发数
+};
+
+/**
+ * @brief 提取FbxSkin/FbxCluster数据：骨架表、逆绑定矩阵与压缩的逐控制点骨骼索引/权重
+ */
+class FbxSkinExtractor
+{
+public:
+    /**
+     * @brief 提取场景中（过滤器命中的）全部蒙皮Mesh
+     */
+    static void Extract(FbxScene* pScene, const FbxExtractionFilter& Filter, const FbxSkinOptions& Options, FbxSkinningInfo& Skinning);
+
+    static void Extract(FbxScene* pScene, const FbxSkinOptions& Options, FbxSkinningInfo& Skinning)
+    {
+        Extract(pScene, FbxExtractionFilter(), Options, Skinning);
+    }
+};
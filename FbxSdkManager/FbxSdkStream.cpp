@@ -0,0 +1,309 @@
+#include "FbxSdkStream.h"
+#include "FbxSdkException.h"
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const char kFbxBinaryMagic[] = "Kaydara FBX Binary";
+}
+
+FbxMemoryStream::FbxMemoryStream(FbxManager* pManager, const void* pData, size_t pSize)
+    : m_data(static_cast<const char*>(pData)), m_size(pSize), m_position(0), m_error(0),
+      m_state(eClosed), m_readerId(-1)
+{
+    // 二进制与ASCII的FBX使用不同的读取器
+    if (pManager)
+    {
+        FbxIOPluginRegistry* registry = pManager->GetIOPluginRegistry();
+        m_readerId = IsBinaryFbx(pData, pSize)
+            ? registry->FindReaderIDByDescription("FBX binary (*.fbx)")
+            : registry->FindReaderIDByDescription("FBX ascii (*.fbx)");
+    }
+}
+
+FbxMemoryStream::~FbxMemoryStream()
+{
+    Close();
+}
+
+FbxStream::EState FbxMemoryStream::GetState()
+{
+    return m_state;
+}
+
+bool FbxMemoryStream::Open(void* /*pStreamData*/)
+{
+    if (!m_data && m_size > 0)
+    {
+        return false;
+    }
+    m_position = 0;
+    m_error = 0;
+    m_state = m_size > 0 ? eOpen : eEmpty;
+    return true;
+}
+
+bool FbxMemoryStream::Close()
+{
+    m_position = 0;
+    m_state = eClosed;
+    return true;
+}
+
+bool FbxMemoryStream::Flush()
+{
+    return true;
+}
+
+size_t FbxMemoryStream::Write(const void* /*pData*/, FbxUInt64 /*pSize*/)
+{
+    // 只读流
+    m_error = 1;
+    return 0;
+}
+
+size_t FbxMemoryStream::Read(void* pData, FbxUInt64 pSize) const
+{
+    if (m_position >= m_size)
+    {
+        return 0;
+    }
+
+    const size_t available = m_size - m_position;
+    const size_t count = pSize < available ? static_cast<size_t>(pSize) : available;
+    memcpy(pData, m_data + m_position, count);
+    m_position += count;
+    return count;
+}
+
+char* FbxMemoryStream::ReadString(char* pBuffer, int pMaxSize, bool pStopAtFirstWhiteSpace)
+{
+    // 与fgets语义一致：最多读取pMaxSize-1个字符，遇到换行后停止
+    if (!pBuffer || pMaxSize <= 0 || m_position >= m_size)
+    {
+        return nullptr;
+    }
+
+    int count = 0;
+    while (count < pMaxSize - 1 && m_position < m_size)
+    {
+        const char c = m_data[m_position++];
+        pBuffer[count++] = c;
+        if (c == '\n' || (pStopAtFirstWhiteSpace && (c == ' ' || c == '\t' || c == '\r')))
+        {
+            break;
+        }
+    }
+    pBuffer[count] = '\0';
+    return pBuffer;
+}
+
+int FbxMemoryStream::GetReaderID() const
+{
+    return m_readerId;
+}
+
+int FbxMemoryStream::GetWriterID() const
+{
+    return -1;
+}
+
+void FbxMemoryStream::Seek(const FbxInt64& pOffset, const FbxFile::ESeekPos& pSeekPos)
+{
+    FbxInt64 base = 0;
+    switch (pSeekPos)
+    {
+    case FbxFile::eBegin:
+        base = 0;
+        break;
+    case FbxFile::eCurrent:
+        base = static_cast<FbxInt64>(m_position);
+        break;
+    case FbxFile::eEnd:
+        base = static_cast<FbxInt64>(m_size);
+        break;
+    }
+    SetPosition(base + pOffset);
+}
+
+FbxInt64 FbxMemoryStream::GetPosition() const
+{
+    return static_cast<FbxInt64>(m_position);
+}
+
+void FbxMemoryStream::SetPosition(FbxInt64 pPosition)
+{
+    if (pPosition < 0)
+    {
+        m_error = 1;
+        m_position = 0;
+    }
+    else if (static_cast<FbxUInt64>(pPosition) > m_size)
+    {
+        m_error = 1;
+        m_position = m_size;
+    }
+    else
+    {
+        m_position = static_cast<size_t>(pPosition);
+    }
+}
+
+int FbxMemoryStream::GetError() const
+{
+    return m_error;
+}
+
+void FbxMemoryStream::ClearError()
+{
+    m_error = 0;
+}
+
+bool FbxMemoryStream::IsBinaryFbx(const void* pData, size_t pSize)
+{
+    const size_t magicLength = sizeof(kFbxBinaryMagic) - 1;
+    return pData && pSize >= magicLength && memcmp(pData, kFbxBinaryMagic, magicLength) == 0;
+}
+
+// FbxMappedFile implementation
+#ifdef _WIN32
+
+FbxMappedFile::FbxMappedFile()
+    : m_data(nullptr), m_size(0), m_file(INVALID_HANDLE_VALUE), m_mapping(nullptr)
+{
+}
+
+bool FbxMappedFile::Open(const std::string& filename)
+{
+    Close();
+
+    m_file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                         OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+    {
+        FbxErrorHandler::LogError("Unable to open file for mapping: " + filename);
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(m_file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        FbxErrorHandler::LogError("Unable to map empty or unreadable file: " + filename);
+        Close();
+        return false;
+    }
+
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mapping)
+    {
+        FbxErrorHandler::LogError("CreateFileMapping failed: " + filename);
+        Close();
+        return false;
+    }
+
+    m_data = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!m_data)
+    {
+        FbxErrorHandler::LogError("MapViewOfFile failed: " + filename);
+        Close();
+        return false;
+    }
+
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void FbxMappedFile::Close()
+{
+    if (m_data)
+    {
+        UnmapViewOfFile(m_data);
+        m_data = nullptr;
+    }
+    if (m_mapping)
+    {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+    if (m_file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+    }
+    m_size = 0;
+}
+
+#else
+
+FbxMappedFile::FbxMappedFile()
+    : m_data(nullptr), m_size(0), m_file(-1)
+{
+}
+
+bool FbxMappedFile::Open(const std::string& filename)
+{
+    Close();
+
+    m_file = open(filename.c_str(), O_RDONLY);
+    if (m_file < 0)
+    {
+        FbxErrorHandler::LogError("Unable to open file for mapping: " + filename);
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(m_file, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        FbxErrorHandler::LogError("Unable to map empty or unreadable file: " + filename);
+        Close();
+        return false;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, m_file, 0);
+    if (data == MAP_FAILED)
+    {
+        FbxErrorHandler::LogError("mmap failed: " + filename);
+        Close();
+        return false;
+    }
+
+    // 导入器按顺序读取
+    madvise(data, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+    m_data = data;
+    m_size = static_cast<size_t>(fileStat.st_size);
+    return true;
+}
+
+void FbxMappedFile::Close()
+{
+    if (m_data)
+    {
+        munmap(const_cast<void*>(m_data), m_size);
+        m_data = nullptr;
+    }
+    if (m_file >= 0)
+    {
+        close(m_file);
+        m_file = -1;
+    }
+    m_size = 0;
+}
+
+#endif
+
+FbxMappedFile::~FbxMappedFile()
+{
+    Close();
+}
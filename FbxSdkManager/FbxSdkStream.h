@@ -0,0 +1,88 @@
+#pragma once
+#include <fbxsdk.h>
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief 只读内存流，让FbxImporter直接从内存缓冲区导入，无需先写临时文件
+ * @note 缓冲区由调用者持有，必须在Import完成之前保持有效
+ */
+class FbxMemoryStream : public FbxStream
+{
+public:
+    /**
+     * @param pManager 用于查找FBX读取器ID
+     * @param pData 缓冲区起始地址
+     * @param pSize 缓冲区字节数
+     */
+    FbxMemoryStream(FbxManager* pManager, const void* pData, size_t pSize);
+    ~FbxMemoryStream() override;
+
+    EState GetState() override;
+    bool Open(void* pStreamData) override;
+    bool Close() override;
+    bool Flush() override;
+    size_t Write(const void* pData, FbxUInt64 pSize) override;
+    size_t Read(void* pData, FbxUInt64 pSize) const override;
+    char* ReadString(char* pBuffer, int pMaxSize, bool pStopAtFirstWhiteSpace = false) override;
+    int GetReaderID() const override;
+    int GetWriterID() const override;
+    void Seek(const FbxInt64& pOffset, const FbxFile::ESeekPos& pSeekPos) override;
+    FbxInt64 GetPosition() const override;
+    void SetPosition(FbxInt64 pPosition) override;
+    int GetError() const override;
+    void ClearError() override;
+
+    /**
+     * @brief 判断缓冲区是否为二进制FBX（以"Kaydara FBX Binary"开头）
+     */
+    static bool IsBinaryFbx(const void* pData, size_t pSize);
+
+private:
+    const char* m_data;
+    size_t m_size;
+    mutable size_t m_position;
+    mutable int m_error;
+    EState m_state;
+    int m_readerId;
+};
+
+/**
+ * @brief 本地文件的只读内存映射（Windows下为MapViewOfFile，其他平台为mmap）
+ */
+class FbxMappedFile
+{
+public:
+    FbxMappedFile();
+    ~FbxMappedFile();
+
+    // 禁用拷贝
+    FbxMappedFile(const FbxMappedFile&) = delete;
+    FbxMappedFile& operator=(const FbxMappedFile&) = delete;
+
+    /**
+     * @brief 映射文件
+     * @param filename 文件路径
+     * @return 是否成功
+     */
+    bool Open(const std::string& filename);
+
+    /**
+     * @brief 解除映射并关闭文件
+     */
+    void Close();
+
+    const void* GetData() const { return m_data; }
+    size_t GetSize() const { return m_size; }
+    bool IsOpen() const { return m_data != nullptr; }
+
+private:
+    const void* m_data;
+    size_t m_size;
+#ifdef _WIN32
+    void* m_file;
+    void* m_mapping;
+#else
+    int m_file;
+#endif
+};
@@ -0,0 +1,516 @@
+#include "FbxSdkTangents.h"
+#include "FbxSdkParallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace
+{
+    /**
+     * @brief 一个几何体全部section的三角形按section顺序展开后的SoA数据
+     * @note 下标c为corner，c / 3为三角形；内层循环只读写连续的float数组，便于编译器向量化
+     */
+    struct CornerData
+    {
+        std::vector<FbxSection*> Sections;
+        std::vector<size_t> SectionOffsets;  // 每个section第一个corner的下标
+        std::vector<int> ControlPoints;
+        std::vector<float> Px, Py, Pz;
+        std::vector<float> Angles;           // corner处的内角
+        std::vector<float> Fnx, Fny, Fnz;    // 每个三角形的单位面法线
+        std::vector<int> Groups;             // 每个三角形的平滑组，为空表示整体平滑
+        std::vector<float> Nx, Ny, Nz;       // 每个corner最终使用的法线
+    };
+
+    inline void Normalize(float& x, float& y, float& z)
+    {
+        const float length = std::sqrt(x * x + y * y + z * z);
+        const float inv = length > 1e-20f ? 1.0f / length : 0.0f;
+        x *= inv;
+        y *= inv;
+        z *= inv;
+    }
+
+    inline bool IsZero(float x, float y, float z)
+    {
+        return x == 0.0f && y == 0.0f && z == 0.0f;
+    }
+
+    /**
+     * @brief 取与N最不平行的坐标轴，正交化后作为任意切线
+     */
+    inline void AnyPerpendicular(float nx, float ny, float nz, float& tx, float& ty, float& tz)
+    {
+        const bool useX = std::fabs(nx) < 0.9f;
+        const float ax = useX ? 1.0f : 0.0f;
+        const float ay = useX ? 0.0f : 1.0f;
+        const float d = nx * ax + ny * ay;
+        tx = ax - nx * d;
+        ty = ay - ny * d;
+        tz = -nz * d;
+        Normalize(tx, ty, tz);
+    }
+
+    void BuildCornerData(FbxGeometryInfo& Geometry, CornerData& Data)
+    {
+        size_t cornerCount = 0;
+        bool hasGroups = true;
+        for (auto& section : Geometry.Sections)
+        {
+            const size_t sectionCorners = section.second.Triangle.size() / 3 * 3;
+            Data.Sections.push_back(&section.second);
+            Data.SectionOffsets.push_back(cornerCount);
+            cornerCount += sectionCorners;
+            hasGroups = hasGroups && section.second.SmoothingGroups.size() == sectionCorners / 3;
+        }
+
+        const size_t triangleCount = cornerCount / 3;
+        const int pointCount = static_cast<int>(Geometry.ControlPoints.size());
+        Data.ControlPoints.resize(cornerCount);
+        Data.Px.resize(cornerCount);
+        Data.Py.resize(cornerCount);
+        Data.Pz.resize(cornerCount);
+        for (size_t s = 0; s < Data.Sections.size(); ++s)
+        {
+            const FbxSection* section = Data.Sections[s];
+            const size_t base = Data.SectionOffsets[s];
+            const size_t sectionCorners = section->Triangle.size() / 3 * 3;
+            for (size_t i = 0; i < sectionCorners; ++i)
+            {
+                int cp = section->Triangle[i];
+                cp = (cp >= 0 && cp < pointCount) ? cp : -1;
+                Data.ControlPoints[base + i] = cp;
+                if (cp >= 0)
+                {
+                    const FbxVector4& p = Geometry.ControlPoints[cp];
+                    Data.Px[base + i] = static_cast<float>(p[0]);
+                    Data.Py[base + i] = static_cast<float>(p[1]);
+                    Data.Pz[base + i] = static_cast<float>(p[2]);
+                }
+            }
+            if (hasGroups)
+            {
+                Data.Groups.insert(Data.Groups.end(), section->SmoothingGroups.begin(), section->SmoothingGroups.end());
+            }
+        }
+
+        // 面法线与corner内角：无分支的纯算术循环
+        Data.Fnx.resize(triangleCount);
+        Data.Fny.resize(triangleCount);
+        Data.Fnz.resize(triangleCount);
+        Data.Angles.resize(cornerCount);
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            const size_t c = 3 * t;
+            const float e1x = Data.Px[c + 1] - Data.Px[c], e1y = Data.Py[c + 1] - Data.Py[c], e1z = Data.Pz[c + 1] - Data.Pz[c];
+            const float e2x = Data.Px[c + 2] - Data.Px[c], e2y = Data.Py[c + 2] - Data.Py[c], e2z = Data.Pz[c + 2] - Data.Pz[c];
+            float nx = e1y * e2z - e1z * e2y;
+            float ny = e1z * e2x - e1x * e2z;
+            float nz = e1x * e2y - e1y * e2x;
+            Normalize(nx, ny, nz);
+            Data.Fnx[t] = nx;
+            Data.Fny[t] = ny;
+            Data.Fnz[t] = nz;
+
+            for (int k = 0; k < 3; ++k)
+            {
+                const size_t a = c + k, b = c + (k + 1) % 3, d = c + (k + 2) % 3;
+                const float ux = Data.Px[b] - Data.Px[a], uy = Data.Py[b] - Data.Py[a], uz = Data.Pz[b] - Data.Pz[a];
+                const float vx = Data.Px[d] - Data.Px[a], vy = Data.Py[d] - Data.Py[a], vz = Data.Pz[d] - Data.Pz[a];
+                const float lengths = std::sqrt((ux * ux + uy * uy + uz * uz) * (vx * vx + vy * vy + vz * vz));
+                const float cosine = lengths > 1e-30f ? (ux * vx + uy * vy + uz * vz) / lengths : 1.0f;
+                Data.Angles[a] = std::acos(std::min(1.0f, std::max(-1.0f, cosine)));
+            }
+        }
+    }
+
+    /**
+     * @brief 夹角加权的平滑法线，结果写入Data.Nx/Ny/Nz
+     */
+    void ComputeSmoothNormals(size_t PointCount, CornerData& Data)
+    {
+        const size_t cornerCount = Data.ControlPoints.size();
+        Data.Nx.assign(cornerCount, 0.0f);
+        Data.Ny.assign(cornerCount, 0.0f);
+        Data.Nz.assign(cornerCount, 0.0f);
+
+        if (Data.Groups.empty())
+        {
+            // 没有平滑组：共享控制点的corner全部平滑
+            std::vector<float> ax(PointCount, 0.0f), ay(PointCount, 0.0f), az(PointCount, 0.0f);
+            for (size_t c = 0; c < cornerCount; ++c)
+            {
+                const int cp = Data.ControlPoints[c];
+                if (cp < 0)
+                    continue;
+                const size_t t = c / 3;
+                ax[cp] += Data.Fnx[t] * Data.Angles[c];
+                ay[cp] += Data.Fny[t] * Data.Angles[c];
+                az[cp] += Data.Fnz[t] * Data.Angles[c];
+            }
+            for (size_t c = 0; c < cornerCount; ++c)
+            {
+                const int cp = Data.ControlPoints[c];
+                if (cp < 0)
+                    continue;
+                Data.Nx[c] = ax[cp];
+                Data.Ny[c] = ay[cp];
+                Data.Nz[c] = az[cp];
+            }
+        }
+        else
+        {
+            // 按控制点建立corner邻接表（CSR），只累加平滑组有交集的三角形
+            std::vector<size_t> start(PointCount + 1, 0);
+            for (size_t c = 0; c < cornerCount; ++c)
+            {
+                if (Data.ControlPoints[c] >= 0)
+                    ++start[Data.ControlPoints[c] + 1];
+            }
+            for (size_t p = 0; p < PointCount; ++p)
+            {
+                start[p + 1] += start[p];
+            }
+            std::vector<size_t> fill(start.begin(), start.end() - 1);
+            std::vector<size_t> adjacency(start[PointCount]);
+            for (size_t c = 0; c < cornerCount; ++c)
+            {
+                if (Data.ControlPoints[c] >= 0)
+                    adjacency[fill[Data.ControlPoints[c]]++] = c;
+            }
+
+            for (size_t c = 0; c < cornerCount; ++c)
+            {
+                const int cp = Data.ControlPoints[c];
+                const size_t t = c / 3;
+                const int group = Data.Groups[t];
+                if (cp < 0 || group == 0)
+                {
+                    // 平滑组为0表示该面不参与平滑
+                    Data.Nx[c] = Data.Fnx[t];
+                    Data.Ny[c] = Data.Fny[t];
+                    Data.Nz[c] = Data.Fnz[t];
+                    continue;
+                }
+                float x = 0.0f, y = 0.0f, z = 0.0f;
+                for (size_t i = start[cp]; i < start[cp + 1]; ++i)
+                {
+                    const size_t other = adjacency[i];
+                    const size_t ot = other / 3;
+                    const float weight = (Data.Groups[ot] & group) != 0 ? Data.Angles[other] : 0.0f;
+                    x += Data.Fnx[ot] * weight;
+                    y += Data.Fny[ot] * weight;
+                    z += Data.Fnz[ot] * weight;
+                }
+                Data.Nx[c] = x;
+                Data.Ny[c] = y;
+                Data.Nz[c] = z;
+            }
+        }
+
+        for (size_t c = 0; c < cornerCount; ++c)
+        {
+            Normalize(Data.Nx[c], Data.Ny[c], Data.Nz[c]);
+            // 退化情况（例如正反两面抵消）退回面法线
+            const size_t t = c / 3;
+            if (IsZero(Data.Nx[c], Data.Ny[c], Data.Nz[c]))
+            {
+                Data.Nx[c] = Data.Fnx[t];
+                Data.Ny[c] = Data.Fny[t];
+                Data.Nz[c] = Data.Fnz[t];
+            }
+        }
+    }
+
+    /**
+     * @brief MikkTSpace合并corner的依据：同一控制点、相同的法线与UV、相同的手性
+     */
+    struct WeldKey
+    {
+        int ControlPoint;
+        float Nx, Ny, Nz;
+        float U, V;
+        bool Flipped;
+
+        bool operator==(const WeldKey& other) const
+        {
+            return ControlPoint == other.ControlPoint && Nx == other.Nx && Ny == other.Ny && Nz == other.Nz
+                && U == other.U && V == other.V && Flipped == other.Flipped;
+        }
+    };
+
+    struct WeldKeyHash
+    {
+        size_t operator()(const WeldKey& key) const
+        {
+            uint32_t bits[5];
+            memcpy(&bits[0], &key.Nx, sizeof(float));
+            memcpy(&bits[1], &key.Ny, sizeof(float));
+            memcpy(&bits[2], &key.Nz, sizeof(float));
+            memcpy(&bits[3], &key.U, sizeof(float));
+            memcpy(&bits[4], &key.V, sizeof(float));
+            size_t hash = static_cast<size_t>(key.ControlPoint) * 2 + (key.Flipped ? 1 : 0);
+            for (uint32_t b : bits)
+            {
+                hash ^= b + 0x9e3779b9u + (hash << 6) + (hash >> 2);
+            }
+            return hash;
+        }
+    };
+
+    /**
+     * @brief 计算每个corner的切线与手性
+     * @param UVSet 使用的UV套
+     * @param HasUV 为false时为每个corner生成与法线正交的任意切线
+     */
+    void ComputeTangents(const CornerData& Data, int UVSet, bool HasUV,
+                         std::vector<float>& Tx, std::vector<float>& Ty, std::vector<float>& Tz, std::vector<float>& Sign)
+    {
+        const size_t cornerCount = Data.ControlPoints.size();
+        const size_t triangleCount = cornerCount / 3;
+        Tx.assign(cornerCount, 0.0f);
+        Ty.assign(cornerCount, 0.0f);
+        Tz.assign(cornerCount, 0.0f);
+        Sign.assign(cornerCount, 1.0f);
+
+        if (!HasUV)
+        {
+            for (size_t c = 0; c < cornerCount; ++c)
+            {
+                AnyPerpendicular(Data.Nx[c], Data.Ny[c], Data.Nz[c], Tx[c], Ty[c], Tz[c]);
+            }
+            return;
+        }
+
+        std::vector<float> U(cornerCount), V(cornerCount);
+        for (size_t s = 0; s < Data.Sections.size(); ++s)
+        {
+            const FbxSection* section = Data.Sections[s];
+            const size_t base = Data.SectionOffsets[s];
+            const size_t end = s + 1 < Data.Sections.size() ? Data.SectionOffsets[s + 1] : cornerCount;
+            for (size_t c = base; c < end; ++c)
+            {
+                const FbxVector2& uv = section->UVSets[UVSet].UVs[c - base];
+                U[c] = static_cast<float>(uv[0]);
+                V[c] = static_cast<float>(uv[1]);
+            }
+        }
+
+        // 逐面切线方向与手性，与MikkTSpace的vOs相同：sign(area) * (t31y * d1 - t21y * d2)
+        std::vector<float> fx(triangleCount), fy(triangleCount), fz(triangleCount), fs(triangleCount);
+        std::vector<float> fvalid(triangleCount);
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            const size_t c = 3 * t;
+            const float d1x = Data.Px[c + 1] - Data.Px[c], d1y = Data.Py[c + 1] - Data.Py[c], d1z = Data.Pz[c + 1] - Data.Pz[c];
+            const float d2x = Data.Px[c + 2] - Data.Px[c], d2y = Data.Py[c + 2] - Data.Py[c], d2z = Data.Pz[c + 2] - Data.Pz[c];
+            const float t21x = U[c + 1] - U[c], t21y = V[c + 1] - V[c];
+            const float t31x = U[c + 2] - U[c], t31y = V[c + 2] - V[c];
+            const float area = t21x * t31y - t21y * t31x;
+            const float sign = area > 0.0f ? 1.0f : -1.0f;
+            fx[t] = sign * (t31y * d1x - t21y * d2x);
+            fy[t] = sign * (t31y * d1y - t21y * d2y);
+            fz[t] = sign * (t31y * d1z - t21y * d2z);
+            fs[t] = sign;
+            // UV面积为0的三角形不贡献切线
+            fvalid[t] = std::fabs(area) > 1e-20f ? 1.0f : 0.0f;
+        }
+
+        // 把面切线投影到corner法线所在切平面
+        std::vector<float> px(cornerCount), py(cornerCount), pz(cornerCount);
+        for (size_t c = 0; c < cornerCount; ++c)
+        {
+            const size_t t = c / 3;
+            const float nx = Data.Nx[c], ny = Data.Ny[c], nz = Data.Nz[c];
+            const float d = fx[t] * nx + fy[t] * ny + fz[t] * nz;
+            float x = fx[t] - nx * d, y = fy[t] - ny * d, z = fz[t] - nz * d;
+            Normalize(x, y, z);
+            const float weight = Data.Angles[c] * fvalid[t];
+            px[c] = x * weight;
+            py[c] = y * weight;
+            pz[c] = z * weight;
+        }
+
+        // 按(控制点, 法线, UV, 手性)合并
+        std::unordered_map<WeldKey, size_t, WeldKeyHash> groups;
+        groups.reserve(cornerCount);
+        std::vector<size_t> groupOfCorner(cornerCount);
+        std::vector<float> gx, gy, gz;
+        gx.reserve(cornerCount);
+        gy.reserve(cornerCount);
+        gz.reserve(cornerCount);
+        for (size_t c = 0; c < cornerCount; ++c)
+        {
+            const WeldKey key = { Data.ControlPoints[c], Data.Nx[c], Data.Ny[c], Data.Nz[c], U[c], V[c], fs[c / 3] < 0.0f };
+            auto inserted = groups.emplace(key, gx.size());
+            if (inserted.second)
+            {
+                gx.push_back(0.0f);
+                gy.push_back(0.0f);
+                gz.push_back(0.0f);
+            }
+            const size_t group = inserted.first->second;
+            groupOfCorner[c] = group;
+            gx[group] += px[c];
+            gy[group] += py[c];
+            gz[group] += pz[c];
+        }
+
+        for (size_t c = 0; c < cornerCount; ++c)
+        {
+            const size_t group = groupOfCorner[c];
+            float x = gx[group], y = gy[group], z = gz[group];
+            Normalize(x, y, z);
+            if (IsZero(x, y, z))
+            {
+                AnyPerpendicular(Data.Nx[c], Data.Ny[c], Data.Nz[c], x, y, z);
+            }
+            Tx[c] = x;
+            Ty[c] = y;
+            Tz[c] = z;
+            Sign[c] = fs[c / 3];
+        }
+    }
+}
+
+bool FbxTangentGenerator::IsStreamMissing(const std::pmr::vector<FbxVector4>& Stream, size_t CornerCount)
+{
+    if (Stream.size() != CornerCount)
+    {
+        return true;
+    }
+    for (const FbxVector4& value : Stream)
+    {
+        if (value[0] != 0.0 || value[1] != 0.0 || value[2] != 0.0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void FbxTangentGenerator::Generate(FbxGeometryInfo& Geometry, const FbxTangentOptions& Options)
+{
+    const bool wantNormals = (Options.AttributeMask & FBX_ATTRIBUTE_NORMAL) != 0;
+    const bool wantTangents = (Options.AttributeMask & FBX_ATTRIBUTE_TANGENT) != 0;
+    const bool wantBinormals = (Options.AttributeMask & FBX_ATTRIBUTE_BINORMAL) != 0;
+
+    // 逐section判断哪些流需要补齐
+    bool anyNormalMissing = false, generateNormals = false, generateTangents = false, hasUV = true;
+    for (const auto& section : Geometry.Sections)
+    {
+        const FbxSection& s = section.second;
+        const size_t corners = s.Triangle.size() / 3 * 3;
+        const bool normalMissing = IsStreamMissing(s.Normals, corners);
+        anyNormalMissing = anyNormalMissing || normalMissing;
+        generateNormals = generateNormals || (wantNormals && (Options.ForceNormals || normalMissing));
+        generateTangents = generateTangents
+            || (wantTangents && (Options.ForceTangents || IsStreamMissing(s.Tangents, corners)))
+            || (wantBinormals && (Options.ForceTangents || IsStreamMissing(s.Binormals, corners)));
+        hasUV = hasUV && Options.UVSet >= 0 && Options.UVSet < static_cast<int>(s.UVSets.size())
+            && s.UVSets[Options.UVSet].UVs.size() >= corners;
+    }
+    if (!generateNormals && !generateTangents)
+    {
+        return;
+    }
+
+    CornerData data;
+    BuildCornerData(Geometry, data);
+    const size_t cornerCount = data.ControlPoints.size();
+
+    // 需要写回法线，或切线计算缺少可用法线时才重新计算
+    if (generateNormals || anyNormalMissing || Options.ForceNormals)
+    {
+        ComputeSmoothNormals(Geometry.ControlPoints.size(), data);
+    }
+    else
+    {
+        data.Nx.resize(cornerCount);
+        data.Ny.resize(cornerCount);
+        data.Nz.resize(cornerCount);
+    }
+
+    // 没有重新生成的section沿用文件中的法线
+    for (size_t s = 0; s < data.Sections.size(); ++s)
+    {
+        FbxSection* section = data.Sections[s];
+        const size_t base = data.SectionOffsets[s];
+        const size_t corners = section->Triangle.size() / 3 * 3;
+        const bool regenerate = Options.ForceNormals || IsStreamMissing(section->Normals, corners);
+        if (!regenerate)
+        {
+            for (size_t i = 0; i < corners; ++i)
+            {
+                float x = static_cast<float>(section->Normals[i][0]);
+                float y = static_cast<float>(section->Normals[i][1]);
+                float z = static_cast<float>(section->Normals[i][2]);
+                Normalize(x, y, z);
+                data.Nx[base + i] = x;
+                data.Ny[base + i] = y;
+                data.Nz[base + i] = z;
+            }
+        }
+        else if (wantNormals)
+        {
+            section->Normals.resize(corners);
+            for (size_t i = 0; i < corners; ++i)
+            {
+                section->Normals[i] = FbxVector4(data.Nx[base + i], data.Ny[base + i], data.Nz[base + i]);
+            }
+        }
+    }
+
+    if (!generateTangents)
+    {
+        return;
+    }
+
+    std::vector<float> tx, ty, tz, sign;
+    ComputeTangents(data, Options.UVSet, hasUV, tx, ty, tz, sign);
+    for (size_t s = 0; s < data.Sections.size(); ++s)
+    {
+        FbxSection* section = data.Sections[s];
+        const size_t base = data.SectionOffsets[s];
+        const size_t corners = section->Triangle.size() / 3 * 3;
+        const bool writeTangents = wantTangents && (Options.ForceTangents || IsStreamMissing(section->Tangents, corners));
+        const bool writeBinormals = wantBinormals && (Options.ForceTangents || IsStreamMissing(section->Binormals, corners));
+        if (writeTangents)
+        {
+            section->Tangents.resize(corners);
+            for (size_t i = 0; i < corners; ++i)
+            {
+                const size_t c = base + i;
+                section->Tangents[i] = FbxVector4(tx[c], ty[c], tz[c], sign[c]);
+            }
+        }
+        if (writeBinormals)
+        {
+            section->Binormals.resize(corners);
+            for (size_t i = 0; i < corners; ++i)
+            {
+                const size_t c = base + i;
+                const float nx = data.Nx[c], ny = data.Ny[c], nz = data.Nz[c];
+                section->Binormals[i] = FbxVector4(sign[c] * (ny * tz[c] - nz * ty[c]),
+                                                   sign[c] * (nz * tx[c] - nx * tz[c]),
+                                                   sign[c] * (nx * ty[c] - ny * tx[c]));
+            }
+        }
+    }
+}
+
+void FbxTangentGenerator::Generate(std::map<uint64_t, FbxGeometryInfo>& Geometries, const FbxTangentOptions& Options)
+{
+    std::vector<FbxGeometryInfo*> geometries;
+    geometries.reserve(Geometries.size());
+    for (auto& geometry : Geometries)
+    {
+        geometries.push_back(&geometry.second);
+    }
+
+    FbxParallelFor(geometries.size(), [&](size_t Index)
+    {
+        Generate(*geometries[Index], Options);
+    }, Options.ThreadCount);
+}
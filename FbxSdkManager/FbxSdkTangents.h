@@ -0,0 +1,45 @@
+#pragma once
+#include "FbxSdkLibrary.h"
+
+/**
+ * @brief 法线/切线生成选项
+ */
+struct FbxTangentOptions
+{
+    // 需要补齐的属性流，只识别NORMAL/TANGENT/BINORMAL
+    uint32_t AttributeMask = FBX_ATTRIBUTE_NORMAL | FBX_ATTRIBUTE_TANGENT | FBX_ATTRIBUTE_BINORMAL;
+    // 为true时即使文件中已有该层也重新计算
+    bool ForceNormals = false;
+    bool ForceTangents = false;
+    // 计算切线所用的UV套（FbxSection::UVSets的下标）
+    int UVSet = 0;
+    // 并行处理几何体的线程数，0表示使用硬件并发数
+    unsigned ThreadCount = 0;
+};
+
+/**
+ * @brief 在提取后的FbxSection上直接计算缺失的法线、切线与Binormal
+ * @note 法线：按corner夹角加权，仅在平滑组有交集的三角形之间平滑（无平滑组时整体平滑）。
+ *       切线：与MikkTSpace一致的逐面切线基，投影到corner法线后按夹角加权，
+ *             在相同(控制点, 法线, UV, 手性)的corner之间合并；tangent.w为手性，
+ *             binormal = w * cross(N, T)。
+ *       某个流为空、长度不符或xyz全为0时视为缺失。
+ */
+class FbxTangentGenerator
+{
+public:
+    /**
+     * @brief 处理单个几何体
+     */
+    static void Generate(FbxGeometryInfo& Geometry, const FbxTangentOptions& Options = FbxTangentOptions());
+
+    /**
+     * @brief 并行处理全部几何体（几何体之间互不依赖）
+     */
+    static void Generate(std::map<uint64_t, FbxGeometryInfo>& Geometries, const FbxTangentOptions& Options = FbxTangentOptions());
+
+    /**
+     * @brief 判断属性流是否缺失：长度与corner数不符，或xyz全为0
+     */
+    static bool IsStreamMissing(const std::pmr::vector<FbxVector4>& Stream, size_t CornerCount);
+};
@@ -0,0 +1,442 @@
+#include "FbxSdkTexture.h"
+#include "FbxSdkException.h"
+#include "FbxSdkHash.h"
+#include "FbxSdkParallel.h"
+#include "FbxSdkProbe.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <map>
+#include <system_error>
+
+namespace
+{
+    std::string BaseName(const std::string& path)
+    {
+        const size_t slash = path.find_last_of("/\\");
+        return slash == std::string::npos ? path : path.substr(slash + 1);
+    }
+
+    std::string DirectoryOf(const std::string& path)
+    {
+        const size_t slash = path.find_last_of("/\\");
+        return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+    }
+
+    std::string Lower(std::string text)
+    {
+        std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return text;
+    }
+
+    /**
+     * @brief 贴图路径多来自Windows，其他平台上需要把反斜杠换成正斜杠
+     */
+    std::string NativePath(std::string path)
+    {
+#ifndef _WIN32
+        std::replace(path.begin(), path.end(), '\\', '/');
+#endif
+        return path;
+    }
+
+    bool IsFile(const std::string& path)
+    {
+        std::error_code error;
+        return !path.empty() && std::filesystem::is_regular_file(std::filesystem::path(path), error);
+    }
+
+    struct Source
+    {
+        std::string Path;
+        bool Embedded = false;
+        uint64_t Offset = 0;
+        uint64_t Size = 0;
+        uint64_t Hash = 0;
+        FbxImageFormat Format = FBX_IMAGE_UNKNOWN;
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        bool Readable = false;
+    };
+}
+
+std::shared_ptr<const FbxImage> FbxImageCache::Get(uint32_t key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = m_entries.find(key);
+    if (found == m_entries.end())
+    {
+        ++m_misses;
+        return nullptr;
+    }
+    ++m_hits;
+    m_order.splice(m_order.begin(), m_order, found->second.Position);
+    return found->second.Image;
+}
+
+void FbxImageCache::Put(uint32_t key, std::shared_ptr<const FbxImage> image)
+{
+    if (!image)
+        return;
+
+    const uint64_t bytes = image->GetByteSize();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = m_entries.find(key);
+    if (found != m_entries.end())
+    {
+        m_bytes -= found->second.Bytes;
+        m_order.erase(found->second.Position);
+        m_entries.erase(found);
+    }
+    if (bytes > m_budget)
+        return;
+
+    m_order.push_front(key);
+    Entry& entry = m_entries[key];
+    entry.Image = std::move(image);
+    entry.Bytes = bytes;
+    entry.Position = m_order.begin();
+    m_bytes += bytes;
+    Evict(m_budget);
+}
+
+void FbxImageCache::SetBudget(uint64_t budgetBytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_budget = budgetBytes;
+    Evict(m_budget);
+}
+
+void FbxImageCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_order.clear();
+    m_entries.clear();
+    m_bytes = 0;
+}
+
+void FbxImageCache::Evict(uint64_t budgetBytes)
+{
+    while (m_bytes > budgetBytes && !m_order.empty())
+    {
+        auto found = m_entries.find(m_order.back());
+        m_bytes -= found->second.Bytes;
+        m_entries.erase(found);
+        m_order.pop_back();
+        ++m_evictions;
+    }
+}
+
+uint64_t FbxImageCache::GetBudget() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_budget;
+}
+
+uint64_t FbxImageCache::GetBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bytes;
+}
+
+size_t FbxImageCache::GetCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+uint64_t FbxImageCache::GetHits() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+uint64_t FbxImageCache::GetMisses() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
+
+uint64_t FbxImageCache::GetEvictions() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_evictions;
+}
+
+void FbxTextureSet::Clear()
+{
+    m_textures.clear();
+    m_images.clear();
+    m_textureById.clear();
+    m_imageByFileName.clear();
+    m_fbx.Close();
+    m_cache.Clear();
+}
+
+bool FbxTextureSet::Build(FbxScene* pScene, const std::string& fbxPath, const FbxTextureOptions& options)
+{
+    Clear();
+    m_options = options;
+    m_cache.SetBudget(options.CacheBudgetBytes);
+    if (!pScene)
+        return false;
+
+    // 内嵌媒体只登记偏移，内容留在映射中，按需读取
+    std::vector<FbxEmbeddedMedia> media;
+    std::unordered_map<std::string, size_t> mediaByName;
+    if (IsFile(fbxPath) && m_fbx.Open(fbxPath))
+    {
+        FbxSdkProbe::ListEmbeddedMedia(m_fbx.GetData(), m_fbx.GetSize(), media);
+        for (size_t i = 0; i < media.size(); ++i)
+        {
+            mediaByName.emplace(Lower(BaseName(media[i].FileName)), i);
+            mediaByName.emplace(Lower(BaseName(media[i].RelativeFileName)), i);
+        }
+    }
+
+    const std::string directory = NativePath(DirectoryOf(fbxPath));
+    std::vector<std::string> roots;
+    roots.push_back(directory);
+    if (!fbxPath.empty())
+    {
+        const std::string name = BaseName(fbxPath);
+        roots.push_back(directory + name.substr(0, name.find_last_of('.')) + ".fbm/");
+    }
+    for (const std::string& searchPath : options.SearchPaths)
+    {
+        if (!searchPath.empty())
+            roots.push_back(NativePath(searchPath) + (searchPath.back() == '/' || searchPath.back() == '\\' ? "" : "/"));
+    }
+
+    for (int i = 0; i < pScene->GetTextureCount(); ++i)
+    {
+        FbxFileTexture* pTexture = FbxCast<FbxFileTexture>(pScene->GetTexture(i));
+        if (!pTexture)
+            continue;
+        FbxTextureInfo texture;
+        texture.Id = pTexture->GetUniqueID();
+        texture.Name = pTexture->GetName() ? pTexture->GetName() : "";
+        texture.FileName = pTexture->GetFileName() ? pTexture->GetFileName() : "";
+        texture.RelativeFileName = pTexture->GetRelativeFileName() ? pTexture->GetRelativeFileName() : "";
+        if (m_textureById.emplace(texture.Id, static_cast<uint32_t>(m_textures.size())).second)
+            m_textures.push_back(std::move(texture));
+    }
+
+    // 多个贴图对象常引用同一文件，同一路径只解析一次
+    std::vector<Source> sources;
+    std::unordered_map<std::string, uint32_t> sourceByName;
+    std::vector<uint32_t> textureSource(m_textures.size(), npos);
+    for (size_t t = 0; t < m_textures.size(); ++t)
+    {
+        const FbxTextureInfo& texture = m_textures[t];
+        const std::string& key = texture.FileName.empty() ? texture.RelativeFileName : texture.FileName;
+        if (key.empty())
+            continue;
+        auto resolved = sourceByName.find(key);
+        if (resolved != sourceByName.end())
+        {
+            textureSource[t] = resolved->second;
+            continue;
+        }
+
+        Source source;
+        const std::string baseName = BaseName(key);
+        auto embedded = mediaByName.find(Lower(baseName));
+        if (embedded == mediaByName.end() && !texture.RelativeFileName.empty())
+            embedded = mediaByName.find(Lower(BaseName(texture.RelativeFileName)));
+        if (embedded != mediaByName.end())
+        {
+            const FbxEmbeddedMedia& item = media[embedded->second];
+            source.Path = item.FileName.empty() ? item.RelativeFileName : item.FileName;
+            source.Embedded = true;
+            source.Offset = item.Offset;
+            source.Size = item.Size;
+        }
+        else
+        {
+            std::vector<std::string> candidates;
+            candidates.push_back(NativePath(texture.FileName));
+            if (!texture.RelativeFileName.empty())
+                candidates.push_back(directory + NativePath(texture.RelativeFileName));
+            for (const std::string& root : roots)
+                candidates.push_back(root + baseName);
+            for (const std::string& candidate : candidates)
+            {
+                if (IsFile(candidate))
+                {
+                    source.Path = candidate;
+                    break;
+                }
+            }
+        }
+
+        uint32_t index = npos;
+        if (source.Embedded || !source.Path.empty())
+        {
+            index = static_cast<uint32_t>(sources.size());
+            sources.push_back(std::move(source));
+        }
+        else
+        {
+            FbxErrorHandler::LogWarning("Texture not found: " + key);
+        }
+        sourceByName.emplace(key, index);
+        textureSource[t] = index;
+    }
+
+    // 哈希与读取尺寸只触及映射的页面，并行进行
+    FbxParallelFor(sources.size(), [&](size_t i)
+    {
+        Source& source = sources[i];
+        FbxMappedFile file;
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        if (source.Embedded)
+        {
+            data = static_cast<const uint8_t*>(m_fbx.GetData()) + source.Offset;
+            size = static_cast<size_t>(source.Size);
+        }
+        else if (file.Open(source.Path))
+        {
+            data = static_cast<const uint8_t*>(file.GetData());
+            size = file.GetSize();
+        }
+        if (!data)
+            return;
+
+        FbxContentHasher hasher;
+        hasher.Add(data, size);
+        source.Hash = hasher.Get();
+        source.Size = size;
+        source.Format = FbxImageCodec::DetectFormat(data, size, source.Path);
+        FbxImageCodec::ReadDimensions(data, size, source.Format, source.Width, source.Height);
+        source.Readable = true;
+    }, options.ThreadCount);
+
+    // 内容相同（哈希与长度都相等）的文件合并为一份图像，内嵌内容优先作为代表
+    std::map<std::pair<uint64_t, uint64_t>, uint32_t> imageByContent;
+    std::vector<uint32_t> sourceImage(sources.size(), npos);
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+        const Source& source = sources[i];
+        if (!source.Readable)
+            continue;
+        auto inserted = imageByContent.emplace(std::make_pair(source.Hash, source.Size), static_cast<uint32_t>(m_images.size()));
+        sourceImage[i] = inserted.first->second;
+        if (!inserted.second && (!source.Embedded || m_images[sourceImage[i]].Embedded))
+            continue;
+
+        FbxImageInfo info;
+        info.ContentHash = source.Hash;
+        info.Size = source.Size;
+        info.Format = source.Format;
+        info.Width = source.Width;
+        info.Height = source.Height;
+        info.Embedded = source.Embedded;
+        info.Path = source.Path;
+        info.EmbeddedOffset = source.Offset;
+        if (inserted.second)
+            m_images.push_back(std::move(info));
+        else
+            m_images[sourceImage[i]] = std::move(info);
+    }
+
+    for (size_t t = 0; t < m_textures.size(); ++t)
+    {
+        FbxTextureInfo& texture = m_textures[t];
+        if (textureSource[t] != npos)
+            texture.Image = sourceImage[textureSource[t]];
+        if (!texture.FileName.empty())
+            m_imageByFileName.emplace(texture.FileName, texture.Image);
+    }
+
+    if (options.Decode)
+    {
+        // 每个任务只写自己的图像条目，缓存自带锁；超出预算的图像解码后即被淘汰，GetImage时重新解码
+        FbxParallelFor(m_images.size(), [&](size_t i)
+        {
+            std::string error;
+            std::shared_ptr<const FbxImage> image = DecodeImage(static_cast<uint32_t>(i), error);
+            if (image)
+                m_cache.Put(static_cast<uint32_t>(i), std::move(image));
+            else
+                m_images[i].Error = error;
+        }, options.ThreadCount);
+
+        for (const FbxImageInfo& info : m_images)
+        {
+            if (!info.Error.empty())
+                FbxErrorHandler::LogWarning("Failed to decode texture " + info.Path + ": " + info.Error);
+        }
+    }
+    return true;
+}
+
+uint32_t FbxTextureSet::FindTexture(uint64_t id) const
+{
+    auto found = m_textureById.find(id);
+    return found != m_textureById.end() ? found->second : npos;
+}
+
+uint32_t FbxTextureSet::FindImage(const std::string& fileName) const
+{
+    auto found = m_imageByFileName.find(fileName);
+    return found != m_imageByFileName.end() ? found->second : npos;
+}
+
+std::shared_ptr<const FbxImage> FbxTextureSet::GetImage(uint32_t index)
+{
+    if (index >= m_images.size())
+        return nullptr;
+
+    std::shared_ptr<const FbxImage> image = m_cache.Get(index);
+    if (image)
+        return image;
+
+    std::string error;
+    image = DecodeImage(index, error);
+    if (!image)
+    {
+        FbxErrorHandler::LogWarning("Failed to decode texture " + m_images[index].Path + ": " + error);
+        return nullptr;
+    }
+    m_cache.Put(index, image);
+    return image;
+}
+
+std::shared_ptr<const FbxImage> FbxTextureSet::DecodeImage(uint32_t index, std::string& error) const
+{
+    const FbxImageInfo& info = m_images[index];
+    FbxMappedFile file;
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    if (info.Embedded)
+    {
+        if (!m_fbx.IsOpen() || info.EmbeddedOffset + info.Size > m_fbx.GetSize())
+        {
+            error = "Embedded media is no longer available";
+            return nullptr;
+        }
+        data = static_cast<const uint8_t*>(m_fbx.GetData()) + info.EmbeddedOffset;
+        size = static_cast<size_t>(info.Size);
+    }
+    else
+    {
+        if (!file.Open(info.Path))
+        {
+            error = "Unable to open file";
+            return nullptr;
+        }
+        data = static_cast<const uint8_t*>(file.GetData());
+        size = file.GetSize();
+    }
+
+    auto image = std::make_shared<FbxImage>();
+    if (!FbxImageCodec::Decode(data, size, info.Format, image->Base, &error))
+        return nullptr;
+    if (m_options.GenerateMips)
+        FbxImageCodec::GenerateMips(*image);
+    if (m_options.ThumbnailSize > 0)
+        FbxImageCodec::GenerateThumbnail(*image, m_options.ThumbnailSize);
+    return image;
+}
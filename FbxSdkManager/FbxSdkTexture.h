@@ -0,0 +1,151 @@
+#pragma once
+#include "FbxSdkImage.h"
+#include "FbxSdkStream.h"
+#include <fbxsdk.h>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct FbxTextureOptions
+{
+    std::vector<std::string> SearchPaths;       // FBX所在目录之后依次查找的目录
+    unsigned ThreadCount = 0;                   // 0表示使用硬件并发数
+    bool Decode = true;                         // false时只解析路径、去重并读取尺寸
+    bool GenerateMips = false;
+    uint32_t ThumbnailSize = 0;                 // 缩略图最长边，0表示不生成
+    uint64_t CacheBudgetBytes = 256ull << 20;   // 已解码图像的缓存上限
+};
+
+/**
+ * @brief 场景中的一个FbxFileTexture
+ */
+struct FbxTextureInfo
+{
+    uint64_t Id = 0;
+    std::string Name;
+    std::string FileName;           // FbxFileTexture::GetFileName，与FbxMaterialsInfo中的Texture一致
+    std::string RelativeFileName;
+    uint32_t Image = UINT32_MAX;    // 去重后的图像下标，无法解析时为UINT32_MAX
+};
+
+/**
+ * @brief 去重后的一份图像内容
+ */
+struct FbxImageInfo
+{
+    uint64_t ContentHash = 0;
+    uint64_t Size = 0;
+    FbxImageFormat Format = FBX_IMAGE_UNKNOWN;
+    uint32_t Width = 0;
+    uint32_t Height = 0;
+    bool Embedded = false;          // 内容嵌在FBX文件中
+    std::string Path;               // 磁盘文件为解析后的路径，嵌入媒体为其Filename
+    uint64_t EmbeddedOffset = 0;    // 嵌入媒体在FBX文件中的偏移
+    std::string Error;              // Build时无法读取或解码的原因
+};
+
+/**
+ * @brief 按字节预算的LRU图像缓存，线程安全
+ * @note 取出的图像以shared_ptr持有，被淘汰后仍对持有者有效；超过整个预算的单张图像不缓存
+ */
+class FbxImageCache
+{
+public:
+    explicit FbxImageCache(uint64_t budgetBytes = 256ull << 20) : m_budget(budgetBytes) {}
+
+    std::shared_ptr<const FbxImage> Get(uint32_t key);
+    void Put(uint32_t key, std::shared_ptr<const FbxImage> image);
+    void SetBudget(uint64_t budgetBytes);
+    void Clear();
+
+    uint64_t GetBudget() const;
+    uint64_t GetBytes() const;
+    size_t GetCount() const;
+    uint64_t GetHits() const;
+    uint64_t GetMisses() const;
+    uint64_t GetEvictions() const;
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<const FbxImage> Image;
+        uint64_t Bytes = 0;
+        std::list<uint32_t>::iterator Position;
+    };
+
+    void Evict(uint64_t budgetBytes);
+
+    mutable std::mutex m_mutex;
+    std::list<uint32_t> m_order;    // 最近使用的在前
+    std::unordered_map<uint32_t, Entry> m_entries;
+    uint64_t m_budget;
+    uint64_t m_bytes = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+};
+
+/**
+ * @brief 场景贴图集：解析贴图路径，按内容哈希去重，并在线程池上并行解码
+ * @note 路径按以下顺序解析：FBX内嵌媒体（直接从映射的FBX文件中读取，只提取一次）、原始路径、
+ *       FBX目录下的相对路径、FBX目录下的文件名、SDK导出的<名字>.fbm目录、SearchPaths中的文件名。
+ *       同一路径只解析一次，内容相同的文件只保留一份图像。SDK对象只在调用Build的线程上访问
+ */
+class FbxTextureSet
+{
+public:
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    FbxTextureSet() = default;
+
+    // 持有FBX文件的映射，禁用拷贝
+    FbxTextureSet(const FbxTextureSet&) = delete;
+    FbxTextureSet& operator=(const FbxTextureSet&) = delete;
+
+    /**
+     * @param fbxPath 场景对应的FBX文件，用于相对路径与内嵌媒体，可为空
+     * @return 场景非空时返回true，个别贴图无法解析或解码不影响结果
+     */
+    bool Build(FbxScene* pScene, const std::string& fbxPath, const FbxTextureOptions& options = FbxTextureOptions());
+    void Clear();
+
+    size_t GetTextureCount() const { return m_textures.size(); }
+    size_t GetImageCount() const { return m_images.size(); }
+    const FbxTextureInfo& GetTexture(uint32_t index) const { return m_textures[index]; }
+    const FbxImageInfo& GetImageInfo(uint32_t index) const { return m_images[index]; }
+
+    /**
+     * @brief 按贴图对象的唯一Id查找贴图下标，不存在时返回npos
+     */
+    uint32_t FindTexture(uint64_t id) const;
+
+    /**
+     * @brief 按FbxMaterialsInfo中记录的贴图文件名查找图像下标，不存在或无法解析时返回npos
+     */
+    uint32_t FindImage(const std::string& fileName) const;
+
+    /**
+     * @brief 取解码后的图像：优先从缓存取，已被淘汰或Build时未解码则重新读取并解码
+     * @return 失败时返回nullptr并记录警告
+     * @note 可在多个线程上同时调用
+     */
+    std::shared_ptr<const FbxImage> GetImage(uint32_t index);
+
+    FbxImageCache& GetCache() { return m_cache; }
+    const FbxImageCache& GetCache() const { return m_cache; }
+
+private:
+    std::shared_ptr<const FbxImage> DecodeImage(uint32_t index, std::string& error) const;
+
+    std::vector<FbxTextureInfo> m_textures;
+    std::vector<FbxImageInfo> m_images;
+    std::unordered_map<uint64_t, uint32_t> m_textureById;
+    std::unordered_map<std::string, uint32_t> m_imageByFileName;
+    FbxTextureOptions m_options;
+    FbxMappedFile m_fbx;            // 内嵌媒体直接引用其中的字节
+    FbxImageCache m_cache;
+};
@@ -1,9 +1,29 @@
 #include "FbxSdkWrapper.h"
-#include <iostream>
+#include "FbxSdkStream.h"
+#include "FbxSdkArena.h"
+#include "FbxSdkException.h"
+#include <filesystem>
 
 FbxSdkWrapper::FbxSdkWrapper()
-    : m_manager(nullptr), m_scene(nullptr), m_loaded(false)
+    : FbxSdkWrapper(false)
 {
+}
+
+FbxSdkWrapper::FbxSdkWrapper(bool useArena)
+    : m_manager(nullptr), m_scene(nullptr), m_loaded(false), m_attributeMask(FBX_ATTRIBUTE_ALL),
+      m_generateTangents(false), m_watchedTime(0), m_watchedSize(0)
+{
+    // 内存池必须在FbxManager创建之前接管SDK分配
+    if (useArena)
+    {
+        m_arena.reset(new FbxArenaResource());
+        m_arenaScope.reset(new FbxSdkArenaScope(*m_arena));
+    }
+    else if (FbxMemoryAccounting::IsInstalled())
+    {
+        m_memoryAccount.reset(FbxMemoryAccount::Create());
+    }
+    FbxMemoryAccountScope accountScope(m_memoryAccount.get());
     FbxSdkLibrary::InitializeSdkObjects(m_manager, m_scene);
 }
 
@@ -16,7 +36,12 @@ FbxSdkWrapper::~FbxSdkWrapper()
 }
 
 FbxSdkWrapper::FbxSdkWrapper(FbxSdkWrapper&& other) noexcept
-    : m_manager(other.m_manager), m_scene(other.m_scene), m_loaded(other.m_loaded)
+    : m_manager(other.m_manager), m_scene(other.m_scene), m_loaded(other.m_loaded),
+      m_filter(std::move(other.m_filter)), m_attributeMask(other.m_attributeMask),
+      m_generateTangents(other.m_generateTangents), m_tangentOptions(other.m_tangentOptions),
+      m_incremental(std::move(other.m_incremental)), m_watchedFile(std::move(other.m_watchedFile)),
+      m_watchedTime(other.m_watchedTime), m_watchedSize(other.m_watchedSize),
+      m_memoryAccount(std::move(other.m_memoryAccount)), m_arena(std::move(other.m_arena)), m_arenaScope(std::move(other.m_arenaScope))
 {
     other.m_manager = nullptr;
     other.m_scene = nullptr;
@@ -32,11 +57,25 @@ FbxSdkWrapper& FbxSdkWrapper::operator=(FbxSdkWrapper&& other) noexcept
         {
             FbxSdkLibrary::DestroySdkObjects(m_manager);
         }
+        m_memoryAccount.reset();
+        m_arenaScope.reset();
+        m_arena.reset();
 
         // 移动资源
         m_manager = other.m_manager;
         m_scene = other.m_scene;
         m_loaded = other.m_loaded;
+        m_filter = std::move(other.m_filter);
+        m_attributeMask = other.m_attributeMask;
+        m_generateTangents = other.m_generateTangents;
+        m_tangentOptions = other.m_tangentOptions;
+        m_incremental = std::move(other.m_incremental);
+        m_watchedFile = std::move(other.m_watchedFile);
+        m_watchedTime = other.m_watchedTime;
+        m_watchedSize = other.m_watchedSize;
+        m_memoryAccount = std::move(other.m_memoryAccount);
+        m_arena = std::move(other.m_arena);
+        m_arenaScope = std::move(other.m_arenaScope);
 
         // 清空源对象
         other.m_manager = nullptr;
@@ -50,14 +89,146 @@ bool FbxSdkWrapper::LoadFile(const std::string& filename)
 {
     if (!m_manager || !m_scene)
     {
-        std::cerr << "FbxSdkWrapper: Manager or Scene not initialized" << std::endl;
+        FbxErrorHandler::LogError("FbxSdkWrapper: Manager or Scene not initialized");
         return false;
     }
 
+    FbxMemoryAccountScope accountScope(m_memoryAccount.get());
     m_loaded = FbxSdkLibrary::LoadScene(m_manager, m_scene, filename.c_str());
     return m_loaded;
 }
 
+bool FbxSdkWrapper::LoadMappedFile(const std::string& filename)
+{
+    FbxMappedFile mappedFile;
+    if (!mappedFile.Open(filename))
+    {
+        return false;
+    }
+
+    // 导入完成后场景已持有全部数据，映射随即释放
+    return LoadFromMemory(mappedFile.GetData(), mappedFile.GetSize());
+}
+
+bool FbxSdkWrapper::LoadFromMemory(const void* data, size_t size)
+{
+    if (!m_manager || !m_scene)
+    {
+        FbxErrorHandler::LogError("FbxSdkWrapper: Manager or Scene not initialized");
+        return false;
+    }
+
+    FbxMemoryAccountScope accountScope(m_memoryAccount.get());
+    FbxMemoryStream stream(m_manager, data, size);
+    m_loaded = FbxSdkLibrary::LoadSceneFromStream(m_manager, m_scene, &stream);
+    return m_loaded;
+}
+
+bool FbxSdkWrapper::LoadFromStream(FbxStream* stream, void* streamData)
+{
+    if (!m_manager || !m_scene)
+    {
+        FbxErrorHandler::LogError("FbxSdkWrapper: Manager or Scene not initialized");
+        return false;
+    }
+
+    FbxMemoryAccountScope accountScope(m_memoryAccount.get());
+    m_loaded = FbxSdkLibrary::LoadSceneFromStream(m_manager, m_scene, stream, streamData);
+    return m_loaded;
+}
+
+/**
+ * @brief 读取文件的修改时间与大小
+ */
+static bool GetFileStamp(const std::string& filename, int64_t& time, uint64_t& size)
+{
+    std::error_code error;
+    auto writeTime = std::filesystem::last_write_time(filename, error);
+    if (error)
+        return false;
+    auto fileSize = std::filesystem::file_size(filename, error);
+    if (error)
+        return false;
+    time = static_cast<int64_t>(writeTime.time_since_epoch().count());
+    size = static_cast<uint64_t>(fileSize);
+    return true;
+}
+
+bool FbxSdkWrapper::LoadIncremental(const std::string& filename, FbxSceneDelta& delta)
+{
+    delta = FbxSceneDelta();
+    if (!m_manager || !m_scene)
+    {
+        FbxErrorHandler::LogError("FbxSdkWrapper: Manager or Scene not initialized");
+        return false;
+    }
+
+    // 单调内存池不回收被替换的场景，反复重新加载会无限增长
+    if (m_arena)
+    {
+        FbxErrorHandler::LogError("Incremental loading is not supported with the memory arena enabled");
+        return false;
+    }
+
+    // 导入前取时间戳：导入期间文件再次被保存时，下一次ReloadIfChanged仍能发现
+    int64_t time = 0;
+    uint64_t size = 0;
+    if (!GetFileStamp(filename, time, size))
+    {
+        FbxErrorHandler::LogError("Failed to stat file: " + filename);
+        return false;
+    }
+
+    // 导入到新场景，成功后才替换：失败时旧场景与缓存（其中材质的Texture指向旧场景的字符串）保持不变
+    FbxMemoryAccountScope accountScope(m_memoryAccount.get());
+    FbxScene* scene = FbxScene::Create(m_manager, "My Scene");
+    bool imported = false;
+    try
+    {
+        imported = FbxSdkLibrary::LoadScene(m_manager, scene, filename.c_str());
+    }
+    catch (...)
+    {
+        scene->Destroy();
+        throw;
+    }
+    if (!imported)
+    {
+        scene->Destroy();
+        return false;
+    }
+
+    m_scene->Destroy();
+    m_scene = scene;
+    m_loaded = true;
+    m_watchedFile = filename;
+    m_watchedTime = time;
+    m_watchedSize = size;
+
+    // 提取时三角化产生的临时SDK对象同样记入本对象
+    FbxTangentOptions options = m_tangentOptions;
+    m_incremental.Update(m_scene, m_filter, m_attributeMask, m_generateTangents ? &options : nullptr, delta);
+    return true;
+}
+
+bool FbxSdkWrapper::ReloadIfChanged(FbxSceneDelta& delta)
+{
+    delta = FbxSceneDelta();
+    if (m_watchedFile.empty())
+    {
+        return false;
+    }
+
+    int64_t time = 0;
+    uint64_t size = 0;
+    if (!GetFileStamp(m_watchedFile, time, size) || (time == m_watchedTime && size == m_watchedSize))
+    {
+        return false;
+    }
+
+    return LoadIncremental(m_watchedFile, delta);
+}
+
 std::map<std::string, std::string> FbxSdkWrapper::GetMetadata() const
 {
     std::map<std::string, std::string> result;
@@ -89,7 +260,114 @@ std::map<uint64_t, FbxGeometryInfo> FbxSdkWrapper::GetGeometries() const
         return {};
     }
 
-    return FbxSdkLibrary::GetFbxGeometries(m_scene);
+    FbxMemoryAccountScope accountScope(m_memoryAccount.get());
+    std::map<uint64_t, FbxGeometryInfo> geometries =
+        FbxSdkLibrary::GetFbxGeometries(m_scene, m_filter, m_attributeMask, GetMemoryResource());
+    if (m_generateTangents)
+    {
+        FbxTangentOptions options = m_tangentOptions;
+        options.AttributeMask &= m_attributeMask;
+        FbxTangentGenerator::Generate(geometries, options);
+    }
+    return geometries;
+}
+
+void FbxSdkWrapper::ForEachGeometry(const std::function<void(uint64_t meshId, FbxGeometryInfo& geometry)>& visitor) const
+{
+    if (!IsLoaded() || !visitor)
+    {
+        return;
+    }
+
+    for (FbxMesh* mesh : GetFilteredMeshes())
+    {
+        FbxGeometryInfo geometry = ExtractGeometry(mesh);
+        visitor(mesh->GetUniqueID(), geometry);
+    }
+}
+
+std::vector<FbxMesh*> FbxSdkWrapper::GetFilteredMeshes() const
+{
+    std::vector<FbxMesh*> meshes;
+    if (IsLoaded())
+    {
+        FbxSdkLibrary::CollectFilteredMeshes(m_scene, m_filter, meshes);
+    }
+    return meshes;
+}
+
+FbxGeometryInfo FbxSdkWrapper::ExtractGeometry(FbxMesh* mesh) const
+{
+    return ExtractGeometry(mesh, GetMemoryResource());
+}
+
+FbxGeometryInfo FbxSdkWrapper::ExtractGeometry(FbxMesh* mesh, std::pmr::memory_resource* resource) const
+{
+    if (!IsLoaded() || !mesh)
+    {
+        return FbxGeometryInfo();
+    }
+
+    FbxMemoryAccountScope accountScope(m_memoryAccount.get());
+    FbxGeometryInfo geometry = FbxSdkLibrary::GetFbxGeometry(mesh, m_attributeMask, resource);
+    if (m_generateTangents)
+    {
+        FbxTangentOptions options = m_tangentOptions;
+        options.AttributeMask &= m_attributeMask;
+        FbxTangentGenerator::Generate(geometry, options);
+    }
+    return geometry;
+}
+
+std::vector<FbxNodeInfo> FbxSdkWrapper::GetNodes() const
+{
+    std::vector<FbxNodeInfo> nodes;
+    if (IsLoaded())
+    {
+        FbxSdkLibrary::GetFbxNodes(m_scene, nodes);
+    }
+    return nodes;
+}
+
+FbxSceneIndex FbxSdkWrapper::BuildSceneIndex() const
+{
+    FbxSceneIndex index;
+    if (IsLoaded())
+    {
+        index.Build(m_scene);
+    }
+    return index;
+}
+
+FbxSkinningInfo FbxSdkWrapper::GetSkinning(const FbxSkinOptions& options) const
+{
+    FbxSkinningInfo skinning;
+    if (IsLoaded())
+    {
+        FbxSkinExtractor::Extract(m_scene, m_filter, options, skinning);
+    }
+    return skinning;
+}
+
+std::map<uint64_t, std::vector<FbxMorphTarget>> FbxSdkWrapper::GetMorphTargets(const std::map<uint64_t, FbxGeometryInfo>& geometries,
+                                                                               const FbxMorphOptions& options) const
+{
+    std::map<uint64_t, std::vector<FbxMorphTarget>> targets;
+    if (IsLoaded())
+    {
+        FbxMorphExtractor::Extract(m_scene, geometries, options, targets);
+    }
+    return targets;
+}
+
+std::vector<FbxAnimClip> FbxSdkWrapper::GetAnimations(const FbxAnimBakeOptions& options) const
+{
+    std::vector<FbxAnimClip> clips;
+    if (IsLoaded())
+    {
+        FbxAnimationBaker::Bake(m_scene, options, clips);
+    }
+    return clips;
 }
 
 std::map<uint64_t, FbxMaterialsInfo> FbxSdkWrapper::GetMaterials() const
@@ -104,6 +382,31 @@ std::map<uint64_t, FbxMaterialsInfo> FbxSdkWrapper::GetMaterials() const
     return materials;
 }
 
+std::pmr::memory_resource* FbxSdkWrapper::GetMemoryResource() const
+{
+    return m_arena.get();
+}
+
+FbxMemoryReport FbxSdkWrapper::GetMemoryReport() const
+{
+    FbxMemoryReport report;
+    if (m_arena)
+    {
+        // 提取容器同样分配在池中，这里的SdkBytes包含GetGeometries的结果
+        report.SdkBytes = m_arena->GetBytesAllocated();
+        report.SdkPeakBytes = m_arena->GetBytesReserved();
+    }
+    else if (m_memoryAccount)
+    {
+        report.SdkBytes = m_memoryAccount->GetLiveBytes();
+        report.SdkPeakBytes = m_memoryAccount->GetPeakBytes();
+    }
+
+    FbxMemoryAccounting::Measure(m_incremental.GetGeometries(), report);
+    FbxMemoryAccounting::Measure(m_incremental.GetMaterials(), report);
+    return report;
+}
+
 // FbxGeometryExporter implementation
 std::vector<FbxGeometryExporter::SimplifiedMesh> 
 FbxGeometryExporter::ConvertToSimplifiedMeshes(const FbxGeometryInfo& geometryInfo)
@@ -126,7 +429,7 @@ FbxGeometryExporter::ConvertToSimplifiedMeshes(const FbxGeometryInfo& geometryIn
         // 转换顶点数据
         for (size_t i = 0; i < vertexCount; ++i)
         {
-            SimplifiedVertex vertex;
+            SimplifiedVertex vertex = {};
             
             // 位置
             int controlPointIndex = section.Triangle[i];
@@ -147,18 +450,18 @@ FbxGeometryExporter::ConvertToSimplifiedMeshes(const FbxGeometryInfo& geometryIn
                 vertex.normal[2] = static_cast<float>(normal[2]);
             }
             
-            // UV
-            if (i < section.UVs.size())
+            // UV（主UV）
+            if (!section.UVSets.empty() && i < section.UVSets[0].UVs.size())
             {
-                const FbxVector2& uv = section.UVs[i];
+                const FbxVector2& uv = section.UVSets[0].UVs[i];
                 vertex.uv[0] = static_cast<float>(uv[0]);
                 vertex.uv[1] = static_cast<float>(uv[1]);
             }
             
-            // 顶点颜色
-            if (i < section.Colors.size())
+            // 顶点颜色（第一套）
+            if (!section.ColorSets.empty() && i < section.ColorSets[0].Colors.size())
             {
-                const FbxColor& color = section.Colors[i];
+                const FbxColor& color = section.ColorSets[0].Colors[i];
                 vertex.color[0] = static_cast<float>(color[0]);
                 vertex.color[1] = static_cast<float>(color[1]);
                 vertex.color[2] = static_cast<float>(color[2]);
@@ -1,7 +1,25 @@
 #pragma once
 #include "FbxSdkLibrary.h"
+#include "FbxSdkAnimation.h"
+#include "FbxSdkIncremental.h"
+#include "FbxSdkIndex.h"
+#include "FbxSdkMemory.h"
+#include "FbxSdkMorph.h"
+#include "FbxSdkProbe.h"
+#include "FbxSdkSkin.h"
+#include "FbxSdkTangents.h"
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
+#if defined(__has_include)
+#if __has_include(<span>) && (__cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L))
+#include <span>
+#endif
+#endif
+
+class FbxArenaResource;
+class FbxSdkArenaScope;
 
 /**
  * @brief FBX SDK的RAII封装类，自动管理FbxManager和FbxScene的生命周期
@@ -10,6 +28,13 @@ class FbxSdkWrapper
 {
 public:
     FbxSdkWrapper();
+
+    /**
+     * @param useArena 为true时SDK分配与提取容器都走本对象独占的内存池，析构时整体归还
+     * @note SDK分配函数为进程级全局，同一时刻只能有一个启用内存池的实例，且它存活期间
+     *       其他线程不能使用SDK（见FbxSdkArenaScope）；此时GetGeometries返回的数据不能比本对象活得更久
+     */
+    explicit FbxSdkWrapper(bool useArena);
     ~FbxSdkWrapper();
 
     // 禁用拷贝
@@ -27,6 +52,67 @@ public:
      */
     bool LoadFile(const std::string& filename);
 
+    /**
+     * @brief 通过内存映射读取本地文件并导入，避免额外的读盘拷贝
+     * @param filename 文件路径
+     * @return 是否成功
+     */
+    bool LoadMappedFile(const std::string& filename);
+
+    /**
+     * @brief 从内存缓冲区导入FBX（二进制或ASCII）
+     * @param data 缓冲区，仅需在调用期间有效
+     * @param size 缓冲区字节数
+     * @return 是否成功
+     */
+    bool LoadFromMemory(const void* data, size_t size);
+
+#ifdef __cpp_lib_span
+    bool LoadFromMemory(std::span<const std::byte> data)
+    {
+        return LoadFromMemory(data.data(), data.size());
+    }
+#endif
+
+    /**
+     * @brief 从自定义FbxStream导入FBX
+     * @param stream 自定义流，由调用者持有
+     * @param streamData 透传给FbxStream::Open的用户数据
+     * @return 是否成功
+     */
+    bool LoadFromStream(FbxStream* stream, void* streamData = nullptr);
+
+    /**
+     * @brief 增量加载：重新导入文件，只重新提取内容哈希变化的Mesh，结果保存在GetIncrementalCache()中
+     * @param delta 相对上一次增量加载的变化，首次加载时全部为新增
+     * @return 导入失败时返回false，场景与缓存保持上一次成功加载的内容
+     * @note 提取过滤器、属性掩码与切线生成设置同样生效。新文件导入到单独的场景中，成功后才替换旧场景。
+     *       启用内存池时直接返回false：单调内存池不回收被替换的场景，监视模式下内存会无限增长
+     */
+    bool LoadIncremental(const std::string& filename, FbxSceneDelta& delta);
+
+    /**
+     * @brief 监视模式：上一次LoadIncremental的文件修改时间或大小变化时重新增量加载
+     * @return 发生了重新加载时返回true；文件未变化、正在写入导致导入失败时返回false（下次调用会重试）
+     */
+    bool ReloadIfChanged(FbxSceneDelta& delta);
+
+    /**
+     * @brief 增量加载的缓存，键为稳定Id，跨多次加载不变
+     */
+    const FbxIncrementalCache& GetIncrementalCache() const { return m_incremental; }
+
+    /**
+     * @brief 不导入场景，快速探测文件版本与对象/三角形数量
+     * @param filename 文件路径
+     * @param info 探测结果
+     * @return 是否为可识别的FBX文件
+     */
+    static bool Probe(const std::string& filename, FbxProbeInfo& info)
+    {
+        return FbxSdkProbe::Probe(filename, info);
+    }
+
     /**
      * @brief 获取场景元数据
      * @return 元数据映射
@@ -39,6 +125,88 @@ public:
      */
     std::map<uint64_t, FbxGeometryInfo> GetGeometries() const;
 
+    /**
+     * @brief 逐个提取Mesh并回调，回调返回后该Mesh的数据即被释放，适合流式导出
+     * @note 只遍历挂在节点上的Mesh（同样受提取过滤器、属性掩码与切线生成设置约束），同一Mesh只回调一次
+     */
+    void ForEachGeometry(const std::function<void(uint64_t meshId, FbxGeometryInfo& geometry)>& visitor) const;
+
+    /**
+     * @brief ForEachGeometry拆成两步：先取得受提取过滤器约束的Mesh列表，再逐个提取，便于分批或跨线程调度
+     */
+    std::vector<FbxMesh*> GetFilteredMeshes() const;
+
+    /**
+     * @brief 按当前属性掩码与切线生成设置提取一个Mesh
+     */
+    FbxGeometryInfo ExtractGeometry(FbxMesh* mesh) const;
+
+    /**
+     * @brief 同上，但提取容器从resource分配而不是GetMemoryResource()
+     * @note 启用内存池时，用于结果会先于wrapper释放的场合：内存池中的块直到wrapper析构才归还
+     */
+    FbxGeometryInfo ExtractGeometry(FbxMesh* mesh, std::pmr::memory_resource* resource) const;
+
+    /**
+     * @brief 获取节点层级（先序，父节点在前）
+     */
+    std::vector<FbxNodeInfo> GetNodes() const;
+
+    /**
+     * @brief 构建场景索引，按Id/名字/类型定位对象及查询Mesh实例、材质使用者，结果由调用者保存并反复查询
+     */
+    FbxSceneIndex BuildSceneIndex() const;
+
+    /**
+     * @brief 获取蒙皮信息：骨架表与各Mesh压缩后的骨骼索引/权重（同样受提取过滤器约束）
+     */
+    FbxSkinningInfo GetSkinning(const FbxSkinOptions& options = FbxSkinOptions()) const;
+
+    /**
+     * @brief 获取形变目标的稀疏增量，按geometries中各section的顶点顺序重映射
+     * @param geometries 本对象GetGeometries的结果
+     * @return 键为Mesh的Id
+     */
+    std::map<uint64_t, std::vector<FbxMorphTarget>> GetMorphTargets(const std::map<uint64_t, FbxGeometryInfo>& geometries,
+                                                                    const FbxMorphOptions& options = FbxMorphOptions()) const;
+
+    /**
+     * @brief 把场景中的每个动画栈烘焙为固定频率采样的节点变换轨道
+     * @note 会切换场景的当前动画栈
+     */
+    std::vector<FbxAnimClip> GetAnimations(const FbxAnimBakeOptions& options = FbxAnimBakeOptions()) const;
+
+    /**
+     * @brief 设置几何体提取过滤器，之后的GetGeometries只处理命中的节点及其Mesh
+     */
+    void SetExtractionFilter(const FbxExtractionFilter& filter) { m_filter = filter; }
+
+    /**
+     * @brief 清除提取过滤器，恢复全量提取
+     */
+    void ClearExtractionFilter() { m_filter = FbxExtractionFilter(); }
+
+    const FbxExtractionFilter& GetExtractionFilter() const { return m_filter; }
+
+    /**
+     * @brief 选择GetGeometries收集的属性流（FbxAttributeFlags组合），默认全部
+     */
+    void SetAttributeMask(uint32_t mask) { m_attributeMask = mask & FBX_ATTRIBUTE_ALL; }
+
+    uint32_t GetAttributeMask() const { return m_attributeMask; }
+
+    /**
+     * @brief 开启后GetGeometries会补齐缺失的法线/切线/Binormal（只处理属性掩码中选中的流）
+     * @note 平滑组随FBX_ATTRIBUTE_SMOOTHING一起提取，未选中时按整体平滑处理
+     */
+    void EnableTangentGeneration(const FbxTangentOptions& options = FbxTangentOptions())
+    {
+        m_generateTangents = true;
+        m_tangentOptions = options;
+    }
+
+    void DisableTangentGeneration() { m_generateTangents = false; }
+
     /**
      * @brief 获取所有材质信息
      * @return 材质信息映射
@@ -55,6 +223,18 @@ public:
      */
     FbxManager* GetManager() const { return m_manager; }
 
+    /**
+     * @brief 提取容器使用的内存资源（未启用内存池时为nullptr，即std::pmr默认资源）
+     */
+    std::pmr::memory_resource* GetMemoryResource() const;
+
+    /**
+     * @brief 本对象当前的内存占用：SDK场景与增量缓存中的提取结果
+     * @note SDK部分需要启用内存池或事先调用FbxMemoryAccounting::Install，否则为0；
+     *       GetGeometries/GetMaterials返回的副本归调用者所有，用FbxMemoryAccounting::Measure累加
+     */
+    FbxMemoryReport GetMemoryReport() const;
+
     /**
      * @brief 检查是否已加载场景
      */
@@ -64,6 +244,18 @@ private:
     FbxManager* m_manager;
     FbxScene* m_scene;
     bool m_loaded;
+    FbxExtractionFilter m_filter;
+    uint32_t m_attributeMask;
+    bool m_generateTangents;
+    FbxTangentOptions m_tangentOptions;
+    FbxIncrementalCache m_incremental;
+    std::string m_watchedFile;
+    int64_t m_watchedTime;
+    uint64_t m_watchedSize;
+    std::unique_ptr<FbxMemoryAccount, FbxMemoryAccountDeleter> m_memoryAccount;
+    // 声明顺序保证析构时先恢复SDK分配函数，再归还内存池
+    std::unique_ptr<FbxArenaResource> m_arena;
+    std::unique_ptr<FbxSdkArenaScope> m_arenaScope;
 };
 
 /**
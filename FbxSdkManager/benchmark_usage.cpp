@@ -0,0 +1,426 @@
+#include "FbxSdkWrapper.h"
+#include "FbxSdkBvh.h"
+#include "FbxSdkCApi.h"
+#include "FbxSdkCompression.h"
+#include "FbxSdkLod.h"
+#include "FbxSdkException.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double ElapsedMs(Clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    }
+
+    /**
+     * @brief 测量一次完整的 创建->加载->提取->销毁 流程
+     */
+    void BenchmarkLoad(const std::string& filename, bool useArena, int iterations)
+    {
+        double loadMs = 0.0, extractMs = 0.0, destroyMs = 0.0;
+        size_t geometryCount = 0;
+
+        for (int i = 0; i < iterations; ++i)
+        {
+            Clock::time_point begin = Clock::now();
+            auto* wrapper = new FbxSdkWrapper(useArena);
+            if (!wrapper->LoadFile(filename))
+            {
+                delete wrapper;
+                std::cerr << "Failed to load file: " << filename << std::endl;
+                return;
+            }
+            loadMs += ElapsedMs(begin);
+
+            begin = Clock::now();
+            {
+                auto geometries = wrapper->GetGeometries();
+                geometryCount = geometries.size();
+            }
+            extractMs += ElapsedMs(begin);
+
+            begin = Clock::now();
+            delete wrapper;
+            destroyMs += ElapsedMs(begin);
+        }
+
+        std::cout << (useArena ? "[arena]   " : "[default] ")
+                  << "geometries: " << geometryCount
+                  << ", load: " << loadMs / iterations << " ms"
+                  << ", extract: " << extractMs / iterations << " ms"
+                  << ", destroy: " << destroyMs / iterations << " ms" << std::endl;
+    }
+
+    /**
+     * @brief 对比逐多边形查询（复制到每个顶点）与整Mesh逐corner收集法线的耗时
+     */
+    void BenchmarkNormals(const std::string& filename, int iterations)
+    {
+        FbxSdkWrapper wrapper;
+        if (!wrapper.LoadFile(filename))
+        {
+            std::cerr << "Failed to load file: " << filename << std::endl;
+            return;
+        }
+
+        FbxScene* scene = wrapper.GetScene();
+        double perPolygonMs = 0.0, perCornerMs = 0.0;
+        size_t cornerCount = 0;
+
+        for (int i = 0; i < iterations; ++i)
+        {
+            for (int g = 0; g < scene->GetGeometryCount(); ++g)
+            {
+                FbxGeometry* geometry = scene->GetGeometry(g);
+                if (!geometry || geometry->GetAttributeType() != FbxNodeAttribute::eMesh)
+                {
+                    continue;
+                }
+                FbxMesh* mesh = static_cast<FbxMesh*>(geometry);
+
+                Clock::time_point begin = Clock::now();
+                std::vector<FbxVector4> normals;
+                normals.reserve(mesh->GetPolygonVertexCount());
+                for (int p = 0; p < mesh->GetPolygonCount(); ++p)
+                {
+                    FbxVector4 normal;
+                    FbxSdkLibrary::GetPolygonNormal(mesh, p, normal);
+                    normals.insert(normals.end(), mesh->GetPolygonSize(p), normal);
+                }
+                perPolygonMs += ElapsedMs(begin);
+
+                begin = Clock::now();
+                FbxSdkLibrary::GetMeshNormals(mesh, normals);
+                perCornerMs += ElapsedMs(begin);
+
+                cornerCount += normals.size();
+            }
+        }
+
+        std::cout << "corners: " << cornerCount / iterations
+                  << ", per-polygon: " << perPolygonMs / iterations << " ms"
+                  << ", per-corner gather: " << perCornerMs / iterations << " ms" << std::endl;
+    }
+
+    /**
+     * @brief 量化压缩：体积、往返误差与解码吞吐
+     */
+    void BenchmarkCompression(const std::string& filename, int iterations)
+    {
+        FbxSdkWrapper wrapper;
+        if (!wrapper.LoadFile(filename))
+        {
+            std::cerr << "Failed to load file: " << filename << std::endl;
+            return;
+        }
+
+        std::vector<FbxGeometryExporter::SimplifiedMesh> meshes;
+        for (const auto& geoPair : wrapper.GetGeometries())
+        {
+            for (auto& mesh : FbxGeometryExporter::ConvertToSimplifiedMeshes(geoPair.second))
+            {
+                FbxLodGenerator::WeldVertices(mesh);
+                meshes.push_back(std::move(mesh));
+            }
+        }
+
+        size_t rawBytes = 0, encodedBytes = 0, vertexCount = 0;
+        std::vector<std::vector<uint8_t>> encoded;
+        Clock::time_point begin = Clock::now();
+        for (const auto& mesh : meshes)
+        {
+            encoded.push_back(FbxMeshCodec::Encode(mesh));
+            rawBytes += mesh.vertices.size() * sizeof(FbxGeometryExporter::SimplifiedVertex) + mesh.indices.size() * sizeof(uint32_t);
+            encodedBytes += encoded.back().size();
+            vertexCount += mesh.vertices.size();
+        }
+        const double encodeMs = ElapsedMs(begin);
+
+        double decodeMs = 0.0;
+        std::vector<FbxGeometryExporter::SimplifiedMesh> decoded(meshes.size());
+        for (int i = 0; i < iterations; ++i)
+        {
+            begin = Clock::now();
+            for (size_t m = 0; m < meshes.size(); ++m)
+            {
+                FbxMeshCodec::Decode(encoded[m], decoded[m]);
+            }
+            decodeMs += ElapsedMs(begin);
+        }
+
+        // 位置误差相对各网格包围盒对角线，法线误差为夹角
+        float positionError = 0.0f, normalError = 0.0f, uvError = 0.0f;
+        for (size_t m = 0; m < meshes.size(); ++m)
+        {
+            const auto& source = meshes[m].vertices;
+            const auto& result = decoded[m].vertices;
+            if (source.empty() || result.size() != source.size())
+                continue;
+
+            float minimum[3], maximum[3];
+            for (int k = 0; k < 3; ++k)
+                minimum[k] = maximum[k] = source[0].position[k];
+            for (const auto& vertex : source)
+            {
+                for (int k = 0; k < 3; ++k)
+                {
+                    minimum[k] = std::min(minimum[k], vertex.position[k]);
+                    maximum[k] = std::max(maximum[k], vertex.position[k]);
+                }
+            }
+            float diagonal = 0.0f;
+            for (int k = 0; k < 3; ++k)
+                diagonal += (maximum[k] - minimum[k]) * (maximum[k] - minimum[k]);
+            diagonal = std::max(1e-12f, std::sqrt(diagonal));
+
+            for (size_t v = 0; v < source.size(); ++v)
+            {
+                float dot = 0.0f, length = 0.0f;
+                for (int k = 0; k < 3; ++k)
+                {
+                    positionError = std::max(positionError, std::fabs(source[v].position[k] - result[v].position[k]) / diagonal);
+                    dot += source[v].normal[k] * result[v].normal[k];
+                    length += source[v].normal[k] * source[v].normal[k];
+                }
+                if (length > 0.0f)
+                    normalError = std::max(normalError, std::acos(std::min(1.0f, dot / std::sqrt(length))) * 57.29578f);
+                for (int k = 0; k < 2; ++k)
+                    uvError = std::max(uvError, std::fabs(source[v].uv[k] - result[v].uv[k]));
+            }
+        }
+
+        const double averageDecodeMs = decodeMs / iterations;
+        std::cout << "meshes: " << meshes.size() << ", vertices: " << vertexCount
+                  << ", raw: " << rawBytes << " B, encoded: " << encodedBytes << " B"
+                  << " (" << (rawBytes ? 100.0 * encodedBytes / rawBytes : 0.0) << "%)" << std::endl;
+        std::cout << "max error: position " << positionError << " (of diagonal)"
+                  << ", normal " << normalError << " deg, uv " << uvError << std::endl;
+        std::cout << "encode: " << encodeMs << " ms, decode: " << averageDecodeMs << " ms";
+        if (averageDecodeMs > 0.0)
+        {
+            std::cout << " (" << rawBytes / (averageDecodeMs * 1000.0) << " MB/s, "
+                      << vertexCount / (averageDecodeMs * 1000.0) << " Mverts/s)";
+        }
+        std::cout << std::endl;
+    }
+
+    /**
+     * @brief 场景BVH：构建耗时、随机射线与包围盒查询吞吐
+     */
+    void BenchmarkBvh(const std::string& filename, int iterations)
+    {
+        FbxSdkWrapper wrapper;
+        if (!wrapper.LoadFile(filename))
+        {
+            std::cerr << "Failed to load file: " << filename << std::endl;
+            return;
+        }
+
+        const auto geometries = wrapper.GetGeometries();
+        FbxSceneBvh bvh;
+        double buildMs = 0.0;
+        for (int i = 0; i < iterations; ++i)
+        {
+            Clock::time_point begin = Clock::now();
+            bvh.Build(wrapper.GetScene(), geometries);
+            buildMs += ElapsedMs(begin);
+        }
+
+        float minimum[3], maximum[3];
+        if (!bvh.GetBounds(minimum, maximum))
+        {
+            std::cout << "empty scene" << std::endl;
+            return;
+        }
+
+        size_t triangleCount = 0;
+        for (const auto& mesh : bvh.GetMeshes())
+        {
+            triangleCount += mesh.GetTriangleCount();
+        }
+
+        // 射线从包围盒内的随机点射向随机方向，查询盒边长为场景尺寸的5%
+        std::mt19937 random(12345);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        auto randomPoint = [&](float* point)
+        {
+            for (int k = 0; k < 3; ++k)
+                point[k] = minimum[k] + (maximum[k] - minimum[k]) * unit(random);
+        };
+
+        const int rayCount = 100000;
+        std::vector<float> rays(6 * rayCount);
+        for (int r = 0; r < rayCount; ++r)
+        {
+            randomPoint(&rays[6 * r]);
+            for (int k = 0; k < 3; ++k)
+                rays[6 * r + 3 + k] = unit(random) * 2.0f - 1.0f;
+        }
+
+        Clock::time_point begin = Clock::now();
+        size_t hitCount = 0;
+        for (int r = 0; r < rayCount; ++r)
+        {
+            FbxRayHit hit;
+            hitCount += bvh.RayCast(&rays[6 * r], &rays[6 * r + 3], FLT_MAX, hit) ? 1 : 0;
+        }
+        const double rayMs = ElapsedMs(begin);
+
+        const int queryCount = 10000;
+        size_t overlapCount = 0;
+        std::vector<FbxBvhOverlap> overlaps;
+        begin = Clock::now();
+        for (int q = 0; q < queryCount; ++q)
+        {
+            float center[3], queryMin[3], queryMax[3];
+            randomPoint(center);
+            for (int k = 0; k < 3; ++k)
+            {
+                const float half = 0.025f * (maximum[k] - minimum[k]);
+                queryMin[k] = center[k] - half;
+                queryMax[k] = center[k] + half;
+            }
+            overlaps.clear();
+            overlapCount += bvh.QueryAabb(queryMin, queryMax, overlaps);
+        }
+        const double queryMs = ElapsedMs(begin);
+
+        std::cout << "meshes: " << bvh.GetMeshes().size() << ", instances: " << bvh.GetInstances().size()
+                  << ", triangles: " << triangleCount << ", build: " << buildMs / iterations << " ms" << std::endl;
+        std::cout << "rays: " << rayCount << ", hits: " << hitCount << ", " << rayMs << " ms ("
+                  << rayCount / (rayMs * 1000.0) << " Mrays/s)" << std::endl;
+        std::cout << "aabb queries: " << queryCount << ", overlaps: " << overlapCount << ", " << queryMs << " ms" << std::endl;
+    }
+
+    /**
+     * @brief 跨语言边界的开销：STL接口需要绑定层逐元素转成扁平数组，C ABI只取“指针 + 步长”视图
+     * @note 两条路径都在计时前完成提取，只比较把控制点、索引与法线交给外部运行时的代价
+     */
+    void BenchmarkCApi(const std::string& filename, int iterations)
+    {
+        FbxSdkWrapper wrapper;
+        if (!wrapper.LoadFile(filename))
+        {
+            std::cerr << "Failed to load file: " << filename << std::endl;
+            return;
+        }
+        const std::map<uint64_t, FbxGeometryInfo> geometries = wrapper.GetGeometries();
+
+        FbxcScene* scene = nullptr;
+        if (fbxc_scene_load(filename.c_str(), FBXC_ATTRIBUTE_ALL, &scene) != FBXC_OK)
+        {
+            std::cerr << "fbxc_scene_load failed: " << fbxc_last_error() << std::endl;
+            return;
+        }
+
+        double stlMs = 0.0, viewMs = 0.0, checksum = 0.0;
+        size_t bytes = 0;
+        for (int i = 0; i < iterations; ++i)
+        {
+            // STL：相当于绑定层把每个元素转换后写入目标运行时的数组
+            Clock::time_point begin = Clock::now();
+            std::vector<double> positions, normals;
+            std::vector<int32_t> indices;
+            for (const auto& geoPair : geometries)
+            {
+                for (const FbxVector4& point : geoPair.second.ControlPoints)
+                {
+                    positions.push_back(point[0]);
+                    positions.push_back(point[1]);
+                    positions.push_back(point[2]);
+                }
+                for (const auto& section : geoPair.second.Sections)
+                {
+                    for (int index : section.second.Triangle)
+                        indices.push_back(index);
+                    for (const FbxVector4& normal : section.second.Normals)
+                    {
+                        normals.push_back(normal[0]);
+                        normals.push_back(normal[1]);
+                        normals.push_back(normal[2]);
+                    }
+                }
+            }
+            stlMs += ElapsedMs(begin);
+            bytes = (positions.size() + normals.size()) * sizeof(double) + indices.size() * sizeof(int32_t);
+            checksum += positions.empty() ? 0.0 : positions.back();
+
+            // C ABI：每个流一次调用，数据本身不动
+            begin = Clock::now();
+            FbxcView view;
+            const uint32_t meshCount = fbxc_scene_mesh_count(scene);
+            for (uint32_t m = 0; m < meshCount; ++m)
+            {
+                FbxcMeshInfo mesh;
+                fbxc_mesh_info(scene, m, &mesh);
+                if (fbxc_mesh_control_points(scene, m, &view) == FBXC_OK)
+                    checksum += *static_cast<const double*>(view.data);
+                for (uint32_t s = 0; s < mesh.sectionCount; ++s)
+                {
+                    fbxc_section_stream(scene, m, s, FBXC_STREAM_INDICES, 0, &view);
+                    fbxc_section_stream(scene, m, s, FBXC_STREAM_NORMALS, 0, &view);
+                }
+            }
+            viewMs += ElapsedMs(begin);
+        }
+        fbxc_scene_release(scene);
+
+        std::cout << "marshalled: " << bytes / (1024.0 * 1024.0) << " MB"
+                  << ", STL copy: " << stlMs / iterations << " ms"
+                  << ", C views: " << viewMs / iterations << " ms"
+                  << " (checksum " << checksum << ")" << std::endl;
+    }
+}
+
+/**
+ * @brief 性能基准：benchmark_usage <file.fbx> [iterations]
+ */
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <file.fbx> [iterations]" << std::endl;
+        return -1;
+    }
+
+    FbxErrorHandler::SetQuietMode(true);
+    const std::string filename = argv[1];
+    const int iterations = argc > 2 ? std::max(1, std::atoi(argv[2])) : 3;
+
+    try
+    {
+        std::cout << "=== Allocator: load / extract / destroy ===" << std::endl;
+        BenchmarkLoad(filename, false, iterations);
+        BenchmarkLoad(filename, true, iterations);
+
+        std::cout << "\n=== Normals: per-polygon vs per-corner gather ===" << std::endl;
+        BenchmarkNormals(filename, iterations);
+
+        std::cout << "\n=== Compression: size / round-trip error / decode throughput ===" << std::endl;
+        BenchmarkCompression(filename, iterations);
+
+        std::cout << "\n=== BVH: build / ray cast / AABB overlap ===" << std::endl;
+        BenchmarkBvh(filename, iterations);
+
+        std::cout << "\n=== C ABI: element-wise STL marshalling vs zero-copy views ===" << std::endl;
+        BenchmarkCApi(filename, iterations);
+    }
+    catch (const FbxSdkException& e)
+    {
+        std::cerr << "FBX SDK Exception: " << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
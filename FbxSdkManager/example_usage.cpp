@@ -1,128 +1,180 @@
 #include "FbxSdkWrapper.h"
+#include "FbxSdkCompression.h"
+#include "FbxSdkGltf.h"
+#include "FbxSdkPipeline.h"
+#include "FbxSdkShard.h"
+#include "FbxSdkTexture.h"
 #include "FbxSdkException.h"
 #include <iostream>
-#include <fstream>
 
 /**
  * @brief 示例：使用改进后的FBX SDK库
  */
 int main(int argc, char** argv)
 {
+    // 分片转换会以worker参数重新启动本程序
+    if (FbxShardedConverter::IsWorkerCommand(argc, argv))
+        return FbxShardedConverter::WorkerMain(argc, argv);
+
     // 设置错误处理模式
     FbxErrorHandler::SetQuietMode(false);
 
     try
     {
-        // 1. 创建FBX SDK包装器（自动管理资源）
-        FbxSdkWrapper fbxWrapper;
-        
-        // 2. 加载FBX文件
         const char* filename = argc > 1 ? argv[1] : "test.fbx";
-        std::cout << "Loading FBX file: " << filename << std::endl;
-        
-        if (!fbxWrapper.LoadFile(filename))
-        {
-            std::cerr << "Failed to load file: " << FbxErrorHandler::GetLastError() << std::endl;
-            return -1;
-        }
 
-        // 3. 获取并打印元数据
-        auto metadata = fbxWrapper.GetMetadata();
-        std::cout << "\n=== Scene Metadata ===" << std::endl;
-        for (const auto& pair : metadata)
         {
-            std::cout << pair.first << ": " << pair.second << std::endl;
-        }
-
-        // 4. 获取几何体信息
-        auto geometries = fbxWrapper.GetGeometries();
-        std::cout << "\n=== Geometries (" << geometries.size() << ") ===" << std::endl;
+            // 1. 创建FBX SDK包装器（自动管理资源）
+            FbxSdkWrapper fbxWrapper;
         
-        for (const auto& geoPair : geometries)
-        {
-            std::cout << "Geometry ID: " << geoPair.first 
-                      << ", Control Points: " << geoPair.second.ControlPoints.size()
-                      << ", Materials: " << geoPair.second.Sections.size() << std::endl;
+            // 2. 加载FBX文件
+            std::cout << "Loading FBX file: " << filename << std::endl;
+        
+            if (!fbxWrapper.LoadFile(filename))
+            {
+                FbxLogger::Flush();  // 日志异步写出，先让导入器的输出落地
+                std::cerr << "Failed to load file: " << FbxErrorHandler::GetLastError() << std::endl;
+                return -1;
+            }
 
-            // 转换为简化的网格数据
-            auto simplifiedMeshes = FbxGeometryExporter::ConvertToSimplifiedMeshes(geoPair.second);
-            
-            for (size_t i = 0; i < simplifiedMeshes.size(); ++i)
+            // 3. 获取并打印元数据
+            auto metadata = fbxWrapper.GetMetadata();
+            std::cout << "\n=== Scene Metadata ===" << std::endl;
+            for (const auto& pair : metadata)
             {
-                const auto& mesh = simplifiedMeshes[i];
-                std::cout << "  - Mesh " << i << ": "
-                          << mesh.vertices.size() << " vertices, "
-                          << mesh.indices.size() << " indices, "
-                          << "Material ID: " << mesh.materialId << std::endl;
+                std::cout << pair.first << ": " << pair.second << std::endl;
             }
-        }
 
-        // 5. 获取材质信息
-        auto materials = fbxWrapper.GetMaterials();
-        std::cout << "\n=== Materials (" << materials.size() << ") ===" << std::endl;
+            // 4. 获取几何体信息
+            auto geometries = fbxWrapper.GetGeometries();
+            std::cout << "\n=== Geometries (" << geometries.size() << ") ===" << std::endl;
         
-        for (const auto& matPair : materials)
-        {
-            const auto& mat = matPair.second;
-            std::cout << "Material ID: " << matPair.first << std::endl;
-            std::cout << "  - Diffuse: RGB(" 
-                      << mat.Diffuse.Color[0] << ", "
-                      << mat.Diffuse.Color[1] << ", " 
-                      << mat.Diffuse.Color[2] << ")";
-            if (mat.Diffuse.Texture)
+            for (const auto& geoPair : geometries)
             {
-                std::cout << ", Texture: " << mat.Diffuse.Texture;
+                std::cout << "Geometry ID: " << geoPair.first 
+                          << ", Control Points: " << geoPair.second.ControlPoints.size()
+                          << ", Materials: " << geoPair.second.Sections.size() << std::endl;
+
+                // 转换为简化的网格数据
+                auto simplifiedMeshes = FbxGeometryExporter::ConvertToSimplifiedMeshes(geoPair.second);
+            
+                for (size_t i = 0; i < simplifiedMeshes.size(); ++i)
+                {
+                    const auto& mesh = simplifiedMeshes[i];
+                    std::cout << "  - Mesh " << i << ": "
+                              << mesh.vertices.size() << " vertices, "
+                              << mesh.indices.size() << " indices, "
+                              << "Material ID: " << mesh.materialId << std::endl;
+                }
             }
-            std::cout << std::endl;
+
+            // 5. 获取材质信息
+            auto materials = fbxWrapper.GetMaterials();
+            std::cout << "\n=== Materials (" << materials.size() << ") ===" << std::endl;
+
+            // 场景索引只构建一次，之后按材质反查使用者不必再遍历场景
+            FbxSceneIndex sceneIndex = fbxWrapper.BuildSceneIndex();
+        
+            for (const auto& matPair : materials)
+            {
+                const auto& mat = matPair.second;
+                std::cout << "Material ID: " << matPair.first << std::endl;
+                const uint32_t materialIndex = sceneIndex.FindMaterial(matPair.first);
+                if (materialIndex != FbxSceneIndex::npos)
+                {
+                    std::cout << "  - Name: " << sceneIndex.GetMaterial(materialIndex).Name
+                              << ", used by " << sceneIndex.GetMaterialMeshes(materialIndex).size() << " meshes on "
+                              << sceneIndex.GetMaterialNodes(materialIndex).size() << " nodes" << std::endl;
+                }
+                std::cout << "  - Diffuse: RGB(" 
+                          << mat.Diffuse.Color[0] << ", "
+                          << mat.Diffuse.Color[1] << ", " 
+                          << mat.Diffuse.Color[2] << ")";
+                if (mat.Diffuse.Texture)
+                {
+                    std::cout << ", Texture: " << mat.Diffuse.Texture;
+                }
+                std::cout << std::endl;
             
-            std::cout << "  - Opacity: " << mat.Opacity.Factor;
-            if (mat.Opacity.Texture)
+                std::cout << "  - Opacity: " << mat.Opacity.Factor;
+                if (mat.Opacity.Texture)
+                {
+                    std::cout << ", Texture: " << mat.Opacity.Texture;
+                }
+                std::cout << std::endl;
+            }
+
+            // 贴图按路径解析、按内容去重后并行解码，同一文件只解码一次
+            FbxTextureOptions textureOptions;
+            textureOptions.ThumbnailSize = 64;
+            FbxTextureSet textures;
+            textures.Build(fbxWrapper.GetScene(), filename, textureOptions);
+            std::cout << "\n=== Textures (" << textures.GetTextureCount() << " textures, "
+                      << textures.GetImageCount() << " unique images) ===" << std::endl;
+            for (uint32_t i = 0; i < textures.GetImageCount(); ++i)
             {
-                std::cout << ", Texture: " << mat.Opacity.Texture;
+                const FbxImageInfo& image = textures.GetImageInfo(i);
+                std::cout << (image.Embedded ? "[embedded] " : "") << image.Path << ": "
+                          << image.Width << "x" << image.Height;
+                if (!image.Error.empty())
+                {
+                    std::cout << " (" << image.Error << ")";
+                }
+                std::cout << std::endl;
             }
-            std::cout << std::endl;
-        }
 
-        // 6. 导出为自定义格式（示例）
-        if (argc > 2)
-        {
-            std::string outputFile = argv[2];
-            std::ofstream out(outputFile, std::ios::binary);
-            
-            if (out.is_open())
+            // 6. 导出为自定义格式（示例）：提取、转换、序列化与写盘在流水线上重叠执行
+            if (argc > 2)
             {
-                // 写入几何体数量
-                uint32_t geoCount = static_cast<uint32_t>(geometries.size());
-                out.write(reinterpret_cast<const char*>(&geoCount), sizeof(geoCount));
-                
-                // 写入每个几何体的简化数据
-                for (const auto& geoPair : geometries)
+                std::string outputFile = argv[2];
+                FbxPipelineOptions options;
+                options.Compress = false;
+                if (FbxExportPipeline::Run(fbxWrapper, outputFile, options))
                 {
-                    auto meshes = FbxGeometryExporter::ConvertToSimplifiedMeshes(geoPair.second);
-                    uint32_t meshCount = static_cast<uint32_t>(meshes.size());
-                    out.write(reinterpret_cast<const char*>(&meshCount), sizeof(meshCount));
-                    
-                    for (const auto& mesh : meshes)
+                    std::cout << "\nExported to: " << outputFile << std::endl;
+                }
+            }
+
+            // 7. 量化压缩导出（示例）：焊接后逐网格编码，每块前写入字节数，并打印各阶段利用率
+            if (argc > 3)
+            {
+                std::string compressedFile = argv[3];
+                FbxPipelineReport report;
+                if (FbxExportPipeline::Run(fbxWrapper, compressedFile, FbxPipelineOptions(), &report))
+                {
+                    std::cout << "Compressed export to: " << compressedFile << " (" << report.BytesWritten << " bytes, "
+                              << report.WallMs << " ms, overlap " << report.GetOverlap() << "x)" << std::endl;
+                    for (int stage = 0; stage < FBX_PIPELINE_STAGE_COUNT; ++stage)
                     {
-                        // 写入顶点数据
-                        uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size());
-                        out.write(reinterpret_cast<const char*>(&vertexCount), sizeof(vertexCount));
-                        out.write(reinterpret_cast<const char*>(mesh.vertices.data()), 
-                                 vertexCount * sizeof(FbxGeometryExporter::SimplifiedVertex));
-                        
-                        // 写入索引数据
-                        uint32_t indexCount = static_cast<uint32_t>(mesh.indices.size());
-                        out.write(reinterpret_cast<const char*>(&indexCount), sizeof(indexCount));
-                        out.write(reinterpret_cast<const char*>(mesh.indices.data()), 
-                                 indexCount * sizeof(uint32_t));
-                        
-                        // 写入材质ID
-                        out.write(reinterpret_cast<const char*>(&mesh.materialId), sizeof(mesh.materialId));
+                        const FbxPipelineStageStats& stats = report.Stages[stage];
+                        std::cout << "  - " << stats.Name << ": " << stats.Items << " items, busy " << stats.BusyMs
+                                  << " ms (" << report.GetUtilization(static_cast<FbxPipelineStage>(stage)) * 100.0
+                                  << "%), starved " << stats.StarvedMs << " ms, blocked " << stats.BlockedMs << " ms" << std::endl;
                     }
                 }
-                
-                out.close();
-                std::cout << "\nExported to: " << outputFile << std::endl;
+            }
+
+            // 8. 导出GLB（示例）：逐Mesh提取并写出
+            if (argc > 4)
+            {
+                std::string glbFile = argv[4];
+                if (FbxGltfWriter::Export(fbxWrapper, glbFile))
+                {
+                    std::cout << "GLB export to: " << glbFile << std::endl;
+                }
+            }
+        }
+
+        // 9. 多进程分片转换（示例）：各worker进程独立导入并编码一部分Mesh，最后合并为一个容器。
+        //    每个worker都持有一份完整场景，放在上面的wrapper析构之后执行，本进程不再额外占用一份
+        if (argc > 5)
+        {
+            std::string containerFile = argv[5];
+            if (FbxShardedConverter::Convert(filename, containerFile))
+            {
+                FbxShardReader reader;
+                if (reader.Open(containerFile))
+                    std::cout << "Sharded export to: " << containerFile << " (" << reader.GetEntries().size() << " sections)" << std::endl;
             }
         }
 
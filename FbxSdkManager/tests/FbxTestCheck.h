@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdio>
+
+/**
+ * @brief 测试程序共用的断言：失败时打印位置并计数，不中断后续检查
+ */
+inline int& FbxTestFailures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+#define FBX_CHECK(condition)                                                              \
+    do                                                                                    \
+    {                                                                                     \
+        if (!(condition))                                                                 \
+        {                                                                                 \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++FbxTestFailures();                                                          \
+        }                                                                                 \
+    } while (0)
+
+/**
+ * @brief main的返回值：全部通过时为0
+ */
+inline int FbxTestResult(const char* name)
+{
+    if (FbxTestFailures() == 0)
+        std::printf("%s: passed\n", name);
+    else
+        std::printf("%s: %d check(s) failed\n", name, FbxTestFailures());
+    return FbxTestFailures() == 0 ? 0 : 1;
+}
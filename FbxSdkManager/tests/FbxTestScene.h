@@ -0,0 +1,51 @@
+#pragma once
+#include <fbxsdk.h>
+#include <string>
+
+/**
+ * @brief 用SDK生成测试用的FBX：一个四边形Mesh挂在一个节点上，带一个Phong材质与漫反射贴图
+ * @param textureName 漫反射贴图的文件名
+ * @param geometricTranslation 节点的几何平移（只作用于该节点的几何体）
+ */
+inline bool FbxWriteTestScene(const std::string& path, const char* textureName,
+                              const FbxVector4& geometricTranslation = FbxVector4(0.0, 0.0, 0.0))
+{
+    FbxManager* manager = FbxManager::Create();
+    manager->SetIOSettings(FbxIOSettings::Create(manager, IOSROOT));
+    FbxScene* scene = FbxScene::Create(manager, "Test");
+
+    FbxMesh* mesh = FbxMesh::Create(scene, "Quad");
+    mesh->InitControlPoints(4);
+    FbxVector4* points = mesh->GetControlPoints();
+    points[0] = FbxVector4(0.0, 0.0, 0.0);
+    points[1] = FbxVector4(1.0, 0.0, 0.0);
+    points[2] = FbxVector4(1.0, 1.0, 0.0);
+    points[3] = FbxVector4(0.0, 1.0, 0.0);
+    mesh->BeginPolygon(0);
+    for (int i = 0; i < 4; ++i)
+        mesh->AddPolygon(i);
+    mesh->EndPolygon();
+
+    FbxGeometryElementMaterial* element = mesh->CreateElementMaterial();
+    element->SetMappingMode(FbxGeometryElement::eAllSame);
+    element->SetReferenceMode(FbxGeometryElement::eIndexToDirect);
+    element->GetIndexArray().Add(0);
+
+    FbxNode* node = FbxNode::Create(scene, "QuadNode");
+    node->SetNodeAttribute(mesh);
+    node->SetGeometricTranslation(FbxNode::eSourcePivot, geometricTranslation);
+    scene->GetRootNode()->AddChild(node);
+
+    FbxSurfacePhong* material = FbxSurfacePhong::Create(scene, "Paint");
+    material->Diffuse.Set(FbxDouble3(0.5, 0.25, 1.0));
+    FbxFileTexture* texture = FbxFileTexture::Create(scene, "Albedo");
+    texture->SetFileName(textureName);
+    material->Diffuse.ConnectSrcObject(texture);
+    node->AddMaterial(material);
+
+    FbxExporter* exporter = FbxExporter::Create(manager, "");
+    bool succeeded = exporter->Initialize(path.c_str(), -1, manager->GetIOSettings()) && exporter->Export(scene);
+    exporter->Destroy();
+    manager->Destroy();
+    return succeeded;
+}
@@ -0,0 +1,420 @@
+/**
+ * @brief GLB往返：写出一个合成场景，重新解析JSON块与BIN块，检查数量、访问器边界与材质/贴图映射
+ */
+#include "../FbxSdkGltf.h"
+#include "FbxTestCheck.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief 只覆盖glTF JSON所需子集的解析器
+     */
+    struct JsonValue
+    {
+        enum Type { Null, Bool, Number, String, Array, Object } Kind = Null;
+        double NumberValue = 0.0;
+        std::string StringValue;
+        std::vector<JsonValue> Items;
+        std::map<std::string, JsonValue> Members;
+
+        const JsonValue& operator[](const std::string& key) const
+        {
+            static const JsonValue missing;
+            auto found = Members.find(key);
+            return found != Members.end() ? found->second : missing;
+        }
+
+        const JsonValue& operator[](size_t index) const
+        {
+            static const JsonValue missing;
+            return index < Items.size() ? Items[index] : missing;
+        }
+
+        bool Has(const std::string& key) const { return Members.count(key) != 0; }
+        size_t Size() const { return Kind == Array ? Items.size() : Members.size(); }
+        int Int() const { return static_cast<int>(NumberValue); }
+    };
+
+    class JsonParser
+    {
+    public:
+        explicit JsonParser(const std::string& text) : m_text(text) {}
+
+        bool Parse(JsonValue& value)
+        {
+            return ParseValue(value) && (SkipSpace(), m_pos == m_text.size());
+        }
+
+    private:
+        void SkipSpace()
+        {
+            while (m_pos < m_text.size() && std::strchr(" \t\r\n", m_text[m_pos]))
+                ++m_pos;
+        }
+
+        bool Consume(char c)
+        {
+            SkipSpace();
+            if (m_pos < m_text.size() && m_text[m_pos] == c)
+            {
+                ++m_pos;
+                return true;
+            }
+            return false;
+        }
+
+        bool ParseString(std::string& out)
+        {
+            if (!Consume('"'))
+                return false;
+            while (m_pos < m_text.size() && m_text[m_pos] != '"')
+            {
+                char c = m_text[m_pos++];
+                if (c == '\\' && m_pos < m_text.size())
+                {
+                    const char escaped = m_text[m_pos++];
+                    switch (escaped)
+                    {
+                    case 'n': c = '\n'; break;
+                    case 'r': c = '\r'; break;
+                    case 't': c = '\t'; break;
+                    case 'u':
+                        if (m_pos + 4 > m_text.size())
+                            return false;
+                        c = static_cast<char>(std::stoi(m_text.substr(m_pos, 4), nullptr, 16));
+                        m_pos += 4;
+                        break;
+                    default: c = escaped; break;
+                    }
+                }
+                out += c;
+            }
+            return Consume('"');
+        }
+
+        bool ParseValue(JsonValue& value)
+        {
+            SkipSpace();
+            if (m_pos >= m_text.size())
+                return false;
+
+            const char c = m_text[m_pos];
+            if (c == '{')
+            {
+                ++m_pos;
+                value.Kind = JsonValue::Object;
+                if (Consume('}'))
+                    return true;
+                do
+                {
+                    std::string key;
+                    if (!ParseString(key) || !Consume(':') || !ParseValue(value.Members[key]))
+                        return false;
+                } while (Consume(','));
+                return Consume('}');
+            }
+            if (c == '[')
+            {
+                ++m_pos;
+                value.Kind = JsonValue::Array;
+                if (Consume(']'))
+                    return true;
+                do
+                {
+                    value.Items.emplace_back();
+                    if (!ParseValue(value.Items.back()))
+                        return false;
+                } while (Consume(','));
+                return Consume(']');
+            }
+            if (c == '"')
+            {
+                value.Kind = JsonValue::String;
+                return ParseString(value.StringValue);
+            }
+            for (const char* literal : { "true", "false", "null" })
+            {
+                if (m_text.compare(m_pos, std::strlen(literal), literal) == 0)
+                {
+                    value.Kind = literal[0] == 'n' ? JsonValue::Null : JsonValue::Bool;
+                    value.NumberValue = literal[0] == 't' ? 1.0 : 0.0;
+                    m_pos += std::strlen(literal);
+                    return true;
+                }
+            }
+
+            size_t length = 0;
+            try
+            {
+                value.NumberValue = std::stod(m_text.substr(m_pos, 32), &length);
+            }
+            catch (...)
+            {
+                return false;
+            }
+            value.Kind = JsonValue::Number;
+            m_pos += length;
+            return length > 0;
+        }
+
+        const std::string& m_text;
+        size_t m_pos = 0;
+    };
+
+    uint32_t Read32(const std::string& data, size_t offset)
+    {
+        uint32_t value = 0;
+        std::memcpy(&value, data.data() + offset, sizeof(value));
+        return value;
+    }
+
+    bool Near(double a, double b)
+    {
+        return std::abs(a - b) < 1e-5;
+    }
+
+    /**
+     * @brief 按访问器读取BIN中的第index个元素的第component个分量
+     */
+    double ReadAccessor(const JsonValue& gltf, const std::string& bin, int accessorIndex, size_t index, int component)
+    {
+        static const std::map<std::string, int> componentCounts = { { "SCALAR", 1 }, { "VEC2", 2 }, { "VEC3", 3 }, { "VEC4", 4 } };
+        const JsonValue& accessor = gltf["accessors"][accessorIndex];
+        const JsonValue& view = gltf["bufferViews"][accessor["bufferView"].Int()];
+        const int componentType = accessor["componentType"].Int();
+        const size_t componentSize = componentType == 5123 ? 2 : 4;
+        const size_t elementSize = componentSize * componentCounts.at(accessor["type"].StringValue);
+        const size_t offset = static_cast<size_t>(view["byteOffset"].NumberValue + accessor["byteOffset"].NumberValue) +
+                              index * elementSize + component * componentSize;
+        if (offset + componentSize > bin.size())
+            return NAN;
+
+        if (componentType == 5126)
+        {
+            float value;
+            std::memcpy(&value, bin.data() + offset, sizeof(value));
+            return value;
+        }
+        if (componentType == 5123)
+        {
+            uint16_t value;
+            std::memcpy(&value, bin.data() + offset, sizeof(value));
+            return value;
+        }
+        uint32_t value;
+        std::memcpy(&value, bin.data() + offset, sizeof(value));
+        return value;
+    }
+}
+
+namespace
+{
+    /**
+     * @brief 绝对路径的贴图写成相对GLB所在目录的URI，':'编码后不会被读成scheme
+     */
+    void TestImageUris()
+    {
+        const std::string path = "test_gltf_uri.glb";
+        const std::string absoluteTexture = (std::filesystem::current_path() / "textures" / "abs.png").string();
+        const char* textures[] = { absoluteTexture.c_str(), "a:b.png" };
+
+        std::map<uint64_t, FbxMaterialsInfo> materials;
+        for (uint64_t i = 0; i < 2; ++i)
+        {
+            FbxMaterialsInfo material = {};
+            material.Diffuse.Texture = textures[i];
+            material.Opacity.Factor = 1.0;
+            materials[i + 1] = material;
+        }
+        {
+            FbxGltfWriter writer;
+            FBX_CHECK(writer.Open(path));
+            writer.AddMaterials(materials);
+            FBX_CHECK(writer.Finish());
+        }
+
+        std::ifstream file(path, std::ios::binary);
+        const std::string glb((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        file.close();
+        std::remove(path.c_str());
+        FBX_CHECK(glb.size() >= 20 && 20 + static_cast<size_t>(Read32(glb, 12)) <= glb.size());
+        if (glb.size() < 20 || 20 + static_cast<size_t>(Read32(glb, 12)) > glb.size())
+            return;
+
+        JsonValue gltf;
+        FBX_CHECK(JsonParser(glb.substr(20, Read32(glb, 12))).Parse(gltf));
+        FBX_CHECK(gltf["images"].Size() == 2);
+        FBX_CHECK(gltf["images"][0]["uri"].StringValue == "textures/abs.png");
+        FBX_CHECK(gltf["images"][1]["uri"].StringValue == "a%3Ab.png");
+    }
+}
+
+int main()
+{
+    const std::string path = "test_gltf.glb";
+    const uint64_t meshId = 10;
+
+    // 四边形，两个三角形共用对角线上的两个控制点，焊接后应为4个顶点
+    FbxGeometryInfo geometry;
+    geometry.ControlPoints = { FbxVector4(0.0, 0.0, 0.0), FbxVector4(2.0, 0.0, 0.0), FbxVector4(2.0, 1.0, 0.0),
+                               FbxVector4(0.0, 1.0, -3.0) };
+    FbxSection& section = geometry.Sections[100];
+    section.Triangle = { 0, 1, 2, 0, 2, 3 };
+    section.MaterialSlot = 0;
+    section.UVSets.emplace_back();
+    for (int controlPoint : section.Triangle)
+    {
+        section.Normals.push_back(FbxVector4(0.0, 0.0, 1.0));
+        section.UVSets[0].UVs.push_back(FbxVector2(geometry.ControlPoints[controlPoint][0] / 2.0, geometry.ControlPoints[controlPoint][1]));
+    }
+
+    // 两个材质引用同一贴图文件，只应生成一个texture与image
+    const char* textureFile = "textures\\albedo map.png";
+    std::map<uint64_t, FbxMaterialsInfo> materials;
+    for (uint64_t id : { 100ull, 200ull })
+    {
+        FbxMaterialsInfo material = {};
+        material.Diffuse.Color = FbxDouble3(0.5, 0.25, 1.0);
+        material.Diffuse.Texture = textureFile;
+        material.Opacity.Factor = 1.0;
+        material.Shininess.Factor = 20.0;
+        materials[id] = material;
+    }
+
+    std::vector<FbxNodeInfo> nodes(2);
+    nodes[0].Id = 1;
+    nodes[0].NodeName = "Root";
+    nodes[0].LocalTransform.SetIdentity();
+    nodes[0].GeometricTransform.SetIdentity();
+    nodes[1].ParentId = 1;
+    nodes[1].Id = 2;
+    nodes[1].NodeName = "Quad";
+    nodes[1].LinkMeshId = meshId;
+    nodes[1].LinkMaterialsId = { 100 };
+    nodes[1].LocalTransform.SetIdentity();
+    nodes[1].GeometricTransform = FbxAMatrix(FbxVector4(0.0, 0.0, 5.0), FbxVector4(0.0, 0.0, 0.0), FbxVector4(1.0, 1.0, 1.0));
+
+    {
+        FbxGltfWriter writer;
+        FBX_CHECK(writer.Open(path));
+        writer.AddMaterials(materials);
+        FBX_CHECK(writer.AddMesh(meshId, geometry, "Quad"));
+        writer.AddNodes(nodes);
+        FBX_CHECK(writer.Finish());
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    const std::string glb((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    std::remove(path.c_str());
+
+    // 头与块
+    FBX_CHECK(glb.size() >= 28);
+    if (glb.size() < 28)
+        return FbxTestResult("test_gltf");
+    FBX_CHECK(Read32(glb, 0) == 0x46546c67u);
+    FBX_CHECK(Read32(glb, 4) == 2);
+    FBX_CHECK(Read32(glb, 8) == glb.size());
+    const uint32_t jsonLength = Read32(glb, 12);
+    FBX_CHECK(Read32(glb, 16) == 0x4e4f534au);
+    FBX_CHECK(jsonLength % 4 == 0 && 20 + jsonLength + 8 <= glb.size());
+    if (20 + static_cast<size_t>(jsonLength) + 8 > glb.size())
+        return FbxTestResult("test_gltf");
+    const std::string json = glb.substr(20, jsonLength);
+    const size_t binHeader = 20 + jsonLength;
+    const uint32_t binLength = Read32(glb, binHeader);
+    FBX_CHECK(Read32(glb, binHeader + 4) == 0x004e4942u);
+    FBX_CHECK(binHeader + 8 + binLength == glb.size());
+    const std::string bin = glb.substr(binHeader + 8, binLength);
+
+    JsonValue gltf;
+    FBX_CHECK(JsonParser(json).Parse(gltf));
+    FBX_CHECK(gltf["asset"]["version"].StringValue == "2.0");
+    FBX_CHECK(gltf["buffers"][0]["byteLength"].NumberValue == binLength);
+
+    // 节点：Root -> Quad -> Quad_geometry（承载几何变换与mesh）
+    FBX_CHECK(gltf["nodes"].Size() == 3);
+    FBX_CHECK(gltf["scenes"][gltf["scene"].Int()]["nodes"].Size() == 1);
+    FBX_CHECK(gltf["nodes"][0]["name"].StringValue == "Root");
+    FBX_CHECK(gltf["nodes"][0]["children"][0].Int() == 1);
+    const JsonValue& quad = gltf["nodes"][1];
+    FBX_CHECK(quad["name"].StringValue == "Quad");
+    FBX_CHECK(!quad.Has("mesh"));
+    FBX_CHECK(quad["children"].Size() == 1 && quad["children"][0].Int() == 2);
+    const JsonValue& quadGeometry = gltf["nodes"][2];
+    FBX_CHECK(quadGeometry["name"].StringValue == "Quad_geometry");
+    FBX_CHECK(quadGeometry["mesh"].Int() == 0);
+    FBX_CHECK(Near(quadGeometry["translation"][2].NumberValue, 5.0));
+    FBX_CHECK(!quadGeometry.Has("children"));
+
+    // mesh与访问器
+    FBX_CHECK(gltf["meshes"].Size() == 1);
+    const JsonValue& primitive = gltf["meshes"][0]["primitives"][0];
+    FBX_CHECK(gltf["meshes"][0]["primitives"].Size() == 1);
+    FBX_CHECK(primitive["mode"].Int() == 4);
+    const int positionAccessor = primitive["attributes"]["POSITION"].Int();
+    const int indexAccessor = primitive["indices"].Int();
+    const JsonValue& position = gltf["accessors"][positionAccessor];
+    FBX_CHECK(position["count"].Int() == 4);
+    FBX_CHECK(primitive["attributes"].Has("NORMAL"));
+    FBX_CHECK(primitive["attributes"].Has("TEXCOORD_0"));
+    FBX_CHECK(gltf["accessors"][primitive["attributes"]["NORMAL"].Int()]["count"].Int() == 4);
+    FBX_CHECK(gltf["accessors"][indexAccessor]["count"].Int() == 6);
+
+    const double expectedMin[3] = { 0.0, 0.0, -3.0 };
+    const double expectedMax[3] = { 2.0, 1.0, 0.0 };
+    for (int k = 0; k < 3; ++k)
+    {
+        FBX_CHECK(Near(position["min"][k].NumberValue, expectedMin[k]));
+        FBX_CHECK(Near(position["max"][k].NumberValue, expectedMax[k]));
+        double low = INFINITY, high = -INFINITY;
+        for (int v = 0; v < position["count"].Int(); ++v)
+        {
+            const double value = ReadAccessor(gltf, bin, positionAccessor, v, k);
+            low = std::min(low, value);
+            high = std::max(high, value);
+        }
+        FBX_CHECK(Near(low, position["min"][k].NumberValue));
+        FBX_CHECK(Near(high, position["max"][k].NumberValue));
+    }
+
+    // 索引在范围内，且还原出原始的corner位置
+    for (size_t i = 0; i < section.Triangle.size(); ++i)
+    {
+        const double index = ReadAccessor(gltf, bin, indexAccessor, i, 0);
+        FBX_CHECK(index >= 0 && index < position["count"].NumberValue);
+        for (int k = 0; k < 3; ++k)
+        {
+            FBX_CHECK(Near(ReadAccessor(gltf, bin, positionAccessor, static_cast<size_t>(index), k),
+                           geometry.ControlPoints[section.Triangle[i]][k]));
+        }
+    }
+
+    // 材质 -> baseColorTexture -> image
+    FBX_CHECK(gltf["materials"].Size() == 2);
+    const JsonValue& material = gltf["materials"][primitive["material"].Int()];
+    FBX_CHECK(primitive.Has("material"));
+    const JsonValue& pbr = material["pbrMetallicRoughness"];
+    const double expectedColor[4] = { 0.5, 0.25, 1.0, 1.0 };
+    for (int k = 0; k < 4; ++k)
+        FBX_CHECK(Near(pbr["baseColorFactor"][k].NumberValue, expectedColor[k]));
+    FBX_CHECK(!material.Has("alphaMode"));
+    FBX_CHECK(gltf["textures"].Size() == 1);
+    FBX_CHECK(gltf["images"].Size() == 1);
+    FBX_CHECK(gltf["materials"][1]["pbrMetallicRoughness"]["baseColorTexture"]["index"].Int() == 0);
+    const JsonValue& texture = gltf["textures"][pbr["baseColorTexture"]["index"].Int()];
+    FBX_CHECK(gltf["images"][texture["source"].Int()]["uri"].StringValue == "textures/albedo%20map.png");
+
+    TestImageUris();
+    return FbxTestResult("test_gltf");
+}
@@ -0,0 +1,328 @@
+/**
+ * @brief 内置解码器：代码构造的PNG/TGA逐像素比对；JPEG按解析式图案在量化误差内比对
+ */
+#include "../FbxSdkImage.h"
+#include "FbxTestCheck.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const uint32_t kWidth = 19;
+    const uint32_t kHeight = 13;
+
+    /**
+     * @brief JPEG样例的源图案，与生成样例时使用的一致
+     */
+    void Pattern(uint32_t x, uint32_t y, uint8_t rgb[3])
+    {
+        rgb[0] = static_cast<uint8_t>(x * 12 + 8);
+        rgb[1] = static_cast<uint8_t>(y * 16 + 16);
+        rgb[2] = static_cast<uint8_t>(200 - x * 4 - y * 4);
+    }
+
+    // 由libjpeg以质量95编码的19x13样例，宽高都不是MCU的整数倍
+    const uint8_t kBaseline420[] = {
+        0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10, 0x4a, 0x46, 0x49, 0x46, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01,
+        0x00, 0x01, 0x00, 0x00, 0xff, 0xdb, 0x00, 0x43, 0x00, 0x02, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02,
+        0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02, 0x04, 0x03, 0x02, 0x02, 0x02, 0x02, 0x05, 0x04,
+        0x04, 0x03, 0x04, 0x06, 0x05, 0x06, 0x06, 0x06, 0x05, 0x06, 0x06, 0x06, 0x07, 0x09, 0x08, 0x06,
+        0x07, 0x09, 0x07, 0x06, 0x06, 0x08, 0x0b, 0x08, 0x09, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x06, 0x08,
+        0x0b, 0x0c, 0x0b, 0x0a, 0x0c, 0x09, 0x0a, 0x0a, 0x0a, 0xff, 0xdb, 0x00, 0x43, 0x01, 0x02, 0x02,
+        0x02, 0x02, 0x02, 0x02, 0x05, 0x03, 0x03, 0x05, 0x0a, 0x07, 0x06, 0x07, 0x0a, 0x0a, 0x0a, 0x0a,
+        0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a,
+        0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a,
+        0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0xff, 0xc0,
+        0x00, 0x11, 0x08, 0x00, 0x0d, 0x00, 0x13, 0x03, 0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11,
+        0x01, 0xff, 0xc4, 0x00, 0x17, 0x00, 0x00, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x08, 0x09, 0xff, 0xc4, 0x00, 0x22, 0x10, 0x00,
+        0x00, 0x04, 0x05, 0x05, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x01, 0x02, 0x06, 0x04, 0x07, 0x08, 0x11, 0xa2, 0x12, 0x14, 0x15, 0x42, 0x52, 0x22, 0xff, 0xc4,
+        0x00, 0x17, 0x01, 0x00, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x06, 0x07, 0x08, 0x09, 0xff, 0xc4, 0x00, 0x23, 0x11, 0x00, 0x00, 0x04, 0x05,
+        0x04, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x04, 0x07,
+        0x02, 0x03, 0x13, 0x21, 0x31, 0x12, 0x22, 0x23, 0x41, 0x61, 0xa1, 0xb1, 0xff, 0xdd, 0x00, 0x04,
+        0x00, 0x02, 0xff, 0xda, 0x00, 0x0c, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3f, 0x00,
+        0x8c, 0x98, 0xd4, 0xb9, 0x72, 0x41, 0xf1, 0xd8, 0x07, 0x23, 0x1e, 0x97, 0x2e, 0x48, 0x3e, 0x3b,
+        0x01, 0x4f, 0xb1, 0x64, 0xeb, 0x5e, 0xe8, 0x2d, 0x18, 0x10, 0x72, 0xb1, 0x64, 0xeb, 0x5e, 0xe8,
+        0x2d, 0x18, 0x10, 0x2d, 0x72, 0x9f, 0x65, 0xa5, 0xae, 0xe7, 0xec, 0x2e, 0xd8, 0xc7, 0x9d, 0x5f,
+        0x15, 0xcf, 0xa1, 0x24, 0xc1, 0x52, 0xe5, 0xe1, 0x50, 0x7c, 0x77, 0x5f, 0x00, 0x1a, 0x05, 0x07,
+        0x27, 0x5a, 0xfb, 0x54, 0x7c, 0x75, 0xf0, 0x40, 0x12, 0xc4, 0xc7, 0xdd, 0x6d, 0x43, 0xdd, 0x16,
+        0x7c, 0x8d, 0x05, 0x90, 0xf4, 0x2b, 0xa3, 0x0d, 0xcf, 0x05, 0xf0, 0x7f, 0xff, 0xd9,
+    };
+
+    const uint8_t kProgressive422[] = {
+        0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10, 0x4a, 0x46, 0x49, 0x46, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01,
+        0x00, 0x01, 0x00, 0x00, 0xff, 0xdb, 0x00, 0x43, 0x00, 0x02, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02,
+        0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02, 0x04, 0x03, 0x02, 0x02, 0x02, 0x02, 0x05, 0x04,
+        0x04, 0x03, 0x04, 0x06, 0x05, 0x06, 0x06, 0x06, 0x05, 0x06, 0x06, 0x06, 0x07, 0x09, 0x08, 0x06,
+        0x07, 0x09, 0x07, 0x06, 0x06, 0x08, 0x0b, 0x08, 0x09, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x06, 0x08,
+        0x0b, 0x0c, 0x0b, 0x0a, 0x0c, 0x09, 0x0a, 0x0a, 0x0a, 0xff, 0xdb, 0x00, 0x43, 0x01, 0x02, 0x02,
+        0x02, 0x02, 0x02, 0x02, 0x05, 0x03, 0x03, 0x05, 0x0a, 0x07, 0x06, 0x07, 0x0a, 0x0a, 0x0a, 0x0a,
+        0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a,
+        0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a,
+        0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0xff, 0xc2,
+        0x00, 0x11, 0x08, 0x00, 0x0d, 0x00, 0x13, 0x03, 0x01, 0x21, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11,
+        0x01, 0xff, 0xc4, 0x00, 0x16, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x07, 0xff, 0xc4, 0x00, 0x17, 0x01, 0x00, 0x03,
+        0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x07,
+        0x08, 0x05, 0xff, 0xda, 0x00, 0x0c, 0x03, 0x01, 0x00, 0x02, 0x10, 0x03, 0x10, 0x00, 0x00, 0x01,
+        0xc6, 0x19, 0x32, 0xcc, 0x4f, 0x2b, 0x28, 0x35, 0x2c, 0xb2, 0x22, 0x04, 0xd2, 0xb2, 0x82, 0xff,
+        0xc4, 0x00, 0x1a, 0x10, 0x00, 0x02, 0x03, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x02, 0x05, 0x06, 0x12, 0x22, 0xff, 0xda, 0x00, 0x08, 0x01,
+        0x01, 0x00, 0x01, 0x05, 0x02, 0x47, 0x2e, 0x23, 0x97, 0x21, 0x97, 0xf2, 0x8d, 0x3a, 0xa2, 0x34,
+        0xea, 0x90, 0xa7, 0x57, 0x9f, 0xff, 0xc4, 0x00, 0x1d, 0x11, 0x00, 0x01, 0x03, 0x05, 0x01, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x05, 0x03, 0x06,
+        0x12, 0x21, 0x22, 0x32, 0xff, 0xda, 0x00, 0x08, 0x01, 0x03, 0x01, 0x01, 0x3f, 0x01, 0xb1, 0xa7,
+        0x7c, 0xec, 0x64, 0xef, 0x09, 0xb2, 0xc6, 0x91, 0xaf, 0xc8, 0xc9, 0x2a, 0xf8, 0x21, 0xff, 0xc4,
+        0x00, 0x1c, 0x11, 0x00, 0x01, 0x04, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x02, 0x04, 0x05, 0x06, 0x12, 0x21, 0x31, 0x22, 0xff, 0xda, 0x00, 0x08,
+        0x01, 0x02, 0x01, 0x01, 0x3f, 0x01, 0xb2, 0x58, 0x7b, 0xb1, 0x56, 0x1f, 0x5d, 0x2c, 0xb2, 0x8e,
+        0x36, 0x2a, 0x51, 0xc6, 0x47, 0xff, 0xc4, 0x00, 0x16, 0x10, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x33, 0x00, 0x20, 0xff, 0xda, 0x00,
+        0x08, 0x01, 0x01, 0x00, 0x06, 0x3f, 0x02, 0x38, 0xe3, 0xc7, 0xff, 0xc4, 0x00, 0x1c, 0x10, 0x00,
+        0x02, 0x01, 0x05, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x21, 0x31, 0x11, 0x41, 0x51, 0xa1, 0xc1, 0x61, 0xff, 0xda, 0x00, 0x08, 0x01, 0x01, 0x00, 0x01,
+        0x3f, 0x21, 0x87, 0x82, 0x1e, 0x04, 0xfc, 0x60, 0x59, 0x68, 0x59, 0x68, 0xa2, 0xab, 0x60, 0xff,
+        0xda, 0x00, 0x0c, 0x03, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00, 0x10, 0xdc, 0x6c, 0xff,
+        0xc4, 0x00, 0x19, 0x11, 0x00, 0x02, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x81, 0x91, 0xb1, 0xa1, 0xff, 0xda, 0x00, 0x08, 0x01, 0x03,
+        0x01, 0x01, 0x3f, 0x10, 0xe5, 0x11, 0x05, 0x82, 0xd5, 0x22, 0x0b, 0x0f, 0xff, 0xc4, 0x00, 0x1c,
+        0x11, 0x00, 0x01, 0x03, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x01, 0x11, 0x21, 0x31, 0x51, 0x61, 0x71, 0xa1, 0xff, 0xda, 0x00, 0x08, 0x01, 0x02,
+        0x01, 0x01, 0x3f, 0x10, 0x3e, 0x56, 0x62, 0x0a, 0xfa, 0x3a, 0x6e, 0xe7, 0xff, 0xc4, 0x00, 0x18,
+        0x10, 0x00, 0x03, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x01, 0x11, 0xb1, 0xc1, 0xff, 0xda, 0x00, 0x08, 0x01, 0x01, 0x00, 0x01, 0x3f, 0x10,
+        0xba, 0x73, 0xaa, 0x73, 0xbb, 0x4b, 0x42, 0xe6, 0x50, 0xb9, 0x9c, 0x0d, 0x3f, 0xff, 0xd9,
+    };
+
+    const uint8_t kGray[] = {
+        0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10, 0x4a, 0x46, 0x49, 0x46, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01,
+        0x00, 0x01, 0x00, 0x00, 0xff, 0xdb, 0x00, 0x43, 0x00, 0x02, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02,
+        0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02, 0x04, 0x03, 0x02, 0x02, 0x02, 0x02, 0x05, 0x04,
+        0x04, 0x03, 0x04, 0x06, 0x05, 0x06, 0x06, 0x06, 0x05, 0x06, 0x06, 0x06, 0x07, 0x09, 0x08, 0x06,
+        0x07, 0x09, 0x07, 0x06, 0x06, 0x08, 0x0b, 0x08, 0x09, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x06, 0x08,
+        0x0b, 0x0c, 0x0b, 0x0a, 0x0c, 0x09, 0x0a, 0x0a, 0x0a, 0xff, 0xc0, 0x00, 0x0b, 0x08, 0x00, 0x0d,
+        0x00, 0x13, 0x01, 0x01, 0x11, 0x00, 0xff, 0xc4, 0x00, 0x16, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x07, 0x09, 0xff, 0xc4,
+        0x00, 0x23, 0x10, 0x00, 0x00, 0x03, 0x07, 0x05, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x07, 0x42, 0x01, 0x03, 0x06, 0x08, 0x22, 0x24, 0x51, 0x05, 0x15, 0x23,
+        0x33, 0x52, 0x25, 0xff, 0xda, 0x00, 0x08, 0x01, 0x01, 0x00, 0x00, 0x3f, 0x00, 0xcf, 0x32, 0x4a,
+        0x5b, 0x7a, 0x6c, 0x30, 0x90, 0xc0, 0x24, 0xa5, 0xb7, 0xa6, 0xc3, 0x09, 0x09, 0x3d, 0x1e, 0x5b,
+        0x7e, 0x63, 0x9b, 0x04, 0x79, 0x11, 0x42, 0x48, 0xa8, 0x86, 0xf8, 0x68, 0xc2, 0x18, 0x18, 0x04,
+        0x91, 0x51, 0x0d, 0xf0, 0xd1, 0x84, 0x30, 0x24, 0xf4, 0x72, 0xa2, 0x1b, 0xdb, 0x1c, 0xd0, 0x8f,
+        0x0c, 0x1f, 0xff, 0xd9,
+    };
+
+    void AppendBE32(std::vector<uint8_t>& out, uint32_t value)
+    {
+        out.push_back(static_cast<uint8_t>(value >> 24));
+        out.push_back(static_cast<uint8_t>(value >> 16));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    void AppendChunk(std::vector<uint8_t>& png, const char* type, const std::vector<uint8_t>& payload)
+    {
+        AppendBE32(png, static_cast<uint32_t>(payload.size()));
+        png.insert(png.end(), type, type + 4);
+        png.insert(png.end(), payload.begin(), payload.end());
+        AppendBE32(png, 0);    // 解码器不校验CRC
+    }
+
+    /**
+     * @brief 构造PNG：IDAT是只含一个stored块的zlib流
+     */
+    std::vector<uint8_t> MakePng(uint32_t width, uint32_t height, uint8_t colorType, const std::vector<uint8_t>& scanlines,
+                                 const std::vector<uint8_t>& palette = std::vector<uint8_t>())
+    {
+        std::vector<uint8_t> png = { 0x89, 'P', 'N', 'G', 0x0d, 0x0a, 0x1a, 0x0a };
+
+        std::vector<uint8_t> ihdr;
+        AppendBE32(ihdr, width);
+        AppendBE32(ihdr, height);
+        ihdr.insert(ihdr.end(), { 8, colorType, 0, 0, 0 });
+        AppendChunk(png, "IHDR", ihdr);
+
+        if (!palette.empty())
+            AppendChunk(png, "PLTE", palette);
+
+        const uint16_t length = static_cast<uint16_t>(scanlines.size());
+        std::vector<uint8_t> idat = { 0x78, 0x01, 0x01,
+                                      static_cast<uint8_t>(length), static_cast<uint8_t>(length >> 8),
+                                      static_cast<uint8_t>(~length), static_cast<uint8_t>(~length >> 8) };
+        idat.insert(idat.end(), scanlines.begin(), scanlines.end());
+        AppendBE32(idat, 0);    // Adler-32，不校验
+        AppendChunk(png, "IDAT", idat);
+        AppendChunk(png, "IEND", std::vector<uint8_t>());
+        return png;
+    }
+
+    bool PixelIs(const FbxImageLevel& image, uint32_t x, uint32_t y, uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+    {
+        const uint8_t* p = &image.Pixels[(static_cast<size_t>(y) * image.Width + x) * 4];
+        return p[0] == r && p[1] == g && p[2] == b && p[3] == a;
+    }
+
+    void TestPng()
+    {
+        // 3x2 RGB，第二行使用Sub过滤器
+        const std::vector<uint8_t> rgb = {
+            0, 255, 0, 0, 0, 255, 0, 0, 0, 255,
+            1, 10, 20, 30, 5, 5, 5, 5, 5, 5,
+        };
+        std::vector<uint8_t> png = MakePng(3, 2, 2, rgb);
+        FBX_CHECK(FbxImageCodec::DetectFormat(png.data(), png.size(), "a.png") == FBX_IMAGE_PNG);
+
+        uint32_t width = 0, height = 0;
+        FBX_CHECK(FbxImageCodec::ReadDimensions(png.data(), png.size(), FBX_IMAGE_PNG, width, height));
+        FBX_CHECK(width == 3 && height == 2);
+
+        FbxImageLevel image;
+        std::string error;
+        FBX_CHECK(FbxImageCodec::Decode(png.data(), png.size(), FBX_IMAGE_PNG, image, &error));
+        FBX_CHECK(image.Width == 3 && image.Height == 2 && image.Pixels.size() == 3 * 2 * 4);
+        if (image.Pixels.size() == 3 * 2 * 4)
+        {
+            FBX_CHECK(PixelIs(image, 0, 0, 255, 0, 0, 255));
+            FBX_CHECK(PixelIs(image, 1, 0, 0, 255, 0, 255));
+            FBX_CHECK(PixelIs(image, 2, 0, 0, 0, 255, 255));
+            FBX_CHECK(PixelIs(image, 0, 1, 10, 20, 30, 255));
+            FBX_CHECK(PixelIs(image, 1, 1, 15, 25, 35, 255));
+            FBX_CHECK(PixelIs(image, 2, 1, 20, 30, 40, 255));
+        }
+
+        // 2x1 调色板
+        std::vector<uint8_t> indexed = MakePng(2, 1, 3, { 0, 1, 0 }, { 9, 8, 7, 60, 70, 80 });
+        FBX_CHECK(FbxImageCodec::DecodePng(indexed.data(), indexed.size(), image));
+        FBX_CHECK(image.Width == 2 && image.Height == 1);
+        if (image.Pixels.size() == 2 * 4)
+        {
+            FBX_CHECK(PixelIs(image, 0, 0, 60, 70, 80, 255));
+            FBX_CHECK(PixelIs(image, 1, 0, 9, 8, 7, 255));
+        }
+
+        // 截断的数据必须失败并留下空图像
+        std::vector<uint8_t> truncated(png.begin(), png.begin() + png.size() / 2);
+        FBX_CHECK(!FbxImageCodec::DecodePng(truncated.data(), truncated.size(), image, &error));
+        FBX_CHECK(image.Pixels.empty());
+        FBX_CHECK(!error.empty());
+    }
+
+    std::vector<uint8_t> MakeTgaHeader(uint8_t imageType, uint16_t width, uint16_t height, uint8_t bits, uint8_t descriptor)
+    {
+        return { 0, 0, imageType, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                 static_cast<uint8_t>(width), static_cast<uint8_t>(width >> 8),
+                 static_cast<uint8_t>(height), static_cast<uint8_t>(height >> 8), bits, descriptor };
+    }
+
+    void TestTga()
+    {
+        // 2x2 未压缩24位，默认自下而上存储
+        std::vector<uint8_t> tga = MakeTgaHeader(2, 2, 2, 24, 0);
+        tga.insert(tga.end(), {
+            1, 2, 3, 4, 5, 6,           // 底行，BGR
+            7, 8, 9, 10, 11, 12,        // 顶行
+        });
+        FBX_CHECK(FbxImageCodec::DetectFormat(tga.data(), tga.size(), "a.tga") == FBX_IMAGE_TGA);
+
+        FbxImageLevel image;
+        FBX_CHECK(FbxImageCodec::Decode(tga.data(), tga.size(), FBX_IMAGE_TGA, image));
+        FBX_CHECK(image.Width == 2 && image.Height == 2);
+        if (image.Pixels.size() == 2 * 2 * 4)
+        {
+            FBX_CHECK(PixelIs(image, 0, 0, 9, 8, 7, 255));
+            FBX_CHECK(PixelIs(image, 1, 0, 12, 11, 10, 255));
+            FBX_CHECK(PixelIs(image, 0, 1, 3, 2, 1, 255));
+            FBX_CHECK(PixelIs(image, 1, 1, 6, 5, 4, 255));
+        }
+
+        // 3x1 RLE 32位，自上而下：一个重复包加一个原样包
+        std::vector<uint8_t> rle = MakeTgaHeader(10, 3, 1, 32, 0x28);
+        rle.insert(rle.end(), {
+            0x81, 10, 20, 30, 40,
+            0x00, 50, 60, 70, 80,
+        });
+        FBX_CHECK(FbxImageCodec::DecodeTga(rle.data(), rle.size(), image));
+        FBX_CHECK(image.Width == 3 && image.Height == 1);
+        if (image.Pixels.size() == 3 * 4)
+        {
+            FBX_CHECK(PixelIs(image, 0, 0, 30, 20, 10, 40));
+            FBX_CHECK(PixelIs(image, 1, 0, 30, 20, 10, 40));
+            FBX_CHECK(PixelIs(image, 2, 0, 70, 60, 50, 80));
+        }
+
+        // 像素数据不足
+        std::vector<uint8_t> truncated(tga.begin(), tga.end() - 3);
+        FBX_CHECK(!FbxImageCodec::DecodeTga(truncated.data(), truncated.size(), image));
+    }
+
+    /**
+     * @return 解码结果与图案的最大通道误差，解码失败或尺寸不符时为-1
+     */
+    int JpegError(const uint8_t* data, size_t size, bool gray)
+    {
+        FbxImageLevel image;
+        std::string error;
+        if (!FbxImageCodec::Decode(data, size, FBX_IMAGE_JPEG, image, &error))
+        {
+            std::fprintf(stderr, "jpeg: %s\n", error.c_str());
+            return -1;
+        }
+        if (image.Width != kWidth || image.Height != kHeight || image.Pixels.size() != kWidth * kHeight * 4)
+            return -1;
+
+        int maxError = 0;
+        for (uint32_t y = 0; y < kHeight; ++y)
+        {
+            for (uint32_t x = 0; x < kWidth; ++x)
+            {
+                uint8_t expected[3];
+                Pattern(x, y, expected);
+                if (gray)
+                    expected[0] = expected[1] = expected[2] = static_cast<uint8_t>((expected[0] + expected[1]) / 2);
+
+                const uint8_t* p = &image.Pixels[(static_cast<size_t>(y) * kWidth + x) * 4];
+                for (int c = 0; c < 3; ++c)
+                    maxError = std::max(maxError, std::abs(p[c] - expected[c]));
+                if (p[3] != 255)
+                    return -1;
+            }
+        }
+        return maxError;
+    }
+
+    void TestJpeg()
+    {
+        uint32_t width = 0, height = 0;
+        FBX_CHECK(FbxImageCodec::DetectFormat(kBaseline420, sizeof(kBaseline420), "a.bin") == FBX_IMAGE_JPEG);
+        FBX_CHECK(FbxImageCodec::ReadDimensions(kBaseline420, sizeof(kBaseline420), FBX_IMAGE_JPEG, width, height));
+        FBX_CHECK(width == kWidth && height == kHeight);
+
+        // 色度二次采样的误差集中在颜色变化最快的边缘
+        const int baseline = JpegError(kBaseline420, sizeof(kBaseline420), false);
+        FBX_CHECK(baseline >= 0 && baseline <= 16);
+        const int progressive = JpegError(kProgressive422, sizeof(kProgressive422), false);
+        FBX_CHECK(progressive >= 0 && progressive <= 16);
+        const int gray = JpegError(kGray, sizeof(kGray), true);
+        FBX_CHECK(gray >= 0 && gray <= 4);
+
+        // 截断在熵编码数据中间
+        FbxImageLevel image;
+        std::string error;
+        FBX_CHECK(!FbxImageCodec::DecodeJpeg(kBaseline420, sizeof(kBaseline420) / 2, image, &error));
+        FBX_CHECK(image.Pixels.empty());
+        FBX_CHECK(!error.empty());
+    }
+}
+
+int main()
+{
+    TestPng();
+    TestTga();
+    TestJpeg();
+    return FbxTestResult("test_image");
+}
@@ -0,0 +1,71 @@
+/**
+ * @brief 增量加载：重新导入失败时场景与缓存保持上一次成功加载的内容；启用内存池时拒绝增量加载
+ */
+#include "../FbxSdkWrapper.h"
+#include "FbxTestCheck.h"
+#include "FbxTestScene.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace
+{
+    bool TruncateFile(const std::string& path)
+    {
+        // 模拟仍在写入中的文件：大小变化，内容不是完整的FBX
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "Kaydara FBX Binary  ";
+        return static_cast<bool>(out);
+    }
+}
+
+int main()
+{
+    const std::string path = "test_incremental.fbx";
+    FBX_CHECK(FbxWriteTestScene(path, "albedo.png"));
+
+    {
+        FbxSdkWrapper wrapper;
+        FbxSceneDelta delta;
+        FBX_CHECK(wrapper.LoadIncremental(path, delta));
+        FBX_CHECK(delta.AddedMeshes.size() == 1);
+        FBX_CHECK(delta.AddedMaterials.size() == 1);
+
+        const FbxIncrementalCache& cache = wrapper.GetIncrementalCache();
+        FBX_CHECK(cache.GetGeometries().size() == 1);
+        FBX_CHECK(cache.GetMaterials().size() == 1);
+        const char* texture = cache.GetMaterials().begin()->second.Diffuse.Texture;
+        FBX_CHECK(texture && std::strcmp(texture, "albedo.png") == 0);
+
+        // 重新导入失败：返回false，旧场景仍然加载，缓存中的Texture仍指向有效的字符串
+        FBX_CHECK(TruncateFile(path));
+        FBX_CHECK(!wrapper.ReloadIfChanged(delta));
+        FBX_CHECK(delta.IsEmpty());
+        FBX_CHECK(wrapper.IsLoaded());
+        FBX_CHECK(wrapper.GetScene()->GetGeometryCount() == 1);
+        FBX_CHECK(cache.GetGeometries().size() == 1);
+        FBX_CHECK(cache.GetMaterials().size() == 1);
+        texture = cache.GetMaterials().begin()->second.Diffuse.Texture;
+        FBX_CHECK(texture && std::strcmp(texture, "albedo.png") == 0);
+
+        // 文件写完后再次重新加载成功，贴图名来自新场景
+        FBX_CHECK(FbxWriteTestScene(path, "albedo_v2.png"));
+        FBX_CHECK(wrapper.ReloadIfChanged(delta));
+        FBX_CHECK(delta.ModifiedMaterials.size() == 1);
+        FBX_CHECK(delta.ModifiedMeshes.empty());
+        texture = cache.GetMaterials().begin()->second.Diffuse.Texture;
+        FBX_CHECK(texture && std::strcmp(texture, "albedo_v2.png") == 0);
+    }
+
+    {
+        // 单调内存池不回收被替换的场景，增量加载直接拒绝
+        FbxSdkWrapper wrapper(true);
+        FbxSceneDelta delta;
+        FBX_CHECK(!wrapper.LoadIncremental(path, delta));
+        FBX_CHECK(wrapper.GetIncrementalCache().GetGeometries().empty());
+    }
+
+    std::remove(path.c_str());
+    return FbxTestResult("test_incremental");
+}
@@ -0,0 +1,51 @@
+/**
+ * @brief 日志队列满时：Info及以下丢弃并计数，Error同步交给输出端
+ */
+#include "../FbxSdkLog.h"
+#include "FbxTestCheck.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+int main()
+{
+    std::atomic<bool> released{ false };
+    std::atomic<int> infoCount{ 0 };
+    std::atomic<int> errorCount{ 0 };
+
+    FbxLogger::SetLevel(FBX_LOG_LEVEL_INFO);
+    FbxLogger::SetSink([&](FbxLogLevel level, int64_t, uint32_t, const char* message)
+    {
+        // 第一条消息卡住后台线程，让队列填满
+        while (!released.load())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if (level == FBX_LOG_LEVEL_ERROR && std::strcmp(message, "error 7") == 0)
+            ++errorCount;
+        else if (level == FBX_LOG_LEVEL_INFO)
+            ++infoCount;
+    });
+
+    const int infoWritten = static_cast<int>(FbxLogger::kCapacity) * 2;
+    for (int i = 0; i < infoWritten; ++i)
+        FBX_LOG_INFO("info %d", i);
+    FBX_CHECK(FbxLogger::GetDroppedCount() > 0);
+
+    // Error要等输出端的锁，由另一个线程放行后台线程
+    std::thread releaser([&]
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        released.store(true);
+    });
+    const uint64_t droppedBefore = FbxLogger::GetDroppedCount();
+    FBX_LOG_ERROR("error %d", 7);
+    FBX_CHECK(errorCount.load() == 1);
+    releaser.join();
+
+    FbxLogger::Flush();
+    FBX_CHECK(FbxLogger::GetDroppedCount() == droppedBefore);
+    FBX_CHECK(infoCount.load() + static_cast<int>(droppedBefore) == infoWritten);
+
+    FbxLogger::SetSink(FbxLogSink());
+    return FbxTestResult("test_log");
+}
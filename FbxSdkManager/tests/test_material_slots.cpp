@@ -0,0 +1,112 @@
+/**
+ * @brief 共用Mesh的实例节点使用不同材质：每个用到的槽位一个section，各节点按MaterialSlot解析自己的材质
+ */
+#include "../FbxSdkLibrary.h"
+#include "FbxTestCheck.h"
+#include <fbxsdk.h>
+#include <vector>
+
+namespace
+{
+    const FbxSection* FindSlot(const FbxGeometryInfo& geometry, int slot, uint64_t* key)
+    {
+        for (const auto& section : geometry.Sections)
+        {
+            if (section.second.MaterialSlot == slot)
+            {
+                *key = section.first;
+                return &section.second;
+            }
+        }
+        return nullptr;
+    }
+
+    uint64_t Resolve(const std::vector<uint64_t>& nodeMaterials, const FbxSection& section)
+    {
+        const int slot = section.MaterialSlot;
+        return slot >= 0 && static_cast<size_t>(slot) < nodeMaterials.size() ? nodeMaterials[slot] : 0;
+    }
+}
+
+int main()
+{
+    FbxManager* manager = FbxManager::Create();
+    FbxScene* scene = FbxScene::Create(manager, "Slots");
+
+    // 三个四边形，分别使用槽位0、1、2
+    FbxMesh* mesh = FbxMesh::Create(scene, "Shared");
+    mesh->InitControlPoints(8);
+    FbxVector4* points = mesh->GetControlPoints();
+    for (int i = 0; i < 4; ++i)
+    {
+        points[2 * i] = FbxVector4(i, 0.0, 0.0);
+        points[2 * i + 1] = FbxVector4(i, 1.0, 0.0);
+    }
+    FbxGeometryElementMaterial* element = mesh->CreateElementMaterial();
+    element->SetMappingMode(FbxGeometryElement::eByPolygon);
+    element->SetReferenceMode(FbxGeometryElement::eIndexToDirect);
+    for (int quad = 0; quad < 3; ++quad)
+    {
+        mesh->BeginPolygon(quad);
+        mesh->AddPolygon(2 * quad);
+        mesh->AddPolygon(2 * quad + 2);
+        mesh->AddPolygon(2 * quad + 3);
+        mesh->AddPolygon(2 * quad + 1);
+        mesh->EndPolygon();
+        element->GetIndexArray().Add(quad);
+    }
+
+    FbxSurfacePhong* m1 = FbxSurfacePhong::Create(scene, "M1");
+    FbxSurfacePhong* m2 = FbxSurfacePhong::Create(scene, "M2");
+    FbxSurfacePhong* m3 = FbxSurfacePhong::Create(scene, "M3");
+
+    // 首个实例A：[M1, M1]，槽位2不存在；实例B：[M1, M2, M3]
+    FbxNode* a = FbxNode::Create(scene, "A");
+    a->SetNodeAttribute(mesh);
+    a->AddMaterial(m1);
+    a->AddMaterial(m1);
+    scene->GetRootNode()->AddChild(a);
+    FbxNode* b = FbxNode::Create(scene, "B");
+    b->SetNodeAttribute(mesh);
+    b->AddMaterial(m1);
+    b->AddMaterial(m2);
+    b->AddMaterial(m3);
+    scene->GetRootNode()->AddChild(b);
+    FBX_CHECK(mesh->GetNode() == a);
+
+    FbxGeometryInfo geometry = FbxSdkLibrary::GetFbxGeometry(mesh);
+    FBX_CHECK(geometry.Sections.size() == 3);
+
+    uint64_t keys[3] = {};
+    const FbxSection* sections[3] = {};
+    for (int slot = 0; slot < 3; ++slot)
+    {
+        sections[slot] = FindSlot(geometry, slot, &keys[slot]);
+        FBX_CHECK(sections[slot] != nullptr);
+        if (sections[slot])
+            FBX_CHECK(sections[slot]->Triangle.size() == 6);
+    }
+
+    // 材质Id只归最靠前的槽位，其余槽位用槽位键
+    FBX_CHECK(keys[0] == m1->GetUniqueID());
+    FBX_CHECK(keys[1] == FbxSlotSectionKey(1) && FbxIsSlotSectionKey(keys[1]));
+    FBX_CHECK(keys[2] == FbxSlotSectionKey(2));
+    FBX_CHECK(!FbxIsSlotSectionKey(keys[0]));
+
+    std::vector<uint64_t> materialsA;
+    std::vector<uint64_t> materialsB;
+    FbxSdkLibrary::GetMaterialIdTable(a, materialsA);
+    FbxSdkLibrary::GetMaterialIdTable(b, materialsB);
+    if (sections[0] && sections[1] && sections[2])
+    {
+        FBX_CHECK(Resolve(materialsA, *sections[0]) == m1->GetUniqueID());
+        FBX_CHECK(Resolve(materialsA, *sections[1]) == m1->GetUniqueID());
+        FBX_CHECK(Resolve(materialsA, *sections[2]) == 0);
+        FBX_CHECK(Resolve(materialsB, *sections[0]) == m1->GetUniqueID());
+        FBX_CHECK(Resolve(materialsB, *sections[1]) == m2->GetUniqueID());
+        FBX_CHECK(Resolve(materialsB, *sections[2]) == m3->GetUniqueID());
+    }
+
+    manager->Destroy();
+    return FbxTestResult("test_material_slots");
+}
@@ -0,0 +1,109 @@
+/**
+ * @brief 二进制扫描器面对伪造的节点记录：长度回绕、EndOffset不前进时必须终止，合法记录照常统计
+ */
+#include "../FbxSdkProbe.h"
+#include "FbxTestCheck.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // 7500及以上版本的节点头：EndOffset、属性数、属性列表长度各8字节，名字长度1字节
+    const size_t kNodeHeaderSize = 25;
+
+    void AppendU64(std::vector<uint8_t>& out, uint64_t value)
+    {
+        for (int i = 0; i < 8; ++i)
+            out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+
+    void PatchU64(std::vector<uint8_t>& out, size_t offset, uint64_t value)
+    {
+        for (int i = 0; i < 8; ++i)
+            out[offset + i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+
+    std::vector<uint8_t> MakeHeader()
+    {
+        const char magic[] = "Kaydara FBX Binary  ";
+        std::vector<uint8_t> file(magic, magic + 20);
+        file.insert(file.end(), { 0x00, 0x1a, 0x00 });
+        const uint32_t version = 7500;
+        for (int i = 0; i < 4; ++i)
+            file.push_back(static_cast<uint8_t>(version >> (8 * i)));
+        return file;
+    }
+
+    /**
+     * @brief 写一个没有属性的节点头，返回其偏移；EndOffset由调用者回填
+     */
+    size_t BeginNode(std::vector<uint8_t>& file, const char* name, uint64_t propertyListLength = 0)
+    {
+        const size_t offset = file.size();
+        AppendU64(file, 0);
+        AppendU64(file, 0);
+        AppendU64(file, propertyListLength);
+        file.push_back(static_cast<uint8_t>(strlen(name)));
+        file.insert(file.end(), name, name + strlen(name));
+        return offset;
+    }
+
+    void EndNode(std::vector<uint8_t>& file, size_t offset)
+    {
+        file.insert(file.end(), kNodeHeaderSize, 0);    // 子节点列表结束的空记录
+        PatchU64(file, offset, file.size());
+    }
+
+    /**
+     * @brief Objects { Model, <伪造记录> }：伪造记录的属性列表长度回绕到节点头之前，EndOffset指向自身
+     */
+    std::vector<uint8_t> MakeWrappedChild()
+    {
+        std::vector<uint8_t> file = MakeHeader();
+        const size_t objects = BeginNode(file, "Objects");
+        const size_t model = BeginNode(file, "Model");
+        EndNode(file, model);
+
+        const size_t bad = BeginNode(file, "Model", 0 - static_cast<uint64_t>(kNodeHeaderSize + 5));
+        PatchU64(file, bad, bad);
+        EndNode(file, objects);
+        return file;
+    }
+
+    /**
+     * @brief 顶层记录的EndOffset小于自身偏移
+     */
+    std::vector<uint8_t> MakeBackwardTopLevel()
+    {
+        std::vector<uint8_t> file = MakeHeader();
+        const size_t first = BeginNode(file, "Header");
+        EndNode(file, first);
+        const size_t second = BeginNode(file, "Objects");
+        EndNode(file, second);
+        PatchU64(file, second, first);
+        return file;
+    }
+}
+
+int main()
+{
+    // 合法的部分照常统计
+    std::vector<uint8_t> wrapped = MakeWrappedChild();
+    FbxProbeInfo info;
+    FBX_CHECK(FbxSdkProbe::ProbeMemory(wrapped.data(), wrapped.size(), info));
+    FBX_CHECK(info.FileVersion == 7500);
+    FBX_CHECK(info.ModelCount == 1);
+
+    std::vector<FbxEmbeddedMedia> media;
+    FBX_CHECK(FbxSdkProbe::ListEmbeddedMedia(wrapped.data(), wrapped.size(), media));
+    FBX_CHECK(media.empty());
+
+    // 能返回即说明遍历终止
+    std::vector<uint8_t> backward = MakeBackwardTopLevel();
+    FBX_CHECK(FbxSdkProbe::ProbeMemory(backward.data(), backward.size(), info));
+    FBX_CHECK(info.ModelCount == 0);
+    FBX_CHECK(FbxSdkProbe::ListEmbeddedMedia(backward.data(), backward.size(), media));
+
+    return FbxTestResult("test_probe");
+}
@@ -0,0 +1,82 @@
+/**
+ * @brief 分片容器读取器拒绝目录偏移与条目数不一致的尾部，包括相加后回绕的偏移
+ */
+#include "../FbxSdkShard.h"
+#include "FbxTestCheck.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::vector<uint8_t> ReadAll(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void WriteAll(const std::string& path, const std::vector<uint8_t>& bytes)
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    /**
+     * @brief 改写尾部的目录偏移（8字节）与条目数（4字节），小端
+     */
+    void PatchFooter(std::vector<uint8_t>& bytes, uint64_t tableOffset, uint32_t count)
+    {
+        uint8_t* footer = bytes.data() + bytes.size() - 16;
+        for (int i = 0; i < 8; ++i)
+            footer[i] = static_cast<uint8_t>(tableOffset >> (8 * i));
+        for (int i = 0; i < 4; ++i)
+            footer[8 + i] = static_cast<uint8_t>(count >> (8 * i));
+    }
+}
+
+int main()
+{
+    const std::string path = "test_shard.bin";
+    const uint8_t payload[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    {
+        FbxShardWriter writer;
+        FBX_CHECK(writer.Open(path));
+        FbxShardEntry entry;
+        entry.MeshId = 42;
+        FBX_CHECK(writer.Add(entry, payload, sizeof(payload)));
+        FBX_CHECK(writer.Finish());
+    }
+
+    const std::vector<uint8_t> original = ReadAll(path);
+    {
+        FbxShardReader reader;
+        FBX_CHECK(reader.Open(path));
+        FBX_CHECK(reader.GetEntries().size() == 1);
+        if (reader.GetEntries().size() == 1)
+            FBX_CHECK(reader.GetEntries()[0].MeshId == 42 && reader.GetEntries()[0].Size == sizeof(payload));
+    }
+
+    // 两个条目时目录应从size - 16 - 80开始，这里为负数；回绕后的偏移与条目数相加恰好等于文件大小
+    std::vector<uint8_t> wrapped = original;
+    PatchFooter(wrapped, static_cast<uint64_t>(wrapped.size()) - 16 - 2 * 40, 2);
+    WriteAll(path, wrapped);
+    {
+        FbxShardReader reader;
+        FBX_CHECK(!reader.Open(path));
+        FBX_CHECK(reader.GetEntries().empty());
+    }
+
+    // 偏移在文件内但条目数不符
+    std::vector<uint8_t> miscounted = original;
+    PatchFooter(miscounted, miscounted.size() - 16 - 40, 3);
+    WriteAll(path, miscounted);
+    {
+        FbxShardReader reader;
+        FBX_CHECK(!reader.Open(path));
+    }
+
+    std::remove(path.c_str());
+    return FbxTestResult("test_shard");
+}
@@ -0,0 +1,81 @@
+/**
+ * @brief 蒙皮提取：Link不在场景层级中的Cluster被跳过，不能把顶点绑定到根关节
+ */
+#include "../FbxSdkSkin.h"
+#include "FbxTestCheck.h"
+#include <fbxsdk.h>
+
+namespace
+{
+    FbxNode* CreateJoint(FbxScene* scene, const char* name)
+    {
+        FbxSkeleton* skeleton = FbxSkeleton::Create(scene, name);
+        skeleton->SetSkeletonType(FbxSkeleton::eLimbNode);
+        FbxNode* node = FbxNode::Create(scene, name);
+        node->SetNodeAttribute(skeleton);
+        return node;
+    }
+
+    void AddCluster(FbxSkin* skin, FbxNode* link, int controlPoint)
+    {
+        FbxCluster* cluster = FbxCluster::Create(skin->GetScene(), link->GetName());
+        cluster->SetLink(link);
+        cluster->SetLinkMode(FbxCluster::eNormalize);
+        cluster->AddControlPointIndex(controlPoint, 1.0);
+        FbxAMatrix identity;
+        identity.SetIdentity();
+        cluster->SetTransformMatrix(identity);
+        cluster->SetTransformLinkMatrix(identity);
+        skin->AddCluster(cluster);
+    }
+}
+
+int main()
+{
+    FbxManager* manager = FbxManager::Create();
+    FbxScene* scene = FbxScene::Create(manager, "Skin");
+
+    FbxMesh* mesh = FbxMesh::Create(scene, "Body");
+    mesh->InitControlPoints(3);
+    mesh->BeginPolygon();
+    for (int i = 0; i < 3; ++i)
+        mesh->AddPolygon(i);
+    mesh->EndPolygon();
+    FbxNode* meshNode = FbxNode::Create(scene, "BodyNode");
+    meshNode->SetNodeAttribute(mesh);
+    scene->GetRootNode()->AddChild(meshNode);
+
+    // Root -> Arm 在层级中；Stray 没有挂到场景上
+    FbxNode* root = CreateJoint(scene, "Root");
+    FbxNode* arm = CreateJoint(scene, "Arm");
+    root->AddChild(arm);
+    scene->GetRootNode()->AddChild(root);
+    FbxNode* stray = CreateJoint(scene, "Stray");
+
+    FbxSkin* skin = FbxSkin::Create(scene, "BodySkin");
+    AddCluster(skin, arm, 0);
+    AddCluster(skin, stray, 1);
+    mesh->AddDeformer(skin);
+
+    FbxSkinningInfo skinning;
+    FbxSkinExtractor::Extract(scene, FbxSkinOptions(), skinning);
+
+    FBX_CHECK(skinning.Skeleton.size() == 2);
+    FBX_CHECK(skinning.Skins.size() == 1);
+    if (skinning.Skins.size() == 1)
+    {
+        const FbxSkinInfo& info = skinning.Skins.begin()->second;
+        FBX_CHECK(info.Joints.size() == 1);
+        FBX_CHECK(info.InverseBindMatrices.size() == 1);
+        if (info.Joints.size() == 1 && static_cast<size_t>(info.Joints[0]) < skinning.Skeleton.size())
+            FBX_CHECK(skinning.Skeleton[info.Joints[0]].Name == "Arm");
+
+        // 控制点0完全绑定到Arm；控制点1的唯一影响被跳过，没有任何权重
+        FBX_CHECK(info.GetJointIndex(0, 0) == 0 && info.GetWeight(0, 0) == 1.0f);
+        for (int slot = 0; slot < info.InfluenceCount; ++slot)
+            FBX_CHECK(info.GetWeight(1, slot) == 0.0f);
+    }
+
+    manager->Destroy();
+    return FbxTestResult("test_skin");
+}